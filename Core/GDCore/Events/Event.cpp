@@ -9,6 +9,7 @@
 #include "GDCore/PlatformDefinition/Platform.h"
 #include "GDCore/PlatformDefinition/PlatformExtension.h"
 #include "GDCore/Events/EventsCodeGenerator.h"
+#include "GDCore/Events/EventsCodeOutput.h"
 
 namespace gd
 {
@@ -29,13 +30,13 @@ bool BaseEvent::HasSubEvents() const
     return !GetSubEvents().IsEmpty();
 }
 
-std::string BaseEvent::GenerateEventCode(gd::EventsCodeGenerator & codeGenerator, gd::EventsCodeGenerationContext & context)
+void BaseEvent::GenerateEventCode(gd::EventsCodeGenerator & codeGenerator, gd::EventsCodeGenerationContext & context, gd::EventsCodeOutput & output)
 {
-    if ( IsDisabled() ) return "";
+    if ( IsDisabled() ) return;
 
     try
     {
-        if ( type.empty() ) return "";
+        if ( type.empty() ) return;
 
         const gd::Platform & platform = codeGenerator.GetPlatform();
 
@@ -46,7 +47,10 @@ std::string BaseEvent::GenerateEventCode(gd::EventsCodeGenerator & codeGenerator
         {
             std::map<std::string, gd::EventMetadata > & allEvents = guessedExtension->GetAllEvents();
             if ( allEvents.find(type) != allEvents.end() && allEvents[type].codeGeneration )
-                return allEvents[type].codeGeneration->Generate(*this, codeGenerator, context);
+            {
+                allEvents[type].codeGeneration->Generate(*this, codeGenerator, context, output);
+                return;
+            }
         }
 
 
@@ -58,15 +62,16 @@ std::string BaseEvent::GenerateEventCode(gd::EventsCodeGenerator & codeGenerator
 
             std::map<std::string, gd::EventMetadata > & allEvents = extension->GetAllEvents();
             if ( allEvents.find(type) != allEvents.end() && allEvents[type].codeGeneration )
-                return allEvents[type].codeGeneration->Generate(*this, codeGenerator, context);
+            {
+                allEvents[type].codeGeneration->Generate(*this, codeGenerator, context, output);
+                return;
+            }
         }
     }
     catch(...)
     {
         std::cout << "ERROR: Exception caught during code generation for event \"" << type <<"\"." << std::endl;
     }
-
-    return "";
 }
 
 void BaseEvent::Preprocess(gd::EventsCodeGenerator & codeGenerator, gd::EventsList & eventList, unsigned int indexOfTheEventInThisList)
@@ -20,6 +20,7 @@ namespace gd { class Project; }
 namespace gd { class Layout; }
 namespace gd { class EventsCodeGenerator; }
 namespace gd { class EventsCodeGenerationContext; }
+namespace gd { class EventsCodeOutput; }
 namespace gd { class Platform; }
 class wxWindow;
 namespace gd { class EventsEditorItemsAreas; }
@@ -119,7 +120,7 @@ public:
 
     /**
      * \brief Generate the code event : the platform provided by \a codeGenerator is asked for the EventMetadata associated to the event,
-     * which is then used to generate the code event ( gd::EventMetadata::codeGeneration member )
+     * which is then used to generate the code event ( gd::EventMetadata::codeGeneration member ). The code is written at the end of \a output.
      *
      * \warning Even if this method is virtual, you should never redefine it: Always provide the code generation using gd::EventMetadata.
      * This method is virtual as some platforms could have hidden events ( such as profiling events ) needing code generation without declaring
@@ -127,7 +128,7 @@ public:
      *
      * \see gd::EventMetadata
      */
-    virtual std::string GenerateEventCode(gd::EventsCodeGenerator & codeGenerator, gd::EventsCodeGenerationContext & context);
+    virtual void GenerateEventCode(gd::EventsCodeGenerator & codeGenerator, gd::EventsCodeGenerationContext & context, gd::EventsCodeOutput & output);
 
     /**
      * Called before events are compiled : the platform provided by \a codeGenerator is asked for the EventMetadata associated to the event,
@@ -7,6 +7,7 @@
 #include "GDCore/Events/EventMetadata.h"
 #include "GDCore/Events/EventsList.h"
 #include "GDCore/Events/Event.h"
+#include "GDCore/Events/EventsCodeOutput.h"
 
 namespace gd
 {
@@ -30,6 +31,11 @@ std::string EventMetadata::CodeGenerator::Generate(gd::BaseEvent & event, gd::Ev
     return "";
 }
 
+void EventMetadata::CodeGenerator::Generate(gd::BaseEvent & event, gd::EventsCodeGenerator & codeGenerator, gd::EventsCodeGenerationContext & context, gd::EventsCodeOutput & output)
+{
+    output << Generate(event, codeGenerator, context);
+}
+
 void EventMetadata::CodeGenerator::Preprocess(gd::BaseEvent & event, gd::EventsCodeGenerator & codeGenerator,
                                               gd::EventsList & eventList, unsigned int indexOfTheEventInThisList)
 {
@@ -18,6 +18,7 @@ namespace gd { class EventsList; }
 namespace gd { class BaseEvent; }
 namespace gd { class EventsCodeGenerator; }
 namespace gd { class EventsCodeGenerationContext; }
+namespace gd { class EventsCodeOutput; }
 
 namespace gd
 {
@@ -46,6 +47,15 @@ public:
          */
         virtual std::string Generate(gd::BaseEvent & event, gd::EventsCodeGenerator & codeGenerator, gd::EventsCodeGenerationContext & context);
 
+        /**
+         * \brief Generate the code of the event at the end of \a output.
+         *
+         * The default implementation writes the code returned by Generate. Redefine this method
+         * for events having sub events, so that their code is written directly in the output
+         * ( see gd::EventsCodeGenerator::GenerateEventsListCode ) instead of being copied.
+         */
+        virtual void Generate(gd::BaseEvent & event, gd::EventsCodeGenerator & codeGenerator, gd::EventsCodeGenerationContext & context, gd::EventsCodeOutput & output);
+
         /**
          * \brief Called for events that must be preprocessed.
          *
@@ -627,23 +627,33 @@ std::string EventsCodeGenerator::GenerateObjectsDeclarationCode(EventsCodeGenera
  */
 string EventsCodeGenerator::GenerateEventsListCode(gd::EventsList & events, const EventsCodeGenerationContext & parentContext)
 {
-    string output;
+    gd::EventsCodeOutput output;
+    GenerateEventsListCode(events, parentContext, output);
 
+    return output.ToString();
+}
+
+void EventsCodeGenerator::GenerateEventsListCode(gd::EventsList & events, const EventsCodeGenerationContext & parentContext, gd::EventsCodeOutput & output)
+{
     for ( unsigned int eId = 0; eId < events.size();++eId )
     {
         //Each event has its own context : Objects picked in an event are totally different than the one picked in another.
         gd::EventsCodeGenerationContext context;
         context.InheritsFrom(parentContext); //Events in the same "level" share the same context as their parent.
 
-        string eventCoreCode = events[eId].GenerateEventCode(*this, context);
+        //The scope and the declarations are known only when the code of the event is generated.
+        output << "\n";
+        std::size_t scopeBeginAndDeclarations = output.AddPlaceholder();
+        output << "\n";
+        events[eId].GenerateEventCode(*this, context, output);
+
         string scopeBegin = GenerateScopeBegin(context);
         string scopeEnd = GenerateScopeEnd(context);
         string declarationsCode = GenerateObjectsDeclarationCode(context);
 
-        output += "\n"+ scopeBegin +"\n" + declarationsCode + "\n" + eventCoreCode + "\n"+ scopeEnd +"\n";
+        output.FillPlaceholder(scopeBeginAndDeclarations, scopeBegin +"\n" + declarationsCode);
+        output << "\n" << scopeEnd << "\n";
     }
-
-    return output;
 }
 
 std::string EventsCodeGenerator::ConvertToString(std::string plainString)
@@ -981,6 +991,19 @@ std::string EventsCodeGenerator::GetObjectListName(const std::string & name, con
     return ManObjListName(name);
 }
 
+unsigned int EventsCodeGenerator::GenerateStableIdentifier()
+{
+    //Multiplying the counter by an odd number and the finalizer of MurmurHash3 are bijective: identifiers made
+    //with the same seed are all different, and the identifiers of different seeds do not follow each other.
+    unsigned int identifier = stableIdentifiersSeed ^ (stableIdentifiersCount++ * 0x9E3779B9U);
+    identifier ^= identifier >> 16;
+    identifier *= 0x85EBCA6BU;
+    identifier ^= identifier >> 13;
+    identifier *= 0xC2B2AE35U;
+    identifier ^= identifier >> 16;
+    return identifier;
+}
+
 EventsCodeGenerator::EventsCodeGenerator(gd::Project & project_, const gd::Layout & layout, const gd::Platform & platform_) :
     project(project_),
     scene(layout),
@@ -988,7 +1011,9 @@ EventsCodeGenerator::EventsCodeGenerator(gd::Project & project_, const gd::Layou
     errorOccurred(false),
     compilationForRuntime(false),
     maxCustomConditionsDepth(0),
-    maxConditionsListsSize(0)
+    maxConditionsListsSize(0),
+    stableIdentifiersSeed(0),
+    stableIdentifiersCount(0)
 {
 };
 
@@ -2,6 +2,7 @@
 #define GDCORE_EVENTSCODEGENERATOR_H
 
 #include "GDCore/Events/Event.h"
+#include "GDCore/Events/EventsCodeOutput.h"
 #include <string>
 #include <vector>
 #include <set>
@@ -60,6 +61,18 @@ public:
      */
     std::string GenerateEventsListCode(gd::EventsList & events, const EventsCodeGenerationContext & context);
 
+    /**
+     * \brief Generate code for executing an event list, writing it at the end of \a output.
+     *
+     * Prefer this method when generating code for sub events: the code is not copied
+     * for each level of events.
+     *
+     * \param events std::vector of events
+     * \param context Context used for generation
+     * \param output The output where the code is written
+     */
+    void GenerateEventsListCode(gd::EventsList & events, const EventsCodeGenerationContext & context, gd::EventsCodeOutput & output);
+
     /**
      * \brief Generate code for executing a condition list
      *
@@ -211,6 +224,24 @@ public:
      */
     const std::set<std::string> & GetCustomGlobalDeclaration() const { return customGlobalDeclaration; }
 
+    /**
+     * \brief Return a new identifier to be used in the generated code ( for example to name a timer or a function ).
+     *
+     * Identifiers do not depend on the addresses of the events in memory: they are a hash of a seed
+     * ( see SetStableIdentifiersSeed ) and of a counter, so that the code generated for the same events
+     * is always the same. The identifiers generated with the same seed are all different, and are
+     * unlikely to be equal to the ones generated with another seed.
+     */
+    unsigned int GenerateStableIdentifier();
+
+    /**
+     * \brief Set the seed of the identifiers returned by GenerateStableIdentifier, and restart their counter.
+     *
+     * Seeds must be different for all the code which can be run by a scene: use for example
+     * a hash of the kind and of the name of the events ( "scene:"+name, "external:"+name ).
+     */
+    void SetStableIdentifiersSeed(unsigned int seed) { stableIdentifiersSeed = seed; stableIdentifiersCount = 0; };
+
     /**
      * \brief Return true if code generation is made for runtime only.
      */
@@ -466,6 +497,8 @@ protected:
     std::set<std::string> customGlobalDeclaration; ///< Custom global C++ declarations inserted after includes
     size_t maxCustomConditionsDepth; ///< The maximum depth value for all the custom conditions created.
     size_t maxConditionsListsSize; ///< The maximum size of a list of conditions.
+    unsigned int stableIdentifiersSeed; ///< See GenerateStableIdentifier.
+    unsigned int stableIdentifiersCount; ///< See GenerateStableIdentifier.
 };
 
 }
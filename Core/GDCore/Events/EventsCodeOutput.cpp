@@ -0,0 +1,61 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2015 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#include "GDCore/Events/EventsCodeOutput.h"
+
+namespace gd
+{
+
+EventsCodeOutput::EventsCodeOutput()
+{
+    chunks.push_back("");
+}
+
+EventsCodeOutput & EventsCodeOutput::operator<<(const std::string & code)
+{
+    chunks.back() += code;
+    return *this;
+}
+
+EventsCodeOutput & EventsCodeOutput::operator<<(const char * code)
+{
+    chunks.back() += code;
+    return *this;
+}
+
+std::size_t EventsCodeOutput::AddPlaceholder()
+{
+    chunks.push_back("");
+    std::size_t placeholder = chunks.size()-1;
+    chunks.push_back(""); //The code written after the placeholder goes in a new chunk.
+
+    return placeholder;
+}
+
+void EventsCodeOutput::FillPlaceholder(std::size_t placeholder, const std::string & code)
+{
+    if ( placeholder < chunks.size() ) chunks[placeholder] = code;
+}
+
+std::size_t EventsCodeOutput::GetSize() const
+{
+    std::size_t size = 0;
+    for (std::size_t i = 0;i<chunks.size();++i)
+        size += chunks[i].size();
+
+    return size;
+}
+
+std::string EventsCodeOutput::ToString() const
+{
+    std::string code;
+    code.reserve(GetSize());
+    for (std::size_t i = 0;i<chunks.size();++i)
+        code += chunks[i];
+
+    return code;
+}
+
+}
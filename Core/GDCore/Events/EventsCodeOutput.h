@@ -0,0 +1,81 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2015 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#ifndef GDCORE_EVENTSCODEOUTPUT_H
+#define GDCORE_EVENTSCODEOUTPUT_H
+
+#include <string>
+#include <vector>
+
+namespace gd
+{
+
+/**
+ * \brief The output where the code generated for events is written.
+ *
+ * The code of events is written at the end of the output, from the beginning of the events list to its end,
+ * so that the code of sub events is not copied again for each level of events.<br>
+ * When some code must be written before code which is not generated yet ( for example the declarations
+ * of the objects lists used by an event ), add a placeholder and fill it later.
+ *
+ * Usage example:
+ * \code
+ * gd::EventsCodeOutput output;
+ * output << "{\n";
+ * size_t declarations = output.AddPlaceholder();
+ * codeGenerator.GenerateEventsListCode(events, context, output);
+ * output.FillPlaceholder(declarations, codeGenerator.GenerateObjectsDeclarationCode(context));
+ * output << "}\n";
+ *
+ * std::string code = output.ToString();
+ * \endcode
+ *
+ * \see EventsCodeGenerator
+ * \ingroup Events
+ */
+class GD_CORE_API EventsCodeOutput
+{
+public:
+    EventsCodeOutput();
+    virtual ~EventsCodeOutput() {};
+
+    /**
+     * \brief Write code at the end of the output.
+     */
+    EventsCodeOutput & operator<<(const std::string & code);
+
+    /**
+     * \brief Write code at the end of the output.
+     */
+    EventsCodeOutput & operator<<(const char * code);
+
+    /**
+     * \brief Add a placeholder at the end of the output, to be filled later with FillPlaceholder.
+     * \return The identifier of the placeholder.
+     */
+    std::size_t AddPlaceholder();
+
+    /**
+     * \brief Set the code written at the position of a placeholder.
+     */
+    void FillPlaceholder(std::size_t placeholder, const std::string & code);
+
+    /**
+     * \brief Return the size, in characters, of the code written in the output.
+     */
+    std::size_t GetSize() const;
+
+    /**
+     * \brief Return the whole code written in the output.
+     */
+    std::string ToString() const;
+
+private:
+    std::vector<std::string> chunks; ///< The code is stored in chunks, separated by the placeholders ( which are chunks too ).
+};
+
+}
+
+#endif // GDCORE_EVENTSCODEOUTPUT_H
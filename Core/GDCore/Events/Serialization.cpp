@@ -172,9 +172,8 @@ void EventsListSerialization::UpdateInstructionsFromGD2x(gd::Project & project,
 void EventsListSerialization::UnserializeEventsFrom(gd::Project & project, EventsList & list, const SerializerElement & events)
 {
     events.ConsiderAsArrayOf("event", "Event");
-    for(unsigned int i = 0; i<events.GetChildrenCount(); ++i)
+    events.ForEachChild("", [&project, &list](SerializerElement & eventElem)
     {
-        SerializerElement & eventElem = events.GetChild(i);
         std::string type = eventElem.GetChild("type", 0, "Type").GetValue().GetString();
         gd::BaseEventSPtr event = project.CreateEvent(type);
         if ( event != std::shared_ptr<gd::BaseEvent>())
@@ -189,7 +188,7 @@ void EventsListSerialization::UnserializeEventsFrom(gd::Project & project, Event
         event->folded = eventElem.GetBoolAttribute("folded");
 
         list.InsertEvent(event, list.GetEventsCount());
-    }
+    });
 }
 
 void EventsListSerialization::SerializeEventsTo(const EventsList & list, SerializerElement & events)
@@ -213,10 +212,9 @@ using namespace std;
 void gd::EventsListSerialization::OpenConditions(gd::Project & project, vector < gd::Instruction > & conditions, const SerializerElement & elem)
 {
     elem.ConsiderAsArrayOf("condition", "Condition");
-    for(unsigned int i = 0; i<elem.GetChildrenCount(); ++i)
+    elem.ForEachChild("", [&project, &conditions](const SerializerElement & conditionElem)
     {
         gd::Instruction instruction;
-        const SerializerElement & conditionElem = elem.GetChild(i);
 
         instruction.SetType( conditionElem.GetChild("type", 0, "Type").GetStringAttribute("value") );
         instruction.SetInverted( conditionElem.GetChild("type", 0, "Type").GetBoolAttribute("inverted", false, "Contraire") );
@@ -227,8 +225,9 @@ void gd::EventsListSerialization::OpenConditions(gd::Project & project, vector <
         //Compatibility with GD <= 3.3
         if (conditionElem.HasChild("Parametre")) {
 
-            for (unsigned int j = 0;j<conditionElem.GetChildrenCount("Parametre");++j)
-                parameters.push_back(gd::Expression(conditionElem.GetChild("Parametre", j).GetValue().GetString()));
+            conditionElem.ForEachChild("Parametre", [&parameters](const SerializerElement & parameterElem) {
+                parameters.push_back(gd::Expression(parameterElem.GetValue().GetString()));
+            });
 
         }
         //end of compatibility code
@@ -236,8 +235,9 @@ void gd::EventsListSerialization::OpenConditions(gd::Project & project, vector <
         {
             const SerializerElement & parametersElem = conditionElem.GetChild("parameters");
             parametersElem.ConsiderAsArrayOf("parameter");
-            for (unsigned int j = 0;j<parametersElem.GetChildrenCount();++j)
-                parameters.push_back(gd::Expression(parametersElem.GetChild(j).GetValue().GetString()));
+            parametersElem.ForEachChild("", [&parameters](const SerializerElement & parameterElem) {
+                parameters.push_back(gd::Expression(parameterElem.GetValue().GetString()));
+            });
         }
 
         instruction.SetParameters( parameters );
@@ -247,7 +247,7 @@ void gd::EventsListSerialization::OpenConditions(gd::Project & project, vector <
             OpenConditions(project, instruction.GetSubInstructions(), conditionElem.GetChild("subConditions", 0, "SubConditions" ));
 
         conditions.push_back( instruction );
-    }
+    });
 
     if ( project.GetLastSaveGDMajorVersion() < 3 ||
          (project.GetLastSaveGDMajorVersion() == 3 && project.GetLastSaveGDMinorVersion() <= 1 ) )
@@ -260,10 +260,9 @@ void gd::EventsListSerialization::OpenConditions(gd::Project & project, vector <
 void gd::EventsListSerialization::OpenActions(gd::Project & project, vector < gd::Instruction > & actions, const SerializerElement & elem)
 {
     elem.ConsiderAsArrayOf("action", "Action");
-    for(unsigned int i = 0; i<elem.GetChildrenCount(); ++i)
+    elem.ForEachChild("", [&project, &actions](const SerializerElement & actionElem)
     {
         gd::Instruction instruction;
-        const SerializerElement & actionElem = elem.GetChild(i);
 
         instruction.SetType( actionElem.GetChild("type", 0, "Type").GetStringAttribute("value") );
 
@@ -273,8 +272,9 @@ void gd::EventsListSerialization::OpenActions(gd::Project & project, vector < gd
         //Compatibility with GD <= 3.3
         if (actionElem.HasChild("Parametre")) {
 
-            for (unsigned int j = 0;j<actionElem.GetChildrenCount("Parametre");++j)
-                parameters.push_back(gd::Expression(actionElem.GetChild("Parametre", j).GetValue().GetString()));
+            actionElem.ForEachChild("Parametre", [&parameters](const SerializerElement & parameterElem) {
+                parameters.push_back(gd::Expression(parameterElem.GetValue().GetString()));
+            });
 
         }
         //end of compatibility code
@@ -282,8 +282,9 @@ void gd::EventsListSerialization::OpenActions(gd::Project & project, vector < gd
         {
             const SerializerElement & parametersElem = actionElem.GetChild("parameters");
             parametersElem.ConsiderAsArrayOf("parameter");
-            for (unsigned int j = 0;j<parametersElem.GetChildrenCount();++j)
-                parameters.push_back(gd::Expression(parametersElem.GetChild(j).GetValue().GetString()));
+            parametersElem.ForEachChild("", [&parameters](const SerializerElement & parameterElem) {
+                parameters.push_back(gd::Expression(parameterElem.GetValue().GetString()));
+            });
         }
 
         instruction.SetParameters( parameters );
@@ -293,7 +294,7 @@ void gd::EventsListSerialization::OpenActions(gd::Project & project, vector < gd
             OpenActions(project, instruction.GetSubInstructions(), actionElem.GetChild("subActions", 0, "SubActions" ));
 
         actions.push_back( instruction );
-    }
+    });
 
     if ( project.GetLastSaveGDMajorVersion() < 3 ||
          (project.GetLastSaveGDMajorVersion() == 3 && project.GetLastSaveGDMinorVersion() <= 1 ) )
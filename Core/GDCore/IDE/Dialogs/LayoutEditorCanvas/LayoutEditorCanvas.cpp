@@ -168,6 +168,7 @@ LayoutEditorCanvas::LayoutEditorCanvas(wxWindow* parent, gd::Project & project_,
     Connect(wxEVT_MIDDLE_DOWN,(wxObjectEventFunction)&LayoutEditorCanvas::OnMiddleDown);
 	Connect(wxEVT_MIDDLE_UP,(wxObjectEventFunction)&LayoutEditorCanvas::OnMiddleUp);
 	Connect(wxEVT_MOTION,(wxObjectEventFunction)&LayoutEditorCanvas::OnMotion);
+	Connect(wxEVT_ENTER_WINDOW,(wxObjectEventFunction)&LayoutEditorCanvas::OnMouseEnter);
 	Connect(wxEVT_KEY_DOWN,(wxObjectEventFunction)&LayoutEditorCanvas::OnKey);
 	Connect(wxEVT_KEY_UP,(wxObjectEventFunction)&LayoutEditorCanvas::OnKeyUp);
 	Connect(wxEVT_MOUSEWHEEL,(wxObjectEventFunction)&LayoutEditorCanvas::OnMouseWheel);
@@ -964,7 +965,9 @@ void LayoutEditorCanvas::OnLeftUp(wxMouseEvent &)
         //Select the instances that are inside the selection rectangle
         InstancesInAreaPicker picker(*this);
         picker.IgnoreLockedInstances();
-        instances.IterateOverInstances(picker);
+        LayoutEditorCanvasInstancesBounds bounds(*this);
+        instances.IterateOverInstancesInArea(picker, sf::FloatRect(selectionRectangle.GetX(), selectionRectangle.GetY(),
+            selectionRectangle.GetWidth(), selectionRectangle.GetHeight()), bounds);
 
         for ( unsigned int i = 0; i<picker.GetSelectedList().size();++i)
             SelectInstance(picker.GetSelectedList()[i]);
@@ -973,6 +976,13 @@ void LayoutEditorCanvas::OnLeftUp(wxMouseEvent &)
     }
 }
 
+void LayoutEditorCanvas::OnMouseEnter(wxMouseEvent & event)
+{
+    //Objects may have been modified in another editor, changing the size of their instances.
+    instances.InvalidateSpatialIndex();
+    event.Skip();
+}
+
 void LayoutEditorCanvas::OnMotion(wxMouseEvent &)
 {
     if (!editing) return;
@@ -1279,7 +1289,8 @@ InitialInstance * LayoutEditorCanvas::GetInitialInstanceAtPosition(double xPosit
 {
     SmallestInstanceUnderCursorPicker picker(*this, xPosition, yPosition);
     if ( pickOnlyLockedInstances ) picker.PickLockedInstancesAndOnlyThem();
-    instances.IterateOverInstances(picker);
+    LayoutEditorCanvasInstancesBounds bounds(*this);
+    instances.IterateOverInstancesInArea(picker, sf::FloatRect(xPosition, yPosition, 0, 0), bounds);
 
     return picker.GetSmallestInstanceUnderCursor();
 }
@@ -1418,6 +1429,22 @@ sf::Vector2f LayoutEditorCanvas::GetInitialInstanceOrigin(gd::InitialInstance &
     return sf::Vector2f(0,0);
 }
 
+sf::FloatRect LayoutEditorCanvasInstancesBounds::operator()(gd::InitialInstance & instance)
+{
+    sf::Vector2f size = editor.GetInitialInstanceSize(instance);
+    sf::Vector2f origin = editor.GetInitialInstanceOrigin(instance);
+    sf::FloatRect bounds(instance.GetX()-origin.x, instance.GetY()-origin.y, size.x, size.y);
+
+    //A rotated instance stays inside a circle of the size of its diagonal, centered on any point of the instance.
+    if ( instance.GetAngle() != 0 )
+    {
+        float diagonal = sqrt(size.x*size.x+size.y*size.y);
+        bounds = sf::FloatRect(bounds.left-diagonal, bounds.top-diagonal, bounds.width+diagonal*2, bounds.height+diagonal*2);
+    }
+
+    return bounds;
+}
+
 gd::Object * LayoutEditorCanvas::GetObjectLinkedToInitialInstance(gd::InitialInstance & instance) const
 {
     if ( layout.HasObjectNamed(instance.GetObjectName()) )
@@ -1475,6 +1502,7 @@ void LayoutEditorCanvas::ReloadResources()
     for (unsigned int i = 0;i<project.GetObjectsCount();++i)
         project.GetObject(i).LoadResources(project, layout);
 
+    instances.InvalidateSpatialIndex();
     wxSetWorkingDirectory(mainFrameWrapper.GetIDEWorkingDirectory());
 }
 
@@ -19,9 +19,10 @@
 #include <wx/gdicmn.h>
 #include <wx/panel.h>
 #include "GDCore/PlatformDefinition/LayoutEditorPreviewer.h"
+#include "GDCore/PlatformDefinition/InitialInstancesContainer.h"
 namespace gd { class MainFrameWrapper; }
-namespace gd { class InitialInstancesContainer; }
 namespace gd { class InitialInstance; }
+namespace gd { class LayoutEditorCanvas; }
 namespace gd { class LayoutEditorCanvasAssociatedEditor; }
 namespace gd { class Project; }
 namespace gd { class Layout; }
@@ -58,6 +59,24 @@ public:
     InitialInstance * associatedInitialInstance; ///< The associated initial instance, if any.
 };
 
+/**
+ * \brief Compute the bounding box of the instances displayed in a LayoutEditorCanvas,
+ * so that the instances container can find the instances to be rendered or picked.
+ *
+ * \see LayoutEditorCanvas
+ */
+class GD_CORE_API LayoutEditorCanvasInstancesBounds : public gd::InitialInstanceBoundsFunctor
+{
+public:
+    LayoutEditorCanvasInstancesBounds(const LayoutEditorCanvas & editor_) : editor(editor_) {};
+    virtual ~LayoutEditorCanvasInstancesBounds() {};
+
+    virtual sf::FloatRect operator()(gd::InitialInstance & instance);
+
+private:
+    const LayoutEditorCanvas & editor;
+};
+
 /**
  * \brief Base class for implementing the main canvas of layout editors.
  *
@@ -324,6 +343,7 @@ protected:
     virtual void OnMouseWheel( wxMouseEvent &event );
     virtual void OnRightUp( wxMouseEvent &event );
     virtual void OnMotion( wxMouseEvent &event );
+    virtual void OnMouseEnter( wxMouseEvent &event );
     virtual void OnGridBtClick( wxCommandEvent & event );
     virtual void OnGridSetupBtClick( wxCommandEvent & event );
     virtual void OnObjectsPositionList( wxCommandEvent & event );
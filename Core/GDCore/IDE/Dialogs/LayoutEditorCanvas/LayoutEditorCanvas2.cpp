@@ -60,6 +60,7 @@ void LayoutEditorCanvas::OnUpdate()
             project.GetImageManager()->LoadPermanentImages();
             project.imagesChanged.clear();
             layout.SetRefreshNeeded();
+            instances.InvalidateSpatialIndex(); //The size of the instances may have changed.
 
             wxSetWorkingDirectory(mainFrameWrapper.GetIDEWorkingDirectory()); //Go back to the IDE cwd.
         }
@@ -188,6 +189,21 @@ public:
         if ( !associatedObject ) return;
 
         associatedObject->DrawInitialInstance(instance, editor, editor.project, editor.layout);
+    }
+
+    /**
+     * \brief Draw the selection rectangle of \a instance if it is selected, or its highlight rectangle if it is under the cursor.
+     *
+     * Done separately from the rendering of the instances, as selected instances can be outside of the view.
+     */
+    void DrawSelection(gd::InitialInstance & instance)
+    {
+        if ( !editor.layout.HasLayerNamed(instance.GetLayer()) || !editor.layout.GetLayer(instance.GetLayer()).GetVisibility() )
+            return;
+
+        gd::Object * associatedObject = editor.GetObjectLinkedToInitialInstance(instance);
+        if ( !associatedObject ) return;
+
         sf::Vector2f origin = associatedObject->GetInitialInstanceOrigin(instance, editor.project, editor.layout);
         sf::Vector2f size = sf::Vector2f(instance.GetCustomWidth(), instance.GetCustomHeight());
         if ( !instance.HasCustomSize() )
@@ -251,9 +267,12 @@ void LayoutEditorCanvas::RenderEdittime()
     //Prepare GUI elements and the renderer
     std::vector < std::shared_ptr<sf::Shape> > guiElementsShapes;
     guiElements.clear();
-    InstancesRenderer renderer(*this, GetInitialInstanceUnderCursor(), guiElementsShapes);
+    gd::InitialInstance * highlightedInstance = GetInitialInstanceUnderCursor();
+    InstancesRenderer renderer(*this, highlightedInstance, guiElementsShapes);
+    LayoutEditorCanvasInstancesBounds bounds(*this);
+    sf::FloatRect viewArea(editionView.getCenter()-editionView.getSize()/2.0f, editionView.getSize());
 
-    //Render objects of each layer
+    //Render objects of each layer, only drawing the instances which are in the view.
     for (unsigned int layerIndex =0;layerIndex<layout.GetLayersCount();++layerIndex)
     {
         if ( layout.GetLayer(layerIndex).GetVisibility() )
@@ -268,10 +287,15 @@ void LayoutEditorCanvas::RenderEdittime()
 
             pushGLStates();
 
-            instances.IterateOverInstancesWithZOrdering(renderer, layout.GetLayer(layerIndex).GetName());
+            instances.IterateOverInstancesWithZOrdering(renderer, layout.GetLayer(layerIndex).GetName(), viewArea, bounds);
         }
     }
 
+    for (std::map <InitialInstance*, wxRealPoint >::iterator it = selectedInstances.begin();it!=selectedInstances.end();++it)
+        renderer.DrawSelection(*it->first);
+    if ( highlightedInstance && selectedInstances.find(highlightedInstance) == selectedInstances.end() )
+        renderer.DrawSelection(*highlightedInstance);
+
 
     //Go back to "window" view before drawing GUI elements
     setView(sf::View(sf::Vector2f(getSize().x/2,getSize().y/2), sf::Vector2f(getSize().x,getSize().y)));
@@ -33,10 +33,8 @@ void ClassWithObjects::UnserializeObjectsFrom(gd::Project & project, const Seria
 {
     initialObjects.clear();
     element.ConsiderAsArrayOf("object", "Objet");
-    for (unsigned int i = 0; i < element.GetChildrenCount(); ++i)
+    element.ForEachChild("", [this, &project](const SerializerElement & objectElement)
     {
-        const SerializerElement & objectElement = element.GetChild(i);
-
         std::string type = objectElement.GetStringAttribute("type");
         std::shared_ptr<gd::Object> newObject =
             project.CreateObject(type, objectElement.GetStringAttribute("name", "", "nom"));
@@ -48,7 +46,7 @@ void ClassWithObjects::UnserializeObjectsFrom(gd::Project & project, const Seria
         }
         else
             std::cout << "WARNING: Unknown object type \"" << type << "\"" << std::endl;
-    }
+    });
 }
 
 bool ClassWithObjects::HasObjectNamed(const std::string & name) const
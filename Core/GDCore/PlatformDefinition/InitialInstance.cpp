@@ -5,6 +5,7 @@
  */
 
 #include "GDCore/PlatformDefinition/InitialInstance.h"
+#include "GDCore/PlatformDefinition/InitialInstancesContainer.h"
 #include "GDCore/PlatformDefinition/Project.h"
 #include "GDCore/PlatformDefinition/Layout.h"
 #include "GDCore/PlatformDefinition/Object.h"
@@ -15,13 +16,15 @@
 namespace gd
 {
 
+const gd::VariablesContainer InitialInstance::noVariables;
+
 InitialInstance::InitialInstance() :
-    objectName(""),
+    objectName(gd::InternedStrings::GetEmpty()),
     x(0),
     y(0),
     angle(0),
     zOrder(0),
-    layer(""),
+    layer(gd::InternedStrings::GetEmpty()),
     personalizedSize(false),
     width(0),
     height(0),
@@ -29,6 +32,53 @@ InitialInstance::InitialInstance() :
 {
 }
 
+InitialInstance::InitialInstance(const InitialInstance & other) :
+    floatInfos(other.floatInfos),
+    stringInfos(other.stringInfos),
+    objectName(other.objectName),
+    x(other.x),
+    y(other.y),
+    angle(other.angle),
+    zOrder(other.zOrder),
+    layer(other.layer),
+    personalizedSize(other.personalizedSize),
+    width(other.width),
+    height(other.height),
+    initialVariables(other.initialVariables ? new gd::VariablesContainer(*other.initialVariables) : NULL),
+    locked(other.locked)
+{
+}
+
+InitialInstance & InitialInstance::operator=(const InitialInstance & other)
+{
+    if ( this == &other ) return *this;
+
+    floatInfos = other.floatInfos;
+    stringInfos = other.stringInfos;
+    objectName = other.objectName;
+    x = other.x;
+    y = other.y;
+    angle = other.angle;
+    zOrder = other.zOrder;
+    layer = other.layer;
+    personalizedSize = other.personalizedSize;
+    width = other.width;
+    height = other.height;
+    initialVariables.reset(other.initialVariables ? new gd::VariablesContainer(*other.initialVariables) : NULL);
+    locked = other.locked;
+
+    //The container owning the instance is not changed, but has to know that the instance changed.
+    NotifyBoundsChanged();
+    NotifyZOrderChanged();
+    return *this;
+}
+
+gd::VariablesContainer & InitialInstance::GetVariables()
+{
+    if ( !initialVariables ) initialVariables.reset(new gd::VariablesContainer);
+    return *initialVariables;
+}
+
 
 #if defined(GD_IDE_ONLY)
 std::map<std::string, gd::PropertyDescriptor> gd::InitialInstance::GetCustomProperties(gd::Project & project, gd::Layout & layout)
@@ -45,6 +95,8 @@ std::map<std::string, gd::PropertyDescriptor> gd::InitialInstance::GetCustomProp
 
 bool gd::InitialInstance::UpdateCustomProperty(const std::string & name, const std::string & value, gd::Project & project, gd::Layout & layout)
 {
+    NotifyBoundsChanged(); //Custom properties can change the size of the instance.
+
     if ( layout.HasObjectNamed(GetObjectName()) )
         return layout.GetObject(GetObjectName()).UpdateInitialInstanceProperty(*this, name, value, project, layout);
     else if ( project.HasObjectNamed(GetObjectName()) )
@@ -53,6 +105,16 @@ bool gd::InitialInstance::UpdateCustomProperty(const std::string & name, const s
     return false;
 }
 
+void InitialInstance::NotifyBoundsChanged()
+{
+    if ( owner.container ) owner.container->OnInstanceBoundsChanged(*this);
+}
+
+void InitialInstance::NotifyZOrderChanged()
+{
+    if ( owner.container ) owner.container->OnInstanceZOrderChanged();
+}
+
 #endif
 
 }
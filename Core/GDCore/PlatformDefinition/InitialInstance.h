@@ -8,10 +8,13 @@
 #define GDCORE_INITIALINSTANCE_H
 #include <string>
 #include <map>
+#include <memory>
 #include "GDCore/PlatformDefinition/VariablesContainer.h"
+#include "GDCore/Tools/InternedStrings.h"
 namespace gd { class PropertyDescriptor; }
 namespace gd { class Project; }
 namespace gd { class Layout; }
+namespace gd { class InitialInstancesContainer; }
 class wxPropertyGrid;
 class wxPropertyGridEvent;
 
@@ -28,7 +31,9 @@ public:
      * \brief Create an initial instance pointing to no object, at position (0,0).
      */
     InitialInstance();
+    InitialInstance(const InitialInstance & other);
     virtual ~InitialInstance() {};
+    InitialInstance & operator=(const InitialInstance & other);
 
     /**
      * Must return a pointer to a copy of the object. A such method is needed to do polymorphic copies.
@@ -46,13 +51,15 @@ public:
 
     /**
      * \brief Get the name of object instantiated on the layout.
+     *
+     * \note The names are interned: the instances of the same object return a reference to the same string.
      */
-    const std::string & GetObjectName() const { return objectName; }
+    const std::string & GetObjectName() const { return *objectName; }
 
     /**
      * \brief Set the name of object instantiated on the layout.
      */
-    void SetObjectName(const std::string & name) { objectName = name; }
+    void SetObjectName(const std::string & name) { objectName = gd::InternedStrings::Get(name); NotifyBoundsChanged(); }
 
     /**
      * \brief Get the X position of the instance
@@ -62,7 +69,7 @@ public:
     /**
      * \brief Set the X position of the instance
      */
-    void SetX(float x_) { x = x_; }
+    void SetX(float x_) { x = x_; NotifyBoundsChanged(); }
 
     /**
      * \brief Get the Y position of the instance
@@ -72,7 +79,7 @@ public:
     /**
      * \brief Set the Y position of the instance
      */
-    void SetY(float y_) { y = y_; }
+    void SetY(float y_) { y = y_; NotifyBoundsChanged(); }
 
     /**
      * \brief Get the rotation of the instance, in radians.
@@ -82,7 +89,7 @@ public:
     /**
      * \brief Set the rotation of the instance, in radians.
      */
-    void SetAngle(float angle_) {angle = angle_;}
+    void SetAngle(float angle_) {angle = angle_; NotifyBoundsChanged();}
 
     /**
      * \brief Get the Z order of the instance.
@@ -92,17 +99,17 @@ public:
     /**
      * \brief Set the Z order of the instance.
      */
-    void SetZOrder(int zOrder_) {zOrder = zOrder_;}
+    void SetZOrder(int zOrder_) {zOrder = zOrder_; NotifyZOrderChanged();}
 
     /**
      * \brief Get the layer the instance belongs to.
      */
-    const std::string & GetLayer() const {return layer;}
+    const std::string & GetLayer() const {return *layer;}
 
     /**
      * \brief Set the layer the instance belongs to.
      */
-    void SetLayer(const std::string & layer_) {layer = layer_;}
+    void SetLayer(const std::string & layer_) {layer = gd::InternedStrings::Get(layer_); NotifyZOrderChanged();}
 
     /**
      * \brief Return true if the instance has a size which is different from its object default size.
@@ -117,13 +124,13 @@ public:
      * \param hasCustomSize true if the size is different from the object's default size.
      * \see gd::Object
      */
-    void SetHasCustomSize(bool hasCustomSize_ ) { personalizedSize = hasCustomSize_; }
+    void SetHasCustomSize(bool hasCustomSize_ ) { personalizedSize = hasCustomSize_; NotifyBoundsChanged(); }
 
     float GetCustomWidth() const { return width; }
-    void SetCustomWidth(float width_) { width = width_; }
+    void SetCustomWidth(float width_) { width = width_; NotifyBoundsChanged(); }
 
     float GetCustomHeight() const { return height; }
-    void SetCustomHeight(float height_) { height = height_; }
+    void SetCustomHeight(float height_) { height = height_; NotifyBoundsChanged(); }
 
     #if defined(GD_IDE_ONLY)
     /**
@@ -150,13 +157,14 @@ public:
      * Must return a reference to the container storing the instance variables
      * \see gd::VariablesContainer
      */
-    const gd::VariablesContainer & GetVariables() const { return initialVariables; }
+    const gd::VariablesContainer & GetVariables() const { return initialVariables ? *initialVariables : noVariables; }
 
     /**
      * Must return a reference to the container storing the instance variables
+     * \note The container is only allocated when this method is first called, as most instances have no variables.
      * \see gd::VariablesContainer
      */
-    gd::VariablesContainer & GetVariables() { return initialVariables; }
+    gd::VariablesContainer & GetVariables();
     ///@}
 
     #if defined(GD_IDE_ONLY)
@@ -195,18 +203,48 @@ public:
     std::map < std::string, float > floatInfos; ///< More data which can be used by the object
     std::map < std::string, std::string > stringInfos; ///< More data which can be used by the object
 private:
+    #if defined(GD_IDE_ONLY)
+    /**
+     * \brief Tell the container owning the instance that the bounding box of the instance may have changed.
+     */
+    void NotifyBoundsChanged();
+
+    /**
+     * \brief Tell the container owning the instance that the Z order or the layer of the instance changed.
+     */
+    void NotifyZOrderChanged();
 
-    std::string objectName; ///< Object name
+    /**
+     * \brief Pointer to the container owning the instance, which is not copied with the instance.
+     */
+    struct ContainerLink
+    {
+        ContainerLink() : container(NULL) {};
+        ContainerLink(const ContainerLink &) : container(NULL) {};
+        ContainerLink & operator=(const ContainerLink &) { return *this; };
+
+        gd::InitialInstancesContainer * container;
+    };
+    ContainerLink owner; ///< The container owning the instance, if any.
+    friend class InitialInstancesContainer;
+    #else
+    void NotifyBoundsChanged() {};
+    void NotifyZOrderChanged() {};
+    #endif
+
+    const std::string * objectName; ///< Object name, interned.
     float x; ///< Object initial X position
     float y; ///< Object initial Y position
     float angle; ///< Object initial angle
     int zOrder; ///< Object initial Z order
-    std::string layer; ///< Object initial layer
+    const std::string * layer; ///< Object initial layer, interned.
     bool personalizedSize; ///< True if object has a custom size
     float width;  ///< Object custom width
     float height; ///< Object custom height
-    gd::VariablesContainer initialVariables; ///< Instance specific variables
+    std::unique_ptr<gd::VariablesContainer> initialVariables; ///< Instance specific variables, NULL until they are accessed.
     bool locked; ///< True if the instance is locked
+
+    static const gd::VariablesContainer noVariables; ///< Returned when the instance variables were never accessed.
 };
 
 }
@@ -18,22 +18,148 @@ namespace gd
 
 gd::InitialInstance InitialInstancesContainer::badPosition;
 
+namespace
+{
+    const std::size_t minChunkCapacity = 16;
+    const std::size_t maxChunkCapacity = 4096;
+}
+
+InitialInstancesContainer::InitialInstancesContainer()
+#if defined(GD_IDE_ONLY)
+    : zOrderingUpToDate(false),
+    spatialIndexUpToDate(false)
+#endif
+{
+}
+
+InitialInstancesContainer::InitialInstancesContainer(const InitialInstancesContainer & other)
+#if defined(GD_IDE_ONLY)
+    : zOrderingUpToDate(false),
+    spatialIndexUpToDate(false)
+#endif
+{
+    operator=(other);
+}
+
 InitialInstancesContainer::~InitialInstancesContainer()
 {
 }
 
+InitialInstancesContainer & InitialInstancesContainer::operator=(const InitialInstancesContainer & other)
+{
+    if ( this != &other )
+    {
+        //The copied instances are stored in a single chunk.
+        chunks.clear();
+        orderedInstances.clear();
+        freeSlots.clear();
+        Reserve(other.orderedInstances.size());
+        other.ForEachInstance([this](const gd::InitialInstance & instance) { AddInstance(instance); });
+
+        #if defined(GD_IDE_ONLY)
+        Reindex();
+        #endif
+    }
+
+    return *this;
+}
+
+template <typename Function>
+void InitialInstancesContainer::ForEachInstance(Function function)
+{
+    //The size is read before iterating, so that the instances added by function are not iterated.
+    for (std::size_t i = 0, count = orderedInstances.size();i<count;++i)
+        function(*orderedInstances[i]);
+}
+
+template <typename Function>
+void InitialInstancesContainer::ForEachInstance(Function function) const
+{
+    for (std::size_t i = 0;i<orderedInstances.size();++i)
+        function(static_cast<const gd::InitialInstance &>(*orderedInstances[i]));
+}
+
+gd::InitialInstance & InitialInstancesContainer::AddInstance(const gd::InitialInstance & instance)
+{
+    gd::InitialInstance * slot = NULL;
+    if ( !freeSlots.empty() )
+    {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+        *slot = instance;
+    }
+    else
+    {
+        if ( chunks.empty() || chunks.back()->IsFull() )
+        {
+            //Chunks grow with the container, so that small containers stay small.
+            std::size_t capacity = std::min(std::max(minChunkCapacity, orderedInstances.size()), maxChunkCapacity);
+            chunks.push_back(std::unique_ptr<InstancesChunk>(new InstancesChunk(capacity)));
+        }
+
+        InstancesChunk & chunk = *chunks.back();
+        chunk.instances.push_back(instance);
+        slot = &chunk.instances.back();
+    }
+
+    orderedInstances.push_back(slot);
+    return *slot;
+}
+
+void InitialInstancesContainer::Reserve(std::size_t count)
+{
+    orderedInstances.reserve(orderedInstances.size()+count);
+
+    //Free slots are used before the chunks.
+    if ( count <= freeSlots.size() ) return;
+    count -= freeSlots.size();
+    if ( !chunks.empty() && chunks.back()->instances.capacity()-chunks.back()->instances.size() >= count ) return;
+
+    chunks.push_back(std::unique_ptr<InstancesChunk>(new InstancesChunk(std::max(count, minChunkCapacity))));
+}
+
+template <typename Predicate>
+void InitialInstancesContainer::RemoveInstancesIf(Predicate predicate)
+{
+    std::size_t kept = 0;
+    for (std::size_t i = 0;i<orderedInstances.size();++i)
+    {
+        gd::InitialInstance * instance = orderedInstances[i];
+        if ( !predicate(*instance) )
+        {
+            orderedInstances[kept++] = instance;
+            continue;
+        }
+
+        //The slot is kept so that the other instances are not moved, but its memory is released.
+        *instance = gd::InitialInstance();
+        freeSlots.push_back(instance);
+    }
+    orderedInstances.resize(kept);
+
+    if ( orderedInstances.empty() )
+    {
+        chunks.clear();
+        freeSlots.clear();
+    }
+
+    #if defined(GD_IDE_ONLY)
+    Reindex();
+    #endif
+}
+
 unsigned int InitialInstancesContainer::GetInstancesCount() const
 {
-    return initialInstances.size();
+    return orderedInstances.size();
 }
 
 void InitialInstancesContainer::UnserializeFrom(const SerializerElement & element)
 {
     element.ConsiderAsArrayOf("instance", "Objet");
-    for (unsigned int i = 0; i < element.GetChildrenCount(); ++i)
+    Reserve(element.GetChildrenCount());
+    element.ForEachChild("", [this](const SerializerElement & instanceElement)
     {
-        const SerializerElement & instanceElement = element.GetChild(i);
-        gd::InitialInstance newPosition;
+        gd::InitialInstance & newPosition = AddInstance(gd::InitialInstance());
 
         newPosition.SetObjectName(instanceElement.GetStringAttribute("name", "", "nom"));
         newPosition.SetX(instanceElement.GetDoubleAttribute("x"));
@@ -50,32 +176,37 @@ void InitialInstancesContainer::UnserializeFrom(const SerializerElement & elemen
 
         const SerializerElement & floatPropElement = instanceElement.GetChild("numberProperties" , 0 ,"floatInfos");
         floatPropElement.ConsiderAsArrayOf("property", "Info");
-        for (unsigned int j = 0; j < floatPropElement.GetChildrenCount(); ++j)
+        floatPropElement.ForEachChild("", [&newPosition](const SerializerElement & propElement)
         {
-            std::string name = floatPropElement.GetChild(j).GetStringAttribute("name");
-            float value = floatPropElement.GetChild(j).GetDoubleAttribute("value");
+            std::string name = propElement.GetStringAttribute("name");
+            float value = propElement.GetDoubleAttribute("value");
             newPosition.floatInfos[name] = value;
-        }
+        });
 
         const SerializerElement & stringPropElement = instanceElement.GetChild("stringProperties" , 0 ,"stringInfos");
         stringPropElement.ConsiderAsArrayOf("property", "Info");
-        for (unsigned int j = 0; j < stringPropElement.GetChildrenCount(); ++j)
+        stringPropElement.ForEachChild("", [&newPosition](const SerializerElement & propElement)
         {
-            std::string name = stringPropElement.GetChild(j).GetStringAttribute("name");
-            std::string value = stringPropElement.GetChild(j).GetStringAttribute("value");
+            std::string name = propElement.GetStringAttribute("name");
+            std::string value = propElement.GetStringAttribute("value");
             newPosition.stringInfos[name] = value;
-        }
-
-        newPosition.GetVariables().UnserializeFrom(instanceElement.GetChild("initialVariables", 0, "InitialVariables"));
-
-        initialInstances.push_back( newPosition );
-    }
+        });
+
+        //Variables are only allocated for the instances having some.
+        const SerializerElement & variablesElement = instanceElement.GetChild("initialVariables", 0, "InitialVariables");
+        variablesElement.ConsiderAsArrayOf("variable", "Variable");
+        if ( variablesElement.GetChildrenCount() > 0 )
+            newPosition.GetVariables().UnserializeFrom(variablesElement);
+    });
+
+    #if defined(GD_IDE_ONLY)
+    Reindex();
+    #endif
 }
 
 void InitialInstancesContainer::IterateOverInstances(gd::InitialInstanceFunctor & func)
 {
-    for (std::list<gd::InitialInstance>::iterator it = initialInstances.begin(), end = initialInstances.end(); it != end; ++it)
-        func(&(*it));
+    ForEachInstance([&func](gd::InitialInstance & instance) { func(&instance); });
 }
 
 namespace
@@ -93,37 +224,196 @@ struct InstancesZOrderSort
 
 void InitialInstancesContainer::IterateOverInstancesWithZOrdering(gd::InitialInstanceFunctor & func, const std::string & layerName)
 {
+    #if defined(GD_IDE_ONLY)
+    UpdateZOrdering();
+
+    //Iterate on a copy, as func can change the instances and so the Z ordering.
+    std::vector<gd::InitialInstance*> sortedInstances = instancesByLayer[layerName];
+    for (unsigned int i = 0;i<sortedInstances.size();++i)
+        func(sortedInstances[i]);
+    #else
     std::vector<gd::InitialInstance*> sortedInstances;
-    sortedInstances.reserve(initialInstances.size());
-    for (std::list<gd::InitialInstance>::iterator it = initialInstances.begin(), end = initialInstances.end(); it != end; ++it)
+    sortedInstances.reserve(orderedInstances.size());
+    ForEachInstance([&sortedInstances, &layerName](gd::InitialInstance & instance)
     {
-        if (it->GetLayer() == layerName )
-            sortedInstances.push_back(&(*it));
-    }
+        if ( instance.GetLayer() == layerName )
+            sortedInstances.push_back(&instance);
+    });
 
     std::sort(sortedInstances.begin(), sortedInstances.end(), gd::InstancesZOrderSort());
     for (unsigned int i = 0;i<sortedInstances.size();++i)
         func(sortedInstances[i]);
+    #endif
 }
 
 #if defined(GD_IDE_ONLY)
-gd::InitialInstance & InitialInstancesContainer::InsertNewInitialInstance()
+namespace
+{
+
+struct InstancesPositionSort
+{
+    InstancesPositionSort(const std::unordered_map<gd::InitialInstance*, unsigned int> & positions_) : positions(positions_) {};
+
+    bool operator ()(gd::InitialInstance * a, gd::InitialInstance * b) const
+    {
+        return positions.find(a)->second < positions.find(b)->second;
+    }
+
+    const std::unordered_map<gd::InitialInstance*, unsigned int> & positions;
+};
+
+/**
+ * Same order as the one of the sorted lists of the instances of each layer,
+ * which are sorted with a stable sort.
+ */
+struct InstancesZOrderAndPositionSort
 {
-    gd::InitialInstance newInstance;
-    initialInstances.push_back(newInstance);
+    InstancesZOrderAndPositionSort(const std::unordered_map<gd::InitialInstance*, unsigned int> & positions_) : positions(positions_) {};
+
+    bool operator ()(gd::InitialInstance * a, gd::InitialInstance * b) const
+    {
+        if ( a->GetZOrder() != b->GetZOrder() ) return a->GetZOrder() < b->GetZOrder();
+        return positions.find(a)->second < positions.find(b)->second;
+    }
+
+    const std::unordered_map<gd::InitialInstance*, unsigned int> & positions;
+};
 
-    return initialInstances.back();
 }
 
-void InitialInstancesContainer::RemoveInstance(const gd::InitialInstance & instance)
+void InitialInstancesContainer::IterateOverInstancesInArea(gd::InitialInstanceFunctor & func, const sf::FloatRect & area, InitialInstanceBoundsFunctor & bounds)
+{
+    UpdateSpatialIndex(bounds);
+
+    std::vector<gd::InitialInstance*> instances;
+    spatialIndex.Query(area, instances);
+    std::sort(instances.begin(), instances.end(), InstancesPositionSort(instancesPositions));
+
+    for (unsigned int i = 0;i<instances.size();++i)
+        func(instances[i]);
+}
+
+void InitialInstancesContainer::IterateOverInstancesWithZOrdering(gd::InitialInstanceFunctor & func, const std::string & layerName, const sf::FloatRect & area, InitialInstanceBoundsFunctor & bounds)
+{
+    UpdateSpatialIndex(bounds);
+
+    std::vector<gd::InitialInstance*> instances;
+    spatialIndex.Query(area, instances);
+    instances.erase(std::remove_if(instances.begin(), instances.end(),
+        [&layerName](gd::InitialInstance * instance) { return instance->GetLayer() != layerName; }), instances.end());
+    std::sort(instances.begin(), instances.end(), InstancesZOrderAndPositionSort(instancesPositions));
+
+    for (unsigned int i = 0;i<instances.size();++i)
+        func(instances[i]);
+}
+
+void InitialInstancesContainer::InvalidateSpatialIndex()
+{
+    spatialIndexUpToDate = false;
+    movedInstances.clear();
+}
+
+void InitialInstancesContainer::OnInstanceBoundsChanged(gd::InitialInstance & instance)
 {
-    for (std::list<gd::InitialInstance>::iterator it = initialInstances.begin(), end = initialInstances.end(); it != end;)
+    if ( !spatialIndexUpToDate ) return;
+
+    //When a lot of instances are changed, rebuilding the index is faster than updating it.
+    movedInstances.insert(&instance);
+    if ( movedInstances.size() > orderedInstances.size()/4 )
+        InvalidateSpatialIndex();
+}
+
+void InitialInstancesContainer::OnInstanceInserted(gd::InitialInstance & instance)
+{
+    instance.owner.container = this;
+    zOrderingUpToDate = false;
+
+    if ( spatialIndexUpToDate )
     {
-        if ( &(*it) == &instance )
-            it = initialInstances.erase(it);
+        unsigned int position = instancesPositions.size();
+        instancesPositions[&instance] = position;
+        OnInstanceBoundsChanged(instance);
+    }
+}
+
+void InitialInstancesContainer::Reindex()
+{
+    ForEachInstance([this](gd::InitialInstance & instance) { instance.owner.container = this; });
+
+    zOrderingUpToDate = false;
+    InvalidateSpatialIndex();
+}
+
+void InitialInstancesContainer::UpdateZOrdering()
+{
+    if ( zOrderingUpToDate ) return;
+
+    instancesByLayer.clear();
+    ForEachInstance([this](gd::InitialInstance & instance) { instancesByLayer[instance.GetLayer()].push_back(&instance); });
+
+    for (std::map<std::string, std::vector<gd::InitialInstance*> >::iterator it = instancesByLayer.begin(); it != instancesByLayer.end(); ++it)
+        std::stable_sort(it->second.begin(), it->second.end(), gd::InstancesZOrderSort());
+
+    zOrderingUpToDate = true;
+}
+
+void InitialInstancesContainer::UpdateSpatialIndex(InitialInstanceBoundsFunctor & bounds)
+{
+    if ( spatialIndexUpToDate )
+    {
+        for (std::unordered_set<gd::InitialInstance*>::iterator it = movedInstances.begin(); it != movedInstances.end(); ++it)
+            spatialIndex.Insert(*it, bounds(**it));
+
+        movedInstances.clear();
+        return;
+    }
+
+    std::vector<gd::InitialInstance*> instances;
+    instances.reserve(orderedInstances.size());
+    ForEachInstance([&instances](gd::InitialInstance & instance) { instances.push_back(&instance); });
+
+    std::vector<sf::FloatRect> instancesBounds;
+    instancesBounds.reserve(instances.size());
+    float left = 0, top = 0, right = 0, bottom = 0;
+    for (unsigned int i = 0;i<instances.size();++i)
+    {
+        sf::FloatRect instanceBounds = bounds(*instances[i]);
+        if ( instancesBounds.empty() )
+        {
+            left = instanceBounds.left; top = instanceBounds.top;
+            right = instanceBounds.left+instanceBounds.width; bottom = instanceBounds.top+instanceBounds.height;
+        }
         else
-            ++it;
+        {
+            left = std::min(left, instanceBounds.left); top = std::min(top, instanceBounds.top);
+            right = std::max(right, instanceBounds.left+instanceBounds.width); bottom = std::max(bottom, instanceBounds.top+instanceBounds.height);
+        }
+        instancesBounds.push_back(instanceBounds);
     }
+
+    spatialIndex.Reset(sf::FloatRect(left, top, right-left, bottom-top));
+    instancesPositions.clear();
+    for (unsigned int i = 0;i<instances.size();++i)
+    {
+        spatialIndex.Insert(instances[i], instancesBounds[i]);
+        instancesPositions[instances[i]] = i;
+    }
+
+    movedInstances.clear();
+    spatialIndexUpToDate = true;
+}
+
+gd::InitialInstance & InitialInstancesContainer::InsertNewInitialInstance()
+{
+    gd::InitialInstance & newInstance = AddInstance(gd::InitialInstance());
+    OnInstanceInserted(newInstance);
+
+    return newInstance;
+}
+
+void InitialInstancesContainer::RemoveInstance(const gd::InitialInstance & instance)
+{
+    RemoveInstancesIf([&instance](const gd::InitialInstance & it) { return &it == &instance; });
 }
 
 gd::InitialInstance & InitialInstancesContainer::InsertInitialInstance(const gd::InitialInstance & instance)
@@ -131,9 +421,10 @@ gd::InitialInstance & InitialInstancesContainer::InsertInitialInstance(const gd:
     try
     {
         const gd::InitialInstance & castedInstance = dynamic_cast<const gd::InitialInstance&>(instance);
-        initialInstances.push_back(castedInstance);
+        gd::InitialInstance & newInstance = AddInstance(castedInstance);
+        OnInstanceInserted(newInstance);
 
-        return initialInstances.back();
+        return newInstance;
     }
     catch(...) { std::cout << "WARNING: Tried to add an gd::InitialInstance which is not a GD C++ Platform gd::InitialInstance to a GD C++ Platform project"; }
 
@@ -142,52 +433,41 @@ gd::InitialInstance & InitialInstancesContainer::InsertInitialInstance(const gd:
 
 void InitialInstancesContainer::RenameInstancesOfObject(const std::string & oldName, const std::string & newName)
 {
-    for (std::list<gd::InitialInstance>::iterator it = initialInstances.begin(), end = initialInstances.end(); it != end; ++it)
+    ForEachInstance([&oldName, &newName](gd::InitialInstance & instance)
     {
-        if ( (*it).GetObjectName() == oldName )
-            (*it).SetObjectName(newName);
-    }
+        if ( instance.GetObjectName() == oldName )
+            instance.SetObjectName(newName);
+    });
 }
 
 void InitialInstancesContainer::RemoveInitialInstancesOfObject(const std::string & objectName)
 {
-    for (std::list<gd::InitialInstance>::iterator it = initialInstances.begin(), end = initialInstances.end(); it != end;)
-    {
-        if ( (*it).GetObjectName() == objectName )
-            it = initialInstances.erase(it);
-        else
-            ++it;
-    }
+    RemoveInstancesIf([&objectName](const gd::InitialInstance & instance) { return instance.GetObjectName() == objectName; });
 }
 
 void InitialInstancesContainer::RemoveAllInstancesOnLayer(const std::string & layerName)
 {
-    for (std::list<gd::InitialInstance>::iterator it = initialInstances.begin(), end = initialInstances.end(); it != end;)
-    {
-        if ( (*it).GetLayer() == layerName )
-            it = initialInstances.erase(it);
-        else
-            ++it;
-    }
+    RemoveInstancesIf([&layerName](const gd::InitialInstance & instance) { return instance.GetLayer() == layerName; });
 }
 
 void InitialInstancesContainer::MoveInstancesToLayer(const std::string & fromLayer, const std::string & toLayer)
 {
-    for (std::list<gd::InitialInstance>::iterator it = initialInstances.begin(), end = initialInstances.end(); it != end; ++it)
+    ForEachInstance([&fromLayer, &toLayer](gd::InitialInstance & instance)
     {
-        if ( (*it).GetLayer() == fromLayer )
-            (*it).SetLayer(toLayer);
-    }
+        if ( instance.GetLayer() == fromLayer )
+            instance.SetLayer(toLayer);
+    });
 }
 
 bool InitialInstancesContainer::SomeInstancesAreOnLayer(const std::string & layerName)
 {
-    for (std::list<gd::InitialInstance>::iterator it = initialInstances.begin(), end = initialInstances.end(); it != end; ++it)
+    bool found = false;
+    ForEachInstance([&found, &layerName](const gd::InitialInstance & instance)
     {
-        if ( (*it).GetLayer() == layerName )
-            return true;
-    }
-    return false;
+        if ( !found && instance.GetLayer() == layerName )
+            found = true;
+    });
+    return found;
 }
 
 void InitialInstancesContainer::Create(const InitialInstancesContainer & source)
@@ -203,23 +483,23 @@ void InitialInstancesContainer::Create(const InitialInstancesContainer & source)
 void InitialInstancesContainer::SerializeTo(SerializerElement & element) const
 {
     element.ConsiderAsArrayOf("instance");
-    for (std::list<gd::InitialInstance>::const_iterator it = initialInstances.begin(), end = initialInstances.end(); it != end; ++it)
+    ForEachInstance([&element](const gd::InitialInstance & instance)
     {
         SerializerElement & instanceElement = element.AddChild("instance");
-        instanceElement.SetAttribute( "name", (*it).GetObjectName() );
-        instanceElement.SetAttribute( "x", (*it).GetX() );
-        instanceElement.SetAttribute( "y", (*it).GetY() );
-        instanceElement.SetAttribute( "zOrder", (*it).GetZOrder() );
-        instanceElement.SetAttribute( "layer", (*it).GetLayer() );
-        instanceElement.SetAttribute( "angle", (*it).GetAngle() );
-        instanceElement.SetAttribute( "customSize", (*it).HasCustomSize() );
-        instanceElement.SetAttribute( "width", (*it).GetCustomWidth() );
-        instanceElement.SetAttribute( "height", (*it).GetCustomHeight() );
-        instanceElement.SetAttribute( "locked", (*it).IsLocked() );
+        instanceElement.SetAttribute( "name", instance.GetObjectName() );
+        instanceElement.SetAttribute( "x", instance.GetX() );
+        instanceElement.SetAttribute( "y", instance.GetY() );
+        instanceElement.SetAttribute( "zOrder", instance.GetZOrder() );
+        instanceElement.SetAttribute( "layer", instance.GetLayer() );
+        instanceElement.SetAttribute( "angle", instance.GetAngle() );
+        instanceElement.SetAttribute( "customSize", instance.HasCustomSize() );
+        instanceElement.SetAttribute( "width", instance.GetCustomWidth() );
+        instanceElement.SetAttribute( "height", instance.GetCustomHeight() );
+        instanceElement.SetAttribute( "locked", instance.IsLocked() );
 
         SerializerElement & floatPropElement = instanceElement.AddChild("numberProperties");
         floatPropElement.ConsiderAsArrayOf("property");
-        for(std::map<std::string, float>::const_iterator floatInfo = (*it).floatInfos.begin(); floatInfo != (*it).floatInfos.end(); ++floatInfo)
+        for(std::map<std::string, float>::const_iterator floatInfo = instance.floatInfos.begin(); floatInfo != instance.floatInfos.end(); ++floatInfo)
         {
             floatPropElement.AddChild("property")
                 .SetAttribute("name", floatInfo->first)
@@ -228,15 +508,15 @@ void InitialInstancesContainer::SerializeTo(SerializerElement & element) const
 
         SerializerElement & stringPropElement = instanceElement.AddChild("stringProperties");
         stringPropElement.ConsiderAsArrayOf("property");
-        for(std::map<std::string, std::string>::const_iterator stringInfo = (*it).stringInfos.begin(); stringInfo != (*it).stringInfos.end(); ++stringInfo)
+        for(std::map<std::string, std::string>::const_iterator stringInfo = instance.stringInfos.begin(); stringInfo != instance.stringInfos.end(); ++stringInfo)
         {
             stringPropElement.AddChild("property")
                 .SetAttribute("name", stringInfo->first)
                 .SetAttribute("value", stringInfo->second);
         }
 
-        (*it).GetVariables().SerializeTo(instanceElement.AddChild("initialVariables"));
-    }
+        instance.GetVariables().SerializeTo(instanceElement.AddChild("initialVariables"));
+    });
 }
 #endif
 
@@ -244,6 +524,12 @@ InitialInstanceFunctor::~InitialInstanceFunctor()
 {
 };
 
+#if defined(GD_IDE_ONLY)
+InitialInstanceBoundsFunctor::~InitialInstanceBoundsFunctor()
+{
+};
+#endif
+
 
 void HighestZOrderFinder::operator()(gd::InitialInstance * instancePtr)
 {
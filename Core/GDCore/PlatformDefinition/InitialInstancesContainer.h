@@ -7,9 +7,18 @@
 #ifndef GDCORE_INITIALINSTANCESCONTAINER_H
 #define GDCORE_INITIALINSTANCESCONTAINER_H
 #include <string>
-#include <list>
+#include <memory>
+#include <map>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
 #include "GDCore/PlatformDefinition/InitialInstance.h"
+#if defined(GD_IDE_ONLY)
+#include <SFML/Graphics/Rect.hpp>
+#include "GDCore/PlatformDefinition/InitialInstancesQuadtree.h"
+#endif
 namespace gd { class InitialInstanceFunctor; }
+namespace gd { class InitialInstanceBoundsFunctor; }
 namespace gd { class Project; }
 namespace gd { class SerializerElement; }
 
@@ -23,18 +32,26 @@ namespace gd
  * to the elements of the container are not invalidated when
  * a change occurs ( through InsertNewInitialInstance or RemoveInstance
  * for example ). <br>
- * Thus, the implementations uses a std::list
- * for holding the instances. In this way, the container is not required
+ * Thus, the implementation stores the instances in chunks of contiguous memory
+ * which are never reallocated: removed instances leave an empty slot, which is reused by the next
+ * added instance. The order of the instances is stored separately. In this way, the container is not required
  * to provide a direct access to element based on an index. Instead,
  * the method IterateOverInstances is used to perform operations.
  *
+ * In the IDE, the container also keeps the instances of each layer sorted by Z order,
+ * and a spatial index of the instances bounding boxes so that the instances inside an area
+ * can be found without iterating over all the instances ( see IterateOverInstancesInArea ).
+ * These are updated lazily when the instances are changed.
+ *
  * \see gd::InitialInstanceFunctor
  */
 class GD_CORE_API InitialInstancesContainer
 {
 public:
-    InitialInstancesContainer() {};
+    InitialInstancesContainer();
+    InitialInstancesContainer(const InitialInstancesContainer & other);
     virtual ~InitialInstancesContainer();
+    InitialInstancesContainer & operator=(const InitialInstancesContainer & other);
 
     /**
      * \brief Return a pointer to a copy of the container.
@@ -92,6 +109,40 @@ public:
     void IterateOverInstancesWithZOrdering(InitialInstanceFunctor & func, const std::string & layer);
 
     #if defined(GD_IDE_ONLY)
+    /**
+     * \brief Apply \a func to each instance having a bounding box intersecting \a area.
+     *
+     * The instances are iterated in the same order as IterateOverInstances.
+     * \param func The functor to be applied.
+     * \param area The area where the instances must be.
+     * \param bounds The functor used to compute the bounding box of the instances. The same functor
+     * must be used for each call, or InvalidateSpatialIndex must be called when it is changed.
+     *
+     * \see InitialInstanceFunctor
+     * \see InitialInstanceBoundsFunctor
+     */
+    void IterateOverInstancesInArea(InitialInstanceFunctor & func, const sf::FloatRect & area, InitialInstanceBoundsFunctor & bounds);
+
+    /**
+     * Get the instances on the specified layer having a bounding box intersecting \a area,
+     * sort them regarding their Z order and then apply \a func on them.
+     * \param func The functor to be applied.
+     * \param layer The layer
+     * \param area The area where the instances must be.
+     * \param bounds The functor used to compute the bounding box of the instances.
+     *
+     * \see IterateOverInstancesInArea
+     */
+    void IterateOverInstancesWithZOrdering(InitialInstanceFunctor & func, const std::string & layer, const sf::FloatRect & area, InitialInstanceBoundsFunctor & bounds);
+
+    /**
+     * \brief Force the bounding boxes of all the instances to be computed again.
+     *
+     * Must be called when the bounding boxes of instances change without the instances being modified
+     * ( for example, when the object of the instances is modified ).
+     */
+    void InvalidateSpatialIndex();
+
     /**
      * \brief Insert the specified \a instance into the list and return a
      * a reference to the newly added instance.
@@ -155,11 +206,101 @@ public:
     ///@}
 
 private:
-    std::list<gd::InitialInstance> initialInstances;
+    #if defined(GD_IDE_ONLY)
+    friend class gd::InitialInstance;
+
+    /**
+     * \brief Called by an instance of the container when its bounding box may have changed.
+     */
+    void OnInstanceBoundsChanged(gd::InitialInstance & instance);
+
+    /**
+     * \brief Called by an instance of the container when its Z order or its layer changed.
+     */
+    void OnInstanceZOrderChanged() { zOrderingUpToDate = false; };
+
+    /**
+     * \brief Called when an instance was added at the end of the container.
+     */
+    void OnInstanceInserted(gd::InitialInstance & instance);
+
+    /**
+     * \brief Mark the instances as owned by the container and invalidate the Z ordering and the spatial index.
+     */
+    void Reindex();
+
+    void UpdateZOrdering();
+    void UpdateSpatialIndex(InitialInstanceBoundsFunctor & bounds);
+    #endif
+
+    /**
+     * \brief Instances stored contiguously. The vector is never grown beyond its capacity
+     * so that the instances are never moved.
+     */
+    struct InstancesChunk
+    {
+        InstancesChunk(std::size_t capacity) { instances.reserve(capacity); };
+
+        bool IsFull() const { return instances.size() == instances.capacity(); };
+
+        std::vector<gd::InitialInstance> instances;
+    };
+
+    /**
+     * \brief Add a copy of \a instance at the end of the container.
+     */
+    gd::InitialInstance & AddInstance(const gd::InitialInstance & instance);
+
+    /**
+     * \brief Ensure that \a count instances can be added without allocating more than one chunk.
+     */
+    void Reserve(std::size_t count);
+
+    /**
+     * \brief Remove the instances for which \a predicate returns true.
+     */
+    template <typename Predicate> void RemoveInstancesIf(Predicate predicate);
+
+    /**
+     * \brief Call \a function for each instance, in order.
+     */
+    template <typename Function> void ForEachInstance(Function function);
+    template <typename Function> void ForEachInstance(Function function) const;
+
+    std::vector< std::unique_ptr<InstancesChunk> > chunks;
+    std::vector<gd::InitialInstance*> orderedInstances; ///< The instances stored in chunks, in the order they were added.
+    std::vector<gd::InitialInstance*> freeSlots; ///< The slots of removed instances, reused by the next added instances.
+
+    #if defined(GD_IDE_ONLY)
+    bool zOrderingUpToDate; ///< False if instancesByLayer must be updated.
+    std::map<std::string, std::vector<gd::InitialInstance*> > instancesByLayer; ///< The instances of each layer, sorted by Z order.
+
+    bool spatialIndexUpToDate; ///< False if spatialIndex must be rebuilt from scratch.
+    gd::InitialInstancesQuadtree spatialIndex; ///< The bounding boxes of the instances.
+    std::unordered_map<gd::InitialInstance*, unsigned int> instancesPositions; ///< The position of each instance in the container.
+    std::unordered_set<gd::InitialInstance*> movedInstances; ///< Instances to be updated in spatialIndex.
+    #endif
 
     static gd::InitialInstance badPosition;
 };
 
+#if defined(GD_IDE_ONLY)
+/**
+ * \brief Tool class to be used with gd::InitialInstancesContainer::IterateOverInstancesInArea,
+ * to compute the bounding box of an instance.
+ *
+ * \see gd::InitialInstancesContainer
+ */
+class GD_CORE_API InitialInstanceBoundsFunctor
+{
+public:
+    InitialInstanceBoundsFunctor() {};
+    virtual ~InitialInstanceBoundsFunctor();
+
+    virtual sf::FloatRect operator()(InitialInstance & instance) = 0;
+};
+#endif
+
 /**
  * \brief Tool class to be used with gd::InitialInstancesContainer::IterateOverInstances.
  *
@@ -0,0 +1,131 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2015 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#include "GDCore/PlatformDefinition/InitialInstancesQuadtree.h"
+
+namespace gd
+{
+
+const unsigned int InitialInstancesQuadtree::maxDepth = 10;
+
+namespace
+{
+
+bool Contains(const sf::FloatRect & container, const sf::FloatRect & rect)
+{
+    return rect.left >= container.left && rect.left+rect.width <= container.left+container.width &&
+           rect.top >= container.top && rect.top+rect.height <= container.top+container.height;
+}
+
+/**
+ * Contrary to sf::FloatRect::intersects, rectangles sharing only an edge and rectangles
+ * with a zero size are considered as intersecting.
+ */
+bool Intersects(const sf::FloatRect & a, const sf::FloatRect & b)
+{
+    return a.left <= b.left+b.width && b.left <= a.left+a.width &&
+           a.top <= b.top+b.height && b.top <= a.top+a.height;
+}
+
+}
+
+InitialInstancesQuadtree::InitialInstancesQuadtree()
+{
+    Reset(sf::FloatRect(0, 0, 0, 0));
+}
+
+void InitialInstancesQuadtree::Reset(const sf::FloatRect & bounds)
+{
+    nodes.clear();
+    instancesNodes.clear();
+    nodes.push_back(Node(bounds, 0));
+}
+
+unsigned int InitialInstancesQuadtree::FindNodeFor(const sf::FloatRect & instanceBounds)
+{
+    unsigned int nodeIndex = 0;
+    while ( nodes[nodeIndex].depth < maxDepth )
+    {
+        const sf::FloatRect bounds = nodes[nodeIndex].bounds;
+        float halfWidth = bounds.width/2.0f;
+        float halfHeight = bounds.height/2.0f;
+
+        sf::FloatRect childrenBounds[4] = {
+            sf::FloatRect(bounds.left, bounds.top, halfWidth, halfHeight),
+            sf::FloatRect(bounds.left+halfWidth, bounds.top, halfWidth, halfHeight),
+            sf::FloatRect(bounds.left, bounds.top+halfHeight, halfWidth, halfHeight),
+            sf::FloatRect(bounds.left+halfWidth, bounds.top+halfHeight, halfWidth, halfHeight)
+        };
+
+        unsigned int child = 0;
+        while ( child < 4 && !Contains(childrenBounds[child], instanceBounds) ) ++child;
+        if ( child == 4 ) break; //The instance overlaps several children: keep it in this node.
+
+        //Children are only created when an instance can be stored in one of them.
+        if ( nodes[nodeIndex].firstChild == 0 )
+        {
+            unsigned int depth = nodes[nodeIndex].depth;
+            nodes[nodeIndex].firstChild = nodes.size();
+            for (unsigned int i = 0;i<4;++i)
+                nodes.push_back(Node(childrenBounds[i], depth+1));
+        }
+
+        nodeIndex = nodes[nodeIndex].firstChild+child;
+    }
+
+    return nodeIndex;
+}
+
+void InitialInstancesQuadtree::Insert(gd::InitialInstance * instance, const sf::FloatRect & instanceBounds)
+{
+    Remove(instance);
+
+    unsigned int nodeIndex = Contains(nodes[0].bounds, instanceBounds) ? FindNodeFor(instanceBounds) : 0;
+    nodes[nodeIndex].entries.push_back(Entry(instance, instanceBounds));
+    instancesNodes[instance] = nodeIndex;
+}
+
+void InitialInstancesQuadtree::Remove(gd::InitialInstance * instance)
+{
+    std::unordered_map<gd::InitialInstance*, unsigned int>::iterator it = instancesNodes.find(instance);
+    if ( it == instancesNodes.end() ) return;
+
+    std::vector<Entry> & entries = nodes[it->second].entries;
+    for (unsigned int i = 0;i<entries.size();++i)
+    {
+        if ( entries[i].instance == instance )
+        {
+            entries[i] = entries.back();
+            entries.pop_back();
+            break;
+        }
+    }
+
+    instancesNodes.erase(it);
+}
+
+void InitialInstancesQuadtree::Query(const sf::FloatRect & area, std::vector<gd::InitialInstance*> & result) const
+{
+    QueryNode(0, area, result);
+}
+
+void InitialInstancesQuadtree::QueryNode(unsigned int nodeIndex, const sf::FloatRect & area, std::vector<gd::InitialInstance*> & result) const
+{
+    const Node & node = nodes[nodeIndex];
+    for (unsigned int i = 0;i<node.entries.size();++i)
+    {
+        if ( Intersects(node.entries[i].bounds, area) )
+            result.push_back(node.entries[i].instance);
+    }
+
+    if ( node.firstChild == 0 ) return;
+    for (unsigned int i = 0;i<4;++i)
+    {
+        if ( Intersects(nodes[node.firstChild+i].bounds, area) )
+            QueryNode(node.firstChild+i, area, result);
+    }
+}
+
+}
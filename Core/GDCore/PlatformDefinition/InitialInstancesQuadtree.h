@@ -0,0 +1,90 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2015 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#ifndef GDCORE_INITIALINSTANCESQUADTREE_H
+#define GDCORE_INITIALINSTANCESQUADTREE_H
+#include <vector>
+#include <unordered_map>
+#include <SFML/Graphics/Rect.hpp>
+namespace gd { class InitialInstance; }
+
+namespace gd
+{
+
+/**
+ * \brief A quadtree storing the bounding boxes of initial instances, used to
+ * quickly find the instances intersecting an area.
+ *
+ * Each instance is stored in the smallest node entirely containing its bounding box.
+ * Instances which are not inside the bounds of the tree are stored in the root node.
+ *
+ * \see gd::InitialInstancesContainer
+ */
+class GD_CORE_API InitialInstancesQuadtree
+{
+public:
+    InitialInstancesQuadtree();
+    virtual ~InitialInstancesQuadtree() {};
+
+    /**
+     * \brief Remove all the instances from the tree and change the area covered by the tree.
+     */
+    void Reset(const sf::FloatRect & bounds);
+
+    /**
+     * \brief Insert \a instance in the tree, or update its bounding box if it is already in the tree.
+     */
+    void Insert(gd::InitialInstance * instance, const sf::FloatRect & instanceBounds);
+
+    /**
+     * \brief Remove \a instance from the tree.
+     */
+    void Remove(gd::InitialInstance * instance);
+
+    /**
+     * \brief Add to \a result the instances having a bounding box intersecting \a area.
+     *
+     * The edges are included so that an area of zero size can be used to find the instances at a position.
+     * The instances are added in no particular order.
+     */
+    void Query(const sf::FloatRect & area, std::vector<gd::InitialInstance*> & result) const;
+
+    /**
+     * \brief Return the number of instances in the tree.
+     */
+    unsigned int GetInstancesCount() const { return instancesNodes.size(); };
+
+private:
+    struct Entry
+    {
+        Entry(gd::InitialInstance * instance_, const sf::FloatRect & bounds_) : instance(instance_), bounds(bounds_) {};
+
+        gd::InitialInstance * instance;
+        sf::FloatRect bounds;
+    };
+
+    struct Node
+    {
+        Node(const sf::FloatRect & bounds_, unsigned int depth_) : bounds(bounds_), depth(depth_), firstChild(0) {};
+
+        sf::FloatRect bounds;
+        unsigned int depth;
+        unsigned int firstChild; ///< Index of the first of the 4 children in nodes, or 0 if the node has no children.
+        std::vector<Entry> entries;
+    };
+
+    unsigned int FindNodeFor(const sf::FloatRect & instanceBounds);
+    void QueryNode(unsigned int nodeIndex, const sf::FloatRect & area, std::vector<gd::InitialInstance*> & result) const;
+
+    std::vector<Node> nodes; ///< The nodes of the tree. The root is the first one.
+    std::unordered_map<gd::InitialInstance*, unsigned int> instancesNodes; ///< The index of the node storing each instance.
+
+    static const unsigned int maxDepth;
+};
+
+}
+
+#endif // GDCORE_INITIALINSTANCESQUADTREE_H
@@ -282,13 +282,13 @@ void Layout::UnserializeFrom(gd::Project & project, const SerializerElement & el
     initialLayers.clear();
     SerializerElement & layersElement = element.GetChild("layers", 0, "Layers");
     layersElement.ConsiderAsArrayOf("layer", "Layer");
-    for (unsigned int i = 0; i < layersElement.GetChildrenCount(); ++i)
+    layersElement.ForEachChild("", [this](const SerializerElement & layerElement)
     {
         gd::Layer layer;
 
-        layer.UnserializeFrom(layersElement.GetChild(i));
+        layer.UnserializeFrom(layerElement);
         initialLayers.push_back(layer);
-    }
+    });
 
     SerializerElement & automatismsDataElement = element.GetChild("automatismsSharedData", 0, "AutomatismsSharedDatas");
     automatismsDataElement.ConsiderAsArrayOf("automatismSharedData", "AutomatismSharedDatas");
@@ -309,7 +309,16 @@ void Layout::UnserializeFrom(gd::Project & project, const SerializerElement & el
     }
 }
 
-void Layout::Init(const Layout & other)
+void Layout::UnserializeDeferredElement(gd::Project & project)
+{
+    if ( !IsUnserializationDeferred() ) return;
+
+    std::shared_ptr<const SerializerElement> element = deferredElement;
+    deferredElement.reset();
+    UnserializeFrom(project, *element);
+}
+
+void Layout::InitProperties(const Layout & other)
 {
     SetName(other.name);
     backgroundColorR = other.backgroundColorR;
@@ -322,9 +331,26 @@ void Layout::Init(const Layout & other)
     oglZFar = other.oglZFar;
     stopSoundsOnStartup = other.stopSoundsOnStartup;
     disableInputWhenNotFocused = other.disableInputWhenNotFocused;
-    initialInstances = other.initialInstances;
     initialLayers = other.initialLayers;
     variables = other.GetVariables();
+}
+
+void Layout::InitFromImmutableLayout(const Layout & other)
+{
+    if ( this == &other ) return;
+
+    InitProperties(other);
+    initialInstances = gd::InitialInstancesContainer();
+    initialObjects = other.initialObjects;
+    automatismsInitialSharedDatas = other.automatismsInitialSharedDatas;
+    deferredElement.reset();
+}
+
+void Layout::Init(const Layout & other)
+{
+    InitProperties(other);
+    initialInstances = other.initialInstances;
+    deferredElement = other.deferredElement;
 
     initialObjects.clear();
     for (unsigned int i =0;i<other.initialObjects.size();++i)
@@ -337,8 +337,35 @@ public:
      * \brief Unserialize the layout.
      */
     void UnserializeFrom(gd::Project & project, const SerializerElement & element);
+
+    /**
+     * \brief Keep the element the layout must be unserialized from, so that it is unserialized only
+     * when UnserializeDeferredElement is called.
+     *
+     * Used by gd::Project to load the layouts on demand.
+     */
+    void DeferUnserializationFrom(std::shared_ptr<const SerializerElement> element) { deferredElement = element; };
+
+    /**
+     * \brief Return true if the layout must still be unserialized ( see DeferUnserializationFrom ).
+     */
+    bool IsUnserializationDeferred() const { return deferredElement != std::shared_ptr<const SerializerElement>(); };
+
+    /**
+     * \brief Unserialize the layout from the element given to DeferUnserializationFrom, if any, and release the element.
+     */
+    void UnserializeDeferredElement(gd::Project & project);
     ///@}
 
+    /**
+     * \brief Initialize the layout from another layout, sharing its objects instead of cloning them and without
+     * copying its initial instances.
+     *
+     * Used by the runtime, where the layouts are not modified once loaded, so that a RuntimeScene can refer to the
+     * objects of the layout it is playing.
+     */
+    void InitFromImmutableLayout(const gd::Layout & other);
+
     //TODO: Send this to private part.
     std::map < std::string, std::shared_ptr<gd::AutomatismsSharedData> > automatismsInitialSharedDatas; ///< Initial shared datas of automatisms
 
@@ -431,6 +458,7 @@ private:
     float                                       oglZFar; ///< OpenGL Far Z position
     bool                                        disableInputWhenNotFocused; /// If set to true, the input must be disabled when the window do not have the focus.
     static gd::Layer                            badLayer; ///< Null object, returned when GetLayer can not find an appropriate layer.
+    std::shared_ptr<const SerializerElement>    deferredElement; ///< If not empty, the element the layout must still be unserialized from.
     #if defined(GD_IDE_ONLY)
     EventsList                                  events; ///< Scene events
     #endif
@@ -451,6 +479,11 @@ private:
      * Don't forget to update me if members were changed !
      */
     void Init(const gd::Layout & other);
+
+    /**
+     * Copy the properties, layers and variables of another layout. Used by Init and InitFromImmutableLayout.
+     */
+    void InitProperties(const gd::Layout & other);
 };
 
 /**
@@ -60,7 +60,12 @@ Project::Project() :
     windowHeight(600),
     maxFPS(60),
     minFPS(10),
-    verticalSync(false)
+    verticalSync(false),
+    #if defined(GD_IDE_ONLY)
+    loadLayoutsOnDemand(false)
+    #else
+    loadLayoutsOnDemand(true)
+    #endif
     #if !defined(GD_NO_WX_GUI)
     ,imageManager(std::shared_ptr<gd::ImageManager>(new ImageManager))
     #endif
@@ -220,19 +225,27 @@ bool Project::HasLayoutNamed(const std::string & name) const
 }
 gd::Layout & Project::GetLayout(const std::string & name)
 {
-    return *(*find_if(scenes.begin(), scenes.end(), bind2nd(gd::LayoutHasName(), name)));
+    return GetLoadedLayout(*(*find_if(scenes.begin(), scenes.end(), bind2nd(gd::LayoutHasName(), name))));
 }
 const gd::Layout & Project::GetLayout(const std::string & name) const
 {
-    return *(*find_if(scenes.begin(), scenes.end(), bind2nd(gd::LayoutHasName(), name)));
+    return GetLoadedLayout(*(*find_if(scenes.begin(), scenes.end(), bind2nd(gd::LayoutHasName(), name))));
 }
 gd::Layout & Project::GetLayout(unsigned int index)
 {
-    return *scenes[index];
+    return GetLoadedLayout(*scenes[index]);
 }
 const gd::Layout & Project::GetLayout (unsigned int index) const
 {
-    return *scenes[index];
+    return GetLoadedLayout(*scenes[index]);
+}
+gd::Layout & Project::GetLoadedLayout(gd::Layout & layout) const
+{
+    //Unserializing a layout creates its objects using the project, but does not modify the project.
+    if ( layout.IsUnserializationDeferred() )
+        layout.UnserializeDeferredElement(const_cast<gd::Project &>(*this));
+
+    return layout;
 }
 unsigned int Project::GetLayoutPosition(const std::string & name) const
 {
@@ -644,6 +657,13 @@ void Project::UnserializeFrom(const SerializerElement & element)
         const SerializerElement & layoutElement = layoutsElement.GetChild(i);
 
         gd::Layout & layout = InsertNewLayout(layoutElement.GetStringAttribute("name", "", "nom"), -1);
+        if ( loadLayoutsOnDemand )
+        {
+            //The copy is shallow: the children elements are shared, not copied.
+            layout.DeferUnserializationFrom(std::make_shared<SerializerElement>(layoutElement));
+            continue;
+        }
+
         layout.UnserializeFrom(*this, layoutElement);
 
         //Compatibility code with GD 2.x
@@ -710,12 +730,13 @@ void Project::UnserializeFrom(const SerializerElement & element)
 #if !defined(EMSCRIPTEN)
 bool Project::LoadFromFile(const std::string & filename)
 {
-    //Load the XML document structure
-    TiXmlDocument doc;
-    if ( !doc.LoadFile(filename.c_str()) )
+    //Build the serialized project directly from the file, without loading a XML document.
+    //The root element is used whatever its name ( "project", or "Project"/"Game" for GD <= 3.3 ).
+    gd::SerializerElement rootElement;
+    std::string parsingError;
+    if ( !gd::Serializer::FromXMLFile(rootElement, filename, &parsingError) )
     {
-        std::string errorTinyXmlDesc = doc.ErrorDesc();
-        std::string error = gd::ToString(_( "Error while loading :" )) + "\n" + errorTinyXmlDesc + "\n\n" +_("Make sure the file exists and that you have the right to open the file.");
+        std::string error = gd::ToString(_( "Error while loading :" )) + "\n" + parsingError + "\n\n" +_("Make sure the file exists and that you have the right to open the file.");
 
         gd::LogError( error );
         return false;
@@ -726,16 +747,6 @@ bool Project::LoadFromFile(const std::string & filename)
     dirty = false;
     #endif
 
-    TiXmlHandle hdl( &doc );
-    gd::SerializerElement rootElement;
-
-    TiXmlElement * rootXmlElement = hdl.FirstChildElement("project").ToElement();
-    //Compatibility with GD <= 3.3
-    if (!rootXmlElement) rootXmlElement = hdl.FirstChildElement("Project").ToElement();
-    if (!rootXmlElement) rootXmlElement = hdl.FirstChildElement("Game").ToElement();
-    //End of compatibility code
-    gd::Serializer::FromXML(rootElement, rootXmlElement);
-
     //Unserialize the whole project
     UnserializeFrom(rootElement);
 
@@ -745,10 +756,11 @@ bool Project::LoadFromFile(const std::string & filename)
 #if defined(GD_IDE_ONLY)
 bool Project::LoadFromJSONFile(const std::string & filename)
 {
-    std::ifstream ifs(filename.c_str());
-    if (!ifs.is_open())
+    gd::SerializerElement rootElement;
+    std::string parsingError;
+    if ( !gd::Serializer::FromJSONFile(rootElement, filename, &parsingError) )
     {
-        std::string error = gd::ToString(_( "Unable to open the file")) +_("Make sure the file exists and that you have the right to open the file.");
+        std::string error = gd::ToString(_( "Unable to open the file")) + "\n" + parsingError + "\n\n" +_("Make sure the file exists and that you have the right to open the file.");
         gd::LogError( error );
         return false;
     }
@@ -756,8 +768,6 @@ bool Project::LoadFromJSONFile(const std::string & filename)
     SetProjectFile(filename);
     dirty = false;
 
-    std::string str((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
-    gd::SerializerElement rootElement = gd::Serializer::FromJSON(str);
     UnserializeFrom(rootElement);
 
     return true;
@@ -873,16 +883,12 @@ bool Project::SaveToJSONFile(const std::string & filename)
     SerializeTo(rootElement);
 
     //Write JSON to file
-    std::string str = gd::Serializer::ToJSON(rootElement);
-    ofstream ofs(filename.c_str());
-    if (!ofs.is_open())
+    if ( !gd::Serializer::ToJSONFile(rootElement, filename) )
     {
         gd::LogError( _( "Unable to save file ")+filename+_("!\nCheck that the drive has enough free space, is not write-protected and that you have read/write permissions." ) );
         return false;
     }
 
-    ofs << str;
-    ofs.close();
     return true;
 }
 #endif
@@ -1105,6 +1111,7 @@ void Project::Init(const gd::Project & game)
     maxFPS = game.maxFPS;
     minFPS = game.minFPS;
     verticalSync = game.verticalSync;
+    loadLayoutsOnDemand = game.loadLayoutsOnDemand;
 
     #if defined(GD_IDE_ONLY)
     author = game.author;
@@ -346,6 +346,22 @@ public:
      */
     void RemoveLayout(const std::string & name);
 
+    /**
+     * \brief Set if the layouts are unserialized only when they are accessed for the first time,
+     * instead of when the project is unserialized.
+     *
+     * The runtime plays one layout at a time: the layouts not played yet are kept in their serialized form.
+     * Enabled by default in the runtime, disabled in the IDE.
+     *
+     * \note Must be set before calling UnserializeFrom.
+     */
+    void SetLoadLayoutsOnDemand(bool enable) { loadLayoutsOnDemand = enable; }
+
+    /**
+     * \brief Return true if the layouts are unserialized only when they are accessed for the first time.
+     */
+    bool IsLoadingLayoutsOnDemand() const { return loadLayoutsOnDemand; }
+
     ///@}
 
     /** \name Saving and loading
@@ -729,12 +745,18 @@ private:
      */
     void LoadProjectInformationFromXml(const TiXmlElement * elem);
 
+    /**
+     * Unserialize the layout if it was not done yet ( see SetLoadLayoutsOnDemand ) and return it.
+     */
+    gd::Layout & GetLoadedLayout(gd::Layout & layout) const;
+
     std::string                                         name; ///< Game name
     unsigned int                                        windowWidth; ///< Window default width
     unsigned int                                        windowHeight; ///< Window default height
     int                                                 maxFPS; ///< Maximum Frame Per Seconds, -1 for unlimited
     unsigned int                                        minFPS; ///< Minimum Frame Per Seconds ( slow down game if FPS are below this number )
     bool                                                verticalSync; ///< If true, must activate vertical synchronization.
+    bool                                                loadLayoutsOnDemand; ///< If true, the layouts are unserialized when accessed for the first time.
     std::vector < std::shared_ptr<gd::Layout> >       scenes; ///< List of all scenes
     gd::VariablesContainer                              variables; ///< Initial global variables
     std::vector < std::shared_ptr<gd::ExternalLayout> >   externalLayouts; ///< List of all externals layouts
@@ -118,15 +118,14 @@ void Variable::UnserializeFrom(const SerializerElement & element)
     {
         const SerializerElement & childrenElement = element.GetChild("children", 0, "Children");
         childrenElement.ConsiderAsArrayOf("variable", "Variable");
-        for (int i = 0; i < childrenElement.GetChildrenCount(); ++i)
+        childrenElement.ForEachChild("", [this](const SerializerElement & childElement)
         {
-            const SerializerElement & childElement = childrenElement.GetChild(i);
             std::string name = childElement.GetStringAttribute("name", "", "Name");
 
             gd::Variable childVariable;
             childVariable.UnserializeFrom(childElement);
             children[name] = childVariable;
-        }
+        });
     }
     else
         SetString(element.GetStringAttribute("value", "", "Value"));
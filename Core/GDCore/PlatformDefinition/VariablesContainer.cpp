@@ -152,14 +152,12 @@ void VariablesContainer::UnserializeFrom(const SerializerElement & element)
 {
     Clear();
     element.ConsiderAsArrayOf("variable", "Variable");
-    for ( unsigned int j = 0;j < element.GetChildrenCount();j++ )
+    element.ForEachChild("", [this](const SerializerElement & variableElement)
     {
-        const SerializerElement & variableElement = element.GetChild(j);
-
         Variable variable;
         variable.UnserializeFrom(variableElement);
         Insert(variableElement.GetStringAttribute("name", "", "Name" ), variable, -1);
-    }
+    });
 }
 
 }
@@ -6,12 +6,22 @@
 
 #include "GDCore/Serialization/SerializerElement.h"
 #include "GDCore/Serialization/Serializer.h"
+#include "GDCore/Serialization/SerializerParser.h"
+#include "GDCore/Tools/MappedFile.h"
 #include "GDCore/CommonTools.h"
 #include <iostream>
 #include <string>
 #include <vector>
 #include <utility>
 #include <iomanip>
+#include <sstream>
+#include <locale>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
 #if !defined(EMSCRIPTEN)
 #include "GDCore/TinyXml/tinyxml.h"
 #endif
@@ -102,401 +112,782 @@ void Serializer::FromXML(SerializerElement & element, const TiXmlElement * xmlEl
 }
 #endif
 
+//Private functions for JSON writing
 namespace
 {
-
 	/**
-	 * Adapted from public domain library "jsoncpp" (http://sourceforge.net/projects/jsoncpp/).
+	 * Write the JSON of SerializerElements at the end of a single string, so that the JSON of
+	 * children is never copied. When a file is given, the string is used as a buffer written
+	 * to the file each time it is full.
 	 */
-	static inline bool isControlCharacter(char ch)
+	class JSONWriter
 	{
-	   return ch > 0 && ch <= 0x1F;
-	}
+	public:
+		JSONWriter(std::string & output_, bool prettyPrinting_, FILE * file_ = NULL) :
+			output(output_),
+			prettyPrinting(prettyPrinting_),
+			file(file_),
+			failed(false)
+		{
+		};
+
+		void Write(const SerializerElement & element, unsigned int depth = 0)
+		{
+			if (!element.IsValueUndefined())
+			{
+				WriteValue(element.GetValue());
+				return;
+			}
+
+			const std::vector< std::pair<std::string, std::shared_ptr<SerializerElement> > > & children = element.GetAllChildren();
+			if ( !element.ConsideredAsArrayOf().empty() )
+			{
+				//Store the element as an array in JSON:
+				if ( element.GetAllAttributes().size() > 0 )
+				{
+					std::cout << "WARNING: A SerializerElement is considered as an array of " << element.ConsideredAsArrayOf()
+						<< " but has attributes. These attributes won't be saved!" << std::endl;
+				}
+
+				output += '[';
+				bool firstChild = true;
+				for (size_t i = 0; i < children.size(); ++i)
+				{
+					if (children[i].second == std::shared_ptr<SerializerElement>())
+						continue;
+					if (children[i].first != element.ConsideredAsArrayOf())
+					{
+						std::cout << "WARNING: A SerializerElement is considered as an array of " << element.ConsideredAsArrayOf()
+							<< " but has a children called " << children[i].first << ". This children won't be saved!" << std::endl;
+						continue;
+					}
+
+					if ( !firstChild ) output += ',';
+					WriteNewLine(depth+1);
+					Write(*children[i].second, depth+1);
+
+					firstChild = false;
+				}
+
+				if ( !firstChild ) WriteNewLine(depth);
+				output += ']';
+			}
+			else
+			{
+				output += '{';
+				bool firstChild = true;
+
+				const std::map<std::string, SerializerValue> & attributes = element.GetAllAttributes();
+				for (std::map<std::string, SerializerValue>::const_iterator it = attributes.begin();
+					it != attributes.end();++it)
+				{
+					if ( !firstChild ) output += ',';
+					WriteNewLine(depth+1);
+					WriteString(it->first);
+					output += ": ";
+					WriteValue(it->second);
+
+					firstChild = false;
+				}
+
+				for (size_t i = 0; i < children.size(); ++i)
+				{
+					if (children[i].second == std::shared_ptr<SerializerElement>())
+						continue;
+
+					if ( !firstChild ) output += ',';
+					WriteNewLine(depth+1);
+					WriteString(children[i].first);
+					output += ": ";
+					Write(*children[i].second, depth+1);
+
+					firstChild = false;
+				}
+
+				if ( !firstChild ) WriteNewLine(depth);
+				output += '}';
+			}
+
+			if ( file && output.size() >= bufferSize ) Flush();
+		}
+
+		/**
+		 * Write the content of the buffer to the file, if any.
+		 * \return false if an error happened while writing to the file.
+		 */
+		bool Flush()
+		{
+			if ( file )
+			{
+				if ( !output.empty() && fwrite(output.data(), 1, output.size(), file) != output.size() )
+					failed = true;
+				output.clear();
+			}
+
+			return !failed;
+		}
+
+		static const size_t bufferSize = 65536;
+
+	private:
+		void WriteNewLine(unsigned int depth)
+		{
+			if ( !prettyPrinting ) return;
+
+			output += '\n';
+			output.append(depth*4, ' ');
+		}
+
+		void WriteValue(const SerializerValue & val)
+		{
+			if (val.IsBoolean())
+				output += val.GetBool() ? "true" : "false";
+			else if (val.IsInt())
+				WriteInt(val.GetInt());
+			else if (val.IsDouble())
+				WriteDouble(val.GetDouble());
+			else //String, or unknown type stored as a string.
+				WriteString(val.GetRawString());
+		}
+
+		void WriteInt(int value)
+		{
+			char buffer[16];
+			char * end = buffer+sizeof(buffer);
+			char * begin = end;
+			unsigned int absolute = value < 0 ? 0u-static_cast<unsigned int>(value) : value;
+			do
+			{
+				*--begin = '0'+absolute%10;
+				absolute /= 10;
+			} while ( absolute != 0 );
+			if ( value < 0 ) *--begin = '-';
+
+			output.append(begin, end);
+		}
+
+		/**
+		 * Same format as gd::ToString, whatever the locale.
+		 */
+		void WriteDouble(double value)
+		{
+			char buffer[32];
+			int length = snprintf(buffer, sizeof(buffer), "%g", value);
+			for (int i = 0;i<length;++i)
+			{
+				if ( buffer[i] == ',' ) buffer[i] = '.';
+			}
+
+			output.append(buffer, length);
+		}
+
+		static bool IsControlCharacter(char ch)
+		{
+			return ch > 0 && ch <= 0x1F;
+		}
+
+		/**
+		 * Write a string as a quoted string that can be inserted into a JSON file.
+		 * Adapted from public domain library "jsoncpp" (http://sourceforge.net/projects/jsoncpp/).
+		 */
+		void WriteString(const std::string & value)
+		{
+			output += '"';
+
+			//Write the characters not to be escaped in one go.
+			size_t begin = 0;
+			for (size_t i = 0;i<value.size();++i)
+			{
+				char c = value[i];
+				if ( c != '"' && c != '\\' && !IsControlCharacter(c) ) continue;
+
+				output.append(value, begin, i-begin);
+				begin = i+1;
+				switch(c)
+				{
+					case '"': output += "\\\""; break;
+					case '\\': output += "\\\\"; break;
+					case '\b': output += "\\b"; break;
+					case '\f': output += "\\f"; break;
+					case '\n': output += "\\n"; break;
+					case '\r': output += "\\r"; break;
+					case '\t': output += "\\t"; break;
+					default:
+					{
+						char escaped[8];
+						snprintf(escaped, sizeof(escaped), "\\u%04X", static_cast<int>(c));
+						output += escaped;
+						break;
+					}
+				}
+			}
+			output.append(value, begin, std::string::npos);
+
+			output += '"';
+		}
+
+		std::string & output;
+		bool prettyPrinting;
+		FILE * file;
+		bool failed;
+	};
+}
+
+std::string Serializer::ToJSON(const SerializerElement & element, bool prettyPrinting)
+{
+	std::string output;
+	ToJSON(element, output, prettyPrinting);
+	return output;
+}
+
+void Serializer::ToJSON(const SerializerElement & element, std::string & output, bool prettyPrinting)
+{
+	JSONWriter writer(output, prettyPrinting);
+	writer.Write(element);
+}
+
+bool Serializer::ToJSONFile(const SerializerElement & element, const std::string & filename, bool prettyPrinting)
+{
+	FILE * file = fopen(filename.c_str(), "wb");
+	if ( !file ) return false;
+
+	std::string buffer;
+	buffer.reserve(JSONWriter::bufferSize*2);
+	JSONWriter writer(buffer, prettyPrinting, file);
+	writer.Write(element);
+	bool success = writer.Flush();
 
+	return fclose(file) == 0 && success;
+}
+
+//Private functions for parsing
+namespace
+{
 	/**
-	 * Adapted from public domain library "jsoncpp" (http://sourceforge.net/projects/jsoncpp/).
+	 * Convert a JSON number to a double, independently of the locale.
+	 *
+	 * Numbers with at most 15 significant digits and a small exponent, the most common ones, are
+	 * computed with a single operation between exact values, which is correctly rounded.
+	 * Other numbers are converted by the standard library using the "C" locale.
 	 */
-	static bool containsControlCharacter( const char* str )
+	double ParseNumber(const char * number, size_t length)
 	{
-	   while ( *str )
-	   {
-	      if ( isControlCharacter( *(str++) ) )
-	         return true;
-	   }
-	   return false;
+		static const double exactPowersOfTen[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10,
+			1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+		const int maxExactExponent = 22;
+		const int maxExactDigits = 15;
+
+		const char * c = number;
+		const char * end = number+length;
+		bool negative = c != end && *c == '-';
+		if ( c != end && ( *c == '-' || *c == '+' ) ) ++c;
+
+		//Leading zeros are not significant.
+		int digits = 0;
+		bool exact = true;
+		unsigned long long mantissa = 0;
+		int exponent = 0;
+		for (;c != end && *c >= '0' && *c <= '9';++c)
+		{
+			if ( mantissa == 0 && *c == '0' ) continue;
+			if ( ++digits > maxExactDigits ) { exact = false; break; }
+			mantissa = mantissa*10+(*c-'0');
+		}
+		if ( exact && c != end && *c == '.' )
+		{
+			for (++c;c != end && *c >= '0' && *c <= '9';++c)
+			{
+				if ( mantissa != 0 || *c != '0' ) ++digits;
+				if ( digits > maxExactDigits ) { exact = false; break; }
+				mantissa = mantissa*10+(*c-'0');
+				exponent--;
+			}
+		}
+		if ( exact && c != end && ( *c == 'e' || *c == 'E' ) )
+		{
+			++c;
+			bool negativeExponent = c != end && *c == '-';
+			if ( c != end && ( *c == '-' || *c == '+' ) ) ++c;
+
+			int value = 0;
+			for (;c != end && *c >= '0' && *c <= '9' && value <= 1000;++c)
+				value = value*10+(*c-'0');
+			exponent += negativeExponent ? -value : value;
+		}
+
+		if ( exact && c == end && exponent >= -maxExactExponent && exponent <= maxExactExponent )
+		{
+			double result = static_cast<double>(mantissa);
+			result = exponent < 0 ? result/exactPowersOfTen[-exponent] : result*exactPowersOfTen[exponent];
+			return negative ? -result : result;
+		}
+
+		std::istringstream stream(std::string(number, length));
+		stream.imbue(std::locale::classic());
+		double result = 0;
+		stream >> result;
+
+		//On overflow, streams return the largest double: return an infinity, like strtod.
+		if ( stream.fail() && std::fabs(result) == std::numeric_limits<double>::max() )
+			return result > 0 ? HUGE_VAL : -HUGE_VAL;
+
+		return result;
 	}
 
 	/**
-	 * Tool function converting a string to a quoted string that can be inserted into
-	 * a JSON file.
-	 * Adapted from public domain library "jsoncpp" (http://sourceforge.net/projects/jsoncpp/).
+	 * Build the SerializerElement tree from what is reported by a SerializerParser.
 	 */
-	std::string StringToQuotedJSONString( const char *value )
+	class SerializerElementBuilder : public SerializerParser::Handler
 	{
-	   if (value == NULL)
-	      return "";
-	   // Not sure how to handle unicode...
-	   if (strpbrk(value, "\"\\\b\f\n\r\t") == NULL && !containsControlCharacter( value ))
-	      return std::string("\"") + value + "\"";
-	   // We have to walk value and escape any special characters.
-	   // Appending to std::string is not efficient, but this should be rare.
-	   // (Note: forward slashes are *not* rare, but I am not escaping them.)
-	   std::string::size_type maxsize = strlen(value)*2 + 3; // allescaped+quotes+NULL
-	   std::string result;
-	   result.reserve(maxsize); // to avoid lots of mallocs
-	   result += "\"";
-	   for (const char* c=value; *c != 0; ++c)
-	   {
-	      switch(*c)
-	      {
-	         case '\"':
-	            result += "\\\"";
-	            break;
-	         case '\\':
-	            result += "\\\\";
-	            break;
-	         case '\b':
-	            result += "\\b";
-	            break;
-	         case '\f':
-	            result += "\\f";
-	            break;
-	         case '\n':
-	            result += "\\n";
-	            break;
-	         case '\r':
-	            result += "\\r";
-	            break;
-	         case '\t':
-	            result += "\\t";
-	            break;
-	         //case '/':
-	            // Even though \/ is considered a legal escape in JSON, a bare
-	            // slash is also legal, so I see no reason to escape it.
-	            // (I hope I am not misunderstanding something.
-	            // blep notes: actually escaping \/ may be useful in javascript to avoid </
-	            // sequence.
-	            // Should add a flag to allow this compatibility mode and prevent this
-	            // sequence from occurring.
-	         default:
-	            if ( isControlCharacter( *c ) )
-	            {
-	               std::ostringstream oss;
-	               oss << "\\u" << std::hex << std::uppercase << std::setfill('0') << std::setw(4) << static_cast<int>(*c);
-	               result += oss.str();
-	            }
-	            else
-	            {
-	               result += *c;
-	            }
-	            break;
-	      }
-	   }
-	   result += "\"";
-	   return result;
+	public:
+		SerializerElementBuilder(SerializerElement & root_) : root(root_) {};
+		virtual ~SerializerElementBuilder() {};
+
+		virtual void BeginElement(const char * name, size_t nameLength)
+		{
+			if ( elements.empty() )
+				elements.push_back(&root);
+			else
+				elements.push_back(&elements.back()->AddChild(std::string(name, nameLength)));
+		}
+
+		virtual void Attribute(const char * name, size_t nameLength, const char * value, size_t valueLength)
+		{
+			elements.back()->SetAttribute(std::string(name, nameLength), std::string(value, valueLength));
+		}
+
+		virtual void Value(const char * value, size_t valueLength, SerializerParser::ValueType type)
+		{
+			if ( type == SerializerParser::Text )
+			{
+				SerializerValue text;
+				text.Set(std::string(value, valueLength));
+				elements.back()->SetValue(text);
+			}
+			else if ( type == SerializerParser::String )
+				elements.back()->SetValue(std::string(value, valueLength));
+			else if ( type == SerializerParser::Boolean )
+				elements.back()->SetValue(valueLength == 4); //"true"
+			else if ( type == SerializerParser::Number )
+				elements.back()->SetValue(ParseNumber(value, valueLength));
+			//null: the value stays undefined.
+		}
+
+		virtual void EndElement()
+		{
+			elements.pop_back();
+		}
+
+	private:
+		SerializerElement & root;
+		std::vector<SerializerElement *> elements; ///< The elements being built, from the root to the current one.
+	};
+}
+
+bool Serializer::FromXML(SerializerElement & element, const char * xml, size_t size, std::string * error)
+{
+	SerializerElementBuilder builder(element);
+	SerializerParser parser;
+	if ( parser.ParseXML(xml, size, builder) ) return true;
+
+	if ( error ) *error = parser.GetError();
+	return false;
+}
+
+bool Serializer::FromJSON(SerializerElement & element, const char * json, size_t size, std::string * error)
+{
+	SerializerElementBuilder builder(element);
+	SerializerParser parser;
+	if ( parser.ParseJSON(json, size, builder) ) return true;
+
+	if ( error ) *error = parser.GetError();
+	return false;
+}
+
+bool Serializer::FromXMLFile(SerializerElement & element, const std::string & filename, std::string * error)
+{
+	MappedFile file;
+	if ( !file.Open(filename) )
+	{
+		if ( error ) *error = "Unable to open "+filename;
+		return false;
 	}
 
-	std::string ValueToJSON(const SerializerValue & val)
+	return FromXML(element, file.GetData(), file.GetSize(), error);
+}
+
+bool Serializer::FromJSONFile(SerializerElement & element, const std::string & filename, std::string * error)
+{
+	MappedFile file;
+	if ( !file.Open(filename) )
 	{
-		if (val.IsBoolean())
-			return val.GetBool() ? "true" : "false";
-		else if (val.IsInt())
-			return gd::ToString(val.GetInt());
-		else if (val.IsDouble())
-			return gd::ToString(val.GetDouble());
-		else
-			return StringToQuotedJSONString(val.GetString().c_str());
+		if ( error ) *error = "Unable to open "+filename;
+		return false;
 	}
+
+	return FromJSON(element, file.GetData(), file.GetSize(), error);
 }
 
-std::string Serializer::ToJSON(const SerializerElement & element)
+//Private functions for binary snapshots
+namespace
 {
-	if (element.IsValueUndefined())
+	/*
+	 * Layout of a binary snapshot ( all integers are little endian ):
+	 *
+	 * - "GDBS", followed by the version of the format ( uint32 ).
+	 * - The strings table: the number of strings ( uint32 ), then each string as its length ( uint32 )
+	 *   followed by its characters. Names and string values are written only once in the table,
+	 *   and referred to by their index.
+	 * - The root element. An element starts with the size of the rest of the element ( uint32 ), so that
+	 *   it can be skipped without being read. Then come its value, the name its children are an array of
+	 *   ( a string index ), its attributes ( count then name index and value for each ) and its children
+	 *   ( count then name index and element for each ).
+	 *
+	 * A value is a type ( uint8, see BinaryValueType ) followed by a string index ( unknown and string types ),
+	 * one byte ( boolean ), an int32 ( integer ) or the 8 bytes of a double.
+	 */
+	const char binaryMagic[4] = {'G', 'D', 'B', 'S'};
+	const std::uint32_t binaryVersion = 1;
+
+	enum BinaryValueType
+	{
+		BinaryUndefined = 0,
+		BinaryUnknown,
+		BinaryBoolean,
+		BinaryString,
+		BinaryInt,
+		BinaryDouble
+	};
+
+	/**
+	 * Write SerializerElements in a binary snapshot.
+	 */
+	class BinaryWriter
 	{
-		if ( !element.ConsideredAsArrayOf().empty() )
+	public:
+		BinaryWriter() {};
+
+		void Write(const SerializerElement & element, std::string & output)
 		{
-			//Store the element as an array in JSON:
-		    std::string str = "[";
-		    bool firstChild = true;
+			tree.clear();
+			WriteElement(element);
 
-		    if ( element.GetAllAttributes().size() > 0 )
-		    {
-				std::cout << "WARNING: A SerializerElement is considered as an array of " << element.ConsideredAsArrayOf()
-					<< " but has attributes. These attributes won't be saved!" << std::endl;
-		    }
+			output.append(binaryMagic, sizeof(binaryMagic));
+			WriteUInt32(output, binaryVersion);
+			WriteUInt32(output, strings.size());
+			for (size_t i = 0;i<strings.size();++i)
+			{
+				WriteUInt32(output, strings[i]->size());
+				output += *strings[i];
+			}
+			output += tree;
+		}
 
-			const std::vector< std::pair<std::string, std::shared_ptr<SerializerElement> > > & children = element.GetAllChildren();
-			for (size_t i = 0; i < children.size(); ++i)
+	private:
+		static void WriteUInt32(std::string & output, std::uint32_t value)
+		{
+			char bytes[4] = {static_cast<char>(value & 0xFF), static_cast<char>((value >> 8) & 0xFF),
+				static_cast<char>((value >> 16) & 0xFF), static_cast<char>((value >> 24) & 0xFF)};
+			output.append(bytes, 4);
+		}
+
+		void WriteStringIndex(const std::string & str)
+		{
+			std::unordered_map<std::string, std::uint32_t>::iterator it = stringsIndices.find(str);
+			if ( it == stringsIndices.end() )
 			{
-				if (children[i].second == std::shared_ptr<SerializerElement>())
-					continue;
-				if (children[i].first != element.ConsideredAsArrayOf())
-				{
-					std::cout << "WARNING: A SerializerElement is considered as an array of " << element.ConsideredAsArrayOf()
-						<< " but has a children called " << children[i].first << ". This children won't be saved!" << std::endl;
-					continue;
-				}
+				it = stringsIndices.insert(std::make_pair(str, static_cast<std::uint32_t>(strings.size()))).first;
+				strings.push_back(&it->first);
+			}
 
-		        if ( !firstChild ) str += ",";
-		        str += ToJSON(*children[i].second);
+			WriteUInt32(tree, it->second);
+		}
 
-		        firstChild = false;
+		void WriteValue(const SerializerValue & value)
+		{
+			if ( value.IsBoolean() )
+			{
+				tree += static_cast<char>(BinaryBoolean);
+				tree += static_cast<char>(value.GetBool() ? 1 : 0);
 			}
+			else if ( value.IsString() )
+			{
+				tree += static_cast<char>(BinaryString);
+				WriteStringIndex(value.GetRawString());
+			}
+			else if ( value.IsInt() )
+			{
+				tree += static_cast<char>(BinaryInt);
+				WriteUInt32(tree, static_cast<std::uint32_t>(value.GetInt()));
+			}
+			else if ( value.IsDouble() )
+			{
+				double doubleValue = value.GetDouble();
+				std::uint64_t bits;
+				memcpy(&bits, &doubleValue, sizeof(bits));
 
-		    str += "]";
-		    return str;
+				tree += static_cast<char>(BinaryDouble);
+				WriteUInt32(tree, static_cast<std::uint32_t>(bits & 0xFFFFFFFF));
+				WriteUInt32(tree, static_cast<std::uint32_t>(bits >> 32));
+			}
+			else
+			{
+				tree += static_cast<char>(BinaryUnknown);
+				WriteStringIndex(value.GetRawString());
+			}
 		}
-		else
+
+		void WriteElement(const SerializerElement & element)
 		{
-		    std::string str = "{";
-		    bool firstChild = true;
+			size_t sizePosition = tree.size();
+			WriteUInt32(tree, 0); //Patched when the element is written.
 
-			const std::map<std::string, SerializerValue> & attributes = element.GetAllAttributes();
-			for (std::map<std::string, SerializerValue>::const_iterator it = attributes.begin();
-				it != attributes.end();++it)
-		    {
-		        if ( !firstChild ) str += ",";
-		        str += StringToQuotedJSONString(it->first.c_str())+": "+ValueToJSON(it->second);
+			if ( element.IsValueUndefined() )
+				tree += static_cast<char>(BinaryUndefined);
+			else
+				WriteValue(element.GetValue());
 
-		        firstChild = false;
-		    }
+			WriteStringIndex(element.ConsideredAsArrayOf());
+
+			const std::map<std::string, SerializerValue> & attributes = element.GetAllAttributes();
+			WriteUInt32(tree, attributes.size());
+			for (std::map<std::string, SerializerValue>::const_iterator it = attributes.begin(); it != attributes.end();++it)
+			{
+				WriteStringIndex(it->first);
+				WriteValue(it->second);
+			}
 
 			const std::vector< std::pair<std::string, std::shared_ptr<SerializerElement> > > & children = element.GetAllChildren();
+			std::uint32_t childrenCount = 0;
+			for (size_t i = 0; i < children.size(); ++i)
+				if (children[i].second != std::shared_ptr<SerializerElement>()) childrenCount++;
+
+			WriteUInt32(tree, childrenCount);
 			for (size_t i = 0; i < children.size(); ++i)
 			{
 				if (children[i].second == std::shared_ptr<SerializerElement>())
 					continue;
 
-		        if ( !firstChild ) str += ",";
-		        str += StringToQuotedJSONString(children[i].first.c_str())+": "+ToJSON(*children[i].second);
-
-		        firstChild = false;
+				WriteStringIndex(children[i].first);
+				WriteElement(*children[i].second);
 			}
 
-		    str += "}";
-		    return str;
+			std::string elementSize;
+			WriteUInt32(elementSize, tree.size()-sizePosition-4);
+			tree.replace(sizePosition, 4, elementSize);
 		}
-	}
-	else
+
+		std::string tree; ///< The elements, written before the strings table is known.
+		std::unordered_map<std::string, std::uint32_t> stringsIndices;
+		std::vector<const std::string *> strings; ///< The strings of the table, in order ( pointing to the keys of stringsIndices ).
+	};
+
+	/**
+	 * Build SerializerElements from a binary snapshot, reading the snapshot in place.
+	 */
+	class BinaryReader
 	{
-		return ValueToJSON(element.GetValue());
-	}
+	public:
+		BinaryReader(const char * data, size_t size) :
+			current(data),
+			end(data+size),
+			begin(data)
+		{
+		};
+
+		bool Read(SerializerElement & element)
+		{
+			if ( !Serializer::IsBinary(current, end-current) )
+				return SetError("Not a binary snapshot");
+			current += sizeof(binaryMagic);
+
+			std::uint32_t version = 0, stringsCount = 0;
+			if ( !ReadUInt32(version) ) return false;
+			if ( version != binaryVersion )
+				return SetError("Unsupported version of binary snapshot: "+gd::ToString(version));
+
+			if ( !ReadUInt32(stringsCount) ) return false;
+			if ( stringsCount > static_cast<size_t>(end-current)/4 )
+				return SetError("Invalid strings table");
+			strings.reserve(stringsCount);
+			for (std::uint32_t i = 0;i<stringsCount;++i)
+			{
+				std::uint32_t length = 0;
+				if ( !ReadUInt32(length) ) return false;
+				if ( length > static_cast<size_t>(end-current) ) return SetError("Invalid string");
+
+				strings.push_back(std::string(current, length));
+				current += length;
+			}
+
+			return ReadElement(element);
+		}
+
+		const std::string & GetError() const { return error; }
+
+	private:
+		bool ReadUInt32(std::uint32_t & value)
+		{
+			if ( end-current < 4 ) return SetError("Unexpected end of data");
+
+			const unsigned char * bytes = reinterpret_cast<const unsigned char *>(current);
+			value = static_cast<std::uint32_t>(bytes[0]) | (static_cast<std::uint32_t>(bytes[1]) << 8)
+				| (static_cast<std::uint32_t>(bytes[2]) << 16) | (static_cast<std::uint32_t>(bytes[3]) << 24);
+			current += 4;
+			return true;
+		}
+
+		bool ReadString(const std::string * & str)
+		{
+			std::uint32_t index = 0;
+			if ( !ReadUInt32(index) ) return false;
+			if ( index >= strings.size() ) return SetError("Invalid string index");
+
+			str = &strings[index];
+			return true;
+		}
+
+		bool ReadValue(SerializerValue & value, bool & defined)
+		{
+			if ( current == end ) return SetError("Unexpected end of data");
+			unsigned char type = static_cast<unsigned char>(*current++);
+
+			defined = true;
+			const std::string * str = NULL;
+			std::uint32_t low = 0, high = 0;
+			switch(type)
+			{
+				case BinaryUndefined:
+					defined = false;
+					return true;
+				case BinaryUnknown:
+					if ( !ReadString(str) ) return false;
+					value.Set(*str);
+					return true;
+				case BinaryBoolean:
+					if ( current == end ) return SetError("Unexpected end of data");
+					value.SetBool(*current++ != 0);
+					return true;
+				case BinaryString:
+					if ( !ReadString(str) ) return false;
+					value.SetString(*str);
+					return true;
+				case BinaryInt:
+					if ( !ReadUInt32(low) ) return false;
+					value.SetInt(static_cast<std::int32_t>(low));
+					return true;
+				case BinaryDouble:
+				{
+					if ( !ReadUInt32(low) || !ReadUInt32(high) ) return false;
+					std::uint64_t bits = static_cast<std::uint64_t>(low) | (static_cast<std::uint64_t>(high) << 32);
+					double doubleValue;
+					memcpy(&doubleValue, &bits, sizeof(doubleValue));
+					value.SetDouble(doubleValue);
+					return true;
+				}
+				default:
+					return SetError("Invalid value type");
+			}
+		}
+
+		bool ReadElement(SerializerElement & element)
+		{
+			std::uint32_t size = 0;
+			if ( !ReadUInt32(size) ) return false;
+			if ( size > static_cast<size_t>(end-current) ) return SetError("Invalid element size");
+			const char * elementEnd = current+size;
+
+			SerializerValue value;
+			bool defined;
+			if ( !ReadValue(value, defined) ) return false;
+			if ( defined ) element.SetValue(value);
+
+			const std::string * arrayOf = NULL;
+			if ( !ReadString(arrayOf) ) return false;
+
+			std::uint32_t attributesCount = 0;
+			if ( !ReadUInt32(attributesCount) ) return false;
+			for (std::uint32_t i = 0;i<attributesCount;++i)
+			{
+				const std::string * name = NULL;
+				if ( !ReadString(name) || !ReadValue(value, defined) ) return false;
+
+				//Attributes are always defined, and their unknown type is a string.
+				if ( value.IsBoolean() ) element.SetAttribute(*name, value.GetBool());
+				else if ( value.IsInt() ) element.SetAttribute(*name, value.GetInt());
+				else if ( value.IsDouble() ) element.SetAttribute(*name, value.GetDouble());
+				else element.SetAttribute(*name, value.GetRawString());
+			}
+
+			std::uint32_t childrenCount = 0;
+			if ( !ReadUInt32(childrenCount) ) return false;
+			for (std::uint32_t i = 0;i<childrenCount;++i)
+			{
+				const std::string * name = NULL;
+				if ( !ReadString(name) ) return false;
+				if ( !ReadElement(element.AddChild(*name)) ) return false;
+			}
+
+			if ( current != elementEnd ) return SetError("Invalid element size");
+
+			//Done after adding the children, which are not renamed even if they were not named after the array elements.
+			if ( !arrayOf->empty() ) element.ConsiderAsArrayOf(*arrayOf);
+			return true;
+		}
+
+		bool SetError(const std::string & description)
+		{
+			error = description+" at offset "+gd::ToString(current-begin);
+			return false;
+		}
+
+		const char * current; ///< The current position in the snapshot.
+		const char * end; ///< The end of the snapshot.
+		const char * begin; ///< The beginning of the snapshot, used to report the position of errors.
+		std::vector<std::string> strings; ///< The strings table.
+		std::string error;
+	};
 }
 
+void Serializer::ToBinary(const SerializerElement & element, std::string & output)
+{
+	BinaryWriter writer;
+	writer.Write(element, output);
+}
 
+bool Serializer::IsBinary(const char * data, size_t size)
+{
+	return size >= sizeof(binaryMagic) && memcmp(data, binaryMagic, sizeof(binaryMagic)) == 0;
+}
 
-//Private functions for JSON parsing
-namespace
+bool Serializer::FromBinary(SerializerElement & element, const char * data, size_t size, std::string * error)
 {
-    size_t SkipBlankChar(const std::string & str, size_t pos)
-    {
-        const std::string blankChar = " \n";
-        return str.find_first_not_of(blankChar, pos);
-    }
+	BinaryReader reader(data, size);
+	if ( reader.Read(element) ) return true;
 
+	if ( error ) *error = reader.GetError();
+	return false;
+}
 
-	/**
-	 * Adapted from https://github.com/hjiang/jsonxx
-	 */
-	std::string DecodeString(const std::string & original)
+bool Serializer::FromBinaryFile(SerializerElement & element, const std::string & filename, std::string * error)
+{
+	MappedFile file;
+	if ( !file.Open(filename) )
 	{
-		std::string value;
-		value.reserve(original.size());
-		std::istringstream input("\""+original+"\"");
-
-	    char ch = '\0', delimiter = '"';
-	    input.get(ch);
-	    if (ch != delimiter) return "";
-
-	    while(!input.eof() && input.good()) {
-	        input.get(ch);
-	        if (ch == delimiter) {
-	            break;
-	        }
-	        if (ch == '\\') {
-	            input.get(ch);
-	            switch(ch) {
-	                case '\\':
-	                case '/':
-	                    value.push_back(ch);
-	                    break;
-	                case 'b':
-	                    value.push_back('\b');
-	                    break;
-	                case 'f':
-	                    value.push_back('\f');
-	                    break;
-	                case 'n':
-	                    value.push_back('\n');
-	                    break;
-	                case 'r':
-	                    value.push_back('\r');
-	                    break;
-	                case 't':
-	                    value.push_back('\t');
-	                    break;
-	                case 'u': {
-	                        int i;
-	                        std::stringstream ss;
-	                        for( i = 0; (!input.eof() && input.good()) && i < 4; ++i ) {
-	                            input.get(ch);
-	                            ss << ch;
-	                        }
-	                        if( input.good() && (ss >> i) )
-	                            value.push_back(i);
-	                    }
-	                    break;
-	                default:
-	                    if (ch != delimiter) {
-	                        value.push_back('\\');
-	                        value.push_back(ch);
-	                    } else value.push_back(ch);
-	                    break;
-	            }
-	        } else {
-	            value.push_back(ch);
-	        }
-	    }
-	    if (input && ch == delimiter) {
-	        return value;
-	    } else {
-	        return "";
-	    }
+		if ( error ) *error = "Unable to open "+filename;
+		return false;
 	}
 
-    /**
-     * Return the position of the end of the string. Blank are skipped if necessary
-     * @param str The string to be used
-     * @param startPos The start position
-     * @param strContent A reference to a string that will be filled with the string content.
-     */
-    size_t SkipString(const std::string & str, size_t startPos, std::string & strContent)
-    {
-        startPos = SkipBlankChar(str, startPos);
-        if ( startPos >= str.length() ) return std::string::npos;
-
-        size_t endPos = startPos;
-
-        if ( str[startPos] == '"' )
-        {
-            if ( startPos+1 >= str.length() ) return std::string::npos;
-
-            while (endPos == startPos || (str[endPos-1] == '\\'))
-            {
-                endPos = str.find_first_of('\"', endPos+1);
-                if ( endPos == std::string::npos ) return std::string::npos; //Invalid string
-            }
-
-            strContent = DecodeString(str.substr(startPos+1, endPos-1-startPos));
-            return endPos;
-        }
-
-        endPos = str.find_first_of(" \n,:");
-        if ( endPos >= str.length() ) return std::string::npos; //Invalid string
-
-        strContent = DecodeString(str.substr(startPos, endPos-1-startPos));
-        return endPos-1;
-    }
-
-    /**
-     * Parse a JSON string, starting from pos, and storing the result into the specified element.
-     * Note that the parsing is stopped as soon as a valid object is parsed.
-     * \return The position at the end of the valid object stored into the element.
-     */
-    size_t ParseJSONObject(const std::string & jsonStr, size_t startPos, gd::SerializerElement & element)
-    {
-        size_t pos = SkipBlankChar(jsonStr, startPos);
-        if ( pos >= jsonStr.length() ) return std::string::npos;
-
-        if ( jsonStr[pos] == '{' ) //Object
-        {
-            bool firstChild = true;
-            while ( firstChild || jsonStr[pos] == ',' )
-            {
-                pos++;
-                if (pos < jsonStr.length() && jsonStr[pos] == '}' ) break;
-
-                std::string childName;
-                pos = SkipString(jsonStr, pos, childName);
-
-                pos++;
-                pos = SkipBlankChar(jsonStr, pos);
-                if ( pos >= jsonStr.length() || jsonStr[pos] != ':' ) return std::string::npos;
-
-                pos++;
-                pos = ParseJSONObject(jsonStr, pos, element.AddChild(childName));
-
-                pos = SkipBlankChar(jsonStr, pos);
-                if ( pos >= jsonStr.length()) return std::string::npos;
-                firstChild = false;
-            }
-
-            if ( jsonStr[pos] != '}' ) {
-                std::cout << "Parsing error: Object not properly formed.";
-                return std::string::npos;
-            }
-            return pos+1;
-        }
-        else if ( jsonStr[pos] == '[' ) //Array
-        {
-            unsigned int index = 0;
-            while ( index == 0 || jsonStr[pos] == ',' )
-            {
-                pos++;
-                if (pos < jsonStr.length() && jsonStr[pos] == ']' ) break;
-                pos = ParseJSONObject(jsonStr, pos, element.AddChild(""));
-
-                pos = SkipBlankChar(jsonStr, pos);
-                if ( pos >= jsonStr.length()) {
-                    std::cout << "Parsing error: element of array not properly formed.";
-                    return std::string::npos;
-                }
-                index++;
-            }
-
-            if ( jsonStr[pos] != ']' ) {
-                std::cout << "Parsing error: array not properly ended";
-                return std::string::npos;
-            }
-            return pos+1;
-        }
-        else if ( jsonStr[pos] == '"' ) //String
-        {
-            std::string str;
-            pos = SkipString(jsonStr, pos, str);
-            if ( pos >= jsonStr.length() ) {
-                std::cout << "Parsing error: Invalid string";
-                return std::string::npos;
-            }
-
-            element.SetValue(str);
-            return pos+1;
-        }
-        else //Number or boolean
-        {
-            std::string str;
-            size_t endPos = pos;
-            const std::string separators = " \n,}";
-            while (endPos < jsonStr.length() && separators.find_first_of(jsonStr[endPos]) == std::string::npos ) {
-                endPos++;
-            }
-
-            str = jsonStr.substr(pos, endPos-pos);
-            if ( str == "true" )
-            	element.SetValue(true);
-            else if ( str == "false" )
-            	element.SetValue(false);
-            else
-            	element.SetValue(ToDouble(str));
-            return endPos;
-        }
-    }
+	return FromBinary(element, file.GetData(), file.GetSize(), error);
 }
 
 SerializerElement Serializer::FromJSON(const std::string & jsonStr)
 {
 	SerializerElement element;
-   	if ( !jsonStr.empty() ) gd::ParseJSONObject(jsonStr, 0, element);
+	std::string error;
+	if ( !jsonStr.empty() && !FromJSON(element, jsonStr.c_str(), jsonStr.size(), &error) )
+		std::cout << "Parsing error: " << error << std::endl;
+
 	return element;
 }
 
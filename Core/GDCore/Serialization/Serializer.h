@@ -17,6 +17,15 @@ namespace gd
  * \brief The class used to save/load projects and GDCore classes
  * from/to XML or JSON.
  *
+ * Usage example, loading a file:
+ \code
+    gd::SerializerElement rootElement;
+    if ( !gd::Serializer::FromXMLFile(rootElement, "project.gdg") )
+        return false; //Error in XML file!
+
+    game.UnserializeFrom(rootElement);
+ \endcode
+ *
  * Usage example, with TinyXML:
  \code
     //Unserialize from a XML string:
@@ -45,10 +54,64 @@ public:
 
     /** \name JSON serialization.
      * Serialize a SerializerElement from/to JSON.
+     * When \a prettyPrinting is true, the JSON is written on several lines, indented with 4 spaces.
      */
     ///@{
-	static std::string ToJSON(const SerializerElement & element);
+	static std::string ToJSON(const SerializerElement & element, bool prettyPrinting = false);
 	static SerializerElement FromJSON(const std::string & json);
+
+    /**
+     * \brief Write the JSON of an element at the end of \a output.
+     *
+     * The JSON is written in a single pass and children are never copied: prefer this to
+     * concatenating the result of ToJSON with other strings.
+     */
+	static void ToJSON(const SerializerElement & element, std::string & output, bool prettyPrinting = false);
+
+    /**
+     * \brief Write the JSON of an element to a file, without building the whole JSON in memory.
+     * \return true if the file was written.
+     */
+	static bool ToJSONFile(const SerializerElement & element, const std::string & filename, bool prettyPrinting = false);
+    ///@}
+
+    /** \name Streaming parsing.
+     * Build a SerializerElement directly from a XML or JSON document, without an intermediate
+     * representation of the document ( see SerializerParser ).<br>
+     * For XML, the element is filled with the attributes, children and text of the root element of the document.
+     * \return true if the document was parsed without error. Otherwise, the error is stored in \a error if not NULL.
+     */
+    ///@{
+	static bool FromXML(SerializerElement & element, const char * xml, size_t size, std::string * error = NULL);
+	static bool FromJSON(SerializerElement & element, const char * json, size_t size, std::string * error = NULL);
+	static bool FromXMLFile(SerializerElement & element, const std::string & filename, std::string * error = NULL);
+	static bool FromJSONFile(SerializerElement & element, const std::string & filename, std::string * error = NULL);
+    ///@}
+
+    /** \name Binary serialization.
+     * Serialize a SerializerElement from/to a compact binary snapshot, used for the data of exported games.
+     *
+     * The snapshot is versioned, names and strings are stored once in a table and each element is prefixed by
+     * its size. It is read in place from a memory buffer ( usually a gd::MappedFile ), without any parsing.
+     * The types of the values are preserved.
+     */
+    ///@{
+    /**
+     * \brief Write the binary snapshot of an element at the end of \a output.
+     */
+	static void ToBinary(const SerializerElement & element, std::string & output);
+
+    /**
+     * \brief Return true if the data starts like a binary snapshot.
+     */
+	static bool IsBinary(const char * data, size_t size);
+
+    /**
+     * \brief Fill the element from a binary snapshot. Data after the snapshot ( for example padding ) is ignored.
+     * \return true if the snapshot was read without error. Otherwise, the error is stored in \a error if not NULL.
+     */
+	static bool FromBinary(SerializerElement & element, const char * data, size_t size, std::string * error = NULL);
+	static bool FromBinaryFile(SerializerElement & element, const std::string & filename, std::string * error = NULL);
     ///@}
 
 	virtual ~Serializer() {};
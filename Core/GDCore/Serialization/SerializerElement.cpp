@@ -1,6 +1,7 @@
 #include "GDCore/Serialization/SerializerElement.h"
 
 #include <iostream>
+#include <algorithm>
 
 namespace gd
 {
@@ -8,7 +9,8 @@ namespace gd
 SerializerElement SerializerElement::nullElement;
 
 SerializerElement::SerializerElement() :
-	valueUndefined(true)
+	valueUndefined(true),
+	childrenIndexed(false)
 {
 }
 
@@ -123,6 +125,52 @@ bool SerializerElement::HasAttribute(const std::string & name)
 	return attributes.find(name) != attributes.end();
 }
 
+void SerializerElement::IndexChildren() const
+{
+	if (childrenIndexed) return;
+
+	for (size_t i = 0; i < children.size(); ++i)
+	{
+		if (children[i].second != std::shared_ptr<SerializerElement>())
+			childrenPositions[children[i].first].push_back(i);
+	}
+
+	childrenIndexed = true;
+}
+
+const std::vector<size_t> & SerializerElement::FindChildren(const std::string & name, const std::string & deprecatedName, bool withUnnamed, std::vector<size_t> & merged) const
+{
+	static const std::vector<size_t> noChildren;
+	IndexChildren();
+
+	const std::vector<size_t> * positions[3];
+	unsigned int positionsCount = 0;
+
+	std::map< std::string, std::vector<size_t> >::const_iterator it = childrenPositions.find(name);
+	if (it != childrenPositions.end()) positions[positionsCount++] = &it->second;
+	if (!deprecatedName.empty() && deprecatedName != name)
+	{
+		it = childrenPositions.find(deprecatedName);
+		if (it != childrenPositions.end()) positions[positionsCount++] = &it->second;
+	}
+	if (withUnnamed && !name.empty())
+	{
+		it = childrenPositions.find("");
+		if (it != childrenPositions.end()) positions[positionsCount++] = &it->second;
+	}
+
+	if (positionsCount == 0) return noChildren;
+	if (positionsCount == 1) return *positions[0];
+
+	//Children with different names are mixed (for example after a deprecated name was renamed).
+	merged.clear();
+	for (unsigned int i = 0; i < positionsCount; ++i)
+		merged.insert(merged.end(), positions[i]->begin(), positions[i]->end());
+	std::sort(merged.begin(), merged.end());
+
+	return merged;
+}
+
 SerializerElement & SerializerElement::AddChild(std::string name)
 {
 	if ( !arrayOf.empty() )
@@ -137,6 +185,7 @@ SerializerElement & SerializerElement::AddChild(std::string name)
 
 	std::shared_ptr<SerializerElement> newElement(new SerializerElement);
 	children.push_back(std::make_pair(name, newElement));
+	if (childrenIndexed) childrenPositions[name].push_back(children.size()-1);
 
 	return *newElement;
 }
@@ -149,20 +198,10 @@ SerializerElement & SerializerElement::GetChild(unsigned int index) const
 		return nullElement;
 	}
 
-	unsigned int currentIndex = 0;
-	for (size_t i = 0; i < children.size(); ++i)
-	{
-		if (children[i].second == std::shared_ptr<SerializerElement>())
-			continue;
-
-		if (children[i].first == arrayOf || children[i].first.empty() || (!deprecatedArrayOf.empty() && children[i].first == deprecatedArrayOf))
-		{
-			if (index == currentIndex)
-				return *children[i].second;
-			else
-				currentIndex++;
-		}
-	}
+	std::vector<size_t> merged;
+	const std::vector<size_t> & positions = FindChildren(arrayOf, deprecatedArrayOf, true, merged);
+	if (index < positions.size())
+		return *children[positions[index]].second;
 
 	std::cout << "ERROR: Request out of bound child at index " << index << std::endl;
 	return nullElement;
@@ -180,23 +219,35 @@ SerializerElement & SerializerElement::GetChild(std::string name, unsigned int i
 		}
 	}
 
-	unsigned int currentIndex = 0;
-	for (size_t i = 0; i < children.size(); ++i)
-	{
-		if (children[i].second == std::shared_ptr<SerializerElement>())
-			continue;
+	std::vector<size_t> merged;
+	const std::vector<size_t> & positions = FindChildren(name, deprecatedName, !arrayOf.empty(), merged);
+	if (index < positions.size())
+		return *children[positions[index]].second;
+
+	std::cout << "Child " << name << " not found in SerializerElement::GetChild" << std::endl;
+	return nullElement;
+}
 
-		if (children[i].first == name || (!arrayOf.empty() && children[i].first.empty()) || (!deprecatedName.empty() && children[i].first == deprecatedName))
+void SerializerElement::ForEachChild(const std::string & name, const std::function<void(SerializerElement &)> & function, const std::string & deprecatedName) const
+{
+	std::string childrenName = name;
+	std::string childrenDeprecatedName = deprecatedName;
+	if (childrenName.empty())
+	{
+		if ( arrayOf.empty() )
 		{
-			if (index == currentIndex)
-				return *children[i].second;
-			else
-				currentIndex++;
+			std::cout << "ERROR: Iterating over children without specifying name, from a SerializerElement which is NOT considered as an array." << std::endl;
+			return;
 		}
+
+		childrenName = arrayOf;
+		childrenDeprecatedName = deprecatedArrayOf;
 	}
 
-	std::cout << "Child " << name << " not found in SerializerElement::GetChild" << std::endl;
-	return nullElement;
+	std::vector<size_t> merged;
+	const std::vector<size_t> & positions = FindChildren(childrenName, childrenDeprecatedName, !arrayOf.empty(), merged);
+	for (size_t i = 0; i < positions.size(); ++i)
+		function(*children[positions[i]].second);
 }
 
 unsigned int SerializerElement::GetChildrenCount(std::string name, std::string deprecatedName) const
@@ -213,31 +264,14 @@ unsigned int SerializerElement::GetChildrenCount(std::string name, std::string d
 		deprecatedName = deprecatedArrayOf;
 	}
 
-	unsigned int currentIndex = 0;
-	for (size_t i = 0; i < children.size(); ++i)
-	{
-		if (children[i].second == std::shared_ptr<SerializerElement>())
-			continue;
-
-		if (children[i].first == name || (!arrayOf.empty() && children[i].first.empty()) || (!deprecatedName.empty() && children[i].first == deprecatedName))
-			currentIndex++;
-	}
-
-	return currentIndex;
+	std::vector<size_t> merged;
+	return FindChildren(name, deprecatedName, !arrayOf.empty(), merged).size();
 }
 
 bool SerializerElement::HasChild(const std::string & name, std::string deprecatedName) const
 {
-	for (size_t i = 0; i < children.size(); ++i)
-	{
-		if (children[i].second == std::shared_ptr<SerializerElement>())
-			continue;
-
-		if (children[i].first == name || (!deprecatedName.empty() && children[i].first == deprecatedName))
-			return true;
-	}
-
-	return false;
+	std::vector<size_t> merged;
+	return !FindChildren(name, deprecatedName, false, merged).empty();
 }
 
 
@@ -10,6 +10,7 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <functional>
 #include "GDCore/Serialization/SerializerValue.h"
 
 namespace gd {
@@ -175,6 +176,18 @@ public:
      */
 	SerializerElement & GetChild(unsigned int index) const;
 
+    /**
+     * \brief Call a function for each child having a specific name, in order.
+     *
+     * If no children name is specified, the function is called for each child being part of the array
+     * (ConsiderAsArrayOf must have been called before), as for GetChildrenCount.<br>
+     * Prefer this to a loop calling GetChild for each index.
+     *
+     * \param name The name of the children.
+     * \param function The function to be called with each child.
+     */
+	void ForEachChild(const std::string & name, const std::function<void(SerializerElement &)> & function, const std::string & deprecatedName = "") const;
+
     /**
      * \brief Get the number of children having a specific name.
      *
@@ -202,6 +215,17 @@ public:
 
 	static SerializerElement nullElement;
 private:
+    /**
+     * \brief Build the index of the positions of the children, if not done yet.
+     */
+	void IndexChildren() const;
+
+    /**
+     * \brief Return the positions, in order, of the children named \a name or \a deprecatedName, and of the unnamed children
+     * if \a withUnnamed is true.
+     * \param merged Used to store the positions if they come from several names.
+     */
+	const std::vector<size_t> & FindChildren(const std::string & name, const std::string & deprecatedName, bool withUnnamed, std::vector<size_t> & merged) const;
 
 	bool valueUndefined; ///< If true, the element does not have a value.
 	SerializerValue elementValue;
@@ -210,6 +234,8 @@ private:
 	std::vector< std::pair<std::string, std::shared_ptr<SerializerElement> > > children;
 	mutable std::string arrayOf;
 	mutable std::string deprecatedArrayOf;
+	mutable std::map< std::string, std::vector<size_t> > childrenPositions; ///< The positions of the children in children, by name. Built on the first lookup.
+	mutable bool childrenIndexed; ///< true if childrenPositions is built.
 };
 
 }
@@ -0,0 +1,605 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2015 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#include "GDCore/Serialization/SerializerParser.h"
+#include "GDCore/CommonTools.h"
+#include <cstring>
+
+namespace gd
+{
+
+namespace
+{
+
+/**
+ * Same definition of whitespaces as TinyXML.
+ */
+inline bool IsWhiteSpace(char c)
+{
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\v' || c == '\f';
+}
+
+inline bool IsXMLNameEnd(char c)
+{
+    return IsWhiteSpace(c) || c == '/' || c == '>' || c == '=';
+}
+
+inline bool StartsWith(const char * current, const char * end, const char * prefix)
+{
+    std::size_t length = strlen(prefix);
+    return static_cast<std::size_t>(end-current) >= length && strncmp(current, prefix, length) == 0;
+}
+
+/**
+ * Return the position of the first occurrence of pattern in [current, end), or end.
+ */
+const char * Find(const char * current, const char * end, const char * pattern)
+{
+    while ( current != end )
+    {
+        current = static_cast<const char *>(memchr(current, pattern[0], end-current));
+        if ( current == NULL ) return end;
+        if ( StartsWith(current, end, pattern) ) return current;
+        ++current;
+    }
+
+    return end;
+}
+
+/**
+ * Return true if the text can be reported without being decoded.
+ */
+bool CanBeUsedAsIs(const char * begin, const char * end, bool condenseWhiteSpace)
+{
+    for (const char * c = begin;c != end;++c)
+    {
+        if ( *c == '&' || *c == '\r' ) return false;
+        if ( condenseWhiteSpace && IsWhiteSpace(*c) && ( *c != ' ' || ( c+1 != end && IsWhiteSpace(*(c+1)) ) ) )
+            return false;
+    }
+
+    return true;
+}
+
+int HexDigitValue(char c)
+{
+    if ( c >= '0' && c <= '9' ) return c-'0';
+    if ( c >= 'a' && c <= 'f' ) return c-'a'+10;
+    if ( c >= 'A' && c <= 'F' ) return c-'A'+10;
+    return -1;
+}
+
+}
+
+SerializerParser::SerializerParser() :
+    current(NULL),
+    end(NULL),
+    begin(NULL),
+    utf8(false),
+    handler(NULL)
+{
+}
+
+void SerializerParser::SkipWhiteSpaces()
+{
+    while ( current != end && IsWhiteSpace(*current) ) ++current;
+}
+
+bool SerializerParser::SetError(const std::string & description)
+{
+    unsigned int line = 1;
+    for (const char * c = begin;c != current && c != end;++c)
+        if ( *c == '\n' ) line++;
+
+    error = description+" (line "+gd::ToString(line)+")";
+    return false;
+}
+
+void SerializerParser::AppendCodePoint(unsigned long codePoint, bool utf8)
+{
+    if ( !utf8 ) //Same behavior as TinyXML for documents not encoded in UTF-8.
+        scratch.push_back(static_cast<char>(codePoint));
+    else if ( codePoint < 0x80 )
+        scratch.push_back(static_cast<char>(codePoint));
+    else if ( codePoint < 0x800 )
+    {
+        scratch.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+        scratch.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+    else if ( codePoint < 0x10000 )
+    {
+        scratch.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+        scratch.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        scratch.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+    else
+    {
+        scratch.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+        scratch.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+        scratch.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        scratch.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+}
+
+bool SerializerParser::ParseXML(const char * xml, std::size_t size, Handler & handler_)
+{
+    begin = current = xml;
+    end = xml+size;
+    handler = &handler_;
+    utf8 = false;
+    error.clear();
+
+    if ( StartsWith(current, end, "\xEF\xBB\xBF") )
+    {
+        utf8 = true;
+        current += 3;
+    }
+
+    //Skip the declaration, comments and document type until the root element.
+    while ( true )
+    {
+        SkipWhiteSpaces();
+        if ( current == end || *current != '<' )
+            return SetError("No root element found");
+
+        if ( StartsWith(current, end, "<?") )
+        {
+            const char * declarationEnd = Find(current, end, "?>");
+            if ( StartsWith(current, end, "<?xml") )
+            {
+                std::string declaration(current, declarationEnd);
+                for (std::size_t i = 0;i<declaration.size();++i)
+                    declaration[i] = tolower(declaration[i]);
+
+                if ( declaration.find("encoding=\"utf-8\"") != std::string::npos ||
+                     declaration.find("encoding='utf-8'") != std::string::npos )
+                    utf8 = true;
+            }
+
+            current = declarationEnd == end ? end : declarationEnd+2;
+        }
+        else if ( StartsWith(current, end, "<!--") )
+        {
+            const char * commentEnd = Find(current, end, "-->");
+            current = commentEnd == end ? end : commentEnd+3;
+        }
+        else if ( StartsWith(current, end, "<!") )
+        {
+            const char * doctypeEnd = Find(current, end, ">");
+            current = doctypeEnd == end ? end : doctypeEnd+1;
+        }
+        else
+            return ParseXMLElement();
+    }
+}
+
+bool SerializerParser::ParseXMLElement()
+{
+    ++current; //Skip <
+    const char * name = current;
+    while ( current != end && !IsXMLNameEnd(*current) ) ++current;
+    std::size_t nameLength = current-name;
+    if ( nameLength == 0 ) return SetError("Element without name");
+
+    handler->BeginElement(name, nameLength);
+
+    bool emptyElement = false;
+    if ( !ParseXMLAttributes(emptyElement) ) return false;
+    if ( !emptyElement && !ParseXMLContent(name, nameLength) ) return false;
+
+    handler->EndElement();
+    return true;
+}
+
+bool SerializerParser::ParseXMLAttributes(bool & emptyElement)
+{
+    while ( true )
+    {
+        SkipWhiteSpaces();
+        if ( current == end ) return SetError("Unexpected end of document in an element");
+
+        if ( *current == '>' )
+        {
+            ++current;
+            emptyElement = false;
+            return true;
+        }
+        if ( StartsWith(current, end, "/>") )
+        {
+            current += 2;
+            emptyElement = true;
+            return true;
+        }
+
+        const char * name = current;
+        while ( current != end && !IsXMLNameEnd(*current) ) ++current;
+        std::size_t nameLength = current-name;
+        if ( nameLength == 0 ) return SetError("Attribute without name");
+
+        SkipWhiteSpaces();
+        if ( current == end || *current != '=' ) return SetError("Attribute without value");
+        ++current;
+        SkipWhiteSpaces();
+        if ( current == end ) return SetError("Attribute without value");
+
+        const char * valueBegin = current;
+        const char * valueEnd = current;
+        if ( *current == '"' || *current == '\'' )
+        {
+            valueBegin = current+1;
+            valueEnd = static_cast<const char *>(memchr(valueBegin, *current, end-valueBegin));
+            if ( valueEnd == NULL ) return SetError("Attribute value not ended");
+            current = valueEnd+1;
+        }
+        else //Unquoted value, accepted by TinyXML.
+        {
+            while ( current != end && !IsWhiteSpace(*current) && *current != '/' && *current != '>' ) ++current;
+            valueEnd = current;
+        }
+
+        std::size_t valueLength = 0;
+        const char * value = DecodeXMLText(valueBegin, valueEnd, false, valueLength);
+        handler->Attribute(name, nameLength, value, valueLength);
+    }
+}
+
+bool SerializerParser::ParseXMLContent(const char * name, std::size_t nameLength)
+{
+    bool hasChildNode = false; //Only the text before any other node is the value of the element.
+    while ( true )
+    {
+        if ( current == end )
+            return SetError("Unexpected end of document, missing </"+std::string(name, nameLength)+">");
+
+        if ( *current != '<' ) //Text
+        {
+            const char * textBegin = current;
+            const char * textEnd = static_cast<const char *>(memchr(current, '<', end-current));
+            if ( textEnd == NULL ) textEnd = end;
+            current = textEnd;
+
+            while ( textBegin != textEnd && IsWhiteSpace(*textBegin) ) ++textBegin;
+            if ( textBegin == textEnd ) continue; //Whitespaces only: no text node for TinyXML.
+
+            if ( !hasChildNode )
+            {
+                std::size_t length = 0;
+                const char * text = DecodeXMLText(textBegin, textEnd, true, length);
+                handler->Value(text, length, Text);
+            }
+            hasChildNode = true;
+        }
+        else if ( StartsWith(current, end, "</") )
+        {
+            current += 2;
+            const char * endName = current;
+            while ( current != end && !IsXMLNameEnd(*current) ) ++current;
+            if ( static_cast<std::size_t>(current-endName) != nameLength || strncmp(endName, name, nameLength) != 0 )
+                return SetError("Element "+std::string(name, nameLength)+" ended by </"+std::string(endName, current)+">");
+
+            SkipWhiteSpaces();
+            if ( current == end || *current != '>' ) return SetError("End of element not closed");
+            ++current;
+            return true;
+        }
+        else if ( StartsWith(current, end, "<!") || StartsWith(current, end, "<?") )
+        {
+            bool isCDATA = false;
+            const char * content = NULL;
+            std::size_t contentLength = 0;
+            if ( !SkipXMLMarkup(isCDATA, content, contentLength) ) return false;
+
+            if ( isCDATA && !hasChildNode ) handler->Value(content, contentLength, Text);
+            hasChildNode = true;
+        }
+        else
+        {
+            hasChildNode = true;
+            if ( !ParseXMLElement() ) return false;
+        }
+    }
+}
+
+bool SerializerParser::SkipXMLMarkup(bool & isCDATA, const char * & content, std::size_t & contentLength)
+{
+    const char * closing = ">";
+    if ( StartsWith(current, end, "<![CDATA[") )
+    {
+        isCDATA = true;
+        closing = "]]>";
+        content = current+9;
+    }
+    else if ( StartsWith(current, end, "<!--") )
+        closing = "-->";
+    else if ( StartsWith(current, end, "<?") )
+        closing = "?>";
+
+    const char * markupEnd = Find(current, end, closing);
+    if ( markupEnd == end ) return SetError("Unexpected end of document, missing "+std::string(closing));
+
+    if ( isCDATA ) contentLength = markupEnd-content;
+    current = markupEnd+strlen(closing);
+    return true;
+}
+
+const char * SerializerParser::DecodeXMLText(const char * textBegin, const char * textEnd, bool condenseWhiteSpace, std::size_t & length)
+{
+    if ( condenseWhiteSpace )
+    {
+        while ( textBegin != textEnd && IsWhiteSpace(*textBegin) ) ++textBegin;
+        while ( textEnd != textBegin && IsWhiteSpace(*(textEnd-1)) ) --textEnd;
+    }
+
+    if ( CanBeUsedAsIs(textBegin, textEnd, condenseWhiteSpace) )
+    {
+        length = textEnd-textBegin;
+        return textBegin;
+    }
+
+    scratch.clear();
+    bool pendingWhiteSpace = false;
+    for (const char * c = textBegin;c != textEnd;)
+    {
+        if ( condenseWhiteSpace && IsWhiteSpace(*c) )
+        {
+            pendingWhiteSpace = true;
+            ++c;
+            continue;
+        }
+        if ( pendingWhiteSpace ) scratch.push_back(' ');
+        pendingWhiteSpace = false;
+
+        if ( *c == '\r' ) //Line endings are normalized, as done by TinyXML when loading a file.
+        {
+            scratch.push_back('\n');
+            ++c;
+            if ( c != textEnd && *c == '\n' ) ++c;
+        }
+        else if ( *c == '&' )
+        {
+            const char * entityEnd = static_cast<const char *>(memchr(c, ';', textEnd-c));
+            std::string entity = entityEnd ? std::string(c+1, entityEnd) : "";
+            if ( entity == "amp" ) scratch.push_back('&');
+            else if ( entity == "lt" ) scratch.push_back('<');
+            else if ( entity == "gt" ) scratch.push_back('>');
+            else if ( entity == "quot" ) scratch.push_back('"');
+            else if ( entity == "apos" ) scratch.push_back('\'');
+            else if ( entity.size() > 1 && entity[0] == '#' )
+            {
+                unsigned long codePoint = 0;
+                bool hexadecimal = entity[1] == 'x' || entity[1] == 'X';
+                for (std::size_t i = hexadecimal ? 2 : 1;i<entity.size();++i)
+                {
+                    int digit = hexadecimal ? HexDigitValue(entity[i]) : ( entity[i] >= '0' && entity[i] <= '9' ? entity[i]-'0' : -1 );
+                    if ( digit >= 0 ) codePoint = codePoint*(hexadecimal ? 16 : 10)+digit;
+                }
+                AppendCodePoint(codePoint, utf8);
+            }
+            else //Unknown entity: the ampersand is dropped, like TinyXML.
+            {
+                ++c;
+                continue;
+            }
+
+            c = entityEnd+1;
+        }
+        else
+        {
+            scratch.push_back(*c);
+            ++c;
+        }
+    }
+
+    length = scratch.size();
+    return scratch.empty() ? "" : &scratch[0];
+}
+
+bool SerializerParser::ParseJSON(const char * json, std::size_t size, Handler & handler_)
+{
+    begin = current = json;
+    end = json+size;
+    handler = &handler_;
+    error.clear();
+
+    if ( StartsWith(current, end, "\xEF\xBB\xBF") ) current += 3;
+
+    //As before, the parsing is stopped as soon as the root value is parsed.
+    handler->BeginElement("", 0);
+    if ( !ParseJSONValue() ) return false;
+    handler->EndElement();
+
+    return true;
+}
+
+bool SerializerParser::ParseJSONValue()
+{
+    SkipWhiteSpaces();
+    if ( current == end ) return SetError("Unexpected end of document, a value was expected");
+
+    if ( *current == '{' ) //Object
+    {
+        ++current;
+        SkipWhiteSpaces();
+        if ( current != end && *current == '}' )
+        {
+            ++current;
+            return true;
+        }
+
+        while ( true )
+        {
+            SkipWhiteSpaces();
+            if ( current == end || *current != '"' ) return SetError("Object not properly formed, a key was expected");
+
+            const char * key = NULL;
+            std::size_t keyLength = 0;
+            if ( !ParseJSONString(key, keyLength) ) return false;
+
+            SkipWhiteSpaces();
+            if ( current == end || *current != ':' ) return SetError("Object not properly formed, : was expected");
+            ++current;
+
+            handler->BeginElement(key, keyLength);
+            if ( !ParseJSONValue() ) return false;
+            handler->EndElement();
+
+            SkipWhiteSpaces();
+            if ( current == end ) return SetError("Object not properly ended");
+            if ( *current == '}' )
+            {
+                ++current;
+                return true;
+            }
+            if ( *current != ',' ) return SetError("Object not properly formed, , or } was expected");
+            ++current;
+        }
+    }
+    else if ( *current == '[' ) //Array
+    {
+        ++current;
+        SkipWhiteSpaces();
+        if ( current != end && *current == ']' )
+        {
+            ++current;
+            return true;
+        }
+
+        while ( true )
+        {
+            handler->BeginElement("", 0);
+            if ( !ParseJSONValue() ) return false;
+            handler->EndElement();
+
+            SkipWhiteSpaces();
+            if ( current == end ) return SetError("Array not properly ended");
+            if ( *current == ']' )
+            {
+                ++current;
+                return true;
+            }
+            if ( *current != ',' ) return SetError("Array not properly formed, , or ] was expected");
+            ++current;
+        }
+    }
+    else if ( *current == '"' ) //String
+    {
+        const char * string = NULL;
+        std::size_t length = 0;
+        if ( !ParseJSONString(string, length) ) return false;
+
+        handler->Value(string, length, String);
+        return true;
+    }
+    else if ( StartsWith(current, end, "true") || StartsWith(current, end, "false") )
+    {
+        std::size_t length = *current == 't' ? 4 : 5;
+        handler->Value(current, length, Boolean);
+        current += length;
+        return true;
+    }
+    else if ( StartsWith(current, end, "null") )
+    {
+        handler->Value(current, 4, Null);
+        current += 4;
+        return true;
+    }
+    else if ( *current == '-' || ( *current >= '0' && *current <= '9' ) ) //Number
+    {
+        const char * number = current;
+        while ( current != end && ( strchr("+-.eE", *current) != NULL || ( *current >= '0' && *current <= '9' ) ) )
+            ++current;
+
+        handler->Value(number, current-number, Number);
+        return true;
+    }
+
+    return SetError("Unexpected character "+std::string(current, current+1));
+}
+
+bool SerializerParser::ParseJSONString(const char * & string, std::size_t & length)
+{
+    ++current; //Skip "
+    const char * stringBegin = current;
+    while ( current != end && *current != '"' && *current != '\\' ) ++current;
+    if ( current == end ) return SetError("String not ended");
+
+    if ( *current == '"' ) //No escape sequence: the string is used as is.
+    {
+        string = stringBegin;
+        length = current-stringBegin;
+        ++current;
+        return true;
+    }
+
+    scratch.assign(stringBegin, current);
+    while ( current != end && *current != '"' )
+    {
+        if ( *current != '\\' )
+        {
+            scratch.push_back(*current);
+            ++current;
+            continue;
+        }
+
+        ++current;
+        if ( current == end ) break;
+        switch ( *current )
+        {
+            case '"':
+            case '\\':
+            case '/': scratch.push_back(*current); break;
+            case 'b': scratch.push_back('\b'); break;
+            case 'f': scratch.push_back('\f'); break;
+            case 'n': scratch.push_back('\n'); break;
+            case 'r': scratch.push_back('\r'); break;
+            case 't': scratch.push_back('\t'); break;
+            case 'u':
+            {
+                unsigned long codePoint = 0;
+                for (unsigned int i = 0;i<4;++i)
+                {
+                    if ( current+1 == end || HexDigitValue(*(current+1)) < 0 ) return SetError("Invalid unicode escape sequence");
+                    ++current;
+                    codePoint = codePoint*16+HexDigitValue(*current);
+                }
+
+                //Surrogate pair
+                if ( codePoint >= 0xD800 && codePoint <= 0xDBFF && end-current > 6 && StartsWith(current+1, end, "\\u") )
+                {
+                    unsigned long lowSurrogate = 0;
+                    bool valid = true;
+                    for (unsigned int i = 3;i<7;++i)
+                    {
+                        int digit = HexDigitValue(*(current+i));
+                        if ( digit < 0 ) valid = false;
+                        else lowSurrogate = lowSurrogate*16+digit;
+                    }
+
+                    if ( valid && lowSurrogate >= 0xDC00 && lowSurrogate <= 0xDFFF )
+                    {
+                        codePoint = 0x10000+((codePoint-0xD800) << 10)+(lowSurrogate-0xDC00);
+                        current += 6;
+                    }
+                }
+                AppendCodePoint(codePoint, true);
+                break;
+            }
+            default: //Unknown escape sequences are kept as is.
+                scratch.push_back('\\');
+                scratch.push_back(*current);
+                break;
+        }
+        ++current;
+    }
+
+    if ( current == end ) return SetError("String not ended");
+    ++current;
+
+    string = scratch.empty() ? "" : &scratch[0];
+    length = scratch.size();
+    return true;
+}
+
+}
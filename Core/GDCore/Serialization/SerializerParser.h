@@ -0,0 +1,124 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2015 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#ifndef GDCORE_SERIALIZERPARSER_H
+#define GDCORE_SERIALIZERPARSER_H
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace gd
+{
+
+/**
+ * \brief Streaming ( SAX-style ) parser for the XML and JSON documents of GDevelop.
+ *
+ * The parser reads the document from a memory buffer ( usually a gd::MappedFile ) and
+ * reports what it finds to a handler, without building any intermediate representation.
+ * Names and values are given as pointers inside the document when they contain no escape
+ * sequence or entity; otherwise they are decoded in a scratch buffer owned by the parser and
+ * reused for the whole document. In both cases, they are only valid during the call to the handler.
+ *
+ * The elements are reported in the same way as the TinyXML DOM is converted by Serializer::FromXML
+ * ( attributes, children elements and text of the element ) and as JSON was parsed by Serializer::FromJSON
+ * ( an object member is a child named after the key, an array item is a child with an empty name ).
+ *
+ * \see Serializer
+ * \ingroup Serialization
+ */
+class GD_CORE_API SerializerParser
+{
+public:
+    /**
+     * \brief The type of a value reported to the handler.
+     */
+    enum ValueType
+    {
+        Text, ///< The text of a XML element: its type is not known.
+        String,
+        Number,
+        Boolean,
+        Null
+    };
+
+    /**
+     * \brief Interface of the objects receiving what is found by the parser.
+     */
+    class GD_CORE_API Handler
+    {
+    public:
+        virtual ~Handler() {};
+
+        /**
+         * \brief Called when an element starts. For JSON, the name of the root element and of the items of arrays is empty.
+         */
+        virtual void BeginElement(const char * name, std::size_t nameLength) = 0;
+
+        /**
+         * \brief Called for each attribute of the current element ( XML only ).
+         */
+        virtual void Attribute(const char * name, std::size_t nameLength, const char * value, std::size_t valueLength) = 0;
+
+        /**
+         * \brief Called when the current element has a value ( text for XML, string, number, boolean or null for JSON ).
+         */
+        virtual void Value(const char * value, std::size_t valueLength, ValueType type) = 0;
+
+        /**
+         * \brief Called when the current element ends.
+         */
+        virtual void EndElement() = 0;
+    };
+
+    SerializerParser();
+    virtual ~SerializerParser() {};
+
+    /**
+     * \brief Parse a XML document.
+     *
+     * As for the TinyXML DOM, whitespaces of the text of elements are condensed, the text is only reported if it comes
+     * before the children elements, and numeric character references are converted to UTF-8 only for UTF-8 documents.
+     *
+     * \return true if the document was parsed without error. The error can be retrieved with GetError.
+     */
+    bool ParseXML(const char * xml, std::size_t size, Handler & handler);
+
+    /**
+     * \brief Parse a JSON document.
+     * \return true if the document was parsed without error. The error can be retrieved with GetError.
+     */
+    bool ParseJSON(const char * json, std::size_t size, Handler & handler);
+
+    /**
+     * \brief Return the description of the error which stopped the last parsing, if any.
+     */
+    const std::string & GetError() const { return error; };
+
+private:
+    bool ParseXMLElement();
+    bool ParseXMLAttributes(bool & emptyElement);
+    bool ParseXMLContent(const char * name, std::size_t nameLength);
+    bool SkipXMLMarkup(bool & isCDATA, const char * & content, std::size_t & contentLength);
+    const char * DecodeXMLText(const char * textBegin, const char * textEnd, bool condenseWhiteSpace, std::size_t & length);
+    void AppendCodePoint(unsigned long codePoint, bool utf8);
+
+    bool ParseJSONValue();
+    bool ParseJSONString(const char * & string, std::size_t & length);
+
+    void SkipWhiteSpaces();
+    bool SetError(const std::string & description);
+
+    const char * current; ///< The current position in the document.
+    const char * end; ///< The end of the document.
+    const char * begin; ///< The beginning of the document, used to report the position of errors.
+    bool utf8; ///< true if the XML document is encoded in UTF-8.
+    Handler * handler;
+    std::vector<char> scratch; ///< Storage for the decoded names and values, reused for the whole document.
+    std::string error;
+};
+
+}
+
+#endif // GDCORE_SERIALIZERPARSER_H
@@ -61,6 +61,12 @@ public:
 	 */
 	std::string GetString() const;
 
+	/**
+	 * Get a reference to the stored string, without conversion.
+	 * \warning Only meaningful if the value is a string or has an unknown type.
+	 */
+	const std::string & GetRawString() const { return stringValue; };
+
 	/**
 	 * Get the value, its type being an int.
 	 */
@@ -0,0 +1,48 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2015 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#include "GDCore/Tools/InternedStrings.h"
+#include <unordered_set>
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+
+namespace gd
+{
+
+namespace
+{
+    //Function local statics, as strings can be interned during the static initialization.
+    std::unordered_set<std::string> & GetStrings()
+    {
+        static std::unordered_set<std::string> strings; //Elements of an unordered_set are never moved.
+        return strings;
+    }
+
+    sf::Mutex & GetMutex()
+    {
+        static sf::Mutex mutex;
+        return mutex;
+    }
+}
+
+const std::string * InternedStrings::Get(const std::string & str)
+{
+    sf::Lock lock(GetMutex());
+    return &*GetStrings().insert(str).first;
+}
+
+const std::string * InternedStrings::GetEmpty()
+{
+    static const std::string * empty = Get("");
+    return empty;
+}
+
+std::size_t InternedStrings::Count()
+{
+    sf::Lock lock(GetMutex());
+    return GetStrings().size();
+}
+
+}
@@ -0,0 +1,50 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2015 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#ifndef GDCORE_INTERNEDSTRINGS_H
+#define GDCORE_INTERNEDSTRINGS_H
+#include <string>
+
+namespace gd
+{
+
+/**
+ * \brief Store a single copy of strings shared by a lot of objects, like the names of the objects
+ * and layers of initial instances.
+ *
+ * An interned string is never released and its address never changes: it can be stored
+ * as a pointer, and two interned strings are equal if and only if their addresses are equal.
+ *
+ * Usage example:
+ * \code
+ * const std::string * layer = gd::InternedStrings::Get("Background");
+ * bool sameLayer = layer == gd::InternedStrings::Get(otherLayerName);
+ * \endcode
+ *
+ * \note Interning strings is thread safe.
+ * \ingroup Tools
+ */
+class GD_CORE_API InternedStrings
+{
+public:
+    /**
+     * \brief Return the interned copy of \a str.
+     */
+    static const std::string * Get(const std::string & str);
+
+    /**
+     * \brief Return the interned empty string.
+     */
+    static const std::string * GetEmpty();
+
+    /**
+     * \brief Return the number of interned strings.
+     */
+    static std::size_t Count();
+};
+
+}
+
+#endif // GDCORE_INTERNEDSTRINGS_H
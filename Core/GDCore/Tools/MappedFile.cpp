@@ -0,0 +1,119 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2015 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#include "GDCore/Tools/MappedFile.h"
+#include <cstdio>
+#if defined(WINDOWS)
+#include <windows.h>
+#elif defined(LINUX) || defined(MACOS)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace gd
+{
+
+MappedFile::MappedFile() :
+    data(NULL),
+    size(0),
+    mapped(false)
+    #if defined(WINDOWS)
+    ,file(INVALID_HANDLE_VALUE),
+    mapping(NULL)
+    #endif
+{
+}
+
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool MappedFile::Open(const std::string & filename)
+{
+    Close();
+
+    #if defined(WINDOWS)
+    file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if ( file == INVALID_HANDLE_VALUE ) return false;
+
+    LARGE_INTEGER fileSize;
+    if ( GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0 )
+    {
+        mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if ( mapping != NULL )
+        {
+            data = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            if ( data != NULL )
+            {
+                size = static_cast<std::size_t>(fileSize.QuadPart);
+                mapped = true;
+                return true;
+            }
+        }
+    }
+    Close();
+    #elif defined(LINUX) || defined(MACOS)
+    int file = open(filename.c_str(), O_RDONLY);
+    if ( file == -1 ) return false;
+
+    struct stat fileStat;
+    if ( fstat(file, &fileStat) == 0 && fileStat.st_size > 0 )
+    {
+        void * mapping = mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+        if ( mapping != MAP_FAILED )
+        {
+            close(file); //The mapping stays valid after the file is closed.
+            madvise(mapping, fileStat.st_size, MADV_SEQUENTIAL);
+            data = static_cast<const char *>(mapping);
+            size = fileStat.st_size;
+            mapped = true;
+            return true;
+        }
+    }
+    close(file);
+    #endif
+
+    //Empty file or mapping not available.
+    return ReadInBuffer(filename);
+}
+
+bool MappedFile::ReadInBuffer(const std::string & filename)
+{
+    FILE * file = fopen(filename.c_str(), "rb");
+    if ( file == NULL ) return false;
+
+    char chunk[65536];
+    std::size_t read = 0;
+    while ( (read = fread(chunk, 1, sizeof(chunk), file)) > 0 )
+        buffer.insert(buffer.end(), chunk, chunk+read);
+    fclose(file);
+
+    data = buffer.empty() ? "" : &buffer[0];
+    size = buffer.size();
+    return true;
+}
+
+void MappedFile::Close()
+{
+    #if defined(WINDOWS)
+    if ( mapped && data != NULL ) UnmapViewOfFile(data);
+    if ( mapping != NULL ) CloseHandle(mapping);
+    if ( file != INVALID_HANDLE_VALUE ) CloseHandle(file);
+    mapping = NULL;
+    file = INVALID_HANDLE_VALUE;
+    #elif defined(LINUX) || defined(MACOS)
+    if ( mapped && data != NULL ) munmap(const_cast<char *>(data), size);
+    #endif
+
+    data = NULL;
+    size = 0;
+    mapped = false;
+    std::vector<char>().swap(buffer);
+}
+
+}
@@ -0,0 +1,78 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2015 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#ifndef GDCORE_MAPPEDFILE_H
+#define GDCORE_MAPPEDFILE_H
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace gd
+{
+
+/**
+ * \brief Give a read only access to the content of a file, mapped in memory when the system allows it.
+ *
+ * Mapping the file avoids to copy it in memory before parsing it: pages are read by the system
+ * when they are accessed, and can be released at any time as they are backed by the file.
+ * On systems where mapping is not available, the file is read in a buffer.
+ *
+ * Usage example:
+ * \code
+ * gd::MappedFile file;
+ * if ( !file.Open("project.gdg") ) return false;
+ *
+ * gd::SerializerParser parser;
+ * parser.ParseXML(file.GetData(), file.GetSize(), handler);
+ * \endcode
+ *
+ * \ingroup Tools
+ */
+class GD_CORE_API MappedFile
+{
+public:
+    MappedFile();
+    virtual ~MappedFile();
+
+    /**
+     * \brief Open the file and give access to its content. The previously opened file, if any, is closed.
+     * \return true if the file was opened.
+     */
+    bool Open(const std::string & filename);
+
+    /**
+     * \brief Close the file. GetData must not be used anymore.
+     */
+    void Close();
+
+    /**
+     * \brief Return the content of the file.
+     */
+    const char * GetData() const { return data; };
+
+    /**
+     * \brief Return the size, in bytes, of the content of the file.
+     */
+    std::size_t GetSize() const { return size; };
+
+private:
+    MappedFile(const MappedFile &);
+    MappedFile & operator=(const MappedFile &);
+
+    bool ReadInBuffer(const std::string & filename);
+
+    const char * data; ///< The content of the file ( mapping or buffer ).
+    std::size_t size;
+    bool mapped; ///< true if data is a mapping of the file, false if it is the buffer.
+    std::vector<char> buffer; ///< Used when the file can't be mapped.
+    #if defined(WINDOWS)
+    void * file;
+    void * mapping;
+    #endif
+};
+
+}
+
+#endif // GDCORE_MAPPEDFILE_H
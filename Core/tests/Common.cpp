@@ -13,11 +13,13 @@
 #include "GDCore/PlatformDefinition/Project.h"
 #include "GDCore/PlatformDefinition/Layout.h"
 #include "GDCore/PlatformDefinition/Variable.h"
+#include "GDCore/PlatformDefinition/InitialInstancesContainer.h"
 #include "GDCore/Events/EventsList.h"
 #include "GDCore/Events/Event.h"
 #include "GDCore/Events/Builtin/StandardEvent.h"
 #include "GDCore/Events/Serialization.h"
 #include "GDCore/Serialization/Serializer.h"
+#include "GDCore/Serialization/SerializerElement.h"
 
 TEST_CASE( "Common tools", "[common]" ) {
     REQUIRE( gd::ToInt("1") == 1 );
@@ -136,3 +138,162 @@ TEST_CASE( "VersionWrapper", "[common]" ) {
     REQUIRE( gd::VersionWrapper::IsOlder(2,1,0,9,2,1,1,0) == true );
     REQUIRE( gd::VersionWrapper::IsOlderOrEqual(2,1,9,9,2,1,9,9) == true );
 }
+
+namespace
+{
+
+class InstanceBounds : public gd::InitialInstanceBoundsFunctor
+{
+public:
+    virtual sf::FloatRect operator()(gd::InitialInstance & instance)
+    {
+        return sf::FloatRect(instance.GetX(), instance.GetY(), 10, 10);
+    }
+};
+
+class InstancesCollector : public gd::InitialInstanceFunctor
+{
+public:
+    virtual void operator()(gd::InitialInstance * instance) { instances.push_back(instance); }
+
+    std::vector<gd::InitialInstance*> instances;
+};
+
+}
+
+TEST_CASE( "InitialInstancesContainer", "[common]" ) {
+    SECTION("Instances are never moved") {
+        gd::InitialInstancesContainer container;
+        std::vector<gd::InitialInstance*> instances;
+        for (unsigned int i = 0;i<1000;++i)
+        {
+            gd::InitialInstance & instance = container.InsertNewInitialInstance();
+            instance.SetObjectName(i%2 == 0 ? "Even" : "Odd");
+            instance.SetX(i);
+            instances.push_back(&instance);
+        }
+
+        container.RemoveInitialInstancesOfObject("Odd");
+        container.RemoveInstance(*instances[0]);
+        REQUIRE( container.GetInstancesCount() == 499 );
+        for (unsigned int i = 2;i<1000;i+=2)
+            REQUIRE( instances[i]->GetX() == i );
+
+        InstancesCollector collector;
+        container.IterateOverInstances(collector);
+        REQUIRE( collector.instances.size() == 499 );
+        REQUIRE( collector.instances[0] == instances[2] );
+        REQUIRE( collector.instances[498] == instances[998] );
+    }
+    SECTION("Slots of removed instances are reused") {
+        gd::InitialInstancesContainer container;
+        gd::InitialInstance & first = container.InsertNewInitialInstance();
+        gd::InitialInstance & second = container.InsertNewInitialInstance();
+        container.InsertNewInitialInstance();
+
+        for (unsigned int i = 0;i<1000;++i)
+        {
+            container.RemoveInstance(second);
+            REQUIRE( &container.InsertNewInitialInstance() == &second );
+        }
+        REQUIRE( container.GetInstancesCount() == 3 );
+
+        //Reused slots are still iterated in the order the instances were added.
+        InstancesCollector collector;
+        container.IterateOverInstances(collector);
+        REQUIRE( collector.instances.size() == 3 );
+        REQUIRE( collector.instances[0] == &first );
+        REQUIRE( collector.instances[2] == &second );
+    }
+    SECTION("Serialization") {
+        gd::InitialInstancesContainer container;
+        gd::InitialInstance & instance = container.InsertNewInitialInstance();
+        instance.SetObjectName("MyObject");
+        instance.SetLayer("MyLayer");
+        instance.GetVariables().InsertNew("MyVariable", 0).SetValue(42);
+        container.InsertNewInitialInstance().SetObjectName("MyOtherObject");
+
+        gd::SerializerElement element;
+        container.SerializeTo(element);
+        gd::InitialInstancesContainer unserializedContainer;
+        unserializedContainer.UnserializeFrom(element);
+
+        InstancesCollector collector;
+        unserializedContainer.IterateOverInstances(collector);
+        REQUIRE( collector.instances.size() == 2 );
+        REQUIRE( collector.instances[0]->GetObjectName() == "MyObject" );
+        REQUIRE( collector.instances[0]->GetLayer() == "MyLayer" );
+        REQUIRE( &collector.instances[0]->GetLayer() == &instance.GetLayer() ); //Names are interned.
+        REQUIRE( collector.instances[0]->GetVariables().Get("MyVariable").GetValue() == 42 );
+        REQUIRE( collector.instances[1]->GetObjectName() == "MyOtherObject" );
+        REQUIRE( static_cast<const gd::InitialInstance*>(collector.instances[1])->GetVariables().Count() == 0 );
+    }
+    SECTION("Instances in an area") {
+        gd::InitialInstancesContainer container;
+        for (unsigned int i = 0;i<100;++i)
+        {
+            gd::InitialInstance & instance = container.InsertNewInitialInstance();
+            instance.SetX((i%10)*100);
+            instance.SetY((i/10)*100);
+        }
+
+        InstanceBounds bounds;
+        InstancesCollector collector;
+        container.IterateOverInstancesInArea(collector, sf::FloatRect(150, 150, 100, 100), bounds);
+        REQUIRE( collector.instances.size() == 1 );
+        REQUIRE( collector.instances[0]->GetX() == 200 );
+        REQUIRE( collector.instances[0]->GetY() == 200 );
+
+        //Moved instances are updated in the index
+        collector.instances[0]->SetX(-500);
+        InstancesCollector collectorAfterMove;
+        container.IterateOverInstancesInArea(collectorAfterMove, sf::FloatRect(150, 150, 100, 100), bounds);
+        REQUIRE( collectorAfterMove.instances.empty() );
+
+        InstancesCollector collectorAtPosition;
+        container.IterateOverInstancesInArea(collectorAtPosition, sf::FloatRect(-495, 205, 0, 0), bounds);
+        REQUIRE( collectorAtPosition.instances.size() == 1 );
+
+        //Instances are iterated in the order of the container
+        InstancesCollector collectorAll;
+        container.IterateOverInstancesInArea(collectorAll, sf::FloatRect(-1000, -1000, 3000, 3000), bounds);
+        InstancesCollector collectorReference;
+        container.IterateOverInstances(collectorReference);
+        REQUIRE( collectorAll.instances == collectorReference.instances );
+
+        //Copies of the container have their own index
+        gd::InitialInstancesContainer copy = container;
+        InstancesCollector collectorInCopy;
+        copy.IterateOverInstancesInArea(collectorInCopy, sf::FloatRect(-495, 205, 0, 0), bounds);
+        REQUIRE( collectorInCopy.instances.size() == 1 );
+        REQUIRE( collectorInCopy.instances[0] != collectorAtPosition.instances[0] );
+    }
+    SECTION("Z ordering") {
+        gd::InitialInstancesContainer container;
+        gd::InitialInstance & first = container.InsertNewInitialInstance();
+        gd::InitialInstance & second = container.InsertNewInitialInstance();
+        gd::InitialInstance & third = container.InsertNewInitialInstance();
+        third.SetLayer("Other layer");
+        first.SetZOrder(2);
+
+        InstancesCollector collector;
+        container.IterateOverInstancesWithZOrdering(collector, "");
+        REQUIRE( collector.instances.size() == 2 );
+        REQUIRE( collector.instances[0] == &second );
+        REQUIRE( collector.instances[1] == &first );
+
+        second.SetZOrder(3);
+        third.SetLayer("");
+        InstanceBounds bounds;
+        InstancesCollector collectorInArea;
+        container.IterateOverInstancesWithZOrdering(collectorInArea, "", sf::FloatRect(0, 0, 1, 1), bounds);
+        REQUIRE( collectorInArea.instances.size() == 3 );
+        REQUIRE( collectorInArea.instances[0] == &third );
+        REQUIRE( collectorInArea.instances[1] == &first );
+        REQUIRE( collectorInArea.instances[2] == &second );
+
+        InstancesCollector collectorAfterChanges;
+        container.IterateOverInstancesWithZOrdering(collectorAfterChanges, "");
+        REQUIRE( collectorAfterChanges.instances == collectorInArea.instances );
+    }
+}
@@ -17,7 +17,10 @@
 #include "GDCore/Events/Builtin/GroupEvent.h"
 #include "GDCore/Events/Builtin/StandardEvent.h"
 #include "GDCore/Events/Builtin/ForEachEvent.h"
+#include "GDCore/Events/EventsCodeGenerator.h"
+#include "GDCore/PlatformDefinition/Platform.h"
 #include <memory>
+#include <set>
 
 TEST_CASE( "Events", "[common][events]" ) {
     SECTION("StandardEvent") {
@@ -57,4 +60,29 @@ TEST_CASE( "Events", "[common][events]" ) {
         REQUIRE( cloned->GetBackgroundColorB() == 3 );
     }
 
+    SECTION("Stable identifiers") {
+        gd::Platform platform;
+        gd::Project project;
+        gd::Layout layout;
+        gd::EventsCodeGenerator generator(project, layout, platform);
+        gd::EventsCodeGenerator otherGenerator(project, layout, platform);
+
+        //The same seed always gives the same identifiers...
+        generator.SetStableIdentifiersSeed(1);
+        otherGenerator.SetStableIdentifiersSeed(1);
+        std::set<unsigned int> identifiers;
+        for (unsigned int i = 0;i<1000;++i)
+        {
+            unsigned int identifier = generator.GenerateStableIdentifier();
+            REQUIRE( identifier == otherGenerator.GenerateStableIdentifier() );
+            identifiers.insert(identifier);
+        }
+        REQUIRE( identifiers.size() == 1000 );
+
+        //...which are not the ones of a close seed.
+        otherGenerator.SetStableIdentifiersSeed(2);
+        for (unsigned int i = 0;i<1000;++i)
+            REQUIRE( identifiers.find(otherGenerator.GenerateStableIdentifier()) == identifiers.end() );
+    }
+
 }
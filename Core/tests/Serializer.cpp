@@ -18,6 +18,15 @@
 #include "GDCore/Events/Builtin/StandardEvent.h"
 #include "GDCore/Events/Serialization.h"
 #include "GDCore/Serialization/Serializer.h"
+#include "GDCore/TinyXml/tinyxml.h"
+#include "SyntheticProject.h"
+#include <cstdio>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <iterator>
 
 using namespace gd;
 
@@ -43,4 +52,330 @@ TEST_CASE( "Serializer", "[common]" ) {
         std::string json = Serializer::ToJSON(element);
         REQUIRE(json == originalJSON);
     }
+
+    SECTION("JSON writing") {
+        SerializerElement element;
+        element.SetAttribute("int", -42);
+        element.SetAttribute("double", 2.5);
+        element.SetAttribute("bool", true);
+        SerializerElement & array = element.AddChild("array");
+        array.ConsiderAsArrayOf("item");
+        array.AddChild("item").SetValue(std::string("a\u0001"));
+        array.AddChild("item").SetValue(1234567.0);
+        element.AddChild("empty");
+
+        std::string json = "{\"bool\": true,\"double\": 2.5,\"int\": -42,\"array\": [\"a\\u0001\",1.23457e+06],\"empty\": {}}";
+        REQUIRE(Serializer::ToJSON(element) == json);
+
+        std::string output = "data = ";
+        Serializer::ToJSON(element, output);
+        REQUIRE(output == "data = "+json);
+
+        REQUIRE(Serializer::ToJSON(array, true) == "[\n    \"a\\u0001\",\n    1.23457e+06\n]");
+
+        REQUIRE(Serializer::ToJSONFile(element, "GDCore_tests_writer.json"));
+        SerializerElement readElement;
+        REQUIRE(Serializer::FromJSONFile(readElement, "GDCore_tests_writer.json"));
+        REQUIRE(readElement.GetIntAttribute("int") == -42);
+        std::remove("GDCore_tests_writer.json");
+    }
+
+    SECTION("Children lookup") {
+        SerializerElement element;
+        element.AddChild("layer").SetValue(0);
+        element.AddChild("other").SetValue(-1);
+        element.AddChild("Layer").SetValue(1); //Deprecated name
+        element.AddChild("layer").SetValue(2);
+        REQUIRE(element.GetChildrenCount("layer") == 2);
+        REQUIRE(element.GetChildrenCount("layer", "Layer") == 3);
+        REQUIRE(element.GetChild("layer", 1, "Layer").GetValue().GetInt() == 1);
+        REQUIRE(element.HasChild("other"));
+        REQUIRE(!element.HasChild("missing"));
+
+        //Children added after a lookup are found.
+        element.AddChild("layer").SetValue(3);
+        REQUIRE(element.GetChild("layer", 2).GetValue().GetInt() == 3);
+
+        std::string values;
+        element.ForEachChild("layer", [&values](SerializerElement & child) {
+            values += gd::ToString(child.GetValue().GetInt());
+        }, "Layer");
+        REQUIRE(values == "0123");
+
+        //Unnamed children are part of arrays.
+        SerializerElement array;
+        array.AddChild("").SetValue(std::string("a"));
+        array.AddChild("").SetValue(std::string("b"));
+        array.ConsiderAsArrayOf("item");
+        REQUIRE(array.GetChildrenCount() == 2);
+        REQUIRE(array.GetChild(1).GetValue().GetString() == "b");
+
+        values.clear();
+        array.ForEachChild("", [&values](SerializerElement & child) {
+            values += child.GetValue().GetString();
+        });
+        REQUIRE(values == "ab");
+    }
+}
+
+namespace
+{
+
+/**
+ * Load a XML file using TinyXML, as done before the streaming parser.
+ */
+SerializerElement LoadWithTinyXml(const std::string & filename)
+{
+    TiXmlDocument doc;
+    doc.LoadFile(filename.c_str());
+
+    SerializerElement element;
+    Serializer::FromXML(element, TiXmlHandle(&doc).FirstChildElement().Element());
+    return element;
+}
+
+void SaveToXMLFile(SerializerElement & element, const std::string & filename)
+{
+    TiXmlDocument doc;
+    doc.LinkEndChild(new TiXmlDeclaration("1.0", "ISO-8859-1", ""));
+    TiXmlElement * root = new TiXmlElement("project");
+    doc.LinkEndChild(root);
+    Serializer::ToXML(element, root);
+    doc.SaveFile(filename.c_str());
+}
+
+void SaveToTextFile(const std::string & content, const std::string & filename)
+{
+    std::ofstream file(filename.c_str(), std::ios::binary);
+    file << content;
+}
+
+/**
+ * Print the time taken by load, and the additional memory used when load returns the memory
+ * used by the process ( while the loaded elements still exist ).
+ */
+void Measure(const std::string & name, std::function<size_t()> load)
+{
+    size_t memoryBefore = SystemStats::GetUsedVirtualMemory();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    size_t memoryAfterLoading = load();
+    long long duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now()-start).count();
+
+    size_t usedMemory = memoryAfterLoading > memoryBefore ? memoryAfterLoading-memoryBefore : 0; //Memory can be released while loading.
+    std::cout << name << ": " << duration << "ms, +" << usedMemory/1024 << "MB once loaded" << std::endl;
+}
+
+}
+
+TEST_CASE( "Serializer streaming parser", "[common]" ) {
+
+    SECTION("XML, compared to TinyXML") {
+        std::string xml = "<?xml version=\"1.0\" encoding=\"ISO-8859-1\" ?>\n<!-- Comment -->\n"
+            "<project a=\"1\" b='x &amp; y &lt;&#65;&#x42;' c=\"  spaces  \">"
+            "<name>  Hello   world \r\n\t again </name><empty/><text>text<child/>ignored</text>"
+            "<comment><!-- c -->ignored</comment><cdata><![CDATA[ raw <x> ]]></cdata><blank>   </blank>"
+            "<unknown>&unknown; &amp;</unknown></project>";
+        SaveToTextFile(xml, "GDCore_tests_parser.xml");
+
+        SerializerElement element;
+        REQUIRE(Serializer::FromXMLFile(element, "GDCore_tests_parser.xml"));
+        REQUIRE(element.GetStringAttribute("b") == "x & y <AB");
+        REQUIRE(element.GetStringAttribute("c") == "  spaces  ");
+        REQUIRE(element.GetChild("name").GetValue().GetString() == "Hello world again");
+        REQUIRE(element.GetChild("cdata").GetValue().GetString() == " raw <x> ");
+        REQUIRE(Serializer::ToJSON(element) == Serializer::ToJSON(LoadWithTinyXml("GDCore_tests_parser.xml")));
+
+        std::remove("GDCore_tests_parser.xml");
+    }
+
+    SECTION("XML errors") {
+        std::string error;
+        SerializerElement element;
+        std::string xml = "<project><a></b></project>";
+        REQUIRE(!Serializer::FromXML(element, xml.c_str(), xml.size(), &error));
+        REQUIRE(!error.empty());
+
+        SerializerElement otherElement;
+        xml = "<project><a>";
+        REQUIRE(!Serializer::FromXML(otherElement, xml.c_str(), xml.size()));
+    }
+
+    SECTION("JSON values") {
+        std::string json = "{\"array\": [1, 2.5, -3e2, true, false, null],\n\t\"unicode\": \"\\u00e9\\ud83d\\ude00\", \"empty\": {}}";
+        SerializerElement element;
+        REQUIRE(Serializer::FromJSON(element, json.c_str(), json.size()));
+
+        SerializerElement & array = element.GetChild("array");
+        array.ConsiderAsArrayOf("value");
+        REQUIRE(array.GetChildrenCount() == 6);
+        REQUIRE(array.GetChild(0).GetValue().GetInt() == 1);
+        REQUIRE(array.GetChild(1).GetValue().GetDouble() == 2.5);
+        REQUIRE(array.GetChild(2).GetValue().GetDouble() == -300);
+        REQUIRE(array.GetChild(3).GetValue().GetBool() == true);
+        REQUIRE(array.GetChild(4).GetValue().GetBool() == false);
+        REQUIRE(array.GetChild(5).IsValueUndefined());
+
+        //Numbers are parsed exactly, including long and subnormal ones.
+        json = "{\"numbers\": [0.1, 3.141592653589793238, 4.9e-324, 2.2250738585072014e-308, 1.7976931348623157e308, 12345678901234567890, 1E400, -1e400]}";
+        SerializerElement numbersElement;
+        REQUIRE(Serializer::FromJSON(numbersElement, json.c_str(), json.size()));
+        SerializerElement & numbers = numbersElement.GetChild("numbers");
+        numbers.ConsiderAsArrayOf("value");
+        REQUIRE(numbers.GetChild(0).GetValue().GetDouble() == 0.1);
+        REQUIRE(numbers.GetChild(1).GetValue().GetDouble() == 3.141592653589793);
+        REQUIRE(numbers.GetChild(2).GetValue().GetDouble() == 4.9e-324);
+        REQUIRE(numbers.GetChild(3).GetValue().GetDouble() == 2.2250738585072014e-308);
+        REQUIRE(numbers.GetChild(4).GetValue().GetDouble() == 1.7976931348623157e308);
+        REQUIRE(numbers.GetChild(5).GetValue().GetDouble() == 12345678901234567890.0);
+        REQUIRE(numbers.GetChild(6).GetValue().GetDouble() == HUGE_VAL);
+        REQUIRE(numbers.GetChild(7).GetValue().GetDouble() == -HUGE_VAL);
+
+        REQUIRE(element.GetChild("unicode").GetValue().GetString() == "\xC3\xA9\xF0\x9F\x98\x80");
+
+        std::string error;
+        SerializerElement invalidElement;
+        json = "{\"ok\": tru}";
+        REQUIRE(!Serializer::FromJSON(invalidElement, json.c_str(), json.size(), &error));
+        REQUIRE(!error.empty());
+    }
+
+    SECTION("Binary snapshot") {
+        SerializerElement element;
+        element.SetAttribute("int", -42);
+        element.SetAttribute("double", 0.1);
+        element.SetAttribute("bool", true);
+        element.SetAttribute("string", "Hello");
+        SerializerElement & array = element.AddChild("array");
+        array.ConsiderAsArrayOf("item");
+        array.AddChild("item").SetValue(std::string("Hello"));
+        array.AddChild("item").SetValue(1234567.0);
+        SerializerValue unknown;
+        unknown.Set("text");
+        element.AddChild("text").SetValue(unknown);
+
+        std::string snapshot = "data";
+        Serializer::ToBinary(element, snapshot);
+        REQUIRE(snapshot.substr(0, 4) == "data");
+        snapshot = snapshot.substr(4)+std::string(16, '\0'); //Padding is ignored.
+        REQUIRE(Serializer::IsBinary(snapshot.c_str(), snapshot.size()));
+
+        SerializerElement readElement;
+        REQUIRE(Serializer::FromBinary(readElement, snapshot.c_str(), snapshot.size()));
+        REQUIRE(Serializer::ToJSON(readElement) == Serializer::ToJSON(element));
+        REQUIRE(readElement.GetAllAttributes().find("int")->second.IsInt());
+        REQUIRE(readElement.GetDoubleAttribute("double") == 0.1);
+        REQUIRE(readElement.GetChild("array").ConsideredAsArrayOf() == "item");
+        REQUIRE(readElement.GetChild("array").GetChild(1).GetValue().IsDouble());
+        REQUIRE(!readElement.GetChild("text").GetValue().IsString());
+
+        std::string error;
+        SerializerElement truncatedElement;
+        REQUIRE(!Serializer::FromBinary(truncatedElement, snapshot.c_str(), snapshot.size()/2, &error));
+        REQUIRE(!error.empty());
+        REQUIRE(!Serializer::IsBinary("<project>", 9));
+    }
+
+    SECTION("Synthetic project") {
+        gd::Project project;
+        GenerateSyntheticProject(project, 5, 50);
+        SerializerElement projectElement;
+        project.SerializeTo(projectElement);
+
+        //XML: same result as TinyXML.
+        SaveToXMLFile(projectElement, "GDCore_tests_synthetic.xml");
+        SerializerElement element;
+        REQUIRE(Serializer::FromXMLFile(element, "GDCore_tests_synthetic.xml"));
+        REQUIRE(Serializer::ToJSON(element) == Serializer::ToJSON(LoadWithTinyXml("GDCore_tests_synthetic.xml")));
+        std::remove("GDCore_tests_synthetic.xml");
+
+        //JSON: the project can be loaded back.
+        SaveToTextFile(Serializer::ToJSON(projectElement), "GDCore_tests_synthetic.json");
+        SerializerElement jsonElement;
+        REQUIRE(Serializer::FromJSONFile(jsonElement, "GDCore_tests_synthetic.json"));
+        std::remove("GDCore_tests_synthetic.json");
+
+        gd::Project loadedProject;
+        loadedProject.UnserializeFrom(jsonElement);
+        REQUIRE(loadedProject.GetLayoutsCount() == 5);
+        REQUIRE(loadedProject.GetLayout(4).GetName() == "Layout 4");
+        REQUIRE(loadedProject.GetLayout(4).GetEvents().size() == 50);
+        REQUIRE(loadedProject.GetLayout(4).GetVariables().Get("Title").GetString() == "\"Level\" 4\n\tand more");
+
+        //Layouts loaded on demand are the same, once accessed.
+        gd::Project lazyProject;
+        lazyProject.SetLoadLayoutsOnDemand(true);
+        lazyProject.UnserializeFrom(jsonElement);
+        REQUIRE(lazyProject.GetLayoutsCount() == 5);
+        REQUIRE(lazyProject.GetLayoutPosition("Layout 4") == 4);
+        REQUIRE(lazyProject.GetLayout(4).GetEvents().size() == 50);
+        REQUIRE(lazyProject.GetLayout(4).GetVariables().Get("Title").GetString() == "\"Level\" 4\n\tand more");
+        gd::Project lazyProjectCopy = lazyProject;
+        REQUIRE(lazyProjectCopy.GetLayout(3).GetEvents().size() == 50);
+
+        //Binary: the snapshot gives back the same elements.
+        std::string snapshot;
+        Serializer::ToBinary(projectElement, snapshot);
+        SerializerElement binaryElement;
+        REQUIRE(Serializer::FromBinary(binaryElement, snapshot.c_str(), snapshot.size()));
+        REQUIRE(Serializer::ToJSON(binaryElement) == Serializer::ToJSON(projectElement));
+    }
+}
+
+/**
+ * Time and memory used to load a big project, with and without the streaming parser.
+ * Hidden by default: run it with GDCore_tests "[benchmark]".
+ */
+TEST_CASE( "Serializer loading benchmark", "[.][benchmark]" ) {
+    {
+        gd::Project project;
+        GenerateSyntheticProject(project, 200, 1000);
+        SerializerElement projectElement;
+        project.SerializeTo(projectElement);
+
+        SaveToXMLFile(projectElement, "GDCore_benchmark.xml");
+        SaveToTextFile(Serializer::ToJSON(projectElement), "GDCore_benchmark.json");
+
+        std::string snapshot;
+        Serializer::ToBinary(projectElement, snapshot);
+        SaveToTextFile(snapshot, "GDCore_benchmark.bin");
+    }
+
+    Measure("XML with TinyXML", []() {
+        TiXmlDocument doc;
+        doc.LoadFile("GDCore_benchmark.xml");
+        SerializerElement element;
+        Serializer::FromXML(element, TiXmlHandle(&doc).FirstChildElement().Element());
+        return SystemStats::GetUsedVirtualMemory();
+    });
+    Measure("XML with the streaming parser", []() {
+        SerializerElement element;
+        Serializer::FromXMLFile(element, "GDCore_benchmark.xml");
+        return SystemStats::GetUsedVirtualMemory();
+    });
+    Measure("JSON read in a string", []() {
+        std::ifstream ifs("GDCore_benchmark.json");
+        std::string str((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+        SerializerElement element = Serializer::FromJSON(str);
+        return SystemStats::GetUsedVirtualMemory();
+    });
+    Measure("JSON with the streaming parser", []() {
+        SerializerElement element;
+        Serializer::FromJSONFile(element, "GDCore_benchmark.json");
+        return SystemStats::GetUsedVirtualMemory();
+    });
+    Measure("JSON writing", []() {
+        SerializerElement element;
+        Serializer::FromJSONFile(element, "GDCore_benchmark.json");
+        std::string json = Serializer::ToJSON(element);
+        return SystemStats::GetUsedVirtualMemory();
+    });
+    Measure("Binary snapshot", []() {
+        SerializerElement element;
+        Serializer::FromBinaryFile(element, "GDCore_benchmark.bin");
+        return SystemStats::GetUsedVirtualMemory();
+    });
+
+    std::remove("GDCore_benchmark.xml");
+    std::remove("GDCore_benchmark.json");
+    std::remove("GDCore_benchmark.bin");
 }
@@ -0,0 +1,81 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2015 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#include "SyntheticProject.h"
+#include "GDCore/CommonTools.h"
+#include "GDCore/PlatformDefinition/Project.h"
+#include "GDCore/PlatformDefinition/Layout.h"
+#include "GDCore/PlatformDefinition/Object.h"
+#include "GDCore/PlatformDefinition/InitialInstance.h"
+#include "GDCore/PlatformDefinition/InitialInstancesContainer.h"
+#include "GDCore/PlatformDefinition/Variable.h"
+#include "GDCore/Events/EventsList.h"
+#include "GDCore/Events/Instruction.h"
+#include "GDCore/Events/Expression.h"
+#include "GDCore/Events/Builtin/StandardEvent.h"
+#include <vector>
+
+namespace
+{
+
+gd::Instruction CreateInstruction(const std::string & type, const std::string & objectName, unsigned int i)
+{
+    std::vector<gd::Expression> parameters;
+    parameters.push_back(gd::Expression(objectName));
+    parameters.push_back(gd::Expression("="));
+    parameters.push_back(gd::Expression(gd::ToString(i)+"+Variable(\"Score & <bonus>\")"));
+
+    return gd::Instruction(type, parameters);
+}
+
+}
+
+void GenerateSyntheticProject(gd::Project & project, unsigned int layoutsCount, unsigned int eventsPerLayout)
+{
+    const unsigned int objectsCount = 20;
+    const unsigned int instancesCount = 200;
+
+    project.SetName("Synthetic project");
+    for (unsigned int l = 0;l<layoutsCount;++l)
+    {
+        gd::Layout & layout = project.InsertNewLayout("Layout "+gd::ToString(l), project.GetLayoutsCount());
+        layout.GetVariables().InsertNew("Score & <bonus>").SetValue(l);
+        layout.GetVariables().InsertNew("Title").SetString("\"Level\" "+gd::ToString(l)+"\n\tand more");
+
+        for (unsigned int o = 0;o<objectsCount;++o)
+        {
+            gd::Object object("Object"+gd::ToString(o));
+            object.SetType("Sprite");
+            object.GetVariables().InsertNew("Life").SetValue(100);
+            layout.InsertObject(object, layout.GetObjectsCount());
+        }
+
+        for (unsigned int i = 0;i<instancesCount;++i)
+        {
+            gd::InitialInstance & instance = layout.GetInitialInstances().InsertNewInitialInstance();
+            instance.SetObjectName("Object"+gd::ToString(i%objectsCount));
+            instance.SetX(i*12.5f);
+            instance.SetY(i*3);
+            instance.SetAngle(i%360);
+        }
+
+        for (unsigned int e = 0;e<eventsPerLayout;++e)
+        {
+            std::string objectName = "Object"+gd::ToString(e%objectsCount);
+
+            gd::StandardEvent event;
+            event.GetConditions().push_back(CreateInstruction("PosX", objectName, e));
+            event.GetActions().push_back(CreateInstruction("MettreX", objectName, e));
+            event.GetActions().push_back(CreateInstruction("ModVarObjet", objectName, e));
+
+            gd::StandardEvent subEvent;
+            subEvent.GetConditions().push_back(CreateInstruction("VarObjet", objectName, e));
+            subEvent.GetActions().push_back(CreateInstruction("Delete", objectName, e));
+            event.GetSubEvents().InsertEvent(subEvent);
+
+            layout.GetEvents().InsertEvent(event);
+        }
+    }
+}
@@ -0,0 +1,21 @@
+/*
+ * GDevelop Core
+ * Copyright 2008-2015 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+/**
+ * @file Generator of big projects, used by tests and benchmarks of operations
+ * on whole projects ( serialization, loading... ).
+ */
+#ifndef GDCORE_TESTS_SYNTHETICPROJECT_H
+#define GDCORE_TESTS_SYNTHETICPROJECT_H
+namespace gd { class Project; }
+
+/**
+ * Fill the project with \a layoutsCount layouts, each containing objects, initial instances,
+ * variables and \a eventsPerLayout events with sub events, conditions and actions.
+ * Names and values contain characters that must be escaped in XML and JSON.
+ */
+void GenerateSyntheticProject(gd::Project & project, unsigned int layoutsCount, unsigned int eventsPerLayout);
+
+#endif
@@ -25,22 +25,11 @@ DestroyOutsideAutomatism::DestroyOutsideAutomatism() :
 void DestroyOutsideAutomatism::DoStepPostEvents(RuntimeScene & scene)
 {
     bool erase = true;
-    const RuntimeLayer & theLayer = scene.GetRuntimeLayer(object->GetLayer());
-    float objCenterX = object->GetDrawableX()+object->GetCenterX();
-    float objCenterY = object->GetDrawableY()+object->GetCenterY();
+    const RuntimeLayer & theLayer = scene.GetRuntimeLayerFromHandle(object->GetLayerHandle(scene));
     for (unsigned int cameraIndex = 0;cameraIndex < theLayer.GetCameraCount();++cameraIndex)
     {
-        const RuntimeCamera & theCamera = theLayer.GetCamera(cameraIndex);
-
-        float boundingCircleRadius = sqrt(object->GetWidth()*object->GetWidth()+object->GetHeight()*object->GetHeight())/2.0;
-        if (   objCenterX+boundingCircleRadius+extraBorder < theCamera.GetViewCenter().x-theCamera.GetWidth()/2.0
-            || objCenterX-boundingCircleRadius-extraBorder > theCamera.GetViewCenter().x+theCamera.GetWidth()/2.0
-            || objCenterY+boundingCircleRadius+extraBorder < theCamera.GetViewCenter().y-theCamera.GetHeight()/2.0
-            || objCenterY-boundingCircleRadius-extraBorder > theCamera.GetViewCenter().y+theCamera.GetHeight()/2.0)
-        {
-            //Ok we are outside the camera area.
-        }
-        else
+        //The objects visible from the camera are searched once for all the objects.
+        if ( scene.IsObjectVisibleFromCamera(*object, cameraIndex, extraBorder) )
         {
             //The object can be viewed by the camera.
             erase = false;
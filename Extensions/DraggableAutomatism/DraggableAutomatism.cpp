@@ -29,15 +29,18 @@ void DraggableAutomatism::DoStepPreEvents(RuntimeScene & scene)
 {
     //Begin drag ?
     if ( !dragged && scene.GetInputManager().IsMouseButtonPressed("Left") &&
-        !leftPressedLastFrame && !somethingDragged )
+        !leftPressedLastFrame && !somethingDragged && scene.renderWindow )
     {
-        RuntimeLayer & theLayer = scene.GetRuntimeLayer(object->GetLayer());
+        RuntimeLayer & theLayer = scene.GetRuntimeLayerFromHandle(object->GetLayerHandle(scene));
         for (unsigned int cameraIndex = 0;cameraIndex < theLayer.GetCameraCount();++cameraIndex)
         {
-            sf::Vector2f mousePos = scene.renderWindow->mapPixelToCoords(
-                scene.GetInputManager().GetMousePosition(), theLayer.GetCamera(cameraIndex).GetSFMLView());
+            //The conversion is cached by the camera, so that it is done once for all the draggable objects.
+            const sf::Vector2f & mousePos = theLayer.GetCamera(cameraIndex).MapPixelToCoords(
+                *scene.renderWindow, scene.GetInputManager().GetMousePosition());
 
-            if ( object->GetDrawableX() <= mousePos.x
+            //The objects under the cursor are searched once for all the draggable objects.
+            if ( scene.IsObjectAtPosition(*object, mousePos.x, mousePos.y)
+                && object->GetDrawableX() <= mousePos.x
                 && object->GetDrawableX() + object->GetWidth() >= mousePos.x
                 && object->GetDrawableY() <= mousePos.y
                 && object->GetDrawableY() + object->GetHeight() >= mousePos.y )
@@ -58,10 +61,10 @@ void DraggableAutomatism::DoStepPreEvents(RuntimeScene & scene)
     }
 
     //Being dragging ?
-    if ( dragged ) {
-        RuntimeLayer & theLayer = scene.GetRuntimeLayer(object->GetLayer());
-        sf::Vector2f mousePos = scene.renderWindow->mapPixelToCoords(
-            scene.GetInputManager().GetMousePosition(), theLayer.GetCamera(dragCameraIndex).GetSFMLView());
+    if ( dragged && scene.renderWindow ) {
+        RuntimeLayer & theLayer = scene.GetRuntimeLayerFromHandle(object->GetLayerHandle(scene));
+        const sf::Vector2f & mousePos = theLayer.GetCamera(dragCameraIndex).MapPixelToCoords(
+            *scene.renderWindow, scene.GetInputManager().GetMousePosition());
 
         object->SetX(mousePos.x-xOffset);
         object->SetY(mousePos.y-yOffset);
@@ -58,7 +58,7 @@ public:
                         return "//Function \""+functionName+"\" not found.\n";
                     }
 
-                    codeGenerator.AddGlobalDeclaration("void "+FunctionEvent::MangleFunctionName(layout, *functionEvent)+"(RuntimeContext *, std::map <std::string, std::vector<RuntimeObject*> *>, std::vector<std::string> &);\n");
+                    codeGenerator.AddGlobalDeclaration("void "+FunctionEvent::MangleFunctionName(project, layout, *functionEvent)+"(RuntimeContext *, std::map <std::string, std::vector<RuntimeObject*> *>, std::vector<std::string> &);\n");
                     std::string code;
 
                     //Generate code for objects passed as arguments
@@ -87,7 +87,7 @@ public:
                         code += "functionParameters.push_back("+parameterCode+");\n";
                     }
 
-                    code += FunctionEvent::MangleFunctionName(layout, *functionEvent)+"(runtimeContext, "+objectsAsArgumentCode+", functionParameters);\n";
+                    code += FunctionEvent::MangleFunctionName(project, layout, *functionEvent)+"(runtimeContext, "+objectsAsArgumentCode+", functionParameters);\n";
                     return code;
                 };
             };
@@ -121,14 +121,15 @@ public:
                                              gd::EventsCodeGenerationContext & /* The function has nothing to do with the current context */)
                 {
                     FunctionEvent & event = dynamic_cast<FunctionEvent&>(event_);
+                    const gd::Project & project = codeGenerator.GetProject();
                     const gd::Layout & layout = codeGenerator.GetLayout();
 
                     //Declaring function prototype.
-                    codeGenerator.AddGlobalDeclaration("void "+FunctionEvent::MangleFunctionName(layout, event)+"(RuntimeContext *, std::map <std::string, std::vector<RuntimeObject*> *>, std::vector<std::string> &);\n");
+                    codeGenerator.AddGlobalDeclaration("void "+FunctionEvent::MangleFunctionName(project, layout, event)+"(RuntimeContext *, std::map <std::string, std::vector<RuntimeObject*> *>, std::vector<std::string> &);\n");
 
                     //Generating function code:
                     std::string functionCode;
-                    functionCode += "\nvoid "+FunctionEvent::MangleFunctionName(layout, event)+"(RuntimeContext * runtimeContext, std::map <std::string, std::vector<RuntimeObject*> *> objectsListsMap, std::vector<std::string> & currentFunctionParameters)\n{\n";
+                    functionCode += "\nvoid "+FunctionEvent::MangleFunctionName(project, layout, event)+"(RuntimeContext * runtimeContext, std::map <std::string, std::vector<RuntimeObject*> *> objectsListsMap, std::vector<std::string> & currentFunctionParameters)\n{\n";
 
                     gd::EventsCodeGenerationContext callerContext;
                     {
@@ -173,19 +173,61 @@ const FunctionEvent* FunctionEvent::SearchForFunctionInEvents(const gd::Project
     return NULL;
 }
 
-std::string FunctionEvent::MangleFunctionName(const gd::Layout & layout, const FunctionEvent & functionEvent)
+namespace
 {
-    //To generate a "unique" name for the function, the name is mangled and suffixed with the
-    //pointer to the (original) event of the function.
-    const gd::BaseEvent * ptr = &functionEvent;
+
+/**
+ * Search for a function event in events ( as FunctionEvent::SearchForFunctionInEvents does ),
+ * counting the function events with the same name which are before it.
+ * \return true if the function event was found.
+ */
+bool CountHomonymousFunctionsBefore(const gd::Project & project, const gd::EventsList & events,
+    const gd::BaseEvent * function, const std::string & functionName, unsigned int & count)
+{
+    for (unsigned int i = 0;i<events.size();++i)
+    {
+        const FunctionEvent * functionEvent = dynamic_cast<const FunctionEvent*>(&events[i]);
+        const gd::LinkEvent * linkEvent = dynamic_cast<const gd::LinkEvent*>(&events[i]);
+        if (functionEvent)
+        {
+            if ( functionEvent == function ) return true;
+            if ( functionEvent->GetName() == functionName ) ++count;
+        }
+        else if (linkEvent && linkEvent->GetLinkedEvents(project))
+        {
+            if ( CountHomonymousFunctionsBefore(project, *linkEvent->GetLinkedEvents(project), function, functionName, count) )
+                return true;
+        }
+        else if ( events[i].CanHaveSubEvents() )
+        {
+            if ( CountHomonymousFunctionsBefore(project, events[i].GetSubEvents(), function, functionName, count) )
+                return true;
+        }
+    }
+
+    return false;
+}
+
+}
+
+std::string FunctionEvent::MangleFunctionName(const gd::Project & project, const gd::Layout & layout, const FunctionEvent & functionEvent)
+{
+    //The name must not depend on the address of the event, so that the same events always give the
+    //same code. Functions with the same name are distinguished by their position in the layout events
+    //( the first one being the one called by "Launch a function" ).
+    const gd::BaseEvent * function = &functionEvent;
     std::shared_ptr<gd::BaseEvent> originalEvent = functionEvent.originalEvent.lock();
     if (originalEvent != std::shared_ptr<gd::BaseEvent>()) {
-        ptr = originalEvent.get();
+        function = originalEvent.get();
     }
 
+    unsigned int homonymsCount = 0;
+    if ( !CountHomonymousFunctionsBefore(project, layout.GetEvents(), function, functionEvent.GetName(), homonymsCount) )
+        homonymsCount = 0;
+
     return "GDFunction"+layout.GetMangledName()
         +gd::SceneNameMangler::GetMangledSceneName(functionEvent.GetName())
-        +ToString(ptr);
+        +(homonymsCount != 0 ? "_"+ToString(homonymsCount) : "");
 };
 
 #endif
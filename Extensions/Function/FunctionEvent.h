@@ -77,8 +77,11 @@ public:
     /**
      * \brief Tool function to generate an unique C++ name for a function used
      * inside a layout.
+     *
+     * The name only depends on the name of the layout, the name of the function and, if other functions
+     * with the same name are before it in the layout events, on their number.
      */
-    static std::string MangleFunctionName(const gd::Layout & layout, const FunctionEvent & functionEvent);
+    static std::string MangleFunctionName(const gd::Project & project, const gd::Layout & layout, const FunctionEvent & functionEvent);
 
     /**
      * \brief Tool function to search for a function event in an event list.
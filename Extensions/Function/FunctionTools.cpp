@@ -5,7 +5,6 @@ Copyright (c) 2008-2015 Florian Rival (Florian.Rival@gmail.com)
 This project is released under the MIT License.
 */
 #include "FunctionTools.h"
-#include "GDCpp/profile.h"
 
 namespace GDpriv
 {
@@ -22,15 +22,10 @@ Directional_light::~Directional_light()
 
 void Directional_light::Generate(std::vector<Wall*> &m_wall)
 {
-    shapes.clear();
-
     float angle     = m_angle * M_PI / 180;
     float o_angle   = m_opening_angle * M_PI / 180;
 
-    AddTriangle(sf::Vector2f((m_radius*cos(angle + o_angle * 0.5))
-                            ,(m_radius*sin(angle + o_angle * 0.5))) ,
-                sf::Vector2f((m_radius*cos(angle - o_angle * 0.5))
-                            ,(m_radius*sin(angle - o_angle * 0.5))),0,m_wall);
+    GenerateSector(m_wall, angle - o_angle * 0.5, angle + o_angle * 0.5);
 }
 
 void Directional_light::SetAngle(float angle)
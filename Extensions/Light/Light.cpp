@@ -1,5 +1,6 @@
 #include <iostream>
 #include <cmath>
+#include <algorithm>
 #include <SFML/Graphics.hpp>
 #include "Light.h"
 
@@ -28,157 +29,102 @@ void Light::Draw(sf::RenderTarget *App)
     App->draw(shapes, sf::BlendAdd);
 }
 
-sf::Vector2f Intersect(sf::Vector2f p1, sf::Vector2f p2, sf::Vector2f q1, sf::Vector2f q2)
+namespace
 {
-    sf::Vector2f i;
 
-    if((p2.x - p1.x) == 0 && (q2.x - q1.x) == 0)
-        i.x = 0, i.y = 0;
-    else if((p2.x - p1.x) == 0)
-    {
-        i.x = p1.x;
-
-        float c = (q2.y - q1.y) / (q2.x - q1.x);
-        float d = q1.y - q1.x * c;
-
-        i.y = c * i.x + d;
-    }
-
-    else if((q2.x - q1.x) == 0)
-    {
-        i.x = q1.x;
-
-        float a = (p2.y - p1.y) / (p2.x - p1.x);
-        float b = p1.y - p1.x * a;
-
-        i.y = a * i.x + b;
-    }
-    else
-    {
-        float a = (p2.y - p1.y) / (p2.x - p1.x);
-        float b = p1.y - p1.x * a;
+/**
+ * Return the distance, along the ray starting at origin and going in direction,
+ * to the wall (or a negative number if the ray does not hit the wall).
+ */
+float RayToWallDistance(sf::Vector2f origin, sf::Vector2f direction, const Wall & wall)
+{
+    sf::Vector2f edge = wall.pt2 - wall.pt1;
+    float denominator = direction.x * edge.y - direction.y * edge.x;
+    if ( std::fabs(denominator) < 1e-9 ) return -1; //Parallel to the wall
 
-        float c = (q2.y - q1.y) / (q2.x - q1.x);
-        float d = q1.y - q1.x * c;
+    sf::Vector2f w = wall.pt1 - origin;
+    float t = (w.x * edge.y - w.y * edge.x) / denominator;
+    float s = (w.x * direction.y - w.y * direction.x) / denominator;
 
-        i.x = (d-b)/(a-c);
-        i.y = a * i.x + b;
-    }
+    return (s >= 0 && s <= 1) ? t : -1;
+}
 
-    return i;
 }
 
-sf::Vector2f Collision(sf::Vector2f p1, sf::Vector2f p2, sf::Vector2f q1, sf::Vector2f q2)
+sf::Color Light::GetColorAt(sf::Vector2f point) const
 {
-    sf::Vector2f i;
-    i = Intersect(p1, p2, q1, q2);
-
-    if(((i.x >= p1.x - 0.1 && i.x <= p2.x + 0.1)
-        || (i.x >= p2.x - 0.1 && i.x <= p1.x + 0.1))
-    && ((i.x >= q1.x - 0.1 && i.x <= q2.x + 0.1)
-        || (i.x >= q2.x - 0.1 && i.x <= q1.x + 0.1))
-    && ((i.y >= p1.y - 0.1 && i.y <= p2.y + 0.1)
-        || (i.y >= p2.y - 0.1 && i.y <= p1.y + 0.1))
-    && ((i.y >= q1.y - 0.1 && i.y <= q2.y + 0.1)
-        || (i.y >= q2.y - 0.1 && i.y <= q1.y + 0.1)))
-        return i;
-    else
-        return sf::Vector2f (0,0);
+    //The intensity decreases with the distance to the center of the light
+    float intensity = m_radius > 0 ? m_intensity-sqrt(point.x*point.x + point.y*point.y)*m_intensity/m_radius : 0;
+    if ( intensity < 0 ) intensity = 0;
+
+    return sf::Color((int)(intensity*m_color.r/255),
+                     (int)(intensity*m_color.g/255),
+                     (int)(intensity*m_color.b/255));
 }
 
-void Light::AddTriangle(sf::Vector2f pt1,sf::Vector2f pt2, int minimum_wall,std::vector <Wall*> &m_wall)
+void Light::GenerateSector(const std::vector <Wall*> &m_wall, float startAngle, float endAngle)
 {
-    int w = minimum_wall;
-    // On boucle sur tous les murs
-    for(std::vector<Wall*>::iterator IterWall=m_wall.begin()+minimum_wall;IterWall!=m_wall.end();++IterWall,++w)
-    {
-        // l1 et l2 sont les positions relatives au centre de la lumire des deux extrmits du mur
-        sf::Vector2f l1((*IterWall)->pt1.x-m_position.x, (*IterWall)->pt1.y-m_position.y);
-        sf::Vector2f l2((*IterWall)->pt2.x-m_position.x, (*IterWall)->pt2.y-m_position.y);
+    shapes.clear();
 
-        //Discard walls that are too far.
-        if( (l1.x * l1.x + l1.y * l1.y + l2.x * l2.x + l2.y * l2.y)/2 > (m_radius * m_radius)*1.5)
-            continue;
+    if ( m_radius <= 0 || endAngle <= startAngle ) return;
 
-        if(l1.x * l1.x + l1.y * l1.y < m_radius * m_radius)
-        {
-            sf::Vector2f i = Intersect(pt1,pt2,sf::Vector2f (0,0),l1);
-
-            if (pt1 != i && pt2 != i)
-            if((pt1.x >= i.x && pt2.x <= i.x) || (pt1.x <= i.x && pt2.x >= i.x))
-            if((pt1.y >= i.y && pt2.y <= i.y) || (pt1.y <= i.y && pt2.y >= i.y))
-                if(l1.y > 0 && i.y > 0 || l1.y < 0 && i.y < 0)
-                if(l1.x > 0 && i.x > 0 || l1.x < 0 && i.x < 0)
-                AddTriangle(i, pt2, w, m_wall), pt2 = i;
-        }
-        if(l2.x * l2.x + l2.y * l2.y < m_radius * m_radius)
+    std::vector<float> angles;
+
+    //Rays along the circle of the light: the quality is the number of triangles for a full circle.
+    const float sector = endAngle - startAngle;
+    const int arcSteps = std::max(1, (int)std::ceil(m_quality * sector / (M_PI*2) - 0.01));
+    for (int i = 0;i<=arcSteps;++i)
+        angles.push_back(startAngle + sector * i / arcSteps);
+
+    //Rays towards the extremities of the walls, and slightly on each side so as to go past them.
+    const float epsilon = 0.0001f;
+    for (std::size_t i = 0;i<m_wall.size();++i)
+    {
+        const sf::Vector2f extremities[2] = {m_wall[i]->pt1 - m_position, m_wall[i]->pt2 - m_position};
+        for (int e = 0;e<2;++e)
         {
-            sf::Vector2f i = Intersect(pt1,pt2,sf::Vector2f (0,0),l2);
-
-            if (pt1 != i && pt2 != i)
-            if((pt1.x >= i.x && pt2.x <= i.x) || (pt1.x <= i.x && pt2.x >= i.x))
-            if((pt1.y >= i.y && pt2.y <= i.y) || (pt1.y <= i.y && pt2.y >= i.y))
-                if(l2.y > 0 && i.y > 0 || l2.y < 0 && i.y < 0)
-                if(l2.x > 0 && i.x > 0 || l2.x < 0 && i.x < 0)
-                AddTriangle(pt1, i, w, m_wall), pt1 = i;
+            const sf::Vector2f & l = extremities[e];
+            if ( l.x * l.x + l.y * l.y >= m_radius * m_radius ) continue;
+
+            float wallAngle = atan2(l.y, l.x);
+            for (int side = -1;side<=1;++side)
+            {
+                float angle = wallAngle + side * epsilon;
+                while ( angle < startAngle ) angle += M_PI*2;
+                while ( angle >= startAngle + M_PI*2 ) angle -= M_PI*2;
+
+                if ( angle <= endAngle ) angles.push_back(angle);
+            }
         }
+    }
 
-        sf::Vector2f m = Collision(l1, l2, sf::Vector2f(0,0), pt1);
-        sf::Vector2f n = Collision(l1, l2, sf::Vector2f(0,0), pt2);
-        sf::Vector2f o = Collision(l1, l2, pt1, pt2);
+    std::sort(angles.begin(), angles.end());
 
-        if((m.x != 0 || m.y != 0) && (n.x != 0 || n.y != 0))
-            pt1 = m, pt2 = n;
-        else
+    //Cast all the rays, sorted by angle, and add a triangle between each consecutive points
+    sf::Color centerColor = GetColorAt(sf::Vector2f(0,0));
+    sf::Vector2f previousPoint;
+    for (std::size_t i = 0;i<angles.size();++i)
+    {
+        sf::Vector2f direction(cos(angles[i]), sin(angles[i]));
+        float distance = m_radius;
+        for (std::size_t w = 0;w<m_wall.size();++w)
         {
-            if((m.x != 0 || m.y != 0) && (o.x != 0 || o.y != 0))
-                AddTriangle(m ,o , w, m_wall), pt1 = o;
+            float wallDistance = RayToWallDistance(m_position, direction, *m_wall[w]);
+            if ( wallDistance >= 0 && wallDistance < distance ) distance = wallDistance;
+        }
 
-            if((n.x != 0 || n.y != 0) && (o.x != 0 || o.y != 0))
-                AddTriangle(o ,n , w, m_wall), pt2 = o;
+        sf::Vector2f point = direction * distance;
+        if ( i != 0 )
+        {
+            shapes.append(sf::Vertex(m_position, centerColor));
+            shapes.append(sf::Vertex(previousPoint + m_position, GetColorAt(previousPoint)));
+            shapes.append(sf::Vertex(point + m_position, GetColorAt(point)));
         }
+        previousPoint = point;
     }
-
-    // Variable qui contiendra l'intensit calcule, pour le dgrad
-    float intensity;
-
-    // On ajoute un shape
-    // On lui donne comme point de dpart (0,0), le centre de la lumire, avec la couleur et intensit maximal
-    shapes.append(sf::Vertex(m_position, sf::Color((int)(m_intensity*m_color.r/255),
-                                                   (int)(m_intensity*m_color.g/255),
-                                                   (int)(m_intensity*m_color.b/255))));
-
-    // On calcul ou l'on se trouve par rapport au centre, pour savoir  quel intensit on est
-    intensity=m_intensity-sqrt(pt1.x*pt1.x + pt1.y*pt1.y)*m_intensity/m_radius;
-    // Et on ajoute un  point au shape
-    shapes.append(sf::Vertex(sf::Vector2f(pt1.x,pt1.y)+m_position,
-                             sf::Color((int)(intensity*m_color.r/255),
-                                       (int)(intensity*m_color.g/255),
-                                       (int)(intensity*m_color.b/255))));
-
-    // Idem
-    intensity=m_intensity-sqrt(pt2.x*pt2.x + pt2.y*pt2.y)*m_intensity/m_radius;
-    shapes.append(sf::Vertex(sf::Vector2f(pt2.x,pt2.y)+m_position,
-                             sf::Color((int)(intensity*m_color.r/255),
-                                       (int)(intensity*m_color.g/255),
-                                       (int)(intensity*m_color.b/255))));
 }
 
 void Light::Generate(std::vector <Wall*> &m_wall)
 {
-    // On vide la mmoire
-    shapes.clear();
-
-    // buf est l'angle de chaque triangle, c'est donc 2pi divis par le nombre de triangles
-    float buf=(M_PI*2)/(float)m_quality;
-
-    // On ajoute tous les triangles qui composent la lumire
-    for(int i=0;i<m_quality;i++)
-    {
-        AddTriangle(sf::Vector2f((float)((float)m_radius*cos((float)i*buf))
-                                ,(float)((float)m_radius*sin((float)i*buf))) ,
-                    sf::Vector2f((float)((float)m_radius*cos((float)(i+1)*buf))
-                                ,(float)((float)m_radius*sin((float)(i+1)*buf))),0,m_wall);
-    }
+    GenerateSector(m_wall, 0, M_PI*2);
 }
-
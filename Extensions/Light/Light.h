@@ -14,11 +14,15 @@ namespace sf
 class Wall
 {
 public:
-    Wall (sf::Vector2f p1,sf::Vector2f p2) : pt1(p1), pt2(p2) {}
+    Wall (sf::Vector2f p1,sf::Vector2f p2) : pt1(p1), pt2(p2), index(0), cellsMinX(0), cellsMinY(0), cellsMaxX(-1), cellsMaxY(-1) {}
     bool operator==(const Wall& other) { return ( pt1 == other.pt1 && pt2 == other.pt2 ); }
 
     sf::Vector2f pt1;
     sf::Vector2f pt2;
+
+    //Members used by Light_Manager to index the wall:
+    std::size_t index; ///< Position of the wall in Light_Manager::walls
+    int cellsMinX, cellsMinY, cellsMaxX, cellsMaxY; ///< The cells of the Light_Manager grid containing the wall
 };
 
 class GD_EXTENSION_API Light
@@ -33,12 +37,12 @@ class GD_EXTENSION_API Light
     // Afficher la lumire
     void Draw(sf::RenderTarget *App);
 
-    // Calculer la lumire
+    /**
+     * Compute the visibility polygon of the light.
+     * \param m_wall The walls that can block the light (walls far from the light can be omitted).
+     */
     virtual void Generate(std::vector <Wall*> &m_wall);
 
-    // Ajouter un triangle  la lumire, en effet, les lumires sont compose de triangles
-    void AddTriangle(sf::Vector2f pt1,sf::Vector2f pt2, int minimum_wall,std::vector <Wall*> &m_wall);
-
     // Changer diffrents attributs de la lumire
     void SetIntensity(float intensity) { m_intensity=intensity; };
     void SetRadius(float radius) { m_radius=radius; };
@@ -71,8 +75,22 @@ class GD_EXTENSION_API Light
     sf::VertexArray shapes; ///< The vertices composing the light
     //std::vector <sf::Vertex> m_shape;
 
+    /**
+     * Compute the part of the visibility polygon between startAngle and endAngle (in radians).
+     *
+     * Rays are cast from the light towards the extremities of the walls (and on each side of them)
+     * and along the circle of the light, sorted by angle. The triangles between consecutive rays
+     * form the lighted area.
+     */
+    void GenerateSector(const std::vector <Wall*> &m_wall, float startAngle, float endAngle);
+
     private :
 
+    /**
+     * Return the color of the light at the given position (relative to the light center).
+     */
+    sf::Color GetColorAt(sf::Vector2f point) const;
+
     //Qualit de la lumire, c'est  dire le nombre de triangles par dfaut qui la compose.
     int m_quality;
 };
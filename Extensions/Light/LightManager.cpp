@@ -1,15 +1,259 @@
 #include <iostream>
+#include <algorithm>
+#include <memory>
+#include <cmath>
 #include "LightManager.h"
+#include "LightObject.h"
+#include "Light.h"
+
+const float Light_Manager::cellSize = 128;
+const std::size_t Light_Manager::workersCount = 3;
+const std::size_t Light_Manager::lightsPerBatch = 4;
 
 Light_Manager::Light_Manager() :
-    commonBlurEffectLoaded(false)
+    commonBlurEffectLoaded(false),
+    changesCount(0),
+    nextLightToGenerate(0),
+    generatedLightsCount(0),
+    lightsToGenerateCount(0),
+    stopWorkers(false)
 {
     std::cout << "Creating Light Manager";
 }
 Light_Manager::~Light_Manager()
 {
     std::cout << "Destroying Light Manager";
+
+    if ( !workers.empty() )
+    {
+        {
+            sf::Lock lock(workMutex);
+            stopWorkers = true;
+        }
+        idleWorkersMutex.unlock(); //Wake up the workers so that they stop.
+        for (std::size_t i = 0;i<workers.size();++i)
+            workers[i]->wait();
+    }
+}
+
+int Light_Manager::GetCellCoordinate(float position)
+{
+    return static_cast<int>(std::floor(position / cellSize));
+}
+
+void Light_Manager::InsertInCells(Wall * wall)
+{
+    changesCount++;
+
+    wall->cellsMinX = GetCellCoordinate(std::min(wall->pt1.x, wall->pt2.x));
+    wall->cellsMaxX = GetCellCoordinate(std::max(wall->pt1.x, wall->pt2.x));
+    wall->cellsMinY = GetCellCoordinate(std::min(wall->pt1.y, wall->pt2.y));
+    wall->cellsMaxY = GetCellCoordinate(std::max(wall->pt1.y, wall->pt2.y));
+
+    for (int x = wall->cellsMinX;x<=wall->cellsMaxX;++x)
+    {
+        for (int y = wall->cellsMinY;y<=wall->cellsMaxY;++y)
+        {
+            Cell & cell = cells[GetCellKey(x, y)];
+            cell.walls.push_back(wall);
+            cell.lastChange = changesCount;
+        }
+    }
+}
+
+void Light_Manager::RemoveFromCells(Wall * wall)
+{
+    changesCount++;
+
+    for (int x = wall->cellsMinX;x<=wall->cellsMaxX;++x)
+    {
+        for (int y = wall->cellsMinY;y<=wall->cellsMaxY;++y)
+        {
+            //Empty cells are kept to remember their last change.
+            Cell & cell = cells[GetCellKey(x, y)];
+            std::vector<Wall*>::iterator it = std::find(cell.walls.begin(), cell.walls.end(), wall);
+            if ( it != cell.walls.end() )
+            {
+                *it = cell.walls.back();
+                cell.walls.pop_back();
+            }
+            cell.lastChange = changesCount;
+        }
+    }
+
+    wall->cellsMaxX = wall->cellsMinX-1;
+    wall->cellsMaxY = wall->cellsMinY-1;
+}
+
+void Light_Manager::AddWall(Wall * wall)
+{
+    wall->index = walls.size();
+    walls.push_back(wall);
+    InsertInCells(wall);
+}
+
+void Light_Manager::UpdateWall(Wall * wall)
+{
+    RemoveFromCells(wall);
+    InsertInCells(wall);
+}
+
+void Light_Manager::RemoveWall(Wall * wall)
+{
+    if ( wall->index >= walls.size() || walls[wall->index] != wall ) return;
+
+    RemoveFromCells(wall);
+
+    //Swap with the last wall to remove it in constant time
+    walls[wall->index] = walls.back();
+    walls[wall->index]->index = wall->index;
+    walls.pop_back();
+}
+
+void Light_Manager::GetWallsNear(sf::Vector2f position, float radius, std::vector<Wall*> & result) const
+{
+    result.clear();
+
+    const int minX = GetCellCoordinate(position.x - radius), maxX = GetCellCoordinate(position.x + radius);
+    const int minY = GetCellCoordinate(position.y - radius), maxY = GetCellCoordinate(position.y + radius);
+    for (int x = minX;x<=maxX;++x)
+    {
+        for (int y = minY;y<=maxY;++y)
+        {
+            std::unordered_map<unsigned long long, Cell>::const_iterator it = cells.find(GetCellKey(x, y));
+            if ( it != cells.end() )
+                result.insert(result.end(), it->second.walls.begin(), it->second.walls.end());
+        }
+    }
+
+    //A wall can be in several cells
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+}
+
+unsigned int Light_Manager::GetLastChangeNear(sf::Vector2f position, float radius) const
+{
+    unsigned int lastChange = 0;
+
+    const int minX = GetCellCoordinate(position.x - radius), maxX = GetCellCoordinate(position.x + radius);
+    const int minY = GetCellCoordinate(position.y - radius), maxY = GetCellCoordinate(position.y + radius);
+    for (int x = minX;x<=maxX;++x)
+    {
+        for (int y = minY;y<=maxY;++y)
+        {
+            std::unordered_map<unsigned long long, Cell>::const_iterator it = cells.find(GetCellKey(x, y));
+            if ( it != cells.end() && it->second.lastChange > lastChange )
+                lastChange = it->second.lastChange;
+        }
+    }
+
+    return lastChange;
 }
 
+void Light_Manager::AddLight(RuntimeLightObject * light)
+{
+    lights.push_back(light);
+}
+
+void Light_Manager::RemoveLight(RuntimeLightObject * light)
+{
+    std::vector<RuntimeLightObject*>::iterator it = std::find(lights.begin(), lights.end(), light);
+    if ( it != lights.end() )
+    {
+        *it = lights.back();
+        lights.pop_back();
+    }
+}
+
+void Light_Manager::GenerateLights()
+{
+    //No batch can be taken by the workers while the list is changed, as all the lights of
+    //the previous call were taken ( nextLightToGenerate >= lightsToGenerateCount ).
+    lightsToGenerate.clear();
+    for (std::size_t i = 0;i<lights.size();++i)
+    {
+        if ( !lights[i]->IsHidden() && lights[i]->NeedGeneration() )
+            lightsToGenerate.push_back(lights[i]);
+    }
+
+    if ( lightsToGenerate.empty() ) return;
 
+    //Generating a light only reads the walls and modifies the light itself:
+    //the lights can be split between threads.
+    if ( lightsToGenerate.size() > lightsPerBatch && workers.empty() )
+    {
+        idleWorkersMutex.lock();
+        for (std::size_t i = 0;i<workersCount;++i)
+        {
+            workers.push_back(std::unique_ptr<sf::Thread>(new sf::Thread(&Light_Manager::WorkerLoop, this)));
+            workers.back()->launch();
+        }
+    }
 
+    {
+        sf::Lock lock(workMutex);
+        nextLightToGenerate = 0;
+        generatedLightsCount = 0;
+        lightsToGenerateCount = lightsToGenerate.size();
+    }
+
+    //The current thread generates lights too, so that it does not wait for the workers to wake up.
+    if ( !workers.empty() ) idleWorkersMutex.unlock();
+    GenerateLightsBatches();
+
+    //Wait for the batches taken by the workers.
+    while (true)
+    {
+        {
+            sf::Lock lock(workMutex);
+            if ( generatedLightsCount == lightsToGenerateCount ) break;
+        }
+        sf::sleep(sf::Time::Zero);
+    }
+    if ( !workers.empty() ) idleWorkersMutex.lock();
+}
+
+bool Light_Manager::GenerateLightsBatches()
+{
+    bool generatedLights = false;
+    while (true)
+    {
+        std::size_t begin = 0, end = 0;
+        {
+            sf::Lock lock(workMutex);
+            if ( nextLightToGenerate >= lightsToGenerateCount ) return generatedLights;
+
+            begin = nextLightToGenerate;
+            end = std::min(begin + lightsPerBatch, lightsToGenerateCount);
+            nextLightToGenerate = end;
+        }
+
+        for (std::size_t i = begin;i<end;++i)
+            lightsToGenerate[i]->GenerateLight();
+
+        {
+            sf::Lock lock(workMutex);
+            generatedLightsCount += end - begin;
+        }
+        generatedLights = true;
+    }
+}
+
+void Light_Manager::WorkerLoop()
+{
+    while (true)
+    {
+        //Block until GenerateLights has lights to generate.
+        {
+            sf::Lock idleLock(idleWorkersMutex);
+        }
+
+        {
+            sf::Lock lock(workMutex);
+            if ( stopWorkers ) return;
+        }
+
+        if ( !GenerateLightsBatches() )
+            sf::sleep(sf::Time::Zero); //The last batches are being generated by other threads.
+    }
+}
@@ -1,20 +1,125 @@
 #ifndef LIGHTMANAGERH
 #define LIGHTMANAGERH
 #include <vector>
+#include <memory>
+#include <unordered_map>
 #include <SFML/Graphics.hpp>
+#include <SFML/System.hpp>
 class Wall;
+class RuntimeLightObject;
 
+/**
+ * \brief Store the walls (light obstacles) and the lights of a scene.
+ *
+ * Walls are indexed in a grid so that lights only consider the walls near them.
+ * Each cell of the grid remembers when a wall inside it was last changed, so that
+ * lights are generated again only if a wall in their radius has changed.
+ */
 class Light_Manager
 {
 public :
-    std::vector <Wall*> walls; ///< Objects with light obstacle automatism have to insert their into this vector
+    std::vector <Wall*> walls; ///< All the walls. Use AddWall/UpdateWall/RemoveWall to modify them.
 
     bool commonBlurEffectLoaded;
     sf::Shader commonBlurEffect;
 
     Light_Manager();
     ~Light_Manager();
+
+    /**
+     * \brief Add a wall to the manager. The wall is not owned by the manager.
+     */
+    void AddWall(Wall * wall);
+
+    /**
+     * \brief Must be called after the points of a wall added to the manager were changed.
+     */
+    void UpdateWall(Wall * wall);
+
+    /**
+     * \brief Remove a wall from the manager.
+     */
+    void RemoveWall(Wall * wall);
+
+    /**
+     * \brief Fill result with the walls that can be at a distance less than radius from position.
+     */
+    void GetWallsNear(sf::Vector2f position, float radius, std::vector<Wall*> & result) const;
+
+    /**
+     * \brief Return the number of changes made to the walls when a wall near the position was changed for the last time.
+     * \see GetChangesCount
+     */
+    unsigned int GetLastChangeNear(sf::Vector2f position, float radius) const;
+
+    /**
+     * \brief Return the number of changes (wall added, moved or removed) made since the creation of the manager.
+     */
+    unsigned int GetChangesCount() const { return changesCount; };
+
+    /**
+     * \brief Register a light, so that it is generated by GenerateLights.
+     */
+    void AddLight(RuntimeLightObject * light);
+
+    /**
+     * \brief Unregister a light.
+     */
+    void RemoveLight(RuntimeLightObject * light);
+
+    /**
+     * \brief Generate all the visible lights needing to be updated.
+     *
+     * Lights are generated in parallel by the current thread and worker threads, which are
+     * created the first time there are enough lights to generate.
+     *
+     * \warning Must always be called from the thread destroying the Light_Manager.
+     */
+    void GenerateLights();
+
+private:
+    struct Cell
+    {
+        Cell() : lastChange(0) {};
+
+        std::vector<Wall*> walls;
+        unsigned int lastChange; ///< Value of changesCount when a wall of the cell was changed for the last time.
+    };
+
+    static unsigned long long GetCellKey(int x, int y) { return (static_cast<unsigned long long>(static_cast<unsigned int>(x)) << 32) | static_cast<unsigned int>(y); };
+    static int GetCellCoordinate(float position);
+
+    void InsertInCells(Wall * wall);
+    void RemoveFromCells(Wall * wall);
+
+    /**
+     * \brief Generate the lights of lightsToGenerate not taken by another thread, by batches.
+     * \return true if at least one light was generated.
+     */
+    bool GenerateLightsBatches();
+
+    /**
+     * \brief The function run by the worker threads.
+     */
+    void WorkerLoop();
+
+    std::unordered_map<unsigned long long, Cell> cells;
+    unsigned int changesCount;
+
+    std::vector<RuntimeLightObject*> lights;
+    std::vector<RuntimeLightObject*> lightsToGenerate; ///< Used by GenerateLights (stored here to avoid reallocations).
+
+    std::vector< std::unique_ptr<sf::Thread> > workers;
+    sf::Mutex idleWorkersMutex; ///< Locked by the thread calling GenerateLights while there are no lights to generate, so that the workers wait without using the CPU.
+    sf::Mutex workMutex; ///< Protects the members below, shared with the workers.
+    std::size_t nextLightToGenerate; ///< The index in lightsToGenerate of the next light to be taken by a thread.
+    std::size_t generatedLightsCount;
+    std::size_t lightsToGenerateCount;
+    bool stopWorkers;
+
+    static const float cellSize;
+    static const std::size_t workersCount;
+    static const std::size_t lightsPerBatch;
 };
 #endif
 
-
@@ -89,7 +89,9 @@ void LightObject::DoSerializeTo(gd::SerializerElement & element) const
 
 RuntimeLightObject::RuntimeLightObject(RuntimeScene & scene, const gd::Object & object) :
     RuntimeObject(scene, object),
-    angle(0)
+    angle(0),
+    needGeneration(true),
+    lastGenerationChange(0)
 {
     const LightObject & lightObject = static_cast<const LightObject&>(object);
 
@@ -116,9 +118,46 @@ RuntimeLightObject::RuntimeLightObject(RuntimeScene & scene, const gd::Object &
         manager->commonBlurEffectLoaded = true;
     }
 
+    manager->AddLight(this);
     UpdateGlobalLightMembers();
 }
 
+RuntimeLightObject::~RuntimeLightObject()
+{
+    if ( manager ) manager->RemoveLight(this);
+}
+
+void RuntimeLightObject::Init(const RuntimeLightObject & other)
+{
+    if ( manager ) manager->RemoveLight(this);
+
+    angle = other.angle;
+    manager = other.manager;
+    light = other.light;
+    globalLight = other.globalLight;
+    globalLightImage = other.globalLightImage;
+    globalLightColor = other.globalLightColor;
+    needGeneration = true;
+    lastGenerationChange = 0;
+
+    if ( manager ) manager->AddLight(this);
+}
+
+bool RuntimeLightObject::NeedGeneration() const
+{
+    return needGeneration || (manager && manager->GetLastChangeNear(light.GetPosition(), light.GetRadius()) > lastGenerationChange);
+}
+
+void RuntimeLightObject::GenerateLight()
+{
+    if ( !manager ) return;
+
+    lastGenerationChange = manager->GetChangesCount();
+    manager->GetWallsNear(light.GetPosition(), light.GetRadius(), wallsNearLight);
+    light.Generate(wallsNearLight);
+    needGeneration = false;
+}
+
 void RuntimeLightObject::UpdateGlobalLightMembers()
 {
     if ( globalLight )
@@ -144,11 +183,8 @@ bool RuntimeLightObject::Draw( sf::RenderTarget& window )
 
     if ( !manager ) return false;
 
-    if ( updateClock.getElapsedTime().asMilliseconds() > 25 )
-    {
-        light.Generate(manager->walls);
-        updateClock.restart(); //Update each 25 milliseconds
-    }
+    //Generate all the lights needing it at once, so that it's done in parallel.
+    if ( NeedGeneration() ) manager->GenerateLights();
 
     if ( globalLight )
     {
@@ -272,6 +308,7 @@ unsigned int RuntimeLightObject::GetNumberOfProperties() const
 void RuntimeLightObject::OnPositionChanged()
 {
     light.SetPosition(sf::Vector2f(GetX(),GetY()));
+    needGeneration = true;
 }
 
 void RuntimeLightObject::SetColor(const std::string & colorStr)
@@ -13,7 +13,6 @@ This project is released under the MIT License.
 
 #include <memory>
 #include <SFML/Graphics/Color.hpp>
-#include <SFML/System/Clock.hpp>
 #include "Light.h"
 namespace sf
 {
@@ -93,7 +92,9 @@ class GD_EXTENSION_API RuntimeLightObject : public RuntimeObject
 public :
 
     RuntimeLightObject(RuntimeScene & scene, const gd::Object & object);
-    virtual ~RuntimeLightObject() {};
+    RuntimeLightObject(const RuntimeLightObject & other) : RuntimeObject(other) { Init(other); };
+    RuntimeLightObject& operator=(const RuntimeLightObject & other) { if ( this != &other ) { RuntimeObject::operator=(other); Init(other); } return *this; };
+    virtual ~RuntimeLightObject();
     virtual RuntimeObject * Clone() const { return new RuntimeLightObject(*this);}
 
     virtual bool Draw(sf::RenderTarget & renderTarget);
@@ -111,10 +112,10 @@ public :
     int GetQuality() const { return light.GetQuality(); };
     sf::Color GetColor() const { return light.GetColor(); };
 
-    void SetIntensity(float intensity) { light.SetIntensity(intensity); };
-    void SetRadius(float radius) { light.SetRadius(radius); };
-    void SetQuality(int quality) { light.SetQuality(quality); };
-    void SetColor(const sf::Color & color) { light.SetColor(color); };
+    void SetIntensity(float intensity) { light.SetIntensity(intensity); needGeneration = true; };
+    void SetRadius(float radius) { light.SetRadius(radius); needGeneration = true; };
+    void SetQuality(int quality) { light.SetQuality(quality); needGeneration = true; };
+    void SetColor(const sf::Color & color) { light.SetColor(color); needGeneration = true; };
 
     bool IsGlobalLight() const { return globalLight; };
     void SetGlobalLight(bool global) { globalLight = global; UpdateGlobalLightMembers(); };
@@ -137,14 +138,28 @@ public :
     virtual unsigned int GetNumberOfProperties() const;
     #endif
 
+    /**
+     * \brief Return true if the light was changed or if a wall near it was changed since the last generation.
+     */
+    bool NeedGeneration() const;
+
+    /**
+     * \brief Generate the light using the walls near it.
+     * \note Can be called from any thread, as long as the walls are not modified at the same time.
+     */
+    void GenerateLight();
+
     static std::map<const gd::Layout*, std::weak_ptr<Light_Manager> > lightManagersList;
 
 private:
+    void Init(const RuntimeLightObject & other);
     void UpdateGlobalLightMembers();
 
     float angle;
 
-    sf::Clock updateClock;
+    bool needGeneration; ///< true if the light was modified since the last generation.
+    unsigned int lastGenerationChange; ///< Value of Light_Manager::GetChangesCount() when the light was generated.
+    std::vector<Wall*> wallsNearLight; ///< Used by GenerateLight (stored here to avoid reallocations).
 
     std::shared_ptr<Light_Manager>  manager; ///< Keep a link to the light manager of the scene.
     Light light; ///< Light object used to render light
@@ -26,7 +26,7 @@ LightObstacleAutomatism::~LightObstacleAutomatism()
     {
         for (unsigned int i = 0;i<wallsOfObject.size();++i)
         {
-            manager->walls.erase(std::remove(manager->walls.begin(), manager->walls.end(), (wallsOfObject[i])), manager->walls.end());
+            manager->RemoveWall(wallsOfObject[i]);
             delete wallsOfObject[i];
         }
         wallsOfObject.clear();
@@ -69,20 +69,11 @@ void LightObstacleAutomatism::DoStepPostEvents(RuntimeScene & scene)
          objectOldHeight == object->GetHeight() && objectOldWidth == object->GetWidth()) )
         return;
 
-    if ( wallsOfObject.empty() )
+    bool newWalls = wallsOfObject.empty();
+    if ( newWalls )
     {
-        Wall * wall1 = new Wall(sf::Vector2f(0,0), sf::Vector2f(0,0));
-        Wall * wall2 = new Wall(sf::Vector2f(0,0), sf::Vector2f(0,0));
-        Wall * wall3 = new Wall(sf::Vector2f(0,0), sf::Vector2f(0,0));
-        Wall * wall4 = new Wall(sf::Vector2f(0,0), sf::Vector2f(0,0));
-        manager->walls.push_back(wall1);
-        manager->walls.push_back(wall2);
-        manager->walls.push_back(wall3);
-        manager->walls.push_back(wall4);
-        wallsOfObject.push_back(wall1);
-        wallsOfObject.push_back(wall2);
-        wallsOfObject.push_back(wall3);
-        wallsOfObject.push_back(wall4);
+        for (unsigned int i = 0;i<4;++i)
+            wallsOfObject.push_back(new Wall(sf::Vector2f(0,0), sf::Vector2f(0,0)));
     }
 
     sf::Vector2f A = RotatePoint( sf::Vector2f( -object->GetWidth()/2.0f, -object->GetHeight()/2.0f ), -object->GetAngle() );
@@ -100,6 +91,13 @@ void LightObstacleAutomatism::DoStepPostEvents(RuntimeScene & scene)
     wallsOfObject[2]->pt1 = sf::Vector2f(C.x+1,C.y); wallsOfObject[2]->pt2 = sf::Vector2f(D.x,D.y);
     wallsOfObject[3]->pt1 = sf::Vector2f(D.x,D.y+1); wallsOfObject[3]->pt2 = sf::Vector2f(A.x,A.y);
 
+    //Let the manager know about the walls, so that only the lights near them are updated.
+    for (unsigned int i = 0;i<wallsOfObject.size();++i)
+    {
+        if ( newWalls ) manager->AddWall(wallsOfObject[i]);
+        else manager->UpdateWall(wallsOfObject[i]);
+    }
+
     objectOldX = object->GetX();
     objectOldY = object->GetY();
     objectOldAngle = object->GetAngle();
@@ -113,7 +111,7 @@ void LightObstacleAutomatism::OnDeActivate()
     {
         for (unsigned int i = 0;i<wallsOfObject.size();++i)
         {
-            manager->walls.erase(std::remove(manager->walls.begin(), manager->walls.end(), (wallsOfObject[i])), manager->walls.end());
+            manager->RemoveWall(wallsOfObject[i]);
             delete wallsOfObject[i];
         }
         wallsOfObject.clear();
@@ -25,6 +25,7 @@ NetworkAutomatism::NetworkAutomatism() :
     angle(true),
     width(false),
     height(false),
+    snapshotReplication(false),
     sending(true),
     objectNetworkId(0)
 {
@@ -47,7 +48,29 @@ void NetworkAutomatism::EditAutomatism( wxWindow* parent, gd::Project & game_, g
  */
 void NetworkAutomatism::DoStepPreEvents(RuntimeScene & scene)
 {
-    if ( !sending )
+    if ( snapshotReplication )
+    {
+        //Send the snapshot of the objects updated during the previous frame (only done once per frame).
+        NetworkManager::Get()->SendSnapshot();
+
+        if ( sending ) return;
+
+        const ReplicationSnapshot & states = ReceivedDataManager::Get()->objectsStates;
+        if ( objectNetworkId >= states.size() ) return;
+
+        const ReplicatedObjectState & state = states[objectNetworkId];
+        if ( xPosition && state.HasField(ReplicatedObjectState::X) )
+            object->SetX(SnapshotReplication::Dequantize(ReplicatedObjectState::X, state.values[ReplicatedObjectState::X]));
+        if ( yPosition && state.HasField(ReplicatedObjectState::Y) )
+            object->SetY(SnapshotReplication::Dequantize(ReplicatedObjectState::Y, state.values[ReplicatedObjectState::Y]));
+        if ( angle && state.HasField(ReplicatedObjectState::Angle) )
+            object->SetAngle(SnapshotReplication::Dequantize(ReplicatedObjectState::Angle, state.values[ReplicatedObjectState::Angle]));
+        if ( width && state.HasField(ReplicatedObjectState::Width) )
+            object->SetWidth(SnapshotReplication::Dequantize(ReplicatedObjectState::Width, state.values[ReplicatedObjectState::Width]));
+        if ( height && state.HasField(ReplicatedObjectState::Height) )
+            object->SetHeight(SnapshotReplication::Dequantize(ReplicatedObjectState::Height, state.values[ReplicatedObjectState::Height]));
+    }
+    else if ( !sending )
     {
         if ( xPosition ) object->SetX(ReceivedDataManager::Get()->values[dataPrefix+ToString(objectNetworkId)+"/X"]);
         if ( yPosition ) object->SetY(ReceivedDataManager::Get()->values[dataPrefix+ToString(objectNetworkId)+"/Y"]);
@@ -64,6 +87,18 @@ void NetworkAutomatism::DoStepPostEvents(RuntimeScene & scene)
 {
     if ( !sending ) return;
 
+    if ( snapshotReplication )
+    {
+        //The values are sent with the other objects at the beginning of the next frame.
+        SnapshotSender & sender = NetworkManager::Get()->GetSnapshotSender();
+        if ( xPosition ) sender.SetObjectValue(objectNetworkId, ReplicatedObjectState::X, object->GetX());
+        if ( yPosition ) sender.SetObjectValue(objectNetworkId, ReplicatedObjectState::Y, object->GetY());
+        if ( angle ) sender.SetObjectValue(objectNetworkId, ReplicatedObjectState::Angle, object->GetAngle());
+        if ( width ) sender.SetObjectValue(objectNetworkId, ReplicatedObjectState::Width, object->GetWidth());
+        if ( height ) sender.SetObjectValue(objectNetworkId, ReplicatedObjectState::Height, object->GetHeight());
+        return;
+    }
+
     if ( xPosition )
     {
         sf::Packet packet;
@@ -144,6 +179,7 @@ void NetworkAutomatism::SerializeTo(gd::SerializerElement & element) const
     element.SetAttribute("angle", angle);
     element.SetAttribute("width", width);
     element.SetAttribute("height", height);
+    element.SetAttribute("snapshotReplication", snapshotReplication);
     element.SetAttribute("dataPrefix", dataPrefix);
 }
 #endif
@@ -156,6 +192,7 @@ void NetworkAutomatism::UnserializeFrom(const gd::SerializerElement & element)
     angle = element.GetBoolAttribute("angle");
     width = element.GetBoolAttribute("width");
     height = element.GetBoolAttribute("height");
+    snapshotReplication = element.GetBoolAttribute("snapshotReplication", false);
     dataPrefix = element.GetStringAttribute("dataPrefix");
 }
 
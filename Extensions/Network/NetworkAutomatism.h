@@ -52,6 +52,7 @@ public:
     bool angle; ///< True if agnle must be send/updated
     bool width; ///< True if width must be send/updated
     bool height; ///< True if height must be send/updated
+    bool snapshotReplication; ///< True to send the data of all objects in a single packet per frame (see SnapshotSender). Identifiers must be unique among all these objects.
 
     void SetAsSender() {sending=true;};
     void SetAsReceiver() {sending=false;};
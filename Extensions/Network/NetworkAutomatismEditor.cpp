@@ -29,6 +29,7 @@ const long NetworkAutomatismEditor::ID_CHECKBOX5 = wxNewId();
 const long NetworkAutomatismEditor::ID_TEXTCTRL1 = wxNewId();
 const long NetworkAutomatismEditor::ID_STATICTEXT2 = wxNewId();
 const long NetworkAutomatismEditor::ID_STATICTEXT3 = wxNewId();
+const long NetworkAutomatismEditor::ID_CHECKBOX6 = wxNewId();
 const long NetworkAutomatismEditor::ID_BUTTON1 = wxNewId();
 const long NetworkAutomatismEditor::ID_BUTTON2 = wxNewId();
 //*)
@@ -102,6 +103,9 @@ scene(scene_)
 	FlexGridSizer7->Add(FlexGridSizer8, 1, wxALL|wxEXPAND|wxALIGN_CENTER_HORIZONTAL|wxALIGN_CENTER_VERTICAL, 0);
 	StaticText3 = new wxStaticText(this, ID_STATICTEXT3, _("X represent identifier number and Data the data title."), wxDefaultPosition, wxDefaultSize, 0, _T("ID_STATICTEXT3"));
 	FlexGridSizer7->Add(StaticText3, 1, wxALL|wxALIGN_CENTER_HORIZONTAL|wxALIGN_CENTER_VERTICAL, 5);
+	snapshotCheck = new wxCheckBox(this, ID_CHECKBOX6, _("Send all objects in a single compressed packet each frame\n(identifiers must be unique among these objects, the data prefix is not used)"), wxDefaultPosition, wxDefaultSize, 0, wxDefaultValidator, _T("ID_CHECKBOX6"));
+	snapshotCheck->SetValue(false);
+	FlexGridSizer7->Add(snapshotCheck, 1, wxALL|wxALIGN_LEFT|wxALIGN_CENTER_VERTICAL, 5);
 	StaticBoxSizer2->Add(FlexGridSizer7, 1, wxALL|wxEXPAND|wxALIGN_CENTER_HORIZONTAL|wxALIGN_CENTER_VERTICAL, 5);
 	FlexGridSizer5->Add(StaticBoxSizer2, 1, wxALL|wxEXPAND|wxALIGN_CENTER_HORIZONTAL|wxALIGN_CENTER_VERTICAL, 5);
 	FlexGridSizer4->Add(FlexGridSizer5, 1, wxALL|wxEXPAND|wxALIGN_CENTER_HORIZONTAL|wxALIGN_CENTER_VERTICAL, 0);
@@ -126,6 +130,7 @@ scene(scene_)
     angleCheck->SetValue(automatism.angle);
     widthCheck->SetValue(automatism.width);
     heightCheck->SetValue(automatism.height);
+    snapshotCheck->SetValue(automatism.snapshotReplication);
 
     dataPrefixEdit->SetValue(automatism.dataPrefix);
 }
@@ -150,6 +155,7 @@ void NetworkAutomatismEditor::OnokBtClick(wxCommandEvent& event)
     automatism.angle = angleCheck->GetValue();
     automatism.width = widthCheck->GetValue();
     automatism.height = heightCheck->GetValue();
+    automatism.snapshotReplication = snapshotCheck->GetValue();
 
     automatism.dataPrefix = ToString(dataPrefixEdit->GetValue());
 
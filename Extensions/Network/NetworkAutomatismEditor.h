@@ -45,6 +45,7 @@ class NetworkAutomatismEditor: public wxDialog
 		wxRadioBox* initialBehaviourList;
 		wxButton* okBt;
 		wxCheckBox* heightCheck;
+		wxCheckBox* snapshotCheck;
 		//*)
 
 		NetworkAutomatism & automatism;
@@ -62,6 +63,7 @@ class NetworkAutomatismEditor: public wxDialog
 		static const long ID_TEXTCTRL1;
 		static const long ID_STATICTEXT2;
 		static const long ID_STATICTEXT3;
+		static const long ID_CHECKBOX6;
 		static const long ID_BUTTON1;
 		static const long ID_BUTTON2;
 		//*)
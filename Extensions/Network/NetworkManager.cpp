@@ -41,6 +41,24 @@ void NetworkManager::ReceivePackets()
                 ReceivedDataManager::Get()->strings[title] = str;
                 break;
             }
+            case 2:
+            {
+                sf::Uint32 sequence = 0;
+                if ( snapshotReceiver.ReceiveSnapshot(packet, address, port, ReceivedDataManager::Get()->objectsStates, sequence) )
+                {
+                    //Acknowledge the snapshot so that the peer uses it as the baseline for the next ones.
+                    sf::Packet acknowledgement;
+                    acknowledgement << sf::Int32(3) << sequence;
+                    socket.send(acknowledgement, address, port);
+                }
+                break;
+            }
+            case 3:
+            {
+                sf::Uint32 sequence = 0;
+                if ( packet >> sequence ) snapshotSender.Acknowledge(address, port, sequence);
+                break;
+            }
             default:
                 ErrorManager::Get()->SetLastError("Received unknown data ( Type "+ToString(type)+" )\n");
                 break;
@@ -49,3 +67,16 @@ void NetworkManager::ReceivePackets()
     }
 }
 
+void NetworkManager::SendSnapshot()
+{
+    if ( !snapshotSender.HasPendingChanges() ) return;
+
+    for (unsigned int i = 0;i<recipientsList.size();++i)
+    {
+        sf::Packet packet;
+        snapshotSender.FillPacket(packet, recipientsList[i].first, recipientsList[i].second);
+        socket.send(packet, recipientsList[i].first, recipientsList[i].second);
+    }
+
+    snapshotSender.EndTick();
+}
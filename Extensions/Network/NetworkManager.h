@@ -1,6 +1,7 @@
 #ifndef NETWORKMANAGER_H
 #define NETWORKMANAGER_H
 #include <SFML/Network.hpp>
+#include "SnapshotReplication.h"
 
 /**
  * Manage network stuff.
@@ -55,6 +56,17 @@ public:
             socket.send(packet, recipientsList[i].first, recipientsList[i].second);
     }
 
+    /**
+     * Send the snapshot of the objects replicated with snapshots to all registered recipients,
+     * if objects were updated since the last snapshot.
+     */
+    void SendSnapshot();
+
+    /**
+     * Return the object used to build the snapshots of objects.
+     */
+    SnapshotSender & GetSnapshotSender() { return snapshotSender; };
+
     /**
      * Add a peer to send packets to.
      */
@@ -99,6 +111,8 @@ private:
     virtual ~NetworkManager() {};
 
     sf::UdpSocket socket;
+    SnapshotSender snapshotSender;
+    SnapshotReceiver snapshotReceiver;
 
     std::vector< std::pair<sf::IpAddress, short unsigned int> > recipientsList; ///< List of peers to send packets to.
     std::vector<sf::IpAddress> blockedList; ///< Blocked peers : Ignore packets from them.
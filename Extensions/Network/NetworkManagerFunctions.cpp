@@ -24,6 +24,7 @@ void GD_EXTENSION_API ResetReceivedData()
 {
     ReceivedDataManager::Get()->values.clear();
     ReceivedDataManager::Get()->strings.clear();
+    ReceivedDataManager::Get()->objectsStates.clear();
 }
 
 void GD_EXTENSION_API ActStopListening()
@@ -9,6 +9,7 @@ This project is released under the MIT License.
 #define RECEIVEDDATAMANAGER_H
 #include <map>
 #include <string>
+#include "SnapshotReplication.h"
 
 /**
  * Singleton where is stocked receveid data from other peers.
@@ -38,6 +39,7 @@ class GD_EXTENSION_API ReceivedDataManager
 
     std::map<std::string, double> values;
     std::map<std::string, std::string> strings;
+    ReplicationSnapshot objectsStates; ///< The states of objects replicated with snapshots, indexed by their network identifier.
 
     protected:
     private:
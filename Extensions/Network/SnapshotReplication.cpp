@@ -0,0 +1,274 @@
+/**
+
+GDevelop - Network Extension
+Copyright (c) 2010-2015 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+
+#include "SnapshotReplication.h"
+#include <cmath>
+
+namespace
+{
+
+void AppendVarint(std::vector<sf::Uint8> & data, sf::Uint32 value)
+{
+    while ( value >= 0x80 )
+    {
+        data.push_back(static_cast<sf::Uint8>(value | 0x80));
+        value >>= 7;
+    }
+    data.push_back(static_cast<sf::Uint8>(value));
+}
+
+bool ReadVarint(const sf::Uint8 * data, std::size_t size, std::size_t & pos, sf::Uint32 & value)
+{
+    value = 0;
+    for (unsigned int shift = 0;pos < size && shift < 35;shift += 7)
+    {
+        sf::Uint8 byte = data[pos++];
+        value |= static_cast<sf::Uint32>(byte & 0x7F) << shift;
+        if ( !(byte & 0x80) ) return true;
+    }
+
+    return false;
+}
+
+/**
+ * Zigzag encoding so that small negative differences are stored in a few bytes.
+ */
+sf::Uint32 ZigZag(sf::Uint32 value) { return (value << 1) ^ static_cast<sf::Uint32>(static_cast<sf::Int32>(value) >> 31); }
+sf::Uint32 UnZigZag(sf::Uint32 value) { return (value >> 1) ^ (~(value & 1) + 1); }
+
+/**
+ * Compare sequence numbers, taking care of wrap around.
+ */
+bool IsMoreRecent(sf::Uint32 sequence, sf::Uint32 other) { return static_cast<sf::Int32>(sequence - other) > 0; }
+
+const ReplicationSnapshot emptySnapshot;
+
+}
+
+namespace SnapshotReplication
+{
+
+sf::Int32 Quantize(unsigned int field, double value)
+{
+    const double scale = field == ReplicatedObjectState::Angle ? 100.0 : 16.0;
+    return static_cast<sf::Int32>(std::floor(value * scale + 0.5));
+}
+
+double Dequantize(unsigned int field, sf::Int32 value)
+{
+    const double scale = field == ReplicatedObjectState::Angle ? 100.0 : 16.0;
+    return static_cast<double>(value) / scale;
+}
+
+void EncodeDelta(const ReplicationSnapshot & snapshot, const ReplicationSnapshot & baseline, std::vector<sf::Uint8> & data)
+{
+    static const ReplicatedObjectState unknownState;
+
+    unsigned int previousId = 0;
+    for (unsigned int id = 0;id<snapshot.size();++id)
+    {
+        const ReplicatedObjectState & state = snapshot[id];
+        if ( !state.fields ) continue;
+
+        const ReplicatedObjectState & baseState = id < baseline.size() ? baseline[id] : unknownState;
+        sf::Uint8 changedFields = 0;
+        for (unsigned int field = 0;field<ReplicatedObjectState::FieldsCount;++field)
+        {
+            if ( state.HasField(field) && (!baseState.HasField(field) || baseState.values[field] != state.values[field]) )
+                changedFields |= 1 << field;
+        }
+        if ( !changedFields ) continue;
+
+        AppendVarint(data, id - previousId);
+        data.push_back(changedFields);
+        for (unsigned int field = 0;field<ReplicatedObjectState::FieldsCount;++field)
+        {
+            if ( !(changedFields & (1 << field)) ) continue;
+
+            sf::Uint32 baseValue = baseState.HasField(field) ? static_cast<sf::Uint32>(baseState.values[field]) : 0;
+            AppendVarint(data, ZigZag(static_cast<sf::Uint32>(state.values[field]) - baseValue));
+        }
+
+        previousId = id;
+    }
+}
+
+bool DecodeDelta(const sf::Uint8 * data, std::size_t size, const ReplicationSnapshot & baseline, ReplicationSnapshot & snapshot)
+{
+    snapshot = baseline;
+
+    std::size_t pos = 0;
+    sf::Uint32 id = 0;
+    while ( pos < size )
+    {
+        sf::Uint32 idDifference = 0;
+        if ( !ReadVarint(data, size, pos, idDifference) || pos >= size ) return false;
+
+        id += idDifference;
+        if ( id >= maxObjectsCount ) return false;
+        if ( id >= snapshot.size() ) snapshot.resize(id+1);
+
+        ReplicatedObjectState & state = snapshot[id];
+        sf::Uint8 changedFields = data[pos++];
+        for (unsigned int field = 0;field<ReplicatedObjectState::FieldsCount;++field)
+        {
+            if ( !(changedFields & (1 << field)) ) continue;
+
+            sf::Uint32 difference = 0;
+            if ( !ReadVarint(data, size, pos, difference) ) return false;
+
+            sf::Uint32 baseValue = state.HasField(field) ? static_cast<sf::Uint32>(state.values[field]) : 0;
+            state.values[field] = static_cast<sf::Int32>(baseValue + UnZigZag(difference));
+            state.fields |= 1 << field;
+        }
+    }
+
+    return true;
+}
+
+}
+
+SnapshotSender::SnapshotSender() :
+    history(historySize),
+    historySequences(historySize, 0),
+    historyValid(historySize, false),
+    sequence(0),
+    pendingChanges(false)
+{
+}
+
+void SnapshotSender::SetObjectValue(unsigned int id, unsigned int field, double value)
+{
+    if ( id >= SnapshotReplication::maxObjectsCount || field >= ReplicatedObjectState::FieldsCount ) return;
+    if ( id >= current.size() ) current.resize(id+1);
+
+    ReplicatedObjectState & state = current[id];
+    state.values[field] = SnapshotReplication::Quantize(field, value);
+    state.fields |= 1 << field;
+    pendingChanges = true;
+}
+
+const ReplicationSnapshot * SnapshotSender::GetSentSnapshot(sf::Uint32 sentSequence) const
+{
+    unsigned int index = sentSequence % historySize;
+    if ( !historyValid[index] || historySequences[index] != sentSequence ) return NULL;
+
+    return &history[index];
+}
+
+void SnapshotSender::FillPacket(sf::Packet & packet, const sf::IpAddress & address, unsigned short port) const
+{
+    //Use the last snapshot acknowledged by the peer as the baseline, if we still have it.
+    const ReplicationSnapshot * baseline = NULL;
+    sf::Uint32 baselineSequence = 0;
+    std::map< std::pair<sf::IpAddress, unsigned short>, sf::Uint32 >::const_iterator acknowledged =
+        acknowledgedSequences.find(std::make_pair(address, port));
+    if ( acknowledged != acknowledgedSequences.end() )
+    {
+        baselineSequence = acknowledged->second;
+        baseline = GetSentSnapshot(baselineSequence);
+    }
+
+    std::vector<sf::Uint8> data;
+    SnapshotReplication::EncodeDelta(current, baseline ? *baseline : emptySnapshot, data);
+
+    packet  << sf::Int32(2) //2 indicate that the packet contains a snapshot
+            << sequence
+            << sf::Uint8(baseline ? 1 : 0)
+            << baselineSequence
+            << static_cast<sf::Uint32>(data.size());
+    if ( !data.empty() ) packet.append(&data[0], data.size());
+}
+
+void SnapshotSender::EndTick()
+{
+    unsigned int index = sequence % historySize;
+    history[index] = current;
+    historySequences[index] = sequence;
+    historyValid[index] = true;
+
+    sequence++;
+    pendingChanges = false;
+}
+
+void SnapshotSender::Acknowledge(const sf::IpAddress & address, unsigned short port, sf::Uint32 acknowledgedSequence)
+{
+    if ( !IsMoreRecent(sequence, acknowledgedSequence) ) return; //Not sent yet: invalid acknowledgement.
+
+    std::pair<sf::IpAddress, unsigned short> peer(address, port);
+    std::map< std::pair<sf::IpAddress, unsigned short>, sf::Uint32 >::iterator it = acknowledgedSequences.find(peer);
+    if ( it == acknowledgedSequences.end() )
+        acknowledgedSequences[peer] = acknowledgedSequence;
+    else if ( IsMoreRecent(acknowledgedSequence, it->second) )
+        it->second = acknowledgedSequence;
+}
+
+void SnapshotSender::Reset()
+{
+    current.clear();
+    for (unsigned int i = 0;i<historySize;++i)
+    {
+        history[i].clear();
+        historyValid[i] = false;
+    }
+    acknowledgedSequences.clear();
+    pendingChanges = false;
+}
+
+bool SnapshotReceiver::ReceiveSnapshot(sf::Packet & packet, const sf::IpAddress & address, unsigned short port,
+    ReplicationSnapshot & states, sf::Uint32 & sequence)
+{
+    sf::Uint8 hasBaseline = 0;
+    sf::Uint32 baselineSequence = 0;
+    sf::Uint32 dataSize = 0;
+    if ( !(packet >> sequence >> hasBaseline >> baselineSequence >> dataSize) ) return false;
+    if ( dataSize > packet.getDataSize() ) return false; //Bound the memory used by an invalid packet.
+
+    //Read the encoded data, at the end of the packet: a truncated packet is rejected.
+    std::vector<sf::Uint8> data(dataSize);
+    for (sf::Uint32 i = 0;i<dataSize;++i)
+    {
+        if ( !(packet >> data[i]) ) return false;
+    }
+
+    SenderState & sender = senders[std::make_pair(address, port)];
+
+    //Find the baseline used by the peer
+    const ReplicationSnapshot * baseline = &emptySnapshot;
+    if ( hasBaseline )
+    {
+        unsigned int baselineIndex = baselineSequence % SnapshotSender::historySize;
+        if ( !sender.historyValid[baselineIndex] || sender.historySequences[baselineIndex] != baselineSequence )
+            return false; //The baseline is unknown, the snapshot can't be decoded.
+
+        baseline = &sender.history[baselineIndex];
+    }
+
+    ReplicationSnapshot snapshot;
+    if ( !SnapshotReplication::DecodeDelta(data.empty() ? NULL : &data[0], dataSize, *baseline, snapshot) ) return false;
+
+    //Only update the objects if the snapshot is the most recent (packets can arrive out of order).
+    if ( !sender.hasLatest || IsMoreRecent(sequence, sender.latestSequence) )
+    {
+        if ( states.size() < snapshot.size() ) states.resize(snapshot.size());
+        for (unsigned int id = 0;id<snapshot.size();++id)
+        {
+            if ( snapshot[id].fields ) states[id] = snapshot[id];
+        }
+
+        sender.latestSequence = sequence;
+        sender.hasLatest = true;
+    }
+
+    //Remember the snapshot as it can be used as a baseline by the peer
+    unsigned int index = sequence % SnapshotSender::historySize;
+    sender.history[index].swap(snapshot);
+    sender.historySequences[index] = sequence;
+    sender.historyValid[index] = true;
+
+    return true;
+}
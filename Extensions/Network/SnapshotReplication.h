@@ -0,0 +1,165 @@
+/**
+
+GDevelop - Network Extension
+Copyright (c) 2010-2015 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+
+#ifndef SNAPSHOTREPLICATION_H
+#define SNAPSHOTREPLICATION_H
+#include <map>
+#include <vector>
+#include <SFML/Network.hpp>
+
+/**
+ * \brief The state of an object replicated using snapshots.
+ *
+ * Values are stored quantized (see SnapshotReplication::Quantize).
+ */
+struct GD_EXTENSION_API ReplicatedObjectState
+{
+    enum Field { X = 0, Y, Angle, Width, Height, FieldsCount };
+
+    ReplicatedObjectState() : fields(0) { for (unsigned int i = 0;i<FieldsCount;++i) values[i] = 0; };
+
+    bool HasField(unsigned int field) const { return (fields & (1 << field)) != 0; };
+
+    sf::Uint8 fields; ///< Bit mask of the fields known for the object (0 if the object is not part of the snapshot).
+    sf::Int32 values[FieldsCount]; ///< The quantized values of the fields.
+};
+
+/**
+ * \brief The states of all the replicated objects, indexed by their network identifier.
+ */
+typedef std::vector<ReplicatedObjectState> ReplicationSnapshot;
+
+/**
+ * \brief Tools to encode the difference between two snapshots in a compact way.
+ *
+ * For each object having a field different from the baseline, the encoded data contains
+ * the difference between its identifier and the one of the previous object, a bit mask
+ * of the modified fields and the difference of each modified field with the baseline.
+ * All numbers are stored as varints (zigzag encoded for differences of values).
+ */
+namespace SnapshotReplication
+{
+    const unsigned int maxObjectsCount = 65536; ///< Objects with an identifier greater than this are not replicated.
+
+    /**
+     * \brief Convert a value to the integer sent on the network (1/16 pixels for positions and sizes, 1/100 degrees for angles).
+     */
+    sf::Int32 GD_EXTENSION_API Quantize(unsigned int field, double value);
+
+    /**
+     * \brief Convert back a value quantized with Quantize.
+     */
+    double GD_EXTENSION_API Dequantize(unsigned int field, sf::Int32 value);
+
+    /**
+     * \brief Append to data the difference between snapshot and baseline.
+     */
+    void GD_EXTENSION_API EncodeDelta(const ReplicationSnapshot & snapshot, const ReplicationSnapshot & baseline, std::vector<sf::Uint8> & data);
+
+    /**
+     * \brief Rebuild a snapshot from the baseline and the difference encoded by EncodeDelta.
+     * \return false if the data is invalid.
+     */
+    bool GD_EXTENSION_API DecodeDelta(const sf::Uint8 * data, std::size_t size, const ReplicationSnapshot & baseline, ReplicationSnapshot & snapshot);
+}
+
+/**
+ * \brief Build the snapshots packets sent to the peers.
+ *
+ * The state of the objects set during a tick is sent in a single packet for each peer,
+ * encoded as the difference with the last snapshot acknowledged by the peer.
+ */
+class GD_EXTENSION_API SnapshotSender
+{
+public:
+    SnapshotSender();
+
+    /**
+     * \brief Set the value of a field of an object for the current tick.
+     */
+    void SetObjectValue(unsigned int id, unsigned int field, double value);
+
+    /**
+     * \brief Return true if objects were updated since the last call to EndTick.
+     */
+    bool HasPendingChanges() const { return pendingChanges; };
+
+    /**
+     * \brief Fill the packet containing the snapshot of the current tick for a peer.
+     */
+    void FillPacket(sf::Packet & packet, const sf::IpAddress & address, unsigned short port) const;
+
+    /**
+     * \brief Store the snapshot of the current tick and start a new tick.
+     * \note To be called after the packets were sent to all peers.
+     */
+    void EndTick();
+
+    /**
+     * \brief Called when a peer has acknowledged the reception of a snapshot.
+     */
+    void Acknowledge(const sf::IpAddress & address, unsigned short port, sf::Uint32 sequence);
+
+    /**
+     * \brief Forget all the objects and the acknowledgements.
+     */
+    void Reset();
+
+    static const unsigned int historySize = 32; ///< The number of snapshots remembered to be used as baselines.
+
+private:
+    const ReplicationSnapshot * GetSentSnapshot(sf::Uint32 sequence) const;
+
+    ReplicationSnapshot current; ///< The state of all the objects sent (objects are never removed).
+    std::vector<ReplicationSnapshot> history; ///< The last snapshots sent, indexed by sequence % historySize.
+    std::vector<sf::Uint32> historySequences;
+    std::vector<bool> historyValid;
+    std::map< std::pair<sf::IpAddress, unsigned short>, sf::Uint32 > acknowledgedSequences; ///< The last snapshot acknowledged by each peer.
+    sf::Uint32 sequence; ///< The sequence number of the current tick.
+    bool pendingChanges;
+};
+
+/**
+ * \brief Decode the snapshots packets received from peers.
+ */
+class GD_EXTENSION_API SnapshotReceiver
+{
+public:
+    SnapshotReceiver() {};
+
+    /**
+     * \brief Read a snapshot packet (the packet type must have already been read).
+     *
+     * \param states The flat buffer of object states, updated if the snapshot is the most recent one received from the peer.
+     * \param sequence Filled with the sequence of the snapshot, to be acknowledged.
+     * \return true if the snapshot was decoded and must be acknowledged.
+     */
+    bool ReceiveSnapshot(sf::Packet & packet, const sf::IpAddress & address, unsigned short port,
+                         ReplicationSnapshot & states, sf::Uint32 & sequence);
+
+    /**
+     * \brief Forget all the snapshots received.
+     */
+    void Reset() { senders.clear(); };
+
+private:
+    struct SenderState
+    {
+        SenderState() : history(SnapshotSender::historySize), historySequences(SnapshotSender::historySize, 0),
+            historyValid(SnapshotSender::historySize, false), latestSequence(0), hasLatest(false) {};
+
+        std::vector<ReplicationSnapshot> history; ///< The last snapshots received, indexed by sequence % historySize.
+        std::vector<sf::Uint32> historySequences;
+        std::vector<bool> historyValid;
+        sf::Uint32 latestSequence;
+        bool hasLatest;
+    };
+
+    std::map< std::pair<sf::IpAddress, unsigned short>, SenderState > senders;
+};
+
+#endif // SNAPSHOTREPLICATION_H
@@ -0,0 +1,191 @@
+/**
+
+GDevelop - Network Extension
+Copyright (c) 2010-2015 Florian Rival (Florian.Rival@gmail.com)
+This project is released under the MIT License.
+*/
+/**
+ * @file Tests for the snapshot replication of the Network extension.
+ */
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+#include <iostream>
+#include <SFML/Network.hpp>
+#include <SFML/System.hpp>
+#include "../SnapshotReplication.h"
+#include "../NetworkManager.h"
+#include "../ReceivedDataManager.h"
+
+namespace
+{
+
+/**
+ * Receive the packets sent to ourself, waiting a bit for them to arrive.
+ */
+void ReceiveLoopbackPackets()
+{
+    for (unsigned int i = 0;i<20;++i)
+    {
+        sf::sleep(sf::milliseconds(10));
+        NetworkManager::Get()->ReceivePackets();
+    }
+}
+
+double GetReceivedValue(unsigned int id, unsigned int field)
+{
+    const ReplicationSnapshot & states = ReceivedDataManager::Get()->objectsStates;
+    if ( id >= states.size() || !states[id].HasField(field) ) return -1;
+
+    return SnapshotReplication::Dequantize(field, states[id].values[field]);
+}
+
+}
+
+TEST_CASE( "SnapshotReplication", "[game-engine][network]" ) {
+	SECTION("Delta encoding") {
+		ReplicationSnapshot baseline(3);
+		baseline[0].fields = 1 << ReplicatedObjectState::X;
+		baseline[0].values[ReplicatedObjectState::X] = 160;
+		baseline[2].fields = (1 << ReplicatedObjectState::X) | (1 << ReplicatedObjectState::Y);
+		baseline[2].values[ReplicatedObjectState::X] = -50;
+		baseline[2].values[ReplicatedObjectState::Y] = 1000000;
+
+		ReplicationSnapshot snapshot = baseline;
+		snapshot[2].values[ReplicatedObjectState::Y] = 999990;
+		snapshot.resize(11);
+		snapshot[10].fields = 1 << ReplicatedObjectState::Angle;
+		snapshot[10].values[ReplicatedObjectState::Angle] = 9000;
+
+		std::vector<sf::Uint8> data;
+		SnapshotReplication::EncodeDelta(snapshot, baseline, data);
+		REQUIRE(data.size() < 10); //Unchanged objects and fields are not sent.
+
+		ReplicationSnapshot decoded;
+		REQUIRE(SnapshotReplication::DecodeDelta(&data[0], data.size(), baseline, decoded) == true);
+		REQUIRE(decoded.size() == 11);
+		REQUIRE(decoded[0].values[ReplicatedObjectState::X] == 160);
+		REQUIRE(decoded[1].fields == 0);
+		REQUIRE(decoded[2].values[ReplicatedObjectState::X] == -50);
+		REQUIRE(decoded[2].values[ReplicatedObjectState::Y] == 999990);
+		REQUIRE(decoded[10].HasField(ReplicatedObjectState::Angle));
+		REQUIRE(decoded[10].values[ReplicatedObjectState::Angle] == 9000);
+
+		//Truncated data must be rejected
+		REQUIRE(SnapshotReplication::DecodeDelta(&data[0], data.size()-1, baseline, decoded) == false);
+	}
+	SECTION("Quantization") {
+		REQUIRE(SnapshotReplication::Dequantize(ReplicatedObjectState::X, SnapshotReplication::Quantize(ReplicatedObjectState::X, 12.5)) == 12.5);
+		REQUIRE(SnapshotReplication::Dequantize(ReplicatedObjectState::Angle, SnapshotReplication::Quantize(ReplicatedObjectState::Angle, -45.25)) == -45.25);
+	}
+	SECTION("Truncated packet") {
+		SnapshotSender sender;
+		SnapshotReceiver receiver;
+		for (unsigned int id = 0;id<10;++id)
+			sender.SetObjectValue(id, ReplicatedObjectState::X, id*10);
+
+		sf::Packet packet;
+		sender.FillPacket(packet, sf::IpAddress::LocalHost, 1);
+
+		//Drop the last byte of the encoded data.
+		sf::Packet truncated;
+		truncated.append(packet.getData(), packet.getDataSize()-1);
+
+		sf::Int32 type;
+		sf::Uint32 sequence;
+		ReplicationSnapshot states;
+		truncated >> type;
+		REQUIRE(receiver.ReceiveSnapshot(truncated, sf::IpAddress::LocalHost, 1, states, sequence) == false);
+
+		packet >> type;
+		REQUIRE(receiver.ReceiveSnapshot(packet, sf::IpAddress::LocalHost, 1, states, sequence) == true);
+		REQUIRE(SnapshotReplication::Dequantize(ReplicatedObjectState::X, states[9].values[ReplicatedObjectState::X]) == 90);
+	}
+	SECTION("Loopback socket") {
+		const unsigned short port = 50123;
+		NetworkManager::Get()->ListenToPort(port);
+		NetworkManager::Get()->RemoveAllRecipients();
+		NetworkManager::Get()->AddRecipient(sf::IpAddress::LocalHost, port);
+		NetworkManager::Get()->GetSnapshotSender().Reset();
+		ReceivedDataManager::Get()->objectsStates.clear();
+
+		SnapshotSender & sender = NetworkManager::Get()->GetSnapshotSender();
+		for (unsigned int id = 0;id<100;++id)
+		{
+			sender.SetObjectValue(id, ReplicatedObjectState::X, id*10);
+			sender.SetObjectValue(id, ReplicatedObjectState::Y, 42);
+		}
+		NetworkManager::Get()->SendSnapshot();
+		ReceiveLoopbackPackets(); //Also receive the acknowledgement of the snapshot.
+
+		REQUIRE(GetReceivedValue(0, ReplicatedObjectState::X) == 0);
+		REQUIRE(GetReceivedValue(57, ReplicatedObjectState::X) == 570);
+		REQUIRE(GetReceivedValue(99, ReplicatedObjectState::Y) == 42);
+		REQUIRE(GetReceivedValue(99, ReplicatedObjectState::Angle) == -1);
+
+		//The next snapshot is encoded against the acknowledged one.
+		sender.SetObjectValue(57, ReplicatedObjectState::X, 571.5);
+		NetworkManager::Get()->SendSnapshot();
+		ReceiveLoopbackPackets();
+
+		REQUIRE(GetReceivedValue(57, ReplicatedObjectState::X) == 571.5);
+		REQUIRE(GetReceivedValue(56, ReplicatedObjectState::X) == 560);
+
+		//Nothing is sent if no object was updated.
+		REQUIRE(sender.HasPendingChanges() == false);
+
+		NetworkManager::Get()->StopListening();
+		NetworkManager::Get()->RemoveAllRecipients();
+	}
+}
+
+TEST_CASE( "SnapshotReplication bandwidth", "[.benchmark][network]" ) {
+	//Compare the bytes sent for 500 moving objects during 60 frames with one packet per value
+	//and with snapshots (UDP and IP headers are counted as 28 bytes per packet).
+	const unsigned int objectsCount = 500;
+	const unsigned int framesCount = 60;
+	const std::size_t headersSize = 28;
+
+	std::size_t valuesPacketsBytes = 0;
+	std::size_t snapshotsBytes = 0;
+	SnapshotSender sender;
+	SnapshotReceiver receiver;
+	ReplicationSnapshot states;
+	sf::IpAddress peer = sf::IpAddress::LocalHost;
+
+	for (unsigned int frame = 0;frame<framesCount;++frame)
+	{
+		for (unsigned int id = 0;id<objectsCount;++id)
+		{
+			double x = id*32 + frame*2.5, y = 200 + (id%10)*48, angle = (id+frame)%360;
+
+			const char * suffixes[3] = {"/X", "/Y", "/Angle"};
+			double values[3] = {x, y, angle};
+			for (unsigned int i = 0;i<3;++i)
+			{
+				sf::Packet packet;
+				packet << sf::Int32(0) << "Object"+std::to_string(id)+suffixes[i] << values[i];
+				valuesPacketsBytes += packet.getDataSize() + headersSize;
+			}
+
+			sender.SetObjectValue(id, ReplicatedObjectState::X, x);
+			sender.SetObjectValue(id, ReplicatedObjectState::Y, y);
+			sender.SetObjectValue(id, ReplicatedObjectState::Angle, angle);
+		}
+
+		sf::Packet packet;
+		sender.FillPacket(packet, peer, 1);
+		sender.EndTick();
+		snapshotsBytes += packet.getDataSize() + headersSize;
+
+		sf::Int32 type;
+		sf::Uint32 sequence;
+		packet >> type;
+		if ( receiver.ReceiveSnapshot(packet, peer, 1, states, sequence) )
+			sender.Acknowledge(peer, 1, sequence);
+	}
+
+	std::cout << "Bytes per frame for " << objectsCount << " objects:" << std::endl;
+	std::cout << "  One packet per value: " << valuesPacketsBytes/framesCount << " (" << objectsCount*3 << " packets)" << std::endl;
+	std::cout << "  Snapshots: " << snapshotsBytes/framesCount << " (1 packet)" << std::endl;
+	REQUIRE(snapshotsBytes < valuesPacketsBytes);
+}
@@ -13,8 +13,10 @@ void ContactListener::BeginContact( b2Contact * contact )
 
     PhysicsAutomatism * automatism1 = static_cast<PhysicsAutomatism *>(contact->GetFixtureA()->GetBody()->GetUserData());
     PhysicsAutomatism * automatism2 = static_cast<PhysicsAutomatism *>(contact->GetFixtureB()->GetBody()->GetUserData());
-    automatism1->currentContacts.insert(automatism2);
-    automatism2->currentContacts.insert(automatism1);
+    if ( !automatism1 || !automatism2 ) return;
+
+    automatism1->currentContacts[automatism2->GetObject()]++;
+    automatism2->currentContacts[automatism1->GetObject()]++;
 }
 
 void ContactListener::EndContact( b2Contact * contact )
@@ -23,7 +25,9 @@ void ContactListener::EndContact( b2Contact * contact )
 
     PhysicsAutomatism * automatism1 = static_cast<PhysicsAutomatism *>(contact->GetFixtureA()->GetBody()->GetUserData());
     PhysicsAutomatism * automatism2 = static_cast<PhysicsAutomatism *>(contact->GetFixtureB()->GetBody()->GetUserData());
-    automatism1->currentContacts.erase(automatism2);
-    automatism2->currentContacts.erase(automatism1);
+    if ( !automatism1 || !automatism2 ) return;
+
+    automatism1->RemoveContact(automatism2->GetObject());
+    automatism2->RemoveContact(automatism1->GetObject());
 }
 
@@ -566,6 +566,21 @@ public:
 
         }
 
+        #if defined(GD_IDE_ONLY)
+        AddCondition("CollisionBetween",
+                       _("Collision between objects"),
+                       _("Test if objects with the physics automatism are colliding.\nBoth lists of objects are filtered: only the colliding objects will be taken in account by the next actions and conditions.\nThis condition only checks the current contacts of the objects, and is faster when there are a lot of objects."),
+                       _("_PARAM0_ is in collision with _PARAM2_ (physics)"),
+                       _("Physics"),
+                       "res/physics24.png",
+                       "res/physics16.png")
+            .AddParameter("objectList", _("Object"))
+            .AddParameter("automatism", _("Automatism"), "PhysicsAutomatism")
+            .AddParameter("objectList", _("Object"))
+            .AddCodeOnlyParameter("conditionInverted", "")
+            .codeExtraInformation.SetFunctionName("PhysicsAutomatism::PickObjectsInContact").SetIncludeFile("PhysicsAutomatism/PhysicsAutomatism.h");
+        #endif
+
         GD_COMPLETE_EXTENSION_COMPILATION_INFORMATION();
     };
 };
@@ -18,6 +18,8 @@ This project is released under the MIT License.
 #include "GDCpp/Project.h"
 #include "GDCpp/Scene.h"
 #include "RuntimeScenePhysicsDatas.h"
+#include <unordered_set>
+#include <set>
 
 #undef GetObject
 
@@ -32,6 +34,9 @@ PhysicsAutomatism::PhysicsAutomatism() :
     averageRestitution(0),
     linearDamping(0.1),
     angularDamping(0.1),
+    previousBodyX(0),
+    previousBodyY(0),
+    previousBodyAngle(0),
     body(NULL),
     runtimeScenesPhysicsDatas(NULL)
 {
@@ -71,11 +76,17 @@ void PhysicsAutomatism::DoStepPreEvents(RuntimeScene & scene)
         runtimeScenesPhysicsDatas->stepped = true;
     }
 
-    //Update object position according to Box2D body
+    //Update object position according to Box2D body, interpolated between the two last steps of the world
+    //so that the movement stays smooth when the framerate is not a multiple of the physics time step.
+    float alpha = runtimeScenesPhysicsDatas->GetInterpolationFactor();
     b2Vec2 position = body->GetPosition();
+    position.x = previousBodyX+(position.x-previousBodyX)*alpha;
+    position.y = previousBodyY+(position.y-previousBodyY)*alpha;
+    float angle = previousBodyAngle+(body->GetAngle()-previousBodyAngle)*alpha;
+
     object->SetX(position.x*runtimeScenesPhysicsDatas->GetScaleX()-object->GetWidth()/2+object->GetX()-object->GetDrawableX());
     object->SetY(-position.y*runtimeScenesPhysicsDatas->GetScaleY()-object->GetHeight()/2+object->GetY()-object->GetDrawableY()); //Y axis is inverted
-    object->SetAngle(-body->GetAngle()*180.0f/b2_pi); //Angles are inverted
+    object->SetAngle(-angle*180.0f/b2_pi); //Angles are inverted
 
     objectOldX = object->GetX();
     objectOldY = object->GetY();
@@ -122,6 +133,14 @@ void PhysicsAutomatism::DoStepPostEvents(RuntimeScene & scene)
     oldPos.y = -(object->GetDrawableY()+object->GetHeight()/2)*runtimeScenesPhysicsDatas->GetInvScaleY(); //Y axis is inverted
     body->SetTransform(oldPos, -object->GetAngle()*b2_pi/180.0f); //Angles are inverted
     body->SetAwake(true);
+    SavePreviousBodyTransform(); //The object was moved by events: don't interpolate from its old position.
+}
+
+void PhysicsAutomatism::SavePreviousBodyTransform()
+{
+    previousBodyX = body->GetPosition().x;
+    previousBodyY = body->GetPosition().y;
+    previousBodyAngle = body->GetAngle();
 }
 
 /**
@@ -143,6 +162,7 @@ void PhysicsAutomatism::CreateBody(const RuntimeScene & scene)
     bodyDef.fixedRotation = fixedRotation;
     body = runtimeScenesPhysicsDatas->world->CreateBody(&bodyDef);
     body->SetUserData(this);
+    SavePreviousBodyTransform();
 
     //Setup body
     if ( shapeType == Circle)
@@ -538,38 +558,119 @@ double PhysicsAutomatism::GetAngularDamping( const RuntimeScene & scene)
     return body->GetAngularDamping();
 }
 
+void PhysicsAutomatism::RemoveContact(RuntimeObject * otherObject)
+{
+    std::unordered_map<RuntimeObject*, unsigned int>::iterator it = currentContacts.find(otherObject);
+    if ( it == currentContacts.end() ) return;
+
+    if ( it->second <= 1 )
+        currentContacts.erase(it);
+    else
+        it->second--;
+}
+
 /**
  * Test if there is a contact with another object
  */
 bool PhysicsAutomatism::CollisionWith( std::map <std::string, std::vector<RuntimeObject*> *> otherObjectsLists, RuntimeScene & scene)
 {
     if ( !body ) CreateBody(scene);
+    if ( currentContacts.empty() ) return false;
 
-    //Getting a list of all objects which are tested
-    std::vector<RuntimeObject*> objects;
+    //Test if an object of the lists is in contact with our object.
     for (std::map <std::string, std::vector<RuntimeObject*> *>::const_iterator it = otherObjectsLists.begin();it!=otherObjectsLists.end();++it)
     {
-        if ( it->second != NULL )
+        if ( it->second == NULL ) continue;
+
+        const std::vector<RuntimeObject*> & objects = *it->second;
+        for (unsigned int i = 0;i<objects.size();++i)
         {
-            objects.reserve(objects.size()+it->second->size());
-            std::copy(it->second->begin(), it->second->end(), std::back_inserter(objects));
+            if ( currentContacts.find(objects[i]) != currentContacts.end() )
+                return true;
         }
     }
 
-    //Test if an object of the list is in collision with our object.
-	std::vector<RuntimeObject*>::const_iterator obj_end = objects.end();
-    for (std::vector<RuntimeObject*>::iterator obj = objects.begin(); obj != obj_end; ++obj )
+    return false;
+}
+
+namespace
+{
+
+/**
+ * Remove from the lists the objects which are not picked. Lists already trimmed are skipped,
+ * as the same list can be in both lists of objects of a condition.
+ */
+void TrimObjectsLists(std::map <std::string, std::vector<RuntimeObject*> *> & objectsLists,
+    const std::unordered_set<RuntimeObject*> & pickedObjects, std::set< std::vector<RuntimeObject*> * > & trimmedLists)
+{
+    for (std::map <std::string, std::vector<RuntimeObject*> *>::const_iterator it = objectsLists.begin();it!=objectsLists.end();++it)
     {
-        std::set<PhysicsAutomatism*>::const_iterator it = currentContacts.begin();
-        std::set<PhysicsAutomatism*>::const_iterator end = currentContacts.end();
-        for (;it != end;++it)
+        if ( it->second == NULL || !trimmedLists.insert(it->second).second ) continue;
+
+        std::vector<RuntimeObject*> & objects = *it->second;
+        size_t finalSize = 0;
+        for (unsigned int i = 0;i<objects.size();++i)
         {
-            if ( (*it)->GetObject() == (*obj) )
-                return true;
+            if ( pickedObjects.find(objects[i]) != pickedObjects.end() )
+            {
+                objects[finalSize] = objects[i];
+                finalSize++;
+            }
         }
+        objects.resize(finalSize);
     }
+}
 
-    return false;
+}
+
+bool PhysicsAutomatism::PickObjectsInContact(std::map <std::string, std::vector<RuntimeObject*> *> objectsLists1, const std::string & automatismName,
+    std::map <std::string, std::vector<RuntimeObject*> *> objectsLists2, bool conditionInverted)
+{
+    std::unordered_set<RuntimeObject*> objects2;
+    for (std::map <std::string, std::vector<RuntimeObject*> *>::const_iterator it = objectsLists2.begin();it!=objectsLists2.end();++it)
+    {
+        if ( it->second != NULL ) objects2.insert(it->second->begin(), it->second->end());
+    }
+
+    //Enumerate the contacts of the objects of the first lists
+    bool isTrue = false;
+    std::unordered_set<RuntimeObject*> pickedObjects1;
+    std::unordered_set<RuntimeObject*> pickedObjects2;
+    for (std::map <std::string, std::vector<RuntimeObject*> *>::const_iterator it = objectsLists1.begin();it!=objectsLists1.end();++it)
+    {
+        if ( it->second == NULL ) continue;
+
+        const std::vector<RuntimeObject*> & objects = *it->second;
+        for (unsigned int i = 0;i<objects.size();++i)
+        {
+            bool inContact = false;
+            if ( objects[i]->HasAutomatismNamed(automatismName) )
+            {
+                PhysicsAutomatism * automatism = static_cast<PhysicsAutomatism*>(objects[i]->GetAutomatismRawPointer(automatismName));
+                for (std::unordered_map<RuntimeObject*, unsigned int>::const_iterator contact = automatism->currentContacts.begin();
+                     contact != automatism->currentContacts.end();++contact)
+                {
+                    if ( contact->first == objects[i] || objects2.find(contact->first) == objects2.end() ) continue;
+
+                    inContact = true;
+                    if ( conditionInverted ) break;
+                    pickedObjects2.insert(contact->first);
+                }
+            }
+
+            if ( inContact != conditionInverted )
+            {
+                pickedObjects1.insert(objects[i]);
+                isTrue = true;
+            }
+        }
+    }
+
+    std::set< std::vector<RuntimeObject*> * > trimmedLists;
+    TrimObjectsLists(objectsLists1, pickedObjects1, trimmedLists);
+    if ( !conditionInverted ) TrimObjectsLists(objectsLists2, pickedObjects2, trimmedLists);
+
+    return isTrue;
 }
 
 bool PhysicsAutomatism::IsStatic()
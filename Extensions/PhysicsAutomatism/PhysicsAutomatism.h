@@ -13,7 +13,7 @@ This project is released under the MIT License.
 #include "SFML/Config.hpp"
 #include "SFML/System/Vector2.hpp"
 #include <map>
-#include <set>
+#include <unordered_map>
 #include <vector>
 namespace gd { class Project; }
 namespace gd { class Layout; }
@@ -31,6 +31,7 @@ namespace sf
 class GD_EXTENSION_API PhysicsAutomatism : public Automatism
 {
 friend class PhysicsAutomatismEditor;
+friend class RuntimeScenePhysicsDatas;
 
 public:
     PhysicsAutomatism();
@@ -67,7 +68,15 @@ public:
     inline RuntimeObject * GetObject() {return object;};
     inline const RuntimeObject * GetObject() const {return object;};
 
-    std::set<PhysicsAutomatism*> currentContacts; ///< List of other bodies that are in contact with this body.
+    /**
+     * The objects whose body is in contact with this body, with the number of pairs of fixtures touching.
+     */
+    std::unordered_map<RuntimeObject*, unsigned int> currentContacts;
+
+    /**
+     * \brief Remove one pair of fixtures from the contacts with an object, called when the fixtures stop touching.
+     */
+    void RemoveContact(RuntimeObject * otherObject);
 
     void SetStatic(RuntimeScene & scene);
     void SetDynamic(RuntimeScene & scene);
@@ -134,11 +143,22 @@ public:
 
     bool CollisionWith( std::map <std::string, std::vector<RuntimeObject*> *> otherObjectsLists, RuntimeScene & scene);
 
+    /**
+     * \brief Pick the objects of the two lists whose bodies are in contact.
+     *
+     * Contrary to CollisionWith, both lists are filtered and only the contacts of the objects
+     * of the first list are enumerated, so the cost does not depend on the product of the sizes of the lists.
+     * If conditionInverted is true, only the first list is filtered and keeps the objects without any contact.
+     */
+    static bool PickObjectsInContact(std::map <std::string, std::vector<RuntimeObject*> *> objectsLists1, const std::string & automatismName,
+                                     std::map <std::string, std::vector<RuntimeObject*> *> objectsLists2, bool conditionInverted);
+
 private:
 
     virtual void DoStepPreEvents(RuntimeScene & scene);
     virtual void DoStepPostEvents(RuntimeScene & scene);
     void CreateBody(const RuntimeScene & scene);
+    void SavePreviousBodyTransform(); ///< Called by RuntimeScenePhysicsDatas before the last step of the world.
 
     enum ShapeType {Box, Circle, CustomPolygon} shapeType; ///< the kind of hitbox -> Box, Circle or CustomPolygon
     Positioning polygonPositioning;
@@ -166,6 +186,10 @@ private:
     float objectOldWidth;
     float objectOldHeight;
 
+    float previousBodyX; ///< Position of the body before the last step of the world, used for interpolation.
+    float previousBodyY; ///< Position of the body before the last step of the world, used for interpolation.
+    float previousBodyAngle; ///< Angle of the body before the last step of the world, used for interpolation.
+
     sf::Clock *stepClock;
 
     b2Body * body; ///< Box2D body, representing the object in the Box2D world
@@ -8,6 +8,7 @@ This project is released under the MIT License.
 #include "RuntimeScenePhysicsDatas.h"
 #include "ScenePhysicsDatas.h"
 #include "ContactListener.h"
+#include "PhysicsAutomatism.h"
 #include "Box2D/Box2D.h"
 #include <iostream>
 
@@ -35,23 +36,26 @@ void RuntimeScenePhysicsDatas::StepWorld(float dt, int v, int p)
 {
 	totalTime += dt;
 
-	if(totalTime > fixedTimeStep)
-	{
-	    unsigned int numberOfSteps(std::floor(totalTime / fixedTimeStep));
-	    totalTime -= numberOfSteps * fixedTimeStep;
+	//Don't try to catch up after a slow frame: making more steps would slow down the next frames too.
+	if ( totalTime > maxSteps*fixedTimeStep ) totalTime = maxSteps*fixedTimeStep;
 
-	    unsigned int numberOfStepToProcess = std::min(numberOfSteps, maxSteps);
+	while ( totalTime >= fixedTimeStep )
+	{
+	    totalTime -= fixedTimeStep;
 
-	    for(unsigned int a = 0; a < numberOfStepToProcess; a++)
+	    //Remember the bodies transforms before the last step, to interpolate objects positions.
+	    if ( totalTime < fixedTimeStep )
 	    {
-            world->Step(fixedTimeStep, v, p);
-            world->ClearForces();
+	        for (b2Body * body = world->GetBodyList(); body != NULL; body = body->GetNext())
+	        {
+	            PhysicsAutomatism * automatism = static_cast<PhysicsAutomatism *>(body->GetUserData());
+	            if ( automatism ) automatism->SavePreviousBodyTransform();
+	        }
 	    }
-	}
 
-	 //Old method
-	/*world->Step(dt, v, p);
-	world->ClearForces();*/
+	    world->Step(fixedTimeStep, v, p);
+	    world->ClearForces();
+	}
 }
 
 RuntimeScenePhysicsDatas::~RuntimeScenePhysicsDatas()
@@ -51,10 +51,18 @@ public:
 
     /**
      * Call world->Step(), ensuring that the timeStep passed to Step() is fixed.
+     * The transforms of the bodies are saved before the last step so that objects can be
+     * interpolated between the two last steps ( see GetInterpolationFactor ).
      * This method is to be called once a frame ( by PhysicsAutomatism ).
      */
     void StepWorld(float dt, int v, int p);
 
+    /**
+     * Get the position of the current frame between the two last steps of the world,
+     * from 0 ( previous step ) to 1 ( last step ).
+     */
+    inline float GetInterpolationFactor() const { return totalTime/fixedTimeStep; }
+
 private:
     float scaleX;
     float scaleY;
@@ -64,7 +72,7 @@ private:
     float fixedTimeStep; ///< Time step between to call to world->Step(...). Box2D need a fixed time step to ensure reliable simulation.
     unsigned int maxSteps; ///< Maximum steps per frames, to prevent slow down (a slow down will force the computer to make more steps which will force it to make even more steps...)
 
-    float totalTime;
+    float totalTime; ///< Time elapsed since the last step.
 };
 
 #endif // RUNTIMESCENEPHYSICSDATAS_H
@@ -14,6 +14,7 @@ This project is released under the MIT License.
 #include "GDCpp/ImageManager.h"
 #include "GDCpp/Serialization/SerializerElement.h"
 #include "GDCpp/FontManager.h"
+#include "GDCpp/TextRenderer.h"
 #include "GDCpp/Position.h"
 #include "GDCpp/Polygon2d.h"
 #include "GDCpp/CommonTools.h"
@@ -154,6 +155,10 @@ void TextObject::SetFontFilename(const std::string & fontFilename)
 
 RuntimeTextObject::RuntimeTextObject(RuntimeScene & scene, const gd::Object & object) :
     RuntimeObject(scene, object),
+    font(NULL),
+    characterSize(30),
+    style(sf::Text::Regular),
+    color(sf::Color::White),
     opacity(255),
     angle(0)
 {
@@ -174,13 +179,17 @@ bool RuntimeTextObject::Draw( sf::RenderTarget& renderTarget )
 {
     if ( hidden ) return true; //Don't draw anything if hidden
 
-    renderTarget.draw( text );
+    sf::Transform transform;
+    transform.translate(position).rotate(angle).translate(-origin);
+
+    //Texts are drawn by batches by the TextRenderer.
+    TextRenderer::Get()->Draw(renderTarget, geometry, transform, color);
     return true;
 }
 
 void RuntimeTextObject::OnPositionChanged()
 {
-    text.setPosition( GetX()+text.getOrigin().x, GetY()+text.getOrigin().y );
+    position = sf::Vector2f(GetX()+origin.x, GetY()+origin.y);
 }
 
 /**
@@ -202,7 +211,7 @@ std::vector<Polygon2d> RuntimeTextObject::GetHitBoxes() const
  */
 float RuntimeTextObject::GetDrawableX() const
 {
-    return text.getPosition().x-text.getOrigin().x;
+    return position.x-origin.x;
 }
 
 /**
@@ -210,7 +219,7 @@ float RuntimeTextObject::GetDrawableX() const
  */
 float RuntimeTextObject::GetDrawableY() const
 {
-    return text.getPosition().y-text.getOrigin().y;
+    return position.y-origin.y;
 }
 
 /**
@@ -218,7 +227,7 @@ float RuntimeTextObject::GetDrawableY() const
  */
 float RuntimeTextObject::GetWidth() const
 {
-    return text.getLocalBounds().width;
+    return geometry.GetLocalBounds().width;
 }
 
 /**
@@ -226,7 +235,7 @@ float RuntimeTextObject::GetWidth() const
  */
 float RuntimeTextObject::GetHeight() const
 {
-    return text.getLocalBounds().height + text.getLocalBounds().top;
+    return geometry.GetLocalBounds().height + geometry.GetLocalBounds().top;
 }
 
 /**
@@ -234,7 +243,7 @@ float RuntimeTextObject::GetHeight() const
  */
 void RuntimeTextObject::SetColor( unsigned int r, unsigned int g, unsigned int b )
 {
-    text.setColor(sf::Color(r, g, b, opacity));
+    color = sf::Color(r, g, b, opacity);
 }
 
 void RuntimeTextObject::SetColor(const std::string & colorStr)
@@ -254,35 +263,36 @@ void RuntimeTextObject::SetOpacity(float val)
     else if ( val < 0 ) val = 0;
 
     opacity = val;
-    const sf::Color & currentColor = text.getColor();
-    text.setColor(sf::Color(currentColor.r, currentColor.g, currentColor.b, opacity));
+    color.a = opacity;
 }
 
 void RuntimeTextObject::ChangeFont(const std::string & fontName_)
 {
-    if ( !text.getFont() || fontName_ != fontName )
+    if ( !font || fontName_ != fontName )
     {
         fontName = fontName_;
-        text.setFont(*FontManager::Get()->GetFont(fontName));
-        text.setOrigin(text.getLocalBounds().width/2, text.getLocalBounds().height/2);
+        font = FontManager::Get()->GetFont(fontName);
+        UpdateGeometry();
+        UpdateOrigin();
         OnPositionChanged();
         SetSmooth(smoothed); //Ensure texture smoothing is up to date.
     }
 }
 
-void RuntimeTextObject::SetFontStyle(int style)
+void RuntimeTextObject::SetFontStyle(int newStyle)
 {
-    text.setStyle(style);
+    style = newStyle;
+    UpdateGeometry();
 }
 
 int RuntimeTextObject::GetFontStyle()
 {
-    return text.getStyle();
+    return style;
 }
 
-bool RuntimeTextObject::HasFontStyle(sf::Text::Style style)
+bool RuntimeTextObject::HasFontStyle(sf::Text::Style fontStyle)
 {
-    return (text.getStyle() & style) != 0;
+    return (style & fontStyle) != 0;
 }
 
 bool RuntimeTextObject::IsBold()
@@ -325,8 +335,8 @@ void RuntimeTextObject::SetSmooth(bool smooth)
 {
     smoothed = smooth;
 
-    if ( text.getFont() )
-        const_cast<sf::Texture&>(text.getFont()->getTexture(GetCharacterSize())).setSmooth(smooth);
+    if ( font )
+        const_cast<sf::Texture&>(font->getTexture(GetCharacterSize())).setSmooth(smooth);
 }
 
 #if defined(GD_IDE_ONLY)
@@ -11,6 +11,7 @@ This project is released under the MIT License.
 #include <SFML/Graphics/Text.hpp>
 #include "GDCpp/Object.h"
 #include "GDCpp/RuntimeObject.h"
+#include "GDCpp/TextRenderer.h"
 class ImageManager;
 class RuntimeScene;
 namespace gd { class Object; }
@@ -112,6 +113,7 @@ public :
     virtual RuntimeObject * Clone() const { return new RuntimeTextObject(*this);}
 
     virtual bool Draw(sf::RenderTarget & renderTarget);
+    virtual bool IsDrawnWithTextRenderer() const { return true; };
 
     virtual void OnPositionChanged();
 
@@ -121,14 +123,14 @@ public :
     virtual float GetDrawableX() const;
     virtual float GetDrawableY() const;
 
-    virtual bool SetAngle(float newAngle) { angle = newAngle; text.setRotation(angle); return true;};
+    virtual bool SetAngle(float newAngle) { angle = newAngle; return true;};
     virtual float GetAngle() const {return angle;};
 
-    inline void SetString(const std::string & str) { text.setString(str); text.setOrigin(text.getLocalBounds().width/2, text.getLocalBounds().height/2); };
-    inline std::string GetString() const {return text.getString();};
+    inline void SetString(const std::string & str) { string = str; UpdateGeometry(); UpdateOrigin(); };
+    inline std::string GetString() const {return string;};
 
-    inline void SetCharacterSize(float size) { text.setCharacterSize(size); text.setOrigin(text.getLocalBounds().width/2, text.getLocalBounds().height/2); };
-    inline float GetCharacterSize() const { return text.getCharacterSize(); };
+    inline void SetCharacterSize(float size) { characterSize = size; UpdateGeometry(); UpdateOrigin(); };
+    inline float GetCharacterSize() const { return characterSize; };
 
     /** \brief Change the text object font filename and reload the font
      */
@@ -157,9 +159,9 @@ public :
 
     void SetColor(unsigned int r, unsigned int g, unsigned int b);
     void SetColor(const std::string & colorStr);
-    unsigned int GetColorR() const { return text.getColor().r; };
-    unsigned int GetColorG() const { return text.getColor().g; };
-    unsigned int GetColorB() const { return text.getColor().b; };
+    unsigned int GetColorR() const { return color.r; };
+    unsigned int GetColorG() const { return color.g; };
+    unsigned int GetColorB() const { return color.b; };
 
     virtual std::vector<Polygon2d> GetHitBoxes() const;
 
@@ -170,7 +172,24 @@ public :
     #endif
 
 private:
-    sf::Text text;
+    /**
+     * \brief Update the vertices of the text. Nothing is done if the string, the font, the size and the style are unchanged.
+     */
+    void UpdateGeometry() { geometry.Update(string, font, characterSize, style); };
+
+    /**
+     * \brief Put the origin of the text, around which it is rotated, at its center.
+     */
+    void UpdateOrigin() { origin = sf::Vector2f(geometry.GetLocalBounds().width/2, geometry.GetLocalBounds().height/2); };
+
+    sf::String string;
+    const sf::Font * font;
+    unsigned int characterSize;
+    sf::Uint32 style;
+    sf::Color color;
+    sf::Vector2f origin; ///< The point of the text around which it is rotated.
+    sf::Vector2f position; ///< The position of the origin.
+    TextGeometry geometry; ///< The vertices of the text, drawn using TextRenderer.
     std::string fontName;
     float opacity;
     bool smoothed;
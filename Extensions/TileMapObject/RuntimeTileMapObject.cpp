@@ -7,6 +7,7 @@ This project is released under the MIT License.
 
 #include "RuntimeTileMapObject.h"
 
+#include <algorithm>
 #include <SFML/Graphics.hpp>
 #include "GDCore/Tools/Localization.h"
 #include "GDCpp/Object.h"
@@ -31,10 +32,12 @@ RuntimeTileMapObject::RuntimeTileMapObject(RuntimeScene & scene, const gd::Objec
     RuntimeObject(scene, object),
     tileSet(),
     tileMap(),
-    vertexArray(sf::Quads),
+    chunksColumnsCount(0),
+    chunksRowsCount(0),
+    drawCount(0),
+    needGeneration(false),
     oldX(0),
-    oldY(0),
-    needGeneration(false)
+    oldY(0)
 {
     const TileMapObject & tileMapObject = static_cast<const TileMapObject&>(object);
 
@@ -44,10 +47,46 @@ RuntimeTileMapObject::RuntimeTileMapObject(RuntimeScene & scene, const gd::Objec
     //Load the tileset and generate the vertex array
     tileSet.Get().LoadResources(*(scene.game));
     tileSet.Get().Generate(); //We don't need wxBitmaps
-    vertexArray = TileMapExtension::GenerateVertexArray(tileSet.Get(), tileMap.Get());
+    ResetChunks(); //Vertex arrays are generated when chunks are displayed for the first time.
     hitboxes = TileMapExtension::GenerateHitboxes(tileSet.Get(), tileMap.Get());
 }
 
+const int RuntimeTileMapObject::chunkSize = 32;
+const std::size_t RuntimeTileMapObject::chunksEvictionThreshold = 256;
+const unsigned int RuntimeTileMapObject::chunksEvictionDelay = 120;
+
+void RuntimeTileMapObject::ResetChunks()
+{
+    chunksColumnsCount = (tileMap.Get().GetColumnsCount() + chunkSize - 1) / chunkSize;
+    chunksRowsCount = (tileMap.Get().GetRowsCount() + chunkSize - 1) / chunkSize;
+
+    chunks.clear();
+    chunks.resize(chunksColumnsCount * chunksRowsCount);
+}
+
+void RuntimeTileMapObject::GenerateChunk(Chunk & chunk, int chunkCol, int chunkRow)
+{
+    chunk.vertexArray = TileMapExtension::GenerateVertexArray(tileSet.Get(), tileMap.Get(),
+        chunkCol * chunkSize, chunkRow * chunkSize, chunkSize, chunkSize);
+    chunk.generated = true;
+}
+
+void RuntimeTileMapObject::EvictUnusedChunks()
+{
+    if(chunks.size() <= chunksEvictionThreshold || drawCount % chunksEvictionDelay != 0)
+        return;
+
+    for(std::size_t i = 0; i < chunks.size(); ++i)
+    {
+        Chunk & chunk = chunks[i];
+        if(chunk.generated && drawCount - chunk.lastDrawn > chunksEvictionDelay)
+        {
+            chunk.vertexArray = sf::VertexArray(sf::Quads); //Release the memory used by the vertices.
+            chunk.generated = false;
+        }
+    }
+}
+
 /**
  * Render object at runtime
  */
@@ -55,8 +94,8 @@ bool RuntimeTileMapObject::Draw( sf::RenderTarget& window )
 {
     if(needGeneration)
     {
-        //Re-generate the vertex array and the hitboxes
-        vertexArray = TileMapExtension::GenerateVertexArray(tileSet.Get(), tileMap.Get());
+        //Re-generate the hitboxes (vertex arrays of chunks are re-generated when displayed)
+        ResetChunks();
         hitboxes = TileMapExtension::GenerateHitboxes(tileSet.Get(), tileMap.Get());
         for(std::vector<Polygon2d>::iterator it = hitboxes.begin(); it != hitboxes.end(); it++)
         {
@@ -73,18 +112,45 @@ bool RuntimeTileMapObject::Draw( sf::RenderTarget& window )
     sf::Vector2f centerPos = currentView.getCenter();
 
     //Construct the transform
-    sf::Transform transform;
-    transform.translate((int)GetX() + centerPos.x - floor(centerPos.x),
+    sf::Vector2f offset((int)GetX() + centerPos.x - floor(centerPos.x),
                         (int)GetY() + centerPos.y - floor(centerPos.y));
+    sf::Transform transform;
+    transform.translate(offset);
+
+    const float chunkWidth = chunkSize * tileSet.Get().tileSize.x;
+    const float chunkHeight = chunkSize * tileSet.Get().tileSize.y;
+    if(tileSet.Get().IsDirty() || chunkWidth <= 0 || chunkHeight <= 0)
+        return true;
+
+    //Find the chunks intersecting the area displayed by the view (bounding box of the view, if it is rotated)
+    sf::FloatRect visibleArea = currentView.getInverseTransform().transformRect(sf::FloatRect(-1.f, -1.f, 2.f, 2.f));
+    int firstChunkCol = std::max(0, (int)floor((visibleArea.left - offset.x) / chunkWidth));
+    int lastChunkCol = std::min(chunksColumnsCount - 1, (int)floor((visibleArea.left + visibleArea.width - offset.x) / chunkWidth));
+    int firstChunkRow = std::max(0, (int)floor((visibleArea.top - offset.y) / chunkHeight));
+    int lastChunkRow = std::min(chunksRowsCount - 1, (int)floor((visibleArea.top + visibleArea.height - offset.y) / chunkHeight));
 
     //Unsmooth the texture
     bool wasSmooth = tileSet.Get().GetTexture().isSmooth();
     tileSet.Get().GetTexture().setSmooth(false);
 
-    //Draw the tilemap
-    window.draw(vertexArray, sf::RenderStates(sf::BlendAlpha, transform, &tileSet.Get().GetTexture(), NULL));
+    //Draw the visible chunks of the tilemap
+    drawCount++;
+    sf::RenderStates states(sf::BlendAlpha, transform, &tileSet.Get().GetTexture(), NULL);
+    for(int chunkCol = firstChunkCol; chunkCol <= lastChunkCol; ++chunkCol)
+    {
+        for(int chunkRow = firstChunkRow; chunkRow <= lastChunkRow; ++chunkRow)
+        {
+            Chunk & chunk = chunks[chunkCol * chunksRowsCount + chunkRow];
+            if(!chunk.generated)
+                GenerateChunk(chunk, chunkCol, chunkRow);
+
+            window.draw(chunk.vertexArray, states);
+            chunk.lastDrawn = drawCount;
+        }
+    }
 
     tileSet.Get().GetTexture().setSmooth(wasSmooth);
+    EvictUnusedChunks();
 
     return true;
 }
@@ -175,7 +241,17 @@ void RuntimeTileMapObject::SetTile(int layer, int column, int row, int tileId)
 
     //Just update a single tile in the tile map
     tileMap.Get().SetTile(layer, column, row, tileId);
-    TileMapExtension::UpdateVertexArray(vertexArray, layer, column, row, tileSet.Get(), tileMap.Get());
+
+    //Only the chunk containing the tile is updated (if it's not generated, it will be when displayed)
+    const int chunkCol = column / chunkSize;
+    const int chunkRow = row / chunkSize;
+    if(chunkCol < chunksColumnsCount && chunkRow < chunksRowsCount)
+    {
+        Chunk & chunk = chunks[chunkCol * chunksRowsCount + chunkRow];
+        if(chunk.generated)
+            TileMapExtension::UpdateVertexArray(chunk.vertexArray, layer, column, row,
+                chunkCol * chunkSize, chunkRow * chunkSize, chunkSize, chunkSize, tileSet.Get(), tileMap.Get());
+    }
     TileMapExtension::UpdateHitboxes(hitboxes, sf::Vector2f(GetX(), GetY()), layer, column, row, tileSet.Get(), tileMap.Get());
 }
 
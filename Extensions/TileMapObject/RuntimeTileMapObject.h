@@ -81,7 +81,45 @@ public :
 
 private:
 
-    sf::VertexArray vertexArray;
+    /**
+     * \brief A part of the tilemap, containing at most chunkSize x chunkSize tiles.
+     *
+     * Each chunk has its own vertex array, generated only when the chunk is visible,
+     * so that drawing the tilemap depends on the visible area and not on the map size.
+     */
+    struct Chunk
+    {
+        Chunk() : vertexArray(sf::Quads), generated(false), lastDrawn(0) {};
+
+        sf::VertexArray vertexArray;
+        bool generated; ///< true if vertexArray is up to date.
+        unsigned int lastDrawn; ///< Value of drawCount when the chunk was drawn for the last time.
+    };
+
+    /**
+     * Resize the chunks grid to the tilemap size and mark all chunks as needing to be generated.
+     */
+    void ResetChunks();
+
+    /**
+     * Generate the vertex array of a chunk.
+     */
+    void GenerateChunk(Chunk & chunk, int chunkCol, int chunkRow);
+
+    /**
+     * Free the vertex arrays of the chunks that were not drawn recently (only for big tilemaps).
+     */
+    void EvictUnusedChunks();
+
+    std::vector<Chunk> chunks; ///< The chunks, stored by column and then by row.
+    int chunksColumnsCount;
+    int chunksRowsCount;
+    unsigned int drawCount; ///< The number of times the object was drawn.
+
+    static const int chunkSize; ///< The number of columns and rows of tiles in a chunk.
+    static const std::size_t chunksEvictionThreshold; ///< Chunks are only evicted when the map has more chunks than this.
+    static const unsigned int chunksEvictionDelay; ///< The number of draws after which a chunk not drawn is evicted.
+
     std::vector<Polygon2d> hitboxes;
 
     bool needGeneration;
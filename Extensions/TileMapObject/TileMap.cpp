@@ -9,6 +9,95 @@ This project is released under the MIT License.
 
 #include <GDCore/CommonTools.h>
 
+namespace
+{
+
+const char base64Chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+#if defined(GD_IDE_ONLY)
+void AppendVarint(std::vector<unsigned char> &bytes, unsigned int value)
+{
+    while(value >= 0x80)
+    {
+        bytes.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back(static_cast<unsigned char>(value));
+}
+
+std::string EncodeBase64(const std::vector<unsigned char> &bytes)
+{
+    std::string str;
+    str.reserve((bytes.size() + 2) / 3 * 4);
+
+    std::size_t i = 0;
+    for(; i + 2 < bytes.size(); i += 3)
+    {
+        unsigned int chunk = (bytes[i] << 16) | (bytes[i + 1] << 8) | bytes[i + 2];
+        str += base64Chars[(chunk >> 18) & 0x3F];
+        str += base64Chars[(chunk >> 12) & 0x3F];
+        str += base64Chars[(chunk >> 6) & 0x3F];
+        str += base64Chars[chunk & 0x3F];
+    }
+    if(i < bytes.size())
+    {
+        unsigned int chunk = bytes[i] << 16;
+        if(i + 1 < bytes.size()) chunk |= bytes[i + 1] << 8;
+
+        str += base64Chars[(chunk >> 18) & 0x3F];
+        str += base64Chars[(chunk >> 12) & 0x3F];
+        str += i + 1 < bytes.size() ? base64Chars[(chunk >> 6) & 0x3F] : '=';
+        str += '=';
+    }
+
+    return str;
+}
+#endif
+
+std::vector<unsigned char> DecodeBase64(const std::string &str)
+{
+    signed char values[256];
+    std::fill(values, values + 256, -1);
+    for(int i = 0; i < 64; i++)
+        values[static_cast<unsigned char>(base64Chars[i])] = i;
+
+    std::vector<unsigned char> bytes;
+    bytes.reserve(str.size() / 4 * 3);
+
+    unsigned int chunk = 0;
+    int bits = 0;
+    for(std::size_t i = 0; i < str.size(); i++)
+    {
+        signed char value = values[static_cast<unsigned char>(str[i])];
+        if(value < 0) continue; //Skip padding and whitespaces
+
+        chunk = (chunk << 6) | value;
+        bits += 6;
+        if(bits >= 8)
+        {
+            bits -= 8;
+            bytes.push_back(static_cast<unsigned char>((chunk >> bits) & 0xFF));
+        }
+    }
+
+    return bytes;
+}
+
+bool ReadVarint(const std::vector<unsigned char> &bytes, std::size_t &pos, unsigned int &value)
+{
+    value = 0;
+    for(int shift = 0; pos < bytes.size() && shift < 35; shift += 7)
+    {
+        unsigned char byte = bytes[pos++];
+        value |= static_cast<unsigned int>(byte & 0x7F) << shift;
+        if(!(byte & 0x80)) return true;
+    }
+
+    return false;
+}
+
+}
+
 TileMap::TileMap() :
 	m_layers(3, TileMapLayer()),
 	m_width(10),
@@ -65,12 +154,13 @@ void TileMap::UpdateMapSize()
 #if defined(GD_IDE_ONLY)
 void TileMap::SerializeTo(gd::SerializerElement &element) const
 {
+    element.SetAttribute("version", 2);
     element.SetAttribute("columns", m_width);
     element.SetAttribute("rows", m_height);
 
     //Save the tiles
     gd::SerializerElement &tilesElement = element.AddChild("tiles");
-    tilesElement.SetValue(SerializeToString());
+    tilesElement.SetValue(SerializeToBinaryString());
 }
 #endif
 
@@ -83,7 +173,10 @@ void TileMap::UnserializeFrom(const gd::SerializerElement &element)
     if(element.HasChild("tiles"))
     {
         gd::SerializerElement &tilesElement = element.GetChild("tiles");
-        UnserializeFromString(tilesElement.GetValue().GetString());
+        if(element.GetIntAttribute("version", 1) >= 2)
+            UnserializeFromBinaryString(tilesElement.GetValue().GetString());
+        else
+            UnserializeFromString(tilesElement.GetValue().GetString());
     }
 }
 
@@ -147,3 +240,73 @@ void TileMap::UnserializeLayer(int layer, const std::string &str)
         }
     }
 }
+
+#if defined(GD_IDE_ONLY)
+std::string TileMap::SerializeToBinaryString() const
+{
+    std::vector<unsigned char> bytes;
+
+    int currentTile = 0;
+    unsigned int runLength = 0;
+    for(int layer = 0; layer < 3; layer++)
+    {
+        for(int col = 0; col < m_width; col++)
+        {
+            const std::vector<int> &column = m_layers[layer].tiles[col];
+            for(int row = 0; row < m_height; row++)
+            {
+                if(runLength > 0 && column[row] == currentTile)
+                {
+                    runLength++;
+                    continue;
+                }
+
+                if(runLength > 0)
+                {
+                    AppendVarint(bytes, runLength);
+                    AppendVarint(bytes, static_cast<unsigned int>(currentTile + 1));
+                }
+                currentTile = column[row];
+                runLength = 1;
+            }
+        }
+    }
+    if(runLength > 0)
+    {
+        AppendVarint(bytes, runLength);
+        AppendVarint(bytes, static_cast<unsigned int>(currentTile + 1));
+    }
+
+    return EncodeBase64(bytes);
+}
+#endif
+
+void TileMap::UnserializeFromBinaryString(const std::string &str)
+{
+    std::vector<unsigned char> bytes = DecodeBase64(str);
+
+    std::size_t pos = 0;
+    unsigned int runLength = 0;
+    int tile = -1;
+    for(int layer = 0; layer < 3; layer++)
+    {
+        for(int col = 0; col < m_width; col++)
+        {
+            std::vector<int> &column = m_layers[layer].tiles[col];
+            for(int row = 0; row < m_height; row++)
+            {
+                if(runLength == 0)
+                {
+                    unsigned int encodedTile = 0;
+                    if(!ReadVarint(bytes, pos, runLength) || !ReadVarint(bytes, pos, encodedTile) || runLength == 0)
+                        return; //Invalid data: keep the remaining tiles unchanged.
+
+                    tile = static_cast<int>(encodedTile) - 1;
+                }
+
+                column[row] = tile;
+                runLength--;
+            }
+        }
+    }
+}
@@ -61,13 +61,15 @@ public:
 
     #if defined(GD_IDE_ONLY)
     /**
-     * Serialize the tilemap into the given element
+     * Serialize the tilemap into the given element.
+     * The tiles are saved in the compact binary format (see SerializeToBinaryString).
      */
     void SerializeTo(gd::SerializerElement &element) const;
     #endif
 
     /**
-     * Unserialize the tilemap from the given element
+     * Unserialize the tilemap from the given element.
+     * Both the binary format (version 2) and the older string format (version 1) are supported.
      */
     void UnserializeFrom(const gd::SerializerElement &element);
 
@@ -94,6 +96,21 @@ private:
      */
     void UnserializeLayer(int layer, const std::string &str);
 
+    #if defined(GD_IDE_ONLY)
+    /**
+     * Returns the tiles of all layers encoded in a compact binary format:
+     * the tiles (stored by layer, then by column and by row) are run-length encoded
+     * as pairs of varints (run length, tile id + 1) and the result is encoded in base64.
+     */
+    std::string SerializeToBinaryString() const;
+    #endif
+
+    /**
+     * Loads the tiles from the representation returned by SerializeToBinaryString.
+     * The tilemap must already have its final size.
+     */
+    void UnserializeFromBinaryString(const std::string &str);
+
 	std::vector<TileMapLayer> m_layers;
 	int m_width;
 	int m_height;
@@ -7,6 +7,8 @@ This project is released under the MIT License.
 
 #include "TileMapTools.h"
 
+#include <algorithm>
+
 #include "TileSet.h"
 #include "TileMap.h"
 
@@ -14,6 +16,11 @@ namespace TileMapExtension
 {
 
 sf::VertexArray GenerateVertexArray(TileSet &tileSet, TileMap &tileMap)
+{
+    return GenerateVertexArray(tileSet, tileMap, 0, 0, tileMap.GetColumnsCount(), tileMap.GetRowsCount());
+}
+
+sf::VertexArray GenerateVertexArray(TileSet &tileSet, TileMap &tileMap, int firstCol, int firstRow, int columns, int rows)
 {
     sf::VertexArray vertexArray(sf::Quads);
     int tileWidth = tileSet.tileSize.x;
@@ -22,46 +29,32 @@ sf::VertexArray GenerateVertexArray(TileSet &tileSet, TileMap &tileMap)
     if(tileSet.IsDirty())
         return vertexArray;
 
+    //Clamp the part to the tilemap
+    columns = std::max(0, std::min(columns, tileMap.GetColumnsCount() - firstCol));
+    rows = std::max(0, std::min(rows, tileMap.GetRowsCount() - firstRow));
+
+    //The vertices are stored by layer, then by column and then by row (see UpdateVertexArray).
+    vertexArray.resize(4 * 3 * columns * rows);
+    std::size_t vertexPos = 0;
+
     for(int layer = 0; layer < 3; layer++)
     {
-        for(int col = 0; col < tileMap.GetColumnsCount(); col++)
+        for(int col = firstCol; col < firstCol + columns; col++)
         {
-            for(int row = 0; row < tileMap.GetRowsCount(); row++)
+            for(int row = firstRow; row < firstRow + rows; row++)
             {
-                TileTextureCoords coords;
-                if(tileMap.GetTile(layer, col, row) != -1)
-                {
-                    coords = tileSet.GetTileTextureCoords(tileMap.GetTile(layer, col, row));
-                }
-                else
-                {
-                    coords = tileSet.GetTileTextureCoords(0);
-                }
-
-                {
-                    sf::Vertex vertex(sf::Vector2f(col * tileWidth, row * tileHeight), coords.topLeft);
-                    if(tileMap.GetTile(layer, col, row) == -1)
-                        vertex.color.a = 0;
-                    vertexArray.append(vertex);
-                }
-                {
-                    sf::Vertex vertex(sf::Vector2f(col * tileWidth, (row + 1) * tileHeight), coords.bottomLeft);
-                    if(tileMap.GetTile(layer, col, row) == -1)
-                        vertex.color.a = 0;
-                    vertexArray.append(vertex);
-                }
-                {
-                    sf::Vertex vertex(sf::Vector2f((col + 1) * tileWidth, (row + 1) * tileHeight), coords.bottomRight);
-                    if(tileMap.GetTile(layer, col, row) == -1)
-                        vertex.color.a = 0;
-                    vertexArray.append(vertex);
-                }
-                {
-                    sf::Vertex vertex(sf::Vector2f((col + 1) * tileWidth, row * tileHeight), coords.topRight);
-                    if(tileMap.GetTile(layer, col, row) == -1)
-                        vertex.color.a = 0;
-                    vertexArray.append(vertex);
-                }
+                const int tileId = tileMap.GetTile(layer, col, row);
+                TileTextureCoords coords = tileSet.GetTileTextureCoords(tileId != -1 ? tileId : 0);
+                const sf::Uint8 alpha = tileId == -1 ? 0 : 255;
+
+                vertexArray[vertexPos] = sf::Vertex(sf::Vector2f(col * tileWidth, row * tileHeight), coords.topLeft);
+                vertexArray[vertexPos + 1] = sf::Vertex(sf::Vector2f(col * tileWidth, (row + 1) * tileHeight), coords.bottomLeft);
+                vertexArray[vertexPos + 2] = sf::Vertex(sf::Vector2f((col + 1) * tileWidth, (row + 1) * tileHeight), coords.bottomRight);
+                vertexArray[vertexPos + 3] = sf::Vertex(sf::Vector2f((col + 1) * tileWidth, row * tileHeight), coords.topRight);
+                for(int i = 0; i < 4; i++)
+                    vertexArray[vertexPos + i].color.a = alpha;
+
+                vertexPos += 4;
             }
         }
     }
@@ -102,11 +95,21 @@ std::vector<Polygon2d> GenerateHitboxes(TileSet &tileSet, TileMap &tileMap)
 }
 
 void UpdateVertexArray(sf::VertexArray &vertexArray, int layer, int col, int row, TileSet &tileSet, TileMap &tileMap)
+{
+    UpdateVertexArray(vertexArray, layer, col, row, 0, 0, tileMap.GetColumnsCount(), tileMap.GetRowsCount(), tileSet, tileMap);
+}
+
+void UpdateVertexArray(sf::VertexArray &vertexArray, int layer, int col, int row, int firstCol, int firstRow, int columns, int rows, TileSet &tileSet, TileMap &tileMap)
 {
     if(tileSet.IsDirty())
         return;
 
-    const int vertexPos = 4 * (layer * tileMap.GetColumnsCount() * tileMap.GetRowsCount() + col * tileMap.GetRowsCount() + row);
+    columns = std::max(0, std::min(columns, tileMap.GetColumnsCount() - firstCol));
+    rows = std::max(0, std::min(rows, tileMap.GetRowsCount() - firstRow));
+    if(col < firstCol || col >= firstCol + columns || row < firstRow || row >= firstRow + rows)
+        return;
+
+    const int vertexPos = 4 * (layer * columns * rows + (col - firstCol) * rows + (row - firstRow));
 
     TileTextureCoords newCoords = tileMap.GetTile(layer, col, row) != -1 ? tileSet.GetTileTextureCoords(tileMap.GetTile(layer, col, row)) : tileSet.GetTileTextureCoords(0);
     vertexArray[vertexPos].texCoords = newCoords.topLeft;
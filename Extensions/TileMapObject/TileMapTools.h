@@ -18,9 +18,23 @@ class TileMap;
 namespace TileMapExtension
 {
 	sf::VertexArray GenerateVertexArray(TileSet &tileSet, TileMap &tileMap);
+
+    /**
+     * Generate the vertex array of the rectangular part of the tilemap starting at (firstCol, firstRow)
+     * and containing (at most) columns x rows tiles. The vertices are positioned relatively
+     * to the tilemap origin so that the parts can be drawn with the same transform as the whole map.
+     */
+    sf::VertexArray GenerateVertexArray(TileSet &tileSet, TileMap &tileMap, int firstCol, int firstRow, int columns, int rows);
+
 	std::vector<Polygon2d> GenerateHitboxes(TileSet &tileSet, TileMap &tileMap);
 
     void UpdateVertexArray(sf::VertexArray &vertexArray, int layer, int col, int row, TileSet &tileSet, TileMap &tileMap);
+
+    /**
+     * Update the tile at (col, row) in a vertex array generated for a part of the tilemap
+     * with GenerateVertexArray(tileSet, tileMap, firstCol, firstRow, columns, rows).
+     */
+    void UpdateVertexArray(sf::VertexArray &vertexArray, int layer, int col, int row, int firstCol, int firstRow, int columns, int rows, TileSet &tileSet, TileMap &tileMap);
     void UpdateHitboxes(std::vector<Polygon2d> &polygons, sf::Vector2f position, int layer, int col, int row, TileSet &tileSet, TileMap &tileMap);
 }
 
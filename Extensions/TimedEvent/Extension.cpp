@@ -64,7 +64,7 @@ public:
                     if (!parser.ParseMathExpression(codeGenerator.GetPlatform(), codeGenerator.GetProject(), scene, callbacks) || timeOutCode.empty()) timeOutCode = "0";
 
                     //Prepare name
-                    std::string codeName = !event.GetName().empty() ? "GDNamedTimedEvent_"+codeGenerator.ConvertToString(event.GetName()) : "GDTimedEvent_"+ToString(&event);
+                    std::string codeName = event.GetCodeGenerationName(codeGenerator);
 
                     std::string outputCode;
 
@@ -162,12 +162,12 @@ public:
 
                             std::string code;
                             {
-                                std::string codeName = !timedEvent.GetName().empty() ? "GDNamedTimedEvent_"+codeGenerator.ConvertToString(timedEvent.GetName()) : "GDTimedEvent_"+ToString(&timedEvent);
+                                std::string codeName = timedEvent.GetCodeGenerationName(codeGenerator);
                                 code += "GDpriv::TimedEvents::Reset(*runtimeContext->scene, \""+codeName+"\");\n";
                             }
                             for (unsigned int j = 0;j<timedEvent.codeGenerationChildren.size();++j)
                             {
-                                std::string codeName = !timedEvent.codeGenerationChildren[j]->GetName().empty() ? "GDNamedTimedEvent_"+codeGenerator.ConvertToString(timedEvent.codeGenerationChildren[j]->GetName()) : "GDTimedEvent_"+ToString(timedEvent.codeGenerationChildren[j]);
+                                std::string codeName = timedEvent.codeGenerationChildren[j]->GetCodeGenerationName(codeGenerator);
                                 code += "GDpriv::TimedEvents::Reset(*runtimeContext->scene, \""+codeName+"\");\n";
                             }
                             return code;
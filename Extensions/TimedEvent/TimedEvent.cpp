@@ -11,6 +11,7 @@ This project is released under the MIT License.
 #include "GDCore/Serialization/SerializerElement.h"
 #include "TimedEvent.h"
 #include "GDCpp/RuntimeScene.h"
+#include "GDCpp/CommonTools.h"
 #include "GDCpp/tinyxml/tinyxml.h"
 #include "GDCore/Events/EventsCodeGenerator.h"
 #include "GDCore/Events/EventsCodeGenerationContext.h"
@@ -25,6 +26,16 @@ using namespace std;
 
 std::vector< TimedEvent* > TimedEvent::codeGenerationCurrentParents;
 
+std::string TimedEvent::GetCodeGenerationName(gd::EventsCodeGenerator & codeGenerator)
+{
+    if ( !name.empty() ) return "GDNamedTimedEvent_"+codeGenerator.ConvertToString(name);
+
+    if ( codeGenerationUnnamedId.empty() )
+        codeGenerationUnnamedId = "GDTimedEvent_"+ToString(codeGenerator.GenerateStableIdentifier());
+
+    return codeGenerationUnnamedId;
+}
+
 TimedEvent::TimedEvent() :
 BaseEvent()
 {
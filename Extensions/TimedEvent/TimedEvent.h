@@ -21,6 +21,7 @@ namespace gd { class EventsEditorItemsAreas; }
 namespace gd { class EventsEditorSelection; }
 namespace gd { class Layout; }
 namespace gd { class MainFrameWrapper; }
+namespace gd { class EventsCodeGenerator; }
 class wxWindow;
 
 /**
@@ -75,8 +76,16 @@ public:
      */
     virtual EditEventReturnType EditEvent(wxWindow* parent_, gd::Project & game_, gd::Layout & scene_, gd::MainFrameWrapper & mainFrameWrapper_);
 
+    /**
+     * Return the name of the timer of the event in the generated code.
+     * Unnamed events get an identifier from the code generator the first time the method is called,
+     * so that the generated code does not depend on the address of the event.
+     */
+    std::string GetCodeGenerationName(gd::EventsCodeGenerator & codeGenerator);
+
     static std::vector< TimedEvent* > codeGenerationCurrentParents;
     std::vector< TimedEvent* > codeGenerationChildren;
+    std::string codeGenerationUnnamedId; ///< The identifier of the timer of an unnamed event. See GetCodeGenerationName.
 
 private:
     std::string name;
@@ -0,0 +1,38 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2015 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#include "GDCpp/AllocationsTracker.h"
+#include <atomic>
+
+namespace
+{
+    //Constant initialized, so that allocations made before the static initialization of GDCpp are counted.
+    std::atomic<unsigned long long> allocationsCount(0);
+    std::atomic<unsigned long long> allocatedBytes(0);
+}
+
+bool AllocationsTracker::IsEnabled()
+{
+    #if defined(GD_ALLOCATIONS_TRACKING)
+    return true;
+    #else
+    return false;
+    #endif
+}
+
+AllocationsCount AllocationsTracker::GetCount()
+{
+    return AllocationsCount(allocationsCount.load(std::memory_order_relaxed), allocatedBytes.load(std::memory_order_relaxed));
+}
+
+void AllocationsTracker::CountAllocation(std::size_t size)
+{
+    allocationsCount.fetch_add(1, std::memory_order_relaxed);
+    allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+}
+
+#if defined(GD_ALLOCATIONS_TRACKING)
+#include "GDCpp/AllocationsTrackerOperators.h"
+#endif
@@ -0,0 +1,69 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2015 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#ifndef ALLOCATIONSTRACKER_H
+#define ALLOCATIONSTRACKER_H
+#include <cstddef>
+
+/**
+ * \brief A number of memory allocations and the bytes allocated by them.
+ *
+ * \see AllocationsTracker
+ * \ingroup GameEngine
+ */
+struct AllocationsCount
+{
+    AllocationsCount() : allocations(0), bytes(0) {};
+    AllocationsCount(unsigned long long allocations_, unsigned long long bytes_) : allocations(allocations_), bytes(bytes_) {};
+
+    AllocationsCount operator-(const AllocationsCount & other) const { return AllocationsCount(allocations-other.allocations, bytes-other.bytes); };
+
+    unsigned long long allocations;
+    unsigned long long bytes;
+};
+
+/**
+ * \brief Count the memory allocations made by the program, to find the allocations made during a frame
+ * or a scope of the FrameProfiler.
+ *
+ * The allocations are only counted when GDevelop C++ Platform is built with the CMake option GDCPP_ALLOCATIONS_TRACKING
+ * ( which defines GD_ALLOCATIONS_TRACKING ): the global operator new is then replaced by one counting the allocations.
+ * Otherwise, the counts stay at zero.
+ *
+ * Usage example:
+ * \code
+ * AllocationsCount start = AllocationsTracker::GetCount();
+ * //...
+ * AllocationsCount allocated = AllocationsTracker::GetCount()-start;
+ * \endcode
+ *
+ * \note The allocations of all the threads are counted.
+ * \note On Windows, each module has its own operator new: only the allocations made by GDCpp are counted.
+ *
+ * \ingroup GameEngine
+ */
+class GD_API AllocationsTracker
+{
+public:
+    /**
+     * \brief Return true if GDevelop C++ Platform was built with the allocations tracking.
+     */
+    static bool IsEnabled();
+
+    /**
+     * \brief Return the number of allocations, and the bytes allocated, since the start of the program.
+     */
+    static AllocationsCount GetCount();
+
+    /**
+     * \brief Count an allocation of \a size bytes. Called by the replaced operator new.
+     *
+     * Programs can call it from their own operator new to count their allocations
+     * when GDevelop C++ Platform was built without the allocations tracking.
+     */
+    static void CountAllocation(std::size_t size);
+};
+
+#endif // ALLOCATIONSTRACKER_H
@@ -0,0 +1,45 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2015 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#ifndef ALLOCATIONSTRACKEROPERATORS_H
+#define ALLOCATIONSTRACKEROPERATORS_H
+#include "GDCpp/AllocationsTracker.h"
+#include <cstdlib>
+#include <new>
+
+/**
+ * \file AllocationsTrackerOperators.h
+ * \brief Replace the global operator new and operator delete by ones counting the allocations with AllocationsTracker.
+ *
+ * Must be included by exactly one source file of a program or module.
+ * The array and sized versions of the operators call these ones.
+ */
+
+void * operator new(std::size_t size)
+{
+    AllocationsTracker::CountAllocation(size);
+
+    void * memory = std::malloc(size > 0 ? size : 1);
+    if ( !memory ) throw std::bad_alloc();
+    return memory;
+}
+
+void * operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    AllocationsTracker::CountAllocation(size);
+    return std::malloc(size > 0 ? size : 1);
+}
+
+void operator delete(void * memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void * memory, const std::nothrow_t &) noexcept
+{
+    std::free(memory);
+}
+
+#endif // ALLOCATIONSTRACKEROPERATORS_H
@@ -193,7 +193,7 @@ CommonInstructionsExtension::CommonInstructionsExtension()
         {
             virtual std::string GenerateCode(gd::Instruction & instruction, gd::EventsCodeGenerator & codeGenerator, gd::EventsCodeGenerationContext & parentContext)
             {
-                size_t uniqueId = (size_t)&instruction;
+                unsigned int uniqueId = codeGenerator.GenerateStableIdentifier();
                 return "conditionTrue = runtimeContext->TriggerOnce("+ToString(uniqueId)+");\n";
             };
         };
@@ -206,12 +206,11 @@ CommonInstructionsExtension::CommonInstructionsExtension()
     {
         class CodeGen : public gd::EventMetadata::CodeGenerator
         {
-            virtual std::string Generate(gd::BaseEvent & event_, gd::EventsCodeGenerator & codeGenerator, gd::EventsCodeGenerationContext & context)
+            virtual void Generate(gd::BaseEvent & event_, gd::EventsCodeGenerator & codeGenerator, gd::EventsCodeGenerationContext & context, gd::EventsCodeOutput & output)
             {
-                std::string outputCode;
                 gd::StandardEvent & event = dynamic_cast<gd::StandardEvent&>(event_);
 
-                outputCode += codeGenerator.GenerateConditionsListCode(event.GetConditions(), context);
+                output << codeGenerator.GenerateConditionsListCode(event.GetConditions(), context);
 
                 std::string ifPredicat;
                 for (unsigned int i = 0;i<event.GetConditions().size();++i)
@@ -220,19 +219,17 @@ CommonInstructionsExtension::CommonInstructionsExtension()
                     ifPredicat += "condition"+ToString(i)+"IsTrue";
                 }
 
-                if ( !ifPredicat.empty() ) outputCode += "if (" +ifPredicat+ ")\n";
-                outputCode += "{\n";
-                outputCode += codeGenerator.GenerateActionsListCode(event.GetActions(), context);
+                if ( !ifPredicat.empty() ) output << "if (" +ifPredicat+ ")\n";
+                output << "{\n";
+                output << codeGenerator.GenerateActionsListCode(event.GetActions(), context);
                 if ( event.HasSubEvents() ) //Sub events
                 {
-                    outputCode += "\n{\n";
-                    outputCode += codeGenerator.GenerateEventsListCode(event.GetSubEvents(), context);
-                    outputCode += "}\n";
+                    output << "\n{\n";
+                    codeGenerator.GenerateEventsListCode(event.GetSubEvents(), context, output);
+                    output << "}\n";
                 }
 
-                outputCode += "}\n";
-
-                return outputCode;
+                output << "}\n";
             }
         };
         gd::EventMetadata::CodeGenerator * codeGen = new CodeGen;
@@ -295,7 +292,7 @@ CommonInstructionsExtension::CommonInstructionsExtension()
     {
         class CodeGen : public gd::EventMetadata::CodeGenerator
         {
-            virtual std::string Generate(gd::BaseEvent & event_, gd::EventsCodeGenerator & codeGenerator, gd::EventsCodeGenerationContext & parentContext)
+            virtual void Generate(gd::BaseEvent & event_, gd::EventsCodeGenerator & codeGenerator, gd::EventsCodeGenerationContext & parentContext, gd::EventsCodeOutput & output)
             {
                 std::string outputCode;
                 gd::WhileEvent & event = dynamic_cast<gd::WhileEvent&>(event_);
@@ -331,14 +328,13 @@ CommonInstructionsExtension::CommonInstructionsExtension()
                 outputCode += "{\n";
                 outputCode += actionsCode;
                 outputCode += "\n{ //Subevents: \n";
-                outputCode += codeGenerator.GenerateEventsListCode(event.GetSubEvents(), context);
-                outputCode += "} //Subevents end.\n";
-                outputCode += "}\n";
-                outputCode += "} else stopDoWhile = true; \n";
+                output << outputCode;
+                codeGenerator.GenerateEventsListCode(event.GetSubEvents(), context, output);
+                output << "} //Subevents end.\n";
+                output << "}\n";
+                output << "} else stopDoWhile = true; \n";
 
-                outputCode += "} while ( !stopDoWhile );\n";
-
-                return outputCode;
+                output << "} while ( !stopDoWhile );\n";
             }
         };
         gd::EventMetadata::CodeGenerator * codeGen = new CodeGen;
@@ -350,9 +346,8 @@ CommonInstructionsExtension::CommonInstructionsExtension()
     {
         class CodeGen : public gd::EventMetadata::CodeGenerator
         {
-            virtual std::string Generate(gd::BaseEvent & event_, gd::EventsCodeGenerator & codeGenerator, gd::EventsCodeGenerationContext & parentContext)
+            virtual void Generate(gd::BaseEvent & event_, gd::EventsCodeGenerator & codeGenerator, gd::EventsCodeGenerationContext & parentContext, gd::EventsCodeOutput & output)
             {
-                std::string outputCode;
                 gd::RepeatEvent & event = dynamic_cast<gd::RepeatEvent&>(event_);
 
                 const gd::Layout & scene = codeGenerator.GetLayout();
@@ -374,30 +369,25 @@ CommonInstructionsExtension::CommonInstructionsExtension()
                 std::string actionsCode = codeGenerator.GenerateActionsListCode(event.GetActions(), context);
                 std::string ifPredicat = "true"; for (unsigned int i = 0;i<event.GetConditions().size();++i) ifPredicat += " && condition"+ToString(i)+"IsTrue";
 
-                //Prepare object declaration and sub events
-                std::string subevents = codeGenerator.GenerateEventsListCode(event.GetSubEvents(), context);
-                std::string objectDeclaration = codeGenerator.GenerateObjectsDeclarationCode(context)+"\n";
-
-                //Write final code
-                outputCode += "int repeatCount = "+repeatCountCode+";\n";
-                outputCode += "for(unsigned int repeatIndex = 0;repeatIndex < repeatCount;++repeatIndex)\n";
-                outputCode += "{\n";
-                outputCode += objectDeclaration;
-                outputCode += conditionsCode;
-                outputCode += "if (" +ifPredicat+ ")\n";
-                outputCode += "{\n";
-                outputCode += actionsCode;
+                //Write final code ( object declaration is known only when sub events are generated )
+                output << "int repeatCount = "+repeatCountCode+";\n";
+                output << "for(unsigned int repeatIndex = 0;repeatIndex < repeatCount;++repeatIndex)\n";
+                output << "{\n";
+                std::size_t objectDeclaration = output.AddPlaceholder();
+                output << conditionsCode;
+                output << "if (" +ifPredicat+ ")\n";
+                output << "{\n";
+                output << actionsCode;
                 if ( event.HasSubEvents() )
                 {
-                    outputCode += "\n{ //Subevents: \n";
-                    outputCode += subevents;
-                    outputCode += "} //Subevents end.\n";
+                    output << "\n{ //Subevents: \n";
+                    codeGenerator.GenerateEventsListCode(event.GetSubEvents(), context, output);
+                    output << "} //Subevents end.\n";
                 }
-                outputCode += "}\n";
+                output << "}\n";
 
-                outputCode += "}\n";
-
-                return outputCode;
+                output << "}\n";
+                output.FillPlaceholder(objectDeclaration, codeGenerator.GenerateObjectsDeclarationCode(context)+"\n");
             }
         };
         gd::EventMetadata::CodeGenerator * codeGen = new CodeGen;
@@ -409,7 +399,7 @@ CommonInstructionsExtension::CommonInstructionsExtension()
     {
         class CodeGen : public gd::EventMetadata::CodeGenerator
         {
-            virtual std::string Generate(gd::BaseEvent & event_, gd::EventsCodeGenerator & codeGenerator, gd::EventsCodeGenerationContext & parentContext)
+            virtual void Generate(gd::BaseEvent & event_, gd::EventsCodeGenerator & codeGenerator, gd::EventsCodeGenerationContext & parentContext, gd::EventsCodeOutput & output)
             {
                 std::string outputCode;
                 gd::ForEachEvent & event = dynamic_cast<gd::ForEachEvent&>(event_);
@@ -441,7 +431,7 @@ CommonInstructionsExtension::CommonInstructionsExtension()
                         ++i;
                 }
 
-                if ( realObjects.empty() ) return "";
+                if ( realObjects.empty() ) return;
 
                 for (unsigned int i = 0;i<realObjects.size();++i)
                     parentContext.ObjectsListNeeded(realObjects[i]);
@@ -456,11 +446,6 @@ CommonInstructionsExtension::CommonInstructionsExtension()
                 std::string ifPredicat = "true";
                 for (unsigned int i = 0;i<event.GetConditions().size();++i) ifPredicat += " && condition"+ToString(i)+"IsTrue";
 
-                //Prepare object declaration and sub events
-                std::string subevents = codeGenerator.GenerateEventsListCode(event.GetSubEvents(), context);
-
-                std::string objectDeclaration = codeGenerator.GenerateObjectsDeclarationCode(context)+"\n";
-
                 if ( realObjects.size() != 1) //(We write a slighty more simple ( and optimized ) output code when only one object list is used.)
                 {
                     outputCode += "unsigned int forEachTotalCount = 0;";
@@ -511,25 +496,25 @@ CommonInstructionsExtension::CommonInstructionsExtension()
                 }
 
                 outputCode += "{"; //This scope is used as the for loop modified the objects list.
-                outputCode += objectDeclaration;
+                output << outputCode;
+                std::size_t objectDeclaration = output.AddPlaceholder(); //Known only when sub events are generated.
 
-                outputCode += conditionsCode;
-                outputCode += "if (" +ifPredicat+ ")\n";
-                outputCode += "{\n";
-                outputCode += actionsCode;
+                output << conditionsCode;
+                output << "if (" +ifPredicat+ ")\n";
+                output << "{\n";
+                output << actionsCode;
                 if ( event.HasSubEvents() )
                 {
-                    outputCode += "\n{ //Subevents: \n";
-                    outputCode += subevents;
-                    outputCode += "} //Subevents end.\n";
+                    output << "\n{ //Subevents: \n";
+                    codeGenerator.GenerateEventsListCode(event.GetSubEvents(), context, output);
+                    output << "} //Subevents end.\n";
                 }
-                outputCode += "}\n";
+                output << "}\n";
 
-                outputCode += "}";
-
-                outputCode += "}\n"; //End of for loop
+                output << "}";
 
-                return outputCode;
+                output << "}\n"; //End of for loop
+                output.FillPlaceholder(objectDeclaration, codeGenerator.GenerateObjectsDeclarationCode(context)+"\n");
             }
         };
         gd::EventMetadata::CodeGenerator * codeGen = new CodeGen;
@@ -541,9 +526,9 @@ CommonInstructionsExtension::CommonInstructionsExtension()
     {
         class CodeGen : public gd::EventMetadata::CodeGenerator
         {
-            virtual std::string Generate(gd::BaseEvent & event, gd::EventsCodeGenerator & codeGenerator, gd::EventsCodeGenerationContext & context)
+            virtual void Generate(gd::BaseEvent & event, gd::EventsCodeGenerator & codeGenerator, gd::EventsCodeGenerationContext & context, gd::EventsCodeOutput & output)
             {
-                return codeGenerator.GenerateEventsListCode(event.GetSubEvents(), context);
+                codeGenerator.GenerateEventsListCode(event.GetSubEvents(), context, output);
             }
         };
         gd::EventMetadata::CodeGenerator * codeGen = new CodeGen;
@@ -4,7 +4,6 @@
  * This project is released under the MIT License.
  */
 #include "GDCpp/BuiltinExtensions/CommonInstructionsTools.h"
-#include "GDCpp/profile.h"
 #include <SFML/Graphics.hpp>
 #include <sstream>
 
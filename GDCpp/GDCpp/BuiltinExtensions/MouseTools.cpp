@@ -6,52 +6,62 @@
 
 void GD_API CenterCursor( RuntimeScene & scene )
 {
+    if (!scene.renderWindow) return;
     sf::Mouse::setPosition(sf::Vector2i(scene.renderWindow->getSize().x/2, scene.renderWindow->getSize().y/2), *scene.renderWindow );
 }
 
 void GD_API CenterCursorHorizontally( RuntimeScene & scene )
 {
+    if (!scene.renderWindow) return;
     sf::Mouse::setPosition(sf::Vector2i(scene.renderWindow->getSize().x/2, scene.GetInputManager().GetMousePosition().y ), *scene.renderWindow );
 }
 
 void GD_API CenterCursorVertically( RuntimeScene & scene )
 {
+    if (!scene.renderWindow) return;
     sf::Mouse::setPosition(sf::Vector2i(scene.GetInputManager().GetMousePosition().x, scene.renderWindow->getSize().y/2), *scene.renderWindow );
 }
 
 void GD_API SetCursorPosition( RuntimeScene & scene, float newX, float newY )
 {
+    if (!scene.renderWindow) return;
     sf::Mouse::setPosition(sf::Vector2i(newX, newY), *scene.renderWindow );
 }
 
 void GD_API HideCursor( RuntimeScene & scene )
 {
+    if (!scene.renderWindow) return;
     scene.renderWindow->setMouseCursorVisible(false);
 }
 
 void GD_API ShowCursor( RuntimeScene & scene )
 {
+    if (!scene.renderWindow) return;
     scene.renderWindow->setMouseCursorVisible(true);
 }
 
 double GD_API GetCursorXPosition( RuntimeScene & scene, const std::string & layer, unsigned int camera )
 {
-    if (scene.GetRuntimeLayer(layer).GetCameraCount() == 0) return 0;
-    if (camera >= scene.GetRuntimeLayer(layer).GetCameraCount()) camera = 0;
+    if (!scene.renderWindow) return 0;
+    const RuntimeLayer & theLayer = scene.GetRuntimeLayer(layer);
+    if (theLayer.GetCameraCount() == 0) return 0;
+    if (camera >= theLayer.GetCameraCount()) camera = 0;
 
-    //Get view, and compute mouse position
-    const sf::View & view = scene.GetRuntimeLayer(layer).GetCamera(camera).GetSFMLView();
-    return scene.renderWindow->mapPixelToCoords(scene.GetInputManager().GetMousePosition(), view).x;
+    //Compute mouse position
+    const RuntimeCamera & theCamera = theLayer.GetCamera(camera);
+    return theCamera.MapPixelToCoords(*scene.renderWindow, scene.GetInputManager().GetMousePosition()).x;
 }
 
 double GD_API GetCursorYPosition( RuntimeScene & scene, const std::string & layer, unsigned int camera )
 {
-    if (scene.GetRuntimeLayer(layer).GetCameraCount() == 0) return 0;
-    if (camera >= scene.GetRuntimeLayer(layer).GetCameraCount()) camera = 0;
+    if (!scene.renderWindow) return 0;
+    const RuntimeLayer & theLayer = scene.GetRuntimeLayer(layer);
+    if (theLayer.GetCameraCount() == 0) return 0;
+    if (camera >= theLayer.GetCameraCount()) camera = 0;
 
-    //Get view, and compute mouse position
-    const sf::View & view = scene.GetRuntimeLayer(layer).GetCamera(camera).GetSFMLView();
-    return scene.renderWindow->mapPixelToCoords(scene.GetInputManager().GetMousePosition(), view).y;
+    //Compute mouse position
+    const RuntimeCamera & theCamera = theLayer.GetCamera(camera);
+    return theCamera.MapPixelToCoords(*scene.renderWindow, scene.GetInputManager().GetMousePosition()).y;
 }
 
 bool GD_API MouseButtonPressed(RuntimeScene & scene, const std::string & button)
@@ -16,7 +16,6 @@
 #include "GDCpp/CppPlatform.h"
 #include "GDCpp/ObjectHelpers.h"
 #include "GDCpp/RuntimeGame.h"
-#include "GDCpp/profile.h"
 #include "GDCpp/CommonTools.h"
 #include "GDCpp/Variable.h"
 #include "GDCpp/Text.h"
@@ -58,14 +57,10 @@ void GD_API StopGame( RuntimeScene & scene )
 
 void GD_API ChangeScene( RuntimeScene & scene, std::string newSceneName )
 {
-    for ( unsigned int i = 0;i < scene.game->GetLayoutsCount(); ++i )
-    {
-        if ( scene.game->GetLayout(i).GetName() == newSceneName )
-        {
-            scene.GotoSceneWhenEventsAreFinished(i);
-            return;
-        }
-    }
+    //Search by name only, so that the other layouts are not loaded ( see gd::Project::SetLoadLayoutsOnDemand ).
+    unsigned int layoutPosition = scene.game->GetLayoutPosition(newSceneName);
+    if ( layoutPosition < scene.game->GetLayoutsCount() )
+        scene.GotoSceneWhenEventsAreFinished(layoutPosition);
 
    return;
 }
@@ -224,7 +219,8 @@ void GD_API SetWindowIcon(RuntimeScene & scene, const std::string & imageName)
     if ( image == std::shared_ptr<SFMLTextureWrapper>() )
         return;
 
-    scene.renderWindow->setIcon(image->image.getSize().x, image->image.getSize().y, image->image.getPixelsPtr());
+    if (scene.renderWindow != NULL)
+        scene.renderWindow->setIcon(image->image.getSize().x, image->image.getSize().y, image->image.getPixelsPtr());
 }
 
 void GD_API SetWindowTitle(RuntimeScene & scene, const std::string & newName)
@@ -247,6 +243,8 @@ void GD_API SetWindowSize( RuntimeScene & scene, int windowWidth, int windowHeig
         scene.game->SetDefaultHeight( windowHeight );
     }
 
+    if ( scene.renderWindow == NULL ) return;
+
     //Avoid recreating every tick a new window if the size has not changed!
     if ( windowWidth == scene.renderWindow->getSize().x && windowHeight == scene.renderWindow->getSize().y )
         return;
@@ -267,6 +265,8 @@ void GD_API SetWindowSize( RuntimeScene & scene, int windowWidth, int windowHeig
 void GD_API SetFullScreen(RuntimeScene & scene, bool fullscreen, bool)
 {
     #if !defined(GD_IDE_ONLY)
+    if ( scene.renderWindow == NULL ) return;
+
     if ( fullscreen && !scene.RenderWindowIsFullScreen() )
     {
         scene.SetRenderWindowIsFullScreen();
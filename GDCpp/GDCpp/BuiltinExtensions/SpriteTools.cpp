@@ -10,7 +10,6 @@
 #include "GDCpp/RuntimeScene.h"
 #include "GDCpp/ObjectsListsTools.h"
 #include "GDCpp/Collisions.h"
-#include "GDCpp/profile.h"
 #include "GDCpp/BuiltinExtensions/ObjectTools.h"
 
 using namespace std;
@@ -67,11 +67,18 @@ CppPlatform::CppPlatform() :
         CodeCompiler::Get()->SetOutputDirectory(ToString(eventsCompilerTempDir));
     else
         CodeCompiler::Get()->SetOutputDirectory(ToString(wxFileName::GetTempDir()+"/GDTemporaries"));
-    int eventsCompilerMaxThread = 0;
-    if ( wxConfigBase::Get()->Read("/CodeCompiler/MaxThread", &eventsCompilerMaxThread, 0) && eventsCompilerMaxThread >= 0 )
+
+    //The compilation cache is kept when the IDE is closed, so that unchanged scenes are not compiled again.
+    wxString compilationCacheDir;
+    if ( wxConfigBase::Get()->Read("/CodeCompiler/CacheDir", &compilationCacheDir) && !compilationCacheDir.empty() )
+        CodeCompiler::Get()->GetCache().SetDirectory(ToString(compilationCacheDir));
+    else
+        CodeCompiler::Get()->GetCache().SetDirectory(ToString(wxFileName::GetTempDir()+"/GDCompilationCache"));
+    int eventsCompilerMaxThread = 0; //By default, launch as many compiler processes as there are CPUs.
+    if ( wxConfigBase::Get()->Read("/CodeCompiler/MaxThread", &eventsCompilerMaxThread, 0) && eventsCompilerMaxThread > 0 )
         CodeCompiler::Get()->AllowMultithread(eventsCompilerMaxThread > 1, eventsCompilerMaxThread);
     else
-        CodeCompiler::Get()->AllowMultithread(false);
+        CodeCompiler::Get()->AllowMultithread(true);
 
     cout << "* Loading events code compiler configuration" << endl;
     bool deleteTemporaries;
@@ -131,17 +138,21 @@ bool CppPlatform::AddExtension(std::shared_ptr<gd::PlatformExtension> platformEx
 
 std::shared_ptr<RuntimeObject> CppPlatform::CreateRuntimeObject(RuntimeScene & scene, gd::Object & object)
 {
-    const std::string & type = object.GetType();
-
-    if ( runtimeObjCreationFunctionTable.find(type) == runtimeObjCreationFunctionTable.end() )
+    CreateRuntimeObjectFunPtr createFunction = GetRuntimeObjectCreationFunction(object.GetType());
+    if ( !createFunction )
     {
-        std::cout << "Tried to create an object with an unknown type: " << type << std::endl;
+        std::cout << "Tried to create an object with an unknown type: " << object.GetType() << std::endl;
         return std::shared_ptr<RuntimeObject>();
     }
 
     //Create a new object with the type we want.
-    RuntimeObject * newObject = runtimeObjCreationFunctionTable[type](scene, object);
-    return std::shared_ptr<RuntimeObject>(newObject);
+    return std::shared_ptr<RuntimeObject>(createFunction(scene, object));
+}
+
+CreateRuntimeObjectFunPtr CppPlatform::GetRuntimeObjectCreationFunction(const std::string & type) const
+{
+    std::map < std::string, CreateRuntimeObjectFunPtr >::const_iterator it = runtimeObjCreationFunctionTable.find(type);
+    return it != runtimeObjCreationFunctionTable.end() ? it->second : NULL;
 }
 
 #if defined(GD_IDE_ONLY)
@@ -44,6 +44,14 @@ public:
      */
     std::shared_ptr<RuntimeObject> CreateRuntimeObject(RuntimeScene & scene, gd::Object & object);
 
+    /**
+     * \brief Return the function creating the RuntimeObject of the objects of type \a type,
+     * or NULL if the type is unknown.
+     *
+     * Useful to create a lot of objects of the same type without searching the function for each object.
+     */
+    CreateRuntimeObjectFunPtr GetRuntimeObjectCreationFunction(const std::string & type) const;
+
     /**
      * \brief Our platform need to do a bit of extra work when adding an extension
      * ( i.e : Storing pointers to creation/destruction functions ).
@@ -11,10 +11,14 @@
 #include <SFML/System.hpp>
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <string>
+#include <vector>
+#include <map>
 #include <wx/filefn.h>
 #include <wx/filename.h>
 #include <wx/datetime.h>
+#include <wx/dir.h>
 
 #include "GDCore/PlatformDefinition/Layout.h"
 #include "GDCore/PlatformDefinition/Project.h"
@@ -26,6 +30,7 @@
 #include "GDCpp/Events/EventsCodeGenerator.h"
 #include "GDCpp/CodeExecutionEngine.h"
 #include "GDCpp/IDE/DependenciesAnalyzer.h"
+#include "GDCpp/IDE/CodeCompilationCache.h"
 #include "GDCpp/IDE/BaseProfiler.h"
 #include "GDCpp/ExtensionBase.h"
 #include "GDCpp/CommonTools.h"
@@ -39,6 +44,65 @@ using namespace gd;
 //Tool functions
 namespace
 {
+    /**
+     * The object files compiled from the units of the events of each scene ( see EventsCodeGenerator::GenerateSceneEventsSplitCode ),
+     * to be linked with the object file of the scene.
+     *
+     * Scenes are identified by GetSceneEventsUnitsFilesPrefix rather than by their address, which can be reused
+     * by a new scene once a scene is deleted. Deleting or renaming a scene triggers its recompilation, which updates the list.
+     */
+    std::map<std::string, std::vector<std::string> > scenesEventsUnitsObjectFiles;
+
+    /**
+     * Return the beginning of the names of the header and of the units generated for the events of a scene.
+     *
+     * It is made from the project file and the scene name rather than from the address of the scene: the header is
+     * included by the generated code, which must stay the same after the IDE is restarted ( see CodeCompilationCache ).
+     */
+    std::string GetSceneEventsUnitsFilesPrefix(const gd::Project & game, const gd::Layout & scene)
+    {
+        return "GD"+gd::SceneNameMangler::GetMangledSceneName(scene.GetName())+"_"+CodeCompilationCache::Hash(game.GetProjectFile()+"\n"+scene.GetName());
+    }
+
+    /**
+     * Write content to a file, unless the file already has this content.
+     * \return true if the file was written.
+     */
+    bool WriteFileIfChanged(const std::string & filename, const std::string & content)
+    {
+        {
+            std::ifstream existingFile(filename.c_str(), std::ios::in | std::ios::binary);
+            if ( existingFile.is_open() )
+            {
+                std::ostringstream existingContent;
+                existingContent << existingFile.rdbuf();
+                if ( existingContent.str() == content ) return false;
+            }
+        }
+
+        std::ofstream file(filename.c_str(), std::ios::out | std::ios::binary);
+        file << content;
+        return true;
+    }
+
+    /**
+     * Create and submit a task to the code compiler for compiling a unit of the events of a scene.
+     */
+    void CreateSceneEventsUnitCompilationTask(gd::Layout & scene, const std::string & sourceFile, const std::string & objectFile)
+    {
+        CodeCompilerTask task;
+        task.compilerCall.compilationForRuntime = false;
+        task.compilerCall.optimize = false;
+        task.compilerCall.eventsGeneratedCode = true;
+        task.compilerCall.inputFile = sourceFile;
+        task.compilerCall.outputFile = objectFile;
+        task.scene = &scene;
+        task.postWork = std::shared_ptr<CodeCompilerExtraWork>(new SourceFileCodeCompilerPostWork(&scene));
+        task.userFriendlyName = "Compilation of a group of events of scene "+scene.GetName();
+
+        CodeCompiler::Get()->AddTask(task);
+    }
+
     bool SourceFileNeedRecompilation(gd::Project & game, SourceFile & sourceFile)
     {
         if ( !wxFileExists(string(CodeCompiler::Get()->GetOutputDirectory()+"GD"+ToString(&sourceFile)+"ObjectFile.o") ))
@@ -186,7 +250,11 @@ namespace
         task.scene = &scene;
         task.userFriendlyName = "Linking code for scene "+scene.GetName();
 
-        //Also add scene dependencies to the files to be linked.
+        //Add the units of the scene events...
+        const std::vector<std::string> & unitsObjectFiles = scenesEventsUnitsObjectFiles[GetSceneEventsUnitsFilesPrefix(game, scene)];
+        task.compilerCall.extraObjectFiles.insert(task.compilerCall.extraObjectFiles.end(), unitsObjectFiles.begin(), unitsObjectFiles.end());
+
+        //...and scene dependencies to the files to be linked.
         DependenciesAnalyzer analyzer(game, scene);
         if ( !analyzer.Analyze() )
         {
@@ -264,19 +332,51 @@ bool EventsCodeCompilerPreWork::Execute()
         return true;
     }
 
-    gd::Project gameCopy = *game;
-    Scene sceneCopy = *scene;
+    //Only the events are copied, as the preprocessing modifies them. The project and the scene are used as is.
+    gd::EventsList eventsCopy = scene->GetEvents();
 
     //Generate the code
     cout << "Generating C++ code...\n";
-    if ( sceneCopy.GetProfiler() != NULL ) sceneCopy.GetProfiler()->profileEventsInformation.clear();
-    gd::EventsCodeGenerator::DeleteUselessEvents(sceneCopy.GetEvents());
+    if ( scene->GetProfiler() != NULL ) scene->GetProfiler()->profileEventsInformation.clear();
+    gd::EventsCodeGenerator::DeleteUselessEvents(eventsCopy);
+
+    //Groups of events and functions are generated in their own files, which are only compiled again when they are modified.
+    std::string unitsPrefix = GetSceneEventsUnitsFilesPrefix(*game, *scene);
+    std::string headerFilename = unitsPrefix+"EventsHeader.h";
+    std::string header;
+    std::vector<EventsCodeUnit> units;
+    std::string eventsOutput = ::EventsCodeGenerator::GenerateSceneEventsSplitCode(*game, *scene, eventsCopy, headerFilename, header, units, false /*Compilation for edittime*/);
+
+    WriteFileIfChanged(CodeCompiler::Get()->GetOutputDirectory()+headerFilename, header);
+    WriteFileIfChanged(CodeCompiler::Get()->GetOutputDirectory()+"GD"+ToString(scene)+"EventsSource.cpp", eventsOutput);
+
+    std::vector<std::string> & unitsObjectFiles = scenesEventsUnitsObjectFiles[unitsPrefix];
+    unitsObjectFiles.clear();
+    std::set<wxString> unitsFiles;
+    for (unsigned int i = 0;i<units.size();++i)
+    {
+        std::string unitSourceFile = CodeCompiler::Get()->GetOutputDirectory()+unitsPrefix+"EventsUnit"+units[i].key+".cpp";
+        std::string unitObjectFile = CodeCompiler::Get()->GetOutputDirectory()+unitsPrefix+"EventsUnit"+units[i].key+"ObjectFile.o";
+        unitsObjectFiles.push_back(unitObjectFile);
+        unitsFiles.insert(wxFileName(unitSourceFile).GetFullName());
+        unitsFiles.insert(wxFileName(unitObjectFile).GetFullName());
 
-    std::string eventsOutput = ::EventsCodeGenerator::GenerateSceneEventsCompleteCode(gameCopy, sceneCopy, sceneCopy.GetEvents(), false /*Compilation for edittime*/);
-    std::ofstream myfile;
-    myfile.open ( string(CodeCompiler::Get()->GetOutputDirectory()+"GD"+ToString(scene)+"EventsSource.cpp").c_str() );
-    myfile << eventsOutput;
-    myfile.close();
+        if ( WriteFileIfChanged(unitSourceFile, units[i].code) || !wxFileExists(unitObjectFile) )
+        {
+            //Remove the outdated object file: if the compilation fails, the unit will be compiled again next time.
+            if ( wxFileExists(unitObjectFile) ) wxRemoveFile(unitObjectFile);
+            CreateSceneEventsUnitCompilationTask(*scene, unitSourceFile, unitObjectFile);
+        }
+    }
+
+    //Remove the files of the units which do not exist anymore.
+    wxArrayString existingFiles;
+    wxDir::GetAllFiles(CodeCompiler::Get()->GetOutputDirectory(), &existingFiles, unitsPrefix+"EventsUnit*", wxDIR_FILES);
+    for (unsigned int i = 0;i<existingFiles.size();++i)
+    {
+        if ( unitsFiles.find(wxFileName(existingFiles[i]).GetFullName()) == unitsFiles.end() )
+            wxRemoveFile(existingFiles[i]);
+    }
 
     return true;
 }
@@ -305,14 +405,14 @@ bool EventsCodeCompilerRuntimePreWork::Execute()
         return true;
     }
 
-    gd::Project gameCopy = *game;
-    Scene sceneCopy = *scene;
+    //Only the events are copied, as the preprocessing modifies them. The project and the scene are used as is.
+    gd::EventsList eventsCopy = scene->GetEvents();
 
     //Generate the code
     cout << "Generating C++ code...\n";
-    gd::EventsCodeGenerator::DeleteUselessEvents(sceneCopy.GetEvents());
+    gd::EventsCodeGenerator::DeleteUselessEvents(eventsCopy);
 
-    std::string eventsOutput = ::EventsCodeGenerator::GenerateSceneEventsCompleteCode(gameCopy, sceneCopy, sceneCopy.GetEvents(), true /*Compilation for runtime*/);
+    std::string eventsOutput = ::EventsCodeGenerator::GenerateSceneEventsCompleteCode(*game, *scene, eventsCopy, true /*Compilation for runtime*/);
     std::ofstream myfile;
     myfile.open ( string(CodeCompiler::Get()->GetOutputDirectory()+"GD"+ToString(scene)+"RuntimeEventsSource.cpp").c_str() );
     myfile << eventsOutput;
@@ -405,14 +505,14 @@ bool ExternalEventsCodeCompilerPreWork::Execute()
         return true;
     }
 
-    gd::Project gameCopy = *game;
-    gd::ExternalEvents eventsCopy = *externalEvents;
+    //Only the events are copied, as the preprocessing modifies them.
+    gd::EventsList eventsCopy = externalEvents->GetEvents();
 
     //Generate the code
     cout << "Generating C++ code...\n";
-    gd::EventsCodeGenerator::DeleteUselessEvents(eventsCopy.GetEvents());
+    gd::EventsCodeGenerator::DeleteUselessEvents(eventsCopy);
 
-    std::string eventsOutput = ::EventsCodeGenerator::GenerateExternalEventsCompleteCode(gameCopy, eventsCopy, false /*Compilation for edittime*/);
+    std::string eventsOutput = ::EventsCodeGenerator::GenerateExternalEventsCompleteCode(*game, *externalEvents, eventsCopy, false /*Compilation for edittime*/);
     std::ofstream myfile;
     myfile.open ( string(CodeCompiler::Get()->GetOutputDirectory()+"GD"+ToString(externalEvents)+"EventsSource.cpp").c_str() );
     myfile << eventsOutput;
@@ -480,14 +580,14 @@ bool ExternalEventsCodeCompilerRuntimePreWork::Execute()
         return true;
     }
 
-    gd::Project gameCopy = *game;
-    gd::ExternalEvents eventsCopy = *externalEvents;
+    //Only the events are copied, as the preprocessing modifies them.
+    gd::EventsList eventsCopy = externalEvents->GetEvents();
 
     //Generate the code
     cout << "Generating C++ code...\n";
-    gd::EventsCodeGenerator::DeleteUselessEvents(eventsCopy.GetEvents());
+    gd::EventsCodeGenerator::DeleteUselessEvents(eventsCopy);
 
-    std::string eventsOutput = ::EventsCodeGenerator::GenerateExternalEventsCompleteCode(gameCopy, eventsCopy, true /*Compilation for runtime*/);
+    std::string eventsOutput = ::EventsCodeGenerator::GenerateExternalEventsCompleteCode(*game, *externalEvents, eventsCopy, true /*Compilation for runtime*/);
     std::ofstream myfile;
     myfile.open ( string(CodeCompiler::Get()->GetOutputDirectory()+"GD"+ToString(externalEvents)+"RuntimeEventsSource.cpp").c_str() );
     myfile << eventsOutput;
@@ -5,6 +5,7 @@
  */
 
 #if defined(GD_IDE_ONLY)
+#include <cstdio>
 #include "GDCpp/IDE/DependenciesAnalyzer.h"
 #include "GDCpp/CppPlatform.h"
 #include "GDCore/Events/EventsCodeGenerationContext.h"
@@ -16,6 +17,9 @@
 #include "GDCore/PlatformDefinition/Layout.h"
 #include "GDCore/Events/EventsCodeNameMangler.h"
 #include "GDCore/Events/EventsCodeGenerator.h"
+#include "GDCore/Events/Serialization.h"
+#include "GDCore/Serialization/Serializer.h"
+#include "GDCore/Serialization/SerializerElement.h"
 #include "GDCore/CommonTools.h"
 #include "GDCpp/Events/EventsCodeGenerator.h"
 #include "GDCpp/IDE/BaseProfiler.h"
@@ -25,6 +29,58 @@
 
 using namespace std;
 
+namespace
+{
+
+/**
+ * Compute a 32 bits hash (FNV-1a) of a string.
+ */
+unsigned int HashString(const std::string & str)
+{
+    unsigned int hash = 2166136261U;
+    for (unsigned int i = 0;i<str.size();++i)
+    {
+        hash ^= static_cast<unsigned char>(str[i]);
+        hash *= 16777619U;
+    }
+
+    return hash;
+}
+
+std::string ToHexString(unsigned int value)
+{
+    char result[9];
+    snprintf(result, sizeof(result), "%08x", value);
+    return result;
+}
+
+/**
+ * Generate the includes and the global declarations needed by the events code.
+ */
+std::string GenerateIncludesAndDeclarations(const std::set<std::string> & includeFiles, const std::set<std::string> & globalDeclarations)
+{
+    std::string output = "#include <vector>\n#include <map>\n#include <string>\n#include <algorithm>\n#include <SFML/System/Clock.hpp>\n#include <SFML/System/Vector2.hpp>\n#include <SFML/Graphics/Color.hpp>\n#include \"GDCpp/RuntimeContext.h\"\n#include \"GDCpp/RuntimeObject.h\"\n";
+    for ( set<string>::const_iterator include = includeFiles.begin() ; include != includeFiles.end(); ++include )
+        output += "#include \""+*include+"\"\n";
+
+    //Extra declarations needed by events
+    for ( set<string>::const_iterator declaration = globalDeclarations.begin() ; declaration != globalDeclarations.end(); ++declaration )
+        output += *declaration+"\n";
+
+    return output;
+}
+
+/**
+ * Return true if the top-level event must be generated in its own unit.
+ */
+bool MustBeGeneratedInAUnit(const gd::BaseEvent & event)
+{
+    return !event.IsDisabled() &&
+        (event.GetType() == "BuiltinCommonInstructions::Group" || event.GetType() == "Function::Function");
+}
+
+}
+
 std::string EventsCodeGenerator::GenerateObjectFunctionCall(std::string objectListName,
                                                       const gd::ObjectMetadata & objMetadata,
                                                       const gd::ExpressionCodeGenerationInformation & codeInfo,
@@ -407,28 +463,23 @@ std::string EventsCodeGenerator::GenerateParameterCodes(const std::string & para
     return argOutput;
 }
 
-string EventsCodeGenerator::GenerateSceneEventsCompleteCode(gd::Project & project, gd::Layout & scene, gd::EventsList & events, bool compilationForRuntime)
+string EventsCodeGenerator::GenerateSceneEventsCompleteCode(gd::Project & project, const gd::Layout & scene, gd::EventsList & events, bool compilationForRuntime)
 {
     string output;
 
     //Prepare the global context ( Used to get needed header files )
     gd::EventsCodeGenerationContext context;
     EventsCodeGenerator codeGenerator(project, scene);
-    codeGenerator.PreprocessEventList(scene.GetEvents());
+    codeGenerator.PreprocessEventList(events);
     codeGenerator.SetGenerateCodeForRuntime(compilationForRuntime);
+    codeGenerator.SetStableIdentifiersSeed(HashString("scene:"+scene.GetName()));
 
     //Generate whole events code
     string wholeEventsCode = codeGenerator.GenerateEventsListCode(events, context);
 
     //Generate default code around events:
-    //Includes
-    output += "#include <vector>\n#include <map>\n#include <string>\n#include <algorithm>\n#include <SFML/System/Clock.hpp>\n#include <SFML/System/Vector2.hpp>\n#include <SFML/Graphics/Color.hpp>\n#include \"GDCpp/RuntimeContext.h\"\n#include \"GDCpp/RuntimeObject.h\"\n";
-    for ( set<string>::iterator include = codeGenerator.GetIncludeFiles().begin() ; include != codeGenerator.GetIncludeFiles().end(); ++include )
-        output += "#include \""+*include+"\"\n";
-
-    //Extra declarations needed by events
-    for ( set<string>::iterator declaration = codeGenerator.GetCustomGlobalDeclaration().begin() ; declaration != codeGenerator.GetCustomGlobalDeclaration().end(); ++declaration )
-        output += *declaration+"\n";
+    //Includes and extra declarations needed by events
+    output += GenerateIncludesAndDeclarations(codeGenerator.GetIncludeFiles(), codeGenerator.GetCustomGlobalDeclaration());
 
     output +=
     codeGenerator.GetCustomCodeOutsideMain()+
@@ -444,9 +495,108 @@ string EventsCodeGenerator::GenerateSceneEventsCompleteCode(gd::Project & projec
     return output;
 }
 
-std::string EventsCodeGenerator::GenerateExternalEventsCompleteCode(gd::Project & project, gd::ExternalEvents & events, bool compilationForRuntime)
+string EventsCodeGenerator::GenerateSceneEventsSplitCode(gd::Project & project, const gd::Layout & scene, gd::EventsList & events,
+    const std::string & headerFilename, std::string & header, std::vector<EventsCodeUnit> & units, bool compilationForRuntime)
 {
-    DependenciesAnalyzer analyzer(project, events);
+    EventsCodeGenerator codeGenerator(project, scene);
+    codeGenerator.PreprocessEventList(events);
+    codeGenerator.SetGenerateCodeForRuntime(compilationForRuntime);
+    codeGenerator.SetStableIdentifiersSeed(HashString("scene:"+scene.GetName()));
+
+    std::string sceneFunctionName = "GDSceneEvents"+gd::SceneNameMangler::GetMangledSceneName(scene.GetName());
+    std::set<std::string> includeFiles;
+    std::set<std::string> globalDeclarations;
+    std::set<unsigned int> usedKeys;
+    std::string unitsDeclarations;
+    std::vector<std::string> unitsCode;
+    units.clear();
+
+    //Top-level events are generated in a root context and so only depend on the runtime context:
+    //they can be generated separately. Consecutive events which are not generated in a unit stay in the main file.
+    string mainEventsCode;
+    gd::EventsList mainEvents;
+    for (unsigned int i = 0;i<events.size();++i)
+    {
+        if ( !MustBeGeneratedInAUnit(events[i]) )
+        {
+            mainEvents.InsertEvent(events.GetEventSmartPtr(i));
+            continue;
+        }
+
+        if ( !mainEvents.IsEmpty() )
+        {
+            gd::EventsCodeGenerationContext mainContext;
+            mainEventsCode += codeGenerator.GenerateEventsListCode(mainEvents, mainContext);
+            mainEvents.Clear();
+        }
+
+        gd::EventsList unitEvents;
+        unitEvents.InsertEvent(events.GetEventSmartPtr(i));
+
+        //The key only depends on the events, so that the generated code, and the identifiers it uses,
+        //stay the same as long as the events are not modified.
+        gd::SerializerElement serializedEvents;
+        gd::EventsListSerialization::SerializeEventsTo(unitEvents, serializedEvents);
+        unsigned int key = HashString(gd::Serializer::ToJSON(serializedEvents));
+        while ( usedKeys.find(key) != usedKeys.end() ) key = HashString(ToHexString(key));
+        usedKeys.insert(key);
+
+        EventsCodeGenerator unitGenerator(project, scene);
+        unitGenerator.SetGenerateCodeForRuntime(compilationForRuntime);
+        unitGenerator.SetStableIdentifiersSeed(HashString("unit:"+ToHexString(key)));
+
+        gd::EventsCodeGenerationContext context;
+        string unitEventsCode = unitGenerator.GenerateEventsListCode(unitEvents, context);
+
+        includeFiles.insert(unitGenerator.GetIncludeFiles().begin(), unitGenerator.GetIncludeFiles().end());
+        globalDeclarations.insert(unitGenerator.GetCustomGlobalDeclaration().begin(), unitGenerator.GetCustomGlobalDeclaration().end());
+
+        EventsCodeUnit unit;
+        unit.key = ToHexString(key);
+        std::string unitFunctionName = sceneFunctionName+"_"+unit.key;
+        units.push_back(unit);
+        unitsCode.push_back(
+            unitGenerator.GetCustomCodeOutsideMain()+
+            "\n"
+            "void "+unitFunctionName+"(RuntimeContext * runtimeContext)\n"
+            "{\n"+
+            unitGenerator.GetCustomCodeInMain()+
+            unitEventsCode+
+            "}\n");
+
+        unitsDeclarations += "void "+unitFunctionName+"(RuntimeContext * runtimeContext);\n";
+        mainEventsCode += unitFunctionName+"(runtimeContext);\n";
+    }
+    if ( !mainEvents.IsEmpty() )
+    {
+        gd::EventsCodeGenerationContext mainContext;
+        mainEventsCode += codeGenerator.GenerateEventsListCode(mainEvents, mainContext);
+    }
+
+    includeFiles.insert(codeGenerator.GetIncludeFiles().begin(), codeGenerator.GetIncludeFiles().end());
+    globalDeclarations.insert(codeGenerator.GetCustomGlobalDeclaration().begin(), codeGenerator.GetCustomGlobalDeclaration().end());
+    header = GenerateIncludesAndDeclarations(includeFiles, globalDeclarations)+unitsDeclarations;
+
+    //The hash of the header is written in each file, so that a file is modified (and compiled again) when the header is.
+    std::string includeHeader = "#include \""+headerFilename+"\" //"+ToHexString(HashString(header))+"\n";
+    for (unsigned int i = 0;i<units.size();++i)
+        units[i].code = includeHeader+unitsCode[i];
+
+    return includeHeader+
+    codeGenerator.GetCustomCodeOutsideMain()+
+    "\n"
+    "extern \"C\" int "+sceneFunctionName+"(RuntimeContext * runtimeContext)\n"
+    "{\n"+
+    "runtimeContext->StartNewFrame();\n"+
+    codeGenerator.GetCustomCodeInMain()+
+    mainEventsCode+
+    "return 0;\n"
+    "}\n";
+}
+
+std::string EventsCodeGenerator::GenerateExternalEventsCompleteCode(gd::Project & project, gd::ExternalEvents & externalEvents, gd::EventsList & events, bool compilationForRuntime)
+{
+    DependenciesAnalyzer analyzer(project, externalEvents);
     std::string associatedSceneName = analyzer.ExternalEventsCanBeCompiledForAScene();
     if ( associatedSceneName.empty() || !project.HasLayoutNamed(associatedSceneName) )
     {
@@ -460,26 +610,21 @@ std::string EventsCodeGenerator::GenerateExternalEventsCompleteCode(gd::Project
     //Prepare the global context ( Used to get needed header files )
     gd::EventsCodeGenerationContext context;
     EventsCodeGenerator codeGenerator(project, associatedScene);
-    codeGenerator.PreprocessEventList(events.GetEvents());
+    codeGenerator.PreprocessEventList(events);
     codeGenerator.SetGenerateCodeForRuntime(compilationForRuntime);
+    codeGenerator.SetStableIdentifiersSeed(HashString("external:"+externalEvents.GetName()));
 
     //Generate whole events code
-    string wholeEventsCode = codeGenerator.GenerateEventsListCode(events.GetEvents(), context);
+    string wholeEventsCode = codeGenerator.GenerateEventsListCode(events, context);
 
     //Generate default code around events:
-    //Includes
-    output += "#include <vector>\n#include <map>\n#include <string>\n#include <algorithm>\n#include <SFML/System/Clock.hpp>\n#include <SFML/System/Vector2.hpp>\n#include <SFML/Graphics/Color.hpp>\n#include \"GDCpp/RuntimeContext.h\"\n#include \"GDCpp/RuntimeObject.h\"\n";
-    for ( set<string>::iterator include = codeGenerator.GetIncludeFiles().begin() ; include != codeGenerator.GetIncludeFiles().end(); ++include )
-        output += "#include \""+*include+"\"\n";
-
-    //Extra declarations needed by events
-    for ( set<string>::iterator declaration = codeGenerator.GetCustomGlobalDeclaration().begin() ; declaration != codeGenerator.GetCustomGlobalDeclaration().end(); ++declaration )
-        output += *declaration+"\n";
+    //Includes and extra declarations needed by events
+    output += GenerateIncludesAndDeclarations(codeGenerator.GetIncludeFiles(), codeGenerator.GetCustomGlobalDeclaration());
 
     output +=
     codeGenerator.GetCustomCodeOutsideMain()+
     "\n"
-    "void "+EventsCodeNameMangler::Get()->GetExternalEventsFunctionMangledName(events.GetName())+"(RuntimeContext * runtimeContext)\n"
+    "void "+EventsCodeNameMangler::Get()->GetExternalEventsFunctionMangledName(externalEvents.GetName())+"(RuntimeContext * runtimeContext)\n"
     "{\n"
 	+codeGenerator.GetCustomCodeInMain()
     +wholeEventsCode+
@@ -17,6 +17,17 @@ namespace gd { class AutomatismMetadata; }
 namespace gd { class InstructionMetadata; }
 namespace gd { class ExpressionCodeGenerationInformation; }
 
+/**
+ * \brief A C++ file generated for a part of the events of a scene.
+ * \see EventsCodeGenerator::GenerateSceneEventsSplitCode
+ */
+class GD_API EventsCodeUnit
+{
+public:
+    std::string key; ///< Identifier computed from the events of the unit: the same events always give the same key.
+    std::string code; ///< The C++ code of the unit.
+};
+
 class GD_API EventsCodeGenerator : public gd::EventsCodeGenerator
 {
   friend class VariableCodeGenerationCallbacks;
@@ -27,22 +38,41 @@ public:
      *
      * \param project Game used
      * \param scene Scene used
-     * \param events events of the scene
+     * \param events events of the scene. They are modified by the preprocessing ( links are replaced by the linked events... ),
+     * so give a copy of the scene events: the project and the scene do not need to be copied.
      * \param compilationForRuntime Set this to true if the code is generated for runtime.
      * \return C++ code
      */
-    static std::string GenerateSceneEventsCompleteCode(gd::Project & project, gd::Layout & scene, gd::EventsList & events, bool compilationForRuntime = false);
+    static std::string GenerateSceneEventsCompleteCode(gd::Project & project, const gd::Layout & scene, gd::EventsList & events, bool compilationForRuntime = false);
+
+    /**
+     * Generate the C++ files for compiling events of a scene, each top-level group of events and each
+     * top-level function being generated in its own file ( "unit" ). When an event is modified, only
+     * the unit containing it and the main file are changed and must be compiled again.
+     *
+     * \param project Game used
+     * \param scene Scene used
+     * \param events events of the scene ( give a copy, see GenerateSceneEventsCompleteCode ).
+     * \param headerFilename The name of the file where the header will be written. All the files include it.
+     * \param header Filled with the code of the header, declaring the functions of the units.
+     * \param units Filled with the units.
+     * \param compilationForRuntime Set this to true if the code is generated for runtime.
+     * \return C++ code of the main file, which defines the function of the scene events calling the units.
+     */
+    static std::string GenerateSceneEventsSplitCode(gd::Project & project, const gd::Layout & scene, gd::EventsList & events,
+        const std::string & headerFilename, std::string & header, std::vector<EventsCodeUnit> & units, bool compilationForRuntime = false);
 
     /**
      * Generate complete C++ file for compiling external events.
      * \note If events.AreCompiled() == false, no code is generated.
      *
      * \param project Game used
-     * \param events External events used.
+     * \param externalEvents External events used.
+     * \param events events of the external events. As for GenerateSceneEventsCompleteCode, give a copy of the events.
      * \param compilationForRuntime Set this to true if the code is generated for runtime.
      * \return C++ code
      */
-    static std::string GenerateExternalEventsCompleteCode(gd::Project & project, gd::ExternalEvents & events, bool compilationForRuntime = false);
+    static std::string GenerateExternalEventsCompleteCode(gd::Project & project, gd::ExternalEvents & externalEvents, gd::EventsList & events, bool compilationForRuntime = false);
 
     /**
      * \brief GD C++ Platform has a specific processing function so as to handle profiling.
@@ -1,5 +1,6 @@
 #include "GDCpp/FontManager.h"
 #include "GDCpp/ResourcesLoader.h"
+#include "GDCpp/TextRenderer.h"
 #include <SFML/Graphics.hpp>
 #include <string>
 #include <vector>
@@ -16,6 +17,9 @@ FontManager::~FontManager()
 
 void FontManager::UnloadAllFonts()
 {
+    //The glyphs atlases refer to the fonts.
+    TextRenderer::Get()->ClearAtlases();
+
     //Need to explicit delete fonts...
     for ( map<string, sf::Font*>::iterator it=fonts.begin() ; it != fonts.end(); ++it )
     {
@@ -0,0 +1,241 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2015 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#include "GDCpp/FrameProfiler.h"
+#include "GDCpp/AllocationsTracker.h"
+#include <SFML/System/Mutex.hpp>
+#include <SFML/System/Lock.hpp>
+#include <SFML/System/ThreadLocalPtr.hpp>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+bool FrameProfiler::enabled = false;
+
+namespace
+{
+    /**
+     * A scope recorded by the profiler.
+     */
+    struct ProfiledScope
+    {
+        const char * name;
+        long long begin; ///< In nanoseconds, since the start of the profiler.
+        long long end;
+        AllocationsCount allocated; ///< The allocations made during the scope, including its children.
+    };
+
+    /**
+     * A scope started and not ended yet.
+     */
+    struct OpenScope
+    {
+        OpenScope(const char * name_, long long begin_, AllocationsCount allocated_) :
+            name(name_), begin(begin_), allocated(allocated_) {};
+
+        const char * name;
+        long long begin;
+        AllocationsCount allocated; ///< The allocations made since the start of the program, when the scope started.
+    };
+
+    /**
+     * The scopes recorded by a thread.
+     */
+    struct ThreadBuffer
+    {
+        ThreadBuffer(unsigned int threadId_, std::size_t capacity) :
+            threadId(threadId_),
+            next(0),
+            wrapped(false)
+        {
+            scopes.resize(capacity);
+        };
+
+        unsigned int threadId;
+        std::vector<OpenScope> openScopes; ///< The scopes started and not ended yet. Only used by the thread.
+        std::unordered_map<std::string, const char *> names; ///< The names already returned to the thread by FrameProfiler::GetName.
+
+        sf::Mutex mutex; ///< Protect the ring buffer, which is read when exporting.
+        std::vector<ProfiledScope> scopes; ///< The ring buffer of the ended scopes.
+        std::size_t next; ///< The position where the next scope is written.
+        bool wrapped; ///< true if the oldest scopes were overwritten.
+    };
+
+    sf::Mutex buffersMutex; ///< Protect buffers, bufferCapacity and names.
+    std::vector< std::shared_ptr<ThreadBuffer> > buffers; ///< The buffers of all the threads, kept even when a thread exits.
+    std::size_t bufferCapacity = 65536;
+    std::set<std::string> names; ///< The names returned by FrameProfiler::GetName.
+    sf::ThreadLocalPtr<ThreadBuffer> threadBuffer;
+    const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    long long Now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()-startTime).count();
+    }
+
+    ThreadBuffer & GetThreadBuffer()
+    {
+        if ( !threadBuffer )
+        {
+            sf::Lock lock(buffersMutex);
+            std::shared_ptr<ThreadBuffer> buffer(new ThreadBuffer(buffers.size()+1, bufferCapacity));
+            buffers.push_back(buffer);
+            threadBuffer = buffer.get();
+        }
+
+        return *threadBuffer;
+    }
+
+    void WriteEscapedString(std::string & output, const char * str)
+    {
+        output += '"';
+        for (const char * c = str;*c;++c)
+        {
+            if ( *c == '"' || *c == '\\' )
+            {
+                output += '\\';
+                output += *c;
+            }
+            else if ( static_cast<unsigned char>(*c) < 0x20 )
+            {
+                char escaped[8];
+                snprintf(escaped, sizeof(escaped), "\\u%04X", static_cast<int>(*c));
+                output += escaped;
+            }
+            else
+                output += *c;
+        }
+        output += '"';
+    }
+}
+
+void FrameProfiler::Enable(bool enable)
+{
+    enabled = enable;
+}
+
+void FrameProfiler::SetBufferCapacity(std::size_t scopesCount)
+{
+    sf::Lock lock(buffersMutex);
+    bufferCapacity = scopesCount > 0 ? scopesCount : 1;
+    for (std::size_t i = 0;i<buffers.size();++i)
+    {
+        sf::Lock bufferLock(buffers[i]->mutex);
+        buffers[i]->scopes.clear();
+        buffers[i]->scopes.resize(bufferCapacity);
+        buffers[i]->next = 0;
+        buffers[i]->wrapped = false;
+    }
+}
+
+void FrameProfiler::Clear()
+{
+    sf::Lock lock(buffersMutex);
+    for (std::size_t i = 0;i<buffers.size();++i)
+    {
+        sf::Lock bufferLock(buffers[i]->mutex);
+        buffers[i]->next = 0;
+        buffers[i]->wrapped = false;
+    }
+}
+
+void FrameProfiler::BeginScope(const char * name)
+{
+    ThreadBuffer & buffer = GetThreadBuffer();
+    buffer.openScopes.push_back(OpenScope(name, Now(), AllocationsCount()));
+    buffer.openScopes.back().allocated = AllocationsTracker::GetCount(); //After the push_back, which can allocate.
+}
+
+void FrameProfiler::EndScope()
+{
+    ThreadBuffer & buffer = GetThreadBuffer();
+    if ( buffer.openScopes.empty() ) return;
+
+    ProfiledScope scope;
+    scope.name = buffer.openScopes.back().name;
+    scope.begin = buffer.openScopes.back().begin;
+    scope.end = Now();
+    scope.allocated = AllocationsTracker::GetCount()-buffer.openScopes.back().allocated;
+    buffer.openScopes.pop_back();
+
+    sf::Lock lock(buffer.mutex);
+    buffer.scopes[buffer.next] = scope;
+    buffer.next++;
+    if ( buffer.next >= buffer.scopes.size() )
+    {
+        buffer.next = 0;
+        buffer.wrapped = true;
+    }
+}
+
+const char * FrameProfiler::GetName(const std::string & name)
+{
+    //Look for the name in the thread first, to avoid locking.
+    ThreadBuffer & buffer = GetThreadBuffer();
+    std::unordered_map<std::string, const char *>::const_iterator it = buffer.names.find(name);
+    if ( it != buffer.names.end() ) return it->second;
+
+    sf::Lock lock(buffersMutex);
+    const char * storedName = names.insert(name).first->c_str();
+    buffer.names[name] = storedName;
+    return storedName;
+}
+
+void FrameProfiler::WriteChromeTrace(std::string & output)
+{
+    output += "{\"traceEvents\":[";
+    bool firstEvent = true;
+    bool writeAllocations = AllocationsTracker::IsEnabled();
+
+    sf::Lock lock(buffersMutex);
+    for (std::size_t i = 0;i<buffers.size();++i)
+    {
+        ThreadBuffer & buffer = *buffers[i];
+        sf::Lock bufferLock(buffer.mutex);
+
+        //Write the scopes from the oldest to the latest.
+        std::size_t count = buffer.wrapped ? buffer.scopes.size() : buffer.next;
+        std::size_t first = buffer.wrapped ? buffer.next : 0;
+        for (std::size_t j = 0;j<count;++j)
+        {
+            const ProfiledScope & scope = buffer.scopes[(first+j) % buffer.scopes.size()];
+
+            char times[128];
+            snprintf(times, sizeof(times), ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u",
+                static_cast<double>(scope.begin)/1000.0, static_cast<double>(scope.end-scope.begin)/1000.0, buffer.threadId);
+
+            if ( !firstEvent ) output += ",\n";
+            output += "{\"name\":";
+            WriteEscapedString(output, scope.name);
+            output += times;
+            if ( writeAllocations ) //Shown by the trace viewer when the scope is selected.
+            {
+                char allocations[96];
+                snprintf(allocations, sizeof(allocations), ",\"args\":{\"allocations\":%llu,\"bytes\":%llu}",
+                    scope.allocated.allocations, scope.allocated.bytes);
+                output += allocations;
+            }
+            output += '}';
+            firstEvent = false;
+        }
+    }
+
+    output += "],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+bool FrameProfiler::ExportChromeTrace(const std::string & filename)
+{
+    std::string trace;
+    WriteChromeTrace(trace);
+
+    FILE * file = fopen(filename.c_str(), "wb");
+    if ( !file ) return false;
+
+    bool written = fwrite(trace.data(), 1, trace.size(), file) == trace.size();
+    return fclose(file) == 0 && written;
+}
@@ -0,0 +1,127 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2015 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#ifndef FRAMEPROFILER_H
+#define FRAMEPROFILER_H
+#include <string>
+#include <cstddef>
+
+/**
+ * \brief Hierarchical profiler of the runtime, recording the time spent in scopes ( events, automatisms, rendering... ).
+ *
+ * The profiler is always compiled, but records nothing until it is enabled: a disabled scope only costs a test.
+ * Each thread records its scopes in its own ring buffer, so that only the latest scopes are kept when
+ * the profiler runs for a long time. The recorded scopes can be exported as a Chrome trace
+ * ( open chrome://tracing and load the file ).
+ * When the allocations are tracked ( see AllocationsTracker ), the allocations made during each scope,
+ * including its children, are exported as the arguments of the scope.
+ *
+ * Usage example:
+ * \code
+ * void RuntimeScene::Render()
+ * {
+ *     GD_PROFILE_SCOPE("Render");
+ *     ...
+ * }
+ *
+ * FrameProfiler::Enable();
+ * //...
+ * FrameProfiler::ExportChromeTrace("trace.json");
+ * \endcode
+ *
+ * Exported games are profiled when launched with <code>-profile=trace.json</code>: the trace is written when the game exits.
+ *
+ * \ingroup GameEngine
+ */
+class GD_API FrameProfiler
+{
+public:
+    /**
+     * \brief Start or stop recording the scopes.
+     */
+    static void Enable(bool enable = true);
+
+    /**
+     * \brief Return true if the scopes are recorded.
+     */
+    static bool IsEnabled() { return enabled; };
+
+    /**
+     * \brief Change the number of scopes kept for each thread. The oldest scopes are overwritten when the buffer is full.
+     * \note Clear the recorded scopes.
+     */
+    static void SetBufferCapacity(std::size_t scopesCount);
+
+    /**
+     * \brief Remove all the recorded scopes.
+     */
+    static void Clear();
+
+    /**
+     * \brief Start a scope in the current thread. Prefer using GD_PROFILE_SCOPE.
+     * \param name The name of the scope. It must stay valid until the scopes are exported ( use a literal or GetName ).
+     */
+    static void BeginScope(const char * name);
+
+    /**
+     * \brief End the latest scope started in the current thread. Prefer using GD_PROFILE_SCOPE.
+     */
+    static void EndScope();
+
+    /**
+     * \brief Return a copy of \a name which stays valid until the program exits, to be used as the name of a scope.
+     */
+    static const char * GetName(const std::string & name);
+
+    /**
+     * \brief Return \a name, a string literal, which already stays valid until the program exits.
+     */
+    static const char * GetName(const char * name) { return name; };
+
+    /**
+     * \brief Write the recorded scopes, in the Chrome trace event format, at the end of \a output.
+     */
+    static void WriteChromeTrace(std::string & output);
+
+    /**
+     * \brief Write the recorded scopes to a file, in the Chrome trace event format.
+     * \return true if the file was written.
+     */
+    static bool ExportChromeTrace(const std::string & filename);
+
+private:
+    static bool enabled;
+};
+
+/**
+ * \brief Record a scope of the FrameProfiler, from its construction to its destruction.
+ *
+ * \see GD_PROFILE_SCOPE
+ * \ingroup GameEngine
+ */
+class GD_API FrameProfilerScope
+{
+public:
+    /**
+     * \param name The name of the scope ( see FrameProfiler::BeginScope ), or NULL to record nothing.
+     */
+    FrameProfilerScope(const char * name) : active(name != NULL) { if (active) FrameProfiler::BeginScope(name); };
+
+    ~FrameProfilerScope() { if (active) FrameProfiler::EndScope(); };
+
+private:
+    bool active; ///< true if the scope was started, even if the profiler was disabled since.
+};
+
+#define GD_PROFILE_SCOPE_CONCATENATE(a, b) a ## b
+#define GD_PROFILE_SCOPE_VARIABLE(line) GD_PROFILE_SCOPE_CONCATENATE(profilerScope, line)
+
+/**
+ * \brief Record the time spent from this line to the end of the enclosing block, if the FrameProfiler is enabled.
+ * \param name A string literal or a std::string. It is only evaluated if the FrameProfiler is enabled.
+ */
+#define GD_PROFILE_SCOPE(name) FrameProfilerScope GD_PROFILE_SCOPE_VARIABLE(__LINE__)(FrameProfiler::IsEnabled() ? FrameProfiler::GetName(name) : NULL)
+
+#endif // FRAMEPROFILER_H
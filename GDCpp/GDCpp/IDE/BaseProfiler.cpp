@@ -12,7 +12,7 @@
  */
 void ProfileLink::Reset()
 {
-    profileClock.reset();
+    profileClock.restart();
 }
 
 /**
@@ -20,7 +20,7 @@ void ProfileLink::Reset()
  */
 void ProfileLink::Stop()
 {
-    time += profileClock.getTimeMicroseconds();
+    time += profileClock.getElapsedTime().asMicroseconds();
 }
 
 BaseProfiler::BaseProfiler() :
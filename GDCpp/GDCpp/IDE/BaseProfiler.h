@@ -11,7 +11,6 @@
 #include <memory>
 #include <vector>
 #include <SFML/System.hpp>
-#include "GDCpp/profile.h"
 namespace gd { class BaseEvent; }
 
 /**
@@ -26,7 +25,7 @@ public:
     void Stop();
     unsigned long int GetTime() const { return time; }
 
-    btClock profileClock;
+    sf::Clock profileClock;
     unsigned long int time;
     std::weak_ptr<gd::BaseEvent> originalEvent;
 };
@@ -47,8 +46,8 @@ public:
     unsigned long int totalSceneTime; ///< Total time used by events and rendering since the beginning.
     unsigned long int totalEventsTime; ///< Total time used by events since the beginning.
 
-    btClock eventsClock; ///< Used to compute time used by events during the frame
-    btClock renderingClock; ///< Used to compute time used by rendering during the frame
+    sf::Clock eventsClock; ///< Used to compute time used by events during the frame
+    sf::Clock renderingClock; ///< Used to compute time used by rendering during the frame
 
     std::vector<ProfileLink> profileEventsInformation; ///< Used by events generated code
 
@@ -0,0 +1,179 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2015 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#if defined(GD_IDE_ONLY) && !defined(GD_NO_WX_GUI)
+
+#include "GDCpp/IDE/CodeCompilationCache.h"
+#include <cstdio>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <vector>
+#include <wx/dir.h>
+#include <wx/filefn.h>
+#include <wx/filename.h>
+#include <wx/arrstr.h>
+#include "GDCpp/IDE/CodeCompiler.h"
+#include "GDCpp/CommonTools.h"
+#include "GDCore/Tools/Version.h"
+
+namespace
+{
+
+bool ReadFile(const std::string & filename, std::string & content)
+{
+    std::ifstream file(filename.c_str(), std::ios::in | std::ios::binary);
+    if ( !file.is_open() ) return false;
+
+    std::ostringstream stream;
+    stream << file.rdbuf();
+    content = stream.str();
+    return true;
+}
+
+/**
+ * Append the name, size and modification time of all the files of a directory to fingerprint.
+ */
+void AddDirectoryToFingerprint(const std::string & directory, std::string & fingerprint)
+{
+    if ( !wxDirExists(directory) ) return;
+
+    wxArrayString files;
+    wxDir::GetAllFiles(directory, &files);
+    files.Sort();
+    for (unsigned int i = 0;i<files.size();++i)
+    {
+        wxFileName file(files[i]);
+        fingerprint += ToString(files[i])+";"+ToString(file.GetSize().ToString())+";"
+            +ToString(file.GetModificationTime().GetTicks())+"\n";
+    }
+}
+
+}
+
+CodeCompilationCache::CodeCompilationCache() :
+    maxEntriesCount(512)
+{
+}
+
+void CodeCompilationCache::SetDirectory(std::string directory_)
+{
+    directory = directory_;
+    if ( directory.empty() ) return;
+
+    if ( directory[directory.length()-1] != '/' && directory[directory.length()-1] != '\\' )
+        directory += "/";
+
+    if (!wxDirExists(directory.c_str()))
+        wxMkdir(directory);
+
+    RemoveOldestEntries();
+}
+
+std::string CodeCompilationCache::Hash(const std::string & data)
+{
+    sf::Uint64 hash = 14695981039346656037ULL;
+    for (unsigned int i = 0;i<data.size();++i)
+    {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 1099511628211ULL;
+    }
+
+    char result[17];
+    snprintf(result, sizeof(result), "%016llx", static_cast<unsigned long long>(hash));
+    return result;
+}
+
+const std::string & CodeCompilationCache::GetHeadersFingerprint()
+{
+    if ( !headersFingerprint.empty() ) return headersFingerprint;
+
+    std::string fingerprint = GDCore_RC_FILEVERSION_STRING;
+
+    std::string precompiledHeader;
+    if ( ReadFile(CodeCompiler::Get()->GetBaseDirectory()+"CppPlatform/include/GDCpp/GDCpp/EventsPrecompiledHeader.h", precompiledHeader) )
+        fingerprint += precompiledHeader;
+
+    AddDirectoryToFingerprint(CodeCompiler::Get()->GetBaseDirectory()+"CppPlatform/include/GDCpp", fingerprint);
+    AddDirectoryToFingerprint(CodeCompiler::Get()->GetBaseDirectory()+"CppPlatform/include/Core", fingerprint);
+    AddDirectoryToFingerprint(CodeCompiler::Get()->GetBaseDirectory()+"CppPlatform/Extensions/include", fingerprint);
+
+    const std::set<std::string> & headersDirectories = CodeCompiler::Get()->GetAllHeadersDirectories();
+    for (std::set<std::string>::const_iterator it = headersDirectories.begin();it != headersDirectories.end();++it)
+        AddDirectoryToFingerprint(*it, fingerprint);
+
+    headersFingerprint = Hash(fingerprint);
+    return headersFingerprint;
+}
+
+std::string CodeCompilationCache::ComputeKey(const CodeCompilerCall & call)
+{
+    if ( directory.empty() || call.link || !call.eventsGeneratedCode ) return "";
+
+    std::string source;
+    if ( !ReadFile(call.inputFile, source) ) return "";
+
+    //The files names are not part of the key: they change when the IDE is restarted.
+    //The source does not: the identifiers of the generated code are stable ( see gd::EventsCodeGenerator::GenerateStableIdentifier ).
+    CodeCompilerCall options = call;
+    options.inputFile.clear();
+    options.outputFile.clear();
+
+    return Hash(source)+Hash(options.GetFullCall()+GetHeadersFingerprint());
+}
+
+bool CodeCompilationCache::Restore(const std::string & key, const std::string & outputFile)
+{
+    if ( directory.empty() || key.empty() ) return false;
+
+    std::string objectFile = directory+key+".o";
+    if ( !wxFileExists(objectFile) || !wxCopyFile(objectFile, outputFile, true) )
+        return false;
+
+    wxFileName(objectFile).Touch(); //Remember that the object file was recently used.
+    return true;
+}
+
+void CodeCompilationCache::Store(const std::string & key, const std::string & objectFile)
+{
+    if ( directory.empty() || key.empty() ) return;
+
+    if ( !wxCopyFile(objectFile, directory+key+".o", true) )
+    {
+        std::cout << "Unable to store " << objectFile << " in the compilation cache." << std::endl;
+        return;
+    }
+
+    RemoveOldestEntries();
+}
+
+void CodeCompilationCache::Clear()
+{
+    if ( directory.empty() ) return;
+
+    wxArrayString files;
+    wxDir::GetAllFiles(directory, &files, "*.o", wxDIR_FILES);
+    for (unsigned int i = 0;i<files.size();++i)
+        wxRemoveFile(files[i]);
+}
+
+void CodeCompilationCache::RemoveOldestEntries()
+{
+    wxArrayString files;
+    wxDir::GetAllFiles(directory, &files, "*.o", wxDIR_FILES);
+    if ( files.size() <= maxEntriesCount ) return;
+
+    std::vector< std::pair<time_t, wxString> > entries;
+    for (unsigned int i = 0;i<files.size();++i)
+        entries.push_back(std::make_pair(wxFileName(files[i]).GetModificationTime().GetTicks(), files[i]));
+
+    std::sort(entries.begin(), entries.end());
+    for (unsigned int i = 0;i<entries.size()-maxEntriesCount;++i)
+        wxRemoveFile(entries[i].second);
+}
+
+#endif
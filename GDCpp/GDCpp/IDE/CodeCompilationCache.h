@@ -0,0 +1,98 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2015 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+
+#if defined(GD_IDE_ONLY) && !defined(GD_NO_WX_GUI)
+
+#ifndef CODECOMPILATIONCACHE_H
+#define CODECOMPILATIONCACHE_H
+#include <string>
+class CodeCompilerCall;
+
+/**
+ * \brief Persistent cache of the object files compiled from events generated code.
+ *
+ * Object files are stored in the cache directory, named after a key computed from the content
+ * of the source file, the compiler options, the content of the events precompiled header and
+ * the headers of GDevelop and of the extensions. When a scene whose events were not modified is
+ * compiled again ( even after the IDE was restarted ), the CodeCompiler copies the stored object
+ * file instead of launching the compiler.
+ *
+ * \note This relies on the generated code not depending on the addresses of the events in memory:
+ * identifiers used by the generated code ( Trigger once conditions, unnamed timers... ) must be created
+ * with gd::EventsCodeGenerator::GenerateStableIdentifier.
+ *
+ * \see CodeCompiler
+ */
+class GD_API CodeCompilationCache
+{
+public:
+    CodeCompilationCache();
+    virtual ~CodeCompilationCache() {};
+
+    /**
+     * Set the directory where object files are stored. The cache is disabled if the directory is empty.
+     * \note If the directory does not end with a slash ( / ) or a backslash ( \ ), a slash is added at the end.
+     */
+    void SetDirectory(std::string directory_);
+
+    /**
+     * Return the directory where object files are stored.
+     */
+    const std::string & GetDirectory() const { return directory; };
+
+    /**
+     * Set the maximum number of object files stored. The least recently used ones are removed first.
+     */
+    void SetMaxEntriesCount(unsigned int maxEntriesCount_) { maxEntriesCount = maxEntriesCount_; };
+
+    /**
+     * Compute the key identifying the object file produced by a compiler call.
+     *
+     * \return The key, or an empty string if the result of the call must not be cached
+     * ( cache disabled, linking, code not generated from events or input file not readable ).
+     */
+    std::string ComputeKey(const CodeCompilerCall & call);
+
+    /**
+     * Copy the object file stored for the key to outputFile.
+     * \return true if an object file was stored for the key and was copied.
+     */
+    bool Restore(const std::string & key, const std::string & outputFile);
+
+    /**
+     * Store a copy of the object file for the key.
+     */
+    void Store(const std::string & key, const std::string & objectFile);
+
+    /**
+     * Remove all the object files stored in the cache.
+     */
+    void Clear();
+
+    /**
+     * Compute a 64 bits hash (FNV-1a) of data, as an hexadecimal string.
+     */
+    static std::string Hash(const std::string & data);
+
+private:
+    /**
+     * Return a string changing when the headers used by events code are modified ( GDevelop or extensions update ).
+     * It is computed only once.
+     */
+    const std::string & GetHeadersFingerprint();
+
+    /**
+     * Remove the least recently used object files if there are more than maxEntriesCount files.
+     */
+    void RemoveOldestEntries();
+
+    std::string directory; ///< The directory where object files are stored.
+    unsigned int maxEntriesCount; ///< The maximum number of object files stored.
+    std::string headersFingerprint; ///< See GetHeadersFingerprint.
+};
+
+#endif // CODECOMPILATIONCACHE_H
+#endif
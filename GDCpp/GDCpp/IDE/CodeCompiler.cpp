@@ -10,6 +10,7 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <algorithm>
 #include <wx/filename.h>
 #include <wx/filefn.h>
 #include <wx/txtstrm.h>
@@ -25,20 +26,6 @@ sf::Mutex CodeCompiler::openSaveDialogMutex;
 const wxEventType CodeCompiler::refreshEventType = wxNewEventType();
 const wxEventType CodeCompiler::processEndedEventType = wxNewEventType();
 
-namespace {
-
-/**
- * \brief Tool function to create a task which is empty.
- */
-CodeCompilerTask ConstructEmptyTask()
-{
-    CodeCompilerTask task;
-    task.emptyTask = true;
-    return task;
-}
-
-}
-
 std::string CodeCompilerCall::GetFullCall() const
 {
     #if defined(WINDOWS)
@@ -226,102 +213,178 @@ std::string CodeCompilerCall::GetFullCall() const
     return compilerExecutable+" "+argsStr;
 }
 
-void CodeCompiler::StartTheNextTask()
+bool CodeCompilerTask::DependsOn(const CodeCompilerTask & other) const
+{
+    const std::string & otherOutput = other.compilerCall.outputFile;
+    if ( otherOutput.empty() ) return false;
+
+    return compilerCall.inputFile == otherOutput ||
+        find(compilerCall.extraObjectFiles.begin(), compilerCall.extraObjectFiles.end(), otherOutput) != compilerCall.extraObjectFiles.end() ||
+        find(dependencies.begin(), dependencies.end(), otherOutput) != dependencies.end();
+}
+
+bool CodeCompiler::CanLaunchPendingTask(unsigned int index) const
+{
+    const CodeCompilerTask & task = pendingTasks[index];
+
+    //Be sure that the task is not disabled
+    if ( find(compilationDisallowed.begin(), compilationDisallowed.end(), task.scene) != compilationDisallowed.end() )
+        return false;
+
+    //Tasks producing a file used by the task must be done before.
+    //Tasks producing the same file are done in the order they were added.
+    for (unsigned int i = 0;i<runningTasks.size();++i)
+    {
+        if ( task.DependsOn(runningTasks[i]->task) || task.compilerCall.outputFile == runningTasks[i]->task.compilerCall.outputFile )
+            return false;
+    }
+    for (unsigned int i = 0;i<pendingTasks.size();++i)
+    {
+        if ( i == index ) continue;
+        if ( task.DependsOn(pendingTasks[i]) || (i < index && task.compilerCall.outputFile == pendingTasks[i].compilerCall.outputFile) )
+            return false;
+    }
+
+    return true;
+}
+
+void CodeCompiler::StartNextTasks()
+{
+    if ( startingTasks ) return; //Pre and post works can add tasks: they will be launched by the loop below.
+
+    startingTasks = true;
+    while ( StartTheNextTask() )
+        ;
+    startingTasks = false;
+}
+
+bool CodeCompiler::StartTheNextTask()
 {
     //Check if there is a task to be made
+    std::shared_ptr<CodeCompilerRunningTask> runningTask(new CodeCompilerRunningTask);
+    CodeCompilerTask & task = runningTask->task;
+    unsigned int pendingTasksCountBeforePreWork = 0;
     {
         sf::Lock lock(pendingTasksMutex); //Disallow modifying pending tasks.
 
-        if ( !currentTask.emptyTask )
-        {
-           //currentTask is not empty: Do it.
-        }
-        else
+        if ( runningTasks.size() >= maxProcessesCount ) return false; //ProcessEndedWork will launch the next tasks.
+
+        bool newTaskFound = false;
+        for (unsigned int i = 0;i<pendingTasks.size();++i)
         {
-            bool newTaskFound = false;
-            for (unsigned int i = 0;i<pendingTasks.size();++i)
+            if ( CanLaunchPendingTask(i) )
             {
-                //Be sure that the task is not disabled
-                if ( find(compilationDisallowed.begin(), compilationDisallowed.end(), pendingTasks[i].scene) == compilationDisallowed.end() )
-                {
-                    currentTask = pendingTasks[i];
-                    pendingTasks.erase(pendingTasks.begin()+i);
+                task = pendingTasks[i];
+                pendingTasks.erase(pendingTasks.begin()+i);
 
-                    newTaskFound = true;
-                    break;
-                }
-            }
-            if ( !newTaskFound ) //Bail out if no task can be made
-            {
-                if ( pendingTasks.empty() )
-                    std::cout << "No more task to be processed." << std::endl;
-                else
-                    std::cout << "No more task to be processed ( But "+ToString(pendingTasks.size())+" disabled task(s) waiting for being enabled )." << std::endl;
-
-                processLaunched = false;
-                NotifyControls();
-                return;
+                newTaskFound = true;
+                break;
             }
+        }
+        if ( !newTaskFound ) //Bail out if no task can be made
+        {
+            if ( !runningTasks.empty() ) return false; //Tasks will be launched again when a process ends.
 
+            if ( pendingTasks.empty() )
+                std::cout << "No more task to be processed." << std::endl;
+            else
+                std::cout << "No more task to be processed ( But "+ToString(pendingTasks.size())+" disabled task(s) waiting for being enabled )." << std::endl;
+
+            processLaunched = false;
+            NotifyControls();
+            return false;
         }
+
+        runningTasks.push_back(runningTask);
+        pendingTasksCountBeforePreWork = pendingTasks.size();
     }
 
-    std::cout << "Processing task " << currentTask.userFriendlyName << "..." << std::endl;
-    lastTaskFailed = false;
+    std::cout << "Processing task " << task.userFriendlyName << "..." << std::endl;
+    runningTask->report.userFriendlyName = task.userFriendlyName;
     NotifyControls();
     bool skip = false; //Set to true if the preworker of the task asked to relaunch the task later.
 
-    if ( currentTask.preWork != std::shared_ptr<CodeCompilerExtraWork>() )
+    if ( task.preWork != std::shared_ptr<CodeCompilerExtraWork>() )
     {
         std::cout << "Launching pre work..." << std::endl;
-        bool result = currentTask.preWork->Execute();
+        sf::Clock preWorkClock;
+        bool result = task.preWork->Execute();
+        runningTask->report.preWorkDuration = preWorkClock.getElapsedTime().asMilliseconds();
 
         if ( !result )
         {
             std::cout << "Preworker execution failed, task skipped." << std::endl;
             skip = true;
         }
-        else if ( currentTask.preWork->requestRelaunchCompilationLater )
+        else if ( task.preWork->requestRelaunchCompilationLater )
         {
             std::cout << "Preworker asked to launch the task later" << std::endl;
             sf::Lock lock(pendingTasksMutex); //Disallow modifying pending tasks.
-            pendingTasks.push_back(currentTask);
-            pendingTasks.back().preWork->requestRelaunchCompilationLater = false;
 
+            //The tasks added by the pre work are dependencies which must be done before launching the task again.
+            //If the pre work added no task ( they were already pending ), wait for all the other tasks.
+            CodeCompilerTask postponedTask = task;
+            postponedTask.preWork->requestRelaunchCompilationLater = false;
+            unsigned int firstDependency = pendingTasks.size() > pendingTasksCountBeforePreWork ? pendingTasksCountBeforePreWork : 0;
+            for (unsigned int i = firstDependency;i<pendingTasks.size();++i)
+                postponedTask.dependencies.push_back(pendingTasks[i].compilerCall.outputFile);
+            if ( firstDependency == 0 )
+            {
+                for (unsigned int i = 0;i<runningTasks.size();++i)
+                {
+                    if ( runningTasks[i] != runningTask )
+                        postponedTask.dependencies.push_back(runningTasks[i]->task.compilerCall.outputFile);
+                }
+            }
+
+            pendingTasks.push_back(postponedTask);
             skip = true;
         }
     }
 
     if ( skip ) //The preworker asked to skip the task
     {
-        currentTask = ConstructEmptyTask();
+        {
+            sf::Lock lock(pendingTasksMutex);
+            runningTasks.erase(find(runningTasks.begin(), runningTasks.end(), runningTask));
+        }
         NotifyControls();
-        StartTheNextTask(); //Calling recursively StartTheNextTask() is not a problem: The function will be called until a process is launched
-                            //or until all tasks are skipped
-        return;
+        return true;
     }
 
-    lastTaskMessages.clear();
+    //Reuse the object file compiled from the same code, if any.
+    runningTask->cacheKey = cache.ComputeKey(task.compilerCall);
+    if ( cache.Restore(runningTask->cacheKey, task.compilerCall.outputFile) )
+    {
+        std::cout << "Object file restored from the compilation cache, compilation skipped." << std::endl;
+        runningTask->report.restoredFromCache = true;
+        EndTask(*runningTask, true);
+        return true;
+    }
 
     //Launching the process
     std::cout << "Launching compiler process...\n";
-    std::cout << currentTask.compilerCall.GetFullCall() << "\n";
-    currentTaskProcess = new CodeCompilerProcess(this);
-    currentTaskProcess->Redirect();
-    if ( wxExecute(currentTask.compilerCall.GetFullCall(), wxEXEC_ASYNC, currentTaskProcess) == 0 )
+    std::cout << task.compilerCall.GetFullCall() << "\n";
+    runningTask->process = new CodeCompilerProcess(this);
+    runningTask->process->Redirect();
+    runningTask->clock.restart();
+    if ( wxExecute(task.compilerCall.GetFullCall(), wxEXEC_ASYNC, runningTask->process) == 0 )
     {
         gd::LogError(_("Unable to launch the internal compiler: Try to reinstall GDevelop to make sure that every needed file are present."));
-        delete currentTaskProcess;
-        currentTaskProcess = NULL;
+        delete runningTask->process;
+        runningTask->process = NULL;
+        EndTask(*runningTask, false);
     }
     else
     {
         //Also launch the thread which will read the output of the process
-        currentTaskOutputThread = new sf::Thread(&CodeCompilerProcess::WatchOutput, currentTaskProcess);
-        currentTaskOutputThread->launch();
+        runningTask->outputThread = new sf::Thread(&CodeCompilerProcess::WatchOutput, runningTask->process);
+        runningTask->outputThread->launch();
 
         //When the process ends, it will call ProcessEndedWork()...
     }
+
+    return true;
 }
 
 CodeCompilerProcess::CodeCompilerProcess(wxEvtHandler * parent_) :
@@ -341,43 +404,58 @@ void CodeCompilerProcess::OnTerminate( int pid, int status )
     stopWatchOutput = true;
     #if defined(WINDOWS)
     wxCommandEvent processEndedEvent( CodeCompiler::processEndedEventType );
+    processEndedEvent.SetClientData(this);
     if ( parent != NULL) wxPostEvent(parent, processEndedEvent);
     #else
-    wxCommandEvent useless;
-    CodeCompiler::Get()->ProcessEndedWork(useless);
+    wxCommandEvent processEndedEvent;
+    processEndedEvent.SetClientData(this);
+    CodeCompiler::Get()->ProcessEndedWork(processEndedEvent);
     #endif
 }
 
 void CodeCompiler::ProcessEndedWork(wxCommandEvent & event)
 {
     //...This function is called when a CodeCompilerProcess ends its job.
-    std::cout << "CodeCompiler notified that the current process ended work." << std::endl;
+    CodeCompilerProcess * process = static_cast<CodeCompilerProcess*>(event.GetClientData());
+    std::shared_ptr<CodeCompilerRunningTask> runningTask;
+    {
+        sf::Lock lock(pendingTasksMutex);
+        for (unsigned int i = 0;i<runningTasks.size();++i)
+        {
+            if ( runningTasks[i]->process == process ) runningTask = runningTasks[i];
+        }
+    }
+    if ( runningTask == std::shared_ptr<CodeCompilerRunningTask>() )
+    {
+        std::cout << "WARNING: CodeCompiler notified that an unknown process ended work." << std::endl;
+        return;
+    }
+
+    std::cout << "CodeCompiler notified that the process of task " << runningTask->task.userFriendlyName << " ended work." << std::endl;
+    runningTask->report.compilationDuration = runningTask->clock.getElapsedTime().asMilliseconds();
 
     //Also terminate the thread which was reading the output
-    currentTaskOutputThread->wait();
-    delete currentTaskOutputThread;
-    currentTaskOutputThread = NULL;
+    runningTask->outputThread->wait();
+    delete runningTask->outputThread;
+    runningTask->outputThread = NULL;
 
     // Check if compilation was successful
-    bool compilationSucceeded = (currentTaskProcess->exitCode == 0);
+    bool compilationSucceeded = (process->exitCode == 0);
     if (!compilationSucceeded)
-    {
-        std::cout << "Compilation failed with exit code " << currentTaskProcess->exitCode << ".\n";
-        lastTaskFailed = true;
-    }
+        std::cout << "Compilation failed with exit code " << process->exitCode << ".\n";
     else
-    {
         std::cout << "Compilation succeeded." << std::endl;
-    }
 
-    //Compilation ended, saving diagnostics
+    //Compilation ended, saving diagnostics.
+    //The diagnostics of a failed task are kept until the end of the compilation run.
+    if ( !compilationSucceeded || !lastTaskFailed )
     {
         lastTaskMessages.clear();
-        for (unsigned int i = 0;i<currentTaskProcess->output.size();++i)
-            lastTaskMessages += currentTaskProcess->output[i]+"\n";
+        for (unsigned int i = 0;i<process->output.size();++i)
+            lastTaskMessages += process->output[i]+"\n";
 
-        for (unsigned int i = 0;i<currentTaskProcess->outputErrors.size();++i)
-            lastTaskMessages += currentTaskProcess->outputErrors[i]+"\n";
+        for (unsigned int i = 0;i<process->outputErrors.size();++i)
+            lastTaskMessages += process->outputErrors[i]+"\n";
 
         ofstream outputFile;
         outputFile.open (std::string(outputDir+"LatestCompilationOutput.txt").c_str());
@@ -389,32 +467,59 @@ void CodeCompiler::ProcessEndedWork(wxCommandEvent & event)
         else cout << "Unable to open LatestCompilationOutput for writing compiler output!";
     }
 
-    //Now do post work and notify task has been done.
+    if ( compilationSucceeded )
+        cache.Store(runningTask->cacheKey, runningTask->task.compilerCall.outputFile);
+
+    delete runningTask->process;
+    runningTask->process = NULL;
+    EndTask(*runningTask, compilationSucceeded);
+
+    //Launch the next tasks ( even if there is no task to be done )
+    StartNextTasks();
+}
+
+void CodeCompiler::EndTask(CodeCompilerRunningTask & runningTask, bool compilationSucceeded)
+{
+    if ( !compilationSucceeded ) lastTaskFailed = true;
+
+    //Do post work and notify task has been done.
+    CodeCompilerTask & task = runningTask.task;
+    if (task.postWork != std::shared_ptr<CodeCompilerExtraWork>() )
     {
-        if (currentTask.postWork != std::shared_ptr<CodeCompilerExtraWork>() )
+        std::cout << "Launching post task" << std::endl;
+        sf::Clock postWorkClock;
+        task.postWork->compilationSucceeded = compilationSucceeded;
+        task.postWork->Execute();
+        runningTask.report.postWorkDuration = postWorkClock.getElapsedTime().asMilliseconds();
+
+        if ( task.postWork->requestRelaunchCompilationLater )
         {
-            std::cout << "Launching post task" << std::endl;
-            currentTask.postWork->compilationSucceeded = compilationSucceeded;
-            currentTask.postWork->Execute();
+            std::cout << "Postworker asked to launch again the task later" << std::endl;
 
-            if ( currentTask.postWork->requestRelaunchCompilationLater )
-            {
-                std::cout << "Postworker asked to launch again the task later" << std::endl;
+            sf::Lock lock(pendingTasksMutex);
+            pendingTasks.push_back(task);
+            pendingTasks.back().postWork->requestRelaunchCompilationLater = false;
+        }
+    }
+
+    runningTask.report.succeeded = compilationSucceeded;
+    std::cout << "Task " << task.userFriendlyName << " ended (pre work: " << runningTask.report.preWorkDuration
+        << "ms, compilation: " << runningTask.report.compilationDuration << "ms, post work: "
+        << runningTask.report.postWorkDuration << "ms)." << std::endl;
 
-                pendingTasks.push_back(currentTask);
-                pendingTasks.back().postWork->requestRelaunchCompilationLater = false;
+    {
+        sf::Lock lock(pendingTasksMutex);
+        tasksReports.push_back(runningTask.report);
+        for (unsigned int i = 0;i<runningTasks.size();++i)
+        {
+            if ( runningTasks[i].get() == &runningTask )
+            {
+                runningTasks.erase(runningTasks.begin()+i);
+                break;
             }
         }
-
-        std::cout << "Task ended." << std::endl;
-        currentTask = ConstructEmptyTask();
-        NotifyControls();
     }
-
-    //Launch the next task ( even if there is no task to be done )
-    delete currentTaskProcess;
-    currentTaskProcess = NULL;
-    StartTheNextTask();
+    NotifyControls();
 }
 
 void CodeCompiler::NotifyControls()
@@ -425,18 +530,6 @@ void CodeCompiler::NotifyControls()
         if ( (*it) != NULL) wxPostEvent((*it), refreshEvent);
     }
 }
-/* TODO
-void CodeCompiler::SendCurrentThreadToGarbage()
-{
-    sf::Lock lock(garbageThreadsMutex); //Disallow modifying garbageThreads.
-    std::cout << "Old thread (" << currentTaskThread.get() << ") sent to garbage." << std::endl;
-
-    garbageThreads.push_back(currentTaskThread);
-    livingGarbageThreadsCount++; //We increment livingGarbageThreadsCount as the thread sent to garbageThreads was alive ( i.e. : doing work )
-
-    currentTaskThread = std::shared_ptr<sf::Thread>();
-    processLaunched = false;
-}*/
 
 void CodeCompiler::AddTask(CodeCompilerTask task)
 {
@@ -449,42 +542,38 @@ void CodeCompiler::AddTask(CodeCompilerTask task)
             if ( task.IsSameTaskAs(pendingTasks[i]) ) return;
         }
 
-        //If the task is equivalent to the current one, abort it.
-        if ( processLaunched && task.IsSameTaskAs(currentTask) )
-        {
-            std::cout << "Task requested is equivalent to the current one (" << task.userFriendlyName << ")" << std::endl;
-
-            /*if ( livingGarbageThreadsCount < maxGarbageThread ) TODO
-            {
-                SendCurrentProcessToGarbage();
-            }
-            else*/
-            {
-                pendingTasks.push_back(task);
-                std::cout << "Max thread count reached, new pending task added (" << task.userFriendlyName << ")" << std::endl;
-            }
-        }
-        else
-        {
-            pendingTasks.push_back(task);
-            std::cout << "New pending task added (" << task.userFriendlyName << ")" << std::endl;
-        }
+        //If the task is equivalent to a running one, it is done again when the running one is over
+        //( see CanLaunchPendingTask ), as the files used by the task may have changed.
+        pendingTasks.push_back(task);
+        std::cout << "New pending task added (" << task.userFriendlyName << ")" << std::endl;
     }
 
     if ( !processLaunched )
     {
-        std::cout << "Launching new compilation run";
-        processLaunched = true;
-        StartTheNextTask();
+        std::cout << "Launching new compilation run" << std::endl;
+        LaunchCompilationRun();
     }
+    else
+        StartNextTasks(); //Launch the task now if a process is available.
+}
+
+void CodeCompiler::LaunchCompilationRun()
+{
+    processLaunched = true;
+    lastTaskFailed = false;
+    lastTaskMessages.clear();
+    tasksReports.clear();
+    StartNextTasks();
 }
 
 std::vector < CodeCompilerTask > CodeCompiler::GetCurrentTasks() const
 {
     sf::Lock lock(pendingTasksMutex); //Disallow modifying pending tasks.
 
-    std::vector < CodeCompilerTask > allTasks = pendingTasks;
-    if (processLaunched) allTasks.insert(allTasks.begin(), currentTask);
+    std::vector < CodeCompilerTask > allTasks;
+    for (unsigned int i = 0;i<runningTasks.size();++i)
+        allTasks.push_back(runningTasks[i]->task);
+    allTasks.insert(allTasks.end(), pendingTasks.begin(), pendingTasks.end());
 
     return allTasks;
 }
@@ -493,7 +582,10 @@ bool CodeCompiler::HasTaskRelatedTo(gd::Layout & scene) const
 {
     sf::Lock lock(pendingTasksMutex); //Disallow modifying pending tasks.
 
-    if ( processLaunched && currentTask.scene == &scene ) return true;
+    for (unsigned int i = 0;i<runningTasks.size();++i)
+    {
+        if ( runningTasks[i]->task.scene == &scene ) return true;
+    }
 
     for (unsigned int i = 0;i<pendingTasks.size();++i)
     {
@@ -521,9 +613,8 @@ void CodeCompiler::EnableTaskRelatedTo(gd::Layout & scene)
     //Launch pending tasks if needed
     if ( !processLaunched && mustLaunchCompilation )
     {
-        std::cout << "Launching compilation thread...";
-        processLaunched = true;
-        StartTheNextTask();
+        std::cout << "Launching new compilation run" << std::endl;
+        LaunchCompilationRun();
     }
 }
 
@@ -598,20 +689,23 @@ void CodeCompiler::SetBaseDirectory(std::string baseDir_)
 
 void CodeCompiler::AllowMultithread(bool allow, unsigned int maxThread)
 {
-    /*if (!allow || maxThread == 1)
-        maxGarbageThread = 0;
+    if ( !allow )
+        maxProcessesCount = 1;
+    else if ( maxThread == 0 )
+        maxProcessesCount = wxThread::GetCPUCount() > 0 ? wxThread::GetCPUCount() : 1;
     else
-        maxGarbageThread = maxThread-1;*/
+        maxProcessesCount = maxThread;
+
+    std::cout << "Events compiler can launch " << maxProcessesCount << " process(es) at the same time." << std::endl;
 }
 
 CodeCompiler::CodeCompiler() :
     processLaunched(false),
-    currentTask(ConstructEmptyTask()),
-    currentTaskProcess(NULL),
-    currentTaskOutputThread(NULL),
-    //maxGarbageThread(2),
+    startingTasks(false),
+    maxProcessesCount(1),
     lastTaskFailed(false)
 {
+    AllowMultithread(true);
     Connect(wxID_ANY, processEndedEventType, (wxObjectEventFunction) (wxEventFunction) (wxCommandEventFunction) &CodeCompiler::ProcessEndedWork);
 }
 
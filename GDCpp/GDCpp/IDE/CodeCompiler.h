@@ -16,6 +16,7 @@
 #include <wx/event.h>
 #include <wx/process.h>
 #include <wx/thread.h>
+#include "GDCpp/IDE/CodeCompilationCache.h"
 class CodeCompilerExtraWork;
 namespace gd { class Layout; }
 class CodeCompilerThreadStateNotifier;
@@ -87,6 +88,13 @@ public:
 
     std::string userFriendlyName; ///< Task name displayed to the user
     gd::Layout * scene; ///< Optional pointer to a scene to specify that the task work is related to this scene.
+    std::vector<std::string> dependencies; ///< Files produced by other tasks that must be done before launching this task ( in addition to the input files ).
+
+    /**
+     * Return true if the task can only be launched when other is done
+     * ( i.e. other produces one of the files used by the task ).
+     */
+    bool DependsOn(const CodeCompilerTask & other) const;
 
     /**
      * Method to check if the task is the same as another. ( Compare files/options but does not take in account pre/post work )
@@ -116,6 +124,23 @@ public:
     virtual ~CodeCompilerExtraWork();
 };
 
+/**
+ * \brief Timings and result of a task processed by the CodeCompiler.
+ * \see CodeCompiler::GetTasksReports
+ */
+class GD_API CodeCompilerTaskReport
+{
+public:
+    CodeCompilerTaskReport() : succeeded(false), restoredFromCache(false), preWorkDuration(0), compilationDuration(0), postWorkDuration(0) {};
+
+    std::string userFriendlyName; ///< The name of the task.
+    bool succeeded; ///< true if the task was done successfully.
+    bool restoredFromCache; ///< true if the object file was restored from the compilation cache.
+    sf::Int32 preWorkDuration; ///< Time spent in the pre work, in milliseconds.
+    sf::Int32 compilationDuration; ///< Time spent by the compiler process, in milliseconds.
+    sf::Int32 postWorkDuration; ///< Time spent in the post work, in milliseconds.
+};
+
 /**
  * \brief Internal class used to launch building tasks.
  *
@@ -148,11 +173,31 @@ private:
     bool stopWatchOutput;
 };
 
+/**
+ * \brief Internal class storing a task being processed by the CodeCompiler.
+ */
+class CodeCompilerRunningTask
+{
+public:
+    CodeCompilerRunningTask() : process(NULL), outputThread(NULL) {};
+
+    CodeCompilerTask task; ///< The task being processed.
+    CodeCompilerProcess * process; ///< The process doing the task.
+    sf::Thread * outputThread; ///< The thread used to read the output of the compiler.
+    std::string cacheKey; ///< The key used to store the result of the task in the cache, if any.
+    CodeCompilerTaskReport report; ///< The timings of the task.
+    sf::Clock clock; ///< Started when the compiler process is launched.
+};
+
 /**
  * \brief C++ Code compiler
- * This class uses a thread to launch Clang compiler according to the task added using AddTask.
+ * This class launches compiler processes according to the task added using AddTask.
  * Specific functions are available for preventing the compiler to start a new task involving a specific scene.
  *
+ * Independent tasks are processed in parallel, up to the number of processes allowed by AllowMultithread.
+ * A task is launched only when the tasks producing the files it uses are done
+ * ( see CodeCompilerTask::DependsOn ). Pre and post works are always executed in the main thread.
+ *
  * \see CodeCompilerTask
  */
 class GD_API CodeCompiler : public wxEvtHandler
@@ -195,10 +240,15 @@ public:
     bool CompilationInProcess() const;
 
     /**
-     * Return a list of tasks containing the current task and tasks waiting to be processed
+     * Return a list of tasks containing the tasks being processed and tasks waiting to be processed
      */
     std::vector < CodeCompilerTask > GetCurrentTasks() const;
 
+    /**
+     * Return the timings of the tasks done since the latest compilation run was launched.
+     */
+    const std::vector < CodeCompilerTaskReport > & GetTasksReports() const { return tasksReports; };
+
     /**
      * Add a directory where headers can be found.
      * The directory is relative to the base directory ( which is by default the IDE directory. See CodeCompiler::SetBaseDirectory )
@@ -222,12 +272,13 @@ public:
     void RemoveNotifiedControl(wxEvtHandler * control) { notifiedControls.erase(control); };
 
     /**
-     * Return true if the latest task has failed.
+     * Return true if a task has failed since the latest compilation run was launched.
      */
     bool LastTaskFailed() { return lastTaskFailed; };
 
     /**
      * Get the output of the compiler for the last task.
+     * \note If a task failed during the compilation run, the output of the last failed task is returned.
      */
     const std::string & GetLastTaskMessages() { return lastTaskMessages; };
 
@@ -269,14 +320,24 @@ public:
     void ClearOutputDirectory();
 
     /**
-     * Set if CodeCompiler is allowed to launch more than one thread.
+     * Return the cache storing the object files compiled from events code.
+     * Its directory must be set to enable it ( see CodeCompilationCache::SetDirectory ).
+     */
+    CodeCompilationCache & GetCache() { return cache; };
+
+    /**
+     * Set if CodeCompiler is allowed to launch more than one compiler process at the same time.
      *
-     * For example, if a task is requested twice in a short time, CodeCompiler can launch a 2nd
-     * thread to do the work and discard the result of the 1st as it is useless.
-     * If multithread is disabled or if maxThread count is reached, then the second task is added
-     * to pending tasks.
+     * \param allow If false, tasks are processed one at a time.
+     * \param maxThread The maximum number of compiler processes launched at the same time.
+     * If 0, the number of CPUs is used.
+     */
+    void AllowMultithread(bool allow = true, unsigned int maxThread = 0);
+
+    /**
+     * Return the maximum number of compiler processes launched at the same time.
      */
-    void AllowMultithread(bool allow = true, unsigned int maxThread = 3);
+    unsigned int GetMaxProcessesCount() const { return maxProcessesCount; };
 
     static CodeCompiler * Get();
     static void DestroySingleton();
@@ -288,23 +349,41 @@ public:
 private:
 
     /**
-     * \brief Execute the next task to be done.
+     * Reset the failures and the reports of the previous compilation run and launch the pending tasks.
+     */
+    void LaunchCompilationRun();
+
+    /**
+     * \brief Launch the pending tasks which can be done.
      *
      * Return without doing nothing special if no task has to be done.<br>
-     * If a task must be done, a compilation process is executed ( see CodeCompilerProgress ) and then the function returns.
-     * The process will call ProcessEndedWork when it is over.
+     * Pending tasks which are not disabled and whose dependencies are done are launched until
+     * the maximum number of processes is reached: their pre work is executed and then a compilation
+     * process is executed ( see CodeCompilerProcess ). Each process will call ProcessEndedWork when it is over.
      */
-    void StartTheNextTask();
+    void StartNextTasks();
 
     /**
-     * Post an event to notifiedControls to notify them that progress has been made.
+     * \brief Launch the first pending task which can be done, if any.
+     * \return true if StartNextTasks must try to launch another task.
      */
-    void NotifyControls();
+    bool StartTheNextTask();
 
     /**
-     * Set the current process to be considered as garbage.
+     * Return true if the pending task at the specified position can be launched now.
+     * \note pendingTasksMutex must be locked.
      */
-    void SendCurrentProcessToGarbage();
+    bool CanLaunchPendingTask(unsigned int index) const;
+
+    /**
+     * Launch the post work of a task, store its report and mark it as done.
+     */
+    void EndTask(CodeCompilerRunningTask & runningTask, bool compilationSucceeded);
+
+    /**
+     * Post an event to notifiedControls to notify them that progress has been made.
+     */
+    void NotifyControls();
 
 #if !defined(WINDOWS)
 public:
@@ -320,15 +399,16 @@ public:
 private:
 #endif
 
-    //Current task
-    bool processLaunched; ///< Set to true when the thread is working, and to false when the pending task list has been exhausted.
-    CodeCompilerTask currentTask; ///< When a task is being done, it is removed from pendingTasks and stored here.
-    CodeCompilerProcess * currentTaskProcess; ///< The process doing the current task
-    sf::Thread * currentTaskOutputThread; ///< The wxWidgets thread used to read the output of the compiler.
+    //Running tasks
+    bool processLaunched; ///< Set to true when tasks are being processed, and to false when the pending task list has been exhausted.
+    bool startingTasks; ///< true while StartNextTasks is launching tasks.
+    std::vector < std::shared_ptr<CodeCompilerRunningTask> > runningTasks; ///< When a task is being done, it is removed from pendingTasks and stored here.
+    unsigned int maxProcessesCount; ///< The maximum number of compiler processes launched at the same time.
+    std::vector < CodeCompilerTaskReport > tasksReports; ///< The timings of the tasks done since the compilation run was launched.
 
     //Pending task management
     std::vector < CodeCompilerTask > pendingTasks; ///< Compilation task waiting to be launched.
-    mutable sf::Mutex pendingTasksMutex; ///< A mutex is used to be sure that pending tasks are not modified by the thread and another method at the same time.
+    mutable sf::Mutex pendingTasksMutex; ///< A mutex is used to be sure that pending and running tasks are not modified by the thread and another method at the same time.
     std::vector < gd::Layout* > compilationDisallowed; ///< List of scenes which disallow their events to be compiled. (However, if a compilation is being made, it will not be stopped)
 
     //Global compiler configuration
@@ -336,6 +416,7 @@ private:
     std::string outputDir; ///< The directory where temporary files are created
     std::set < std::string > headersDirectories; ///< List of headers that should be used for every compilation task
     bool mustDeleteTemporaries; ///< True if temporary must be deleted
+    CodeCompilationCache cache; ///< The object files already compiled from events code.
 
     //Gui related
     std::set<wxEvtHandler*> notifiedControls; ///< List of wxWidgets controls to be notified when some progress has been made.
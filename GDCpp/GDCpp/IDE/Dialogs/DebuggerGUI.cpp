@@ -16,6 +16,7 @@
 #include "GDCpp/Object.h"
 #include "GDCpp/ObjectHelpers.h"
 #include "GDCpp/CppPlatform.h"
+#include "GDCpp/AllocationsTracker.h"
 #include "GDCore/IDE/Dialogs/ChooseObjectDialog.h"
 #include "GDCore/IDE/Dialogs/ChooseLayerDialog.h"
 #include "GDCore/IDE/SkinHelper.h"
@@ -66,9 +67,10 @@ DebuggerGUI::DebuggerGUI(wxWindow* parent, RuntimeScene &scene_)
     m_generalList->InsertItem(4, _("Window's size"));
     m_generalList->InsertItem(5, _("Position of the mouse over the window"));
     m_generalList->InsertItem(6, _("Time elapsed since the beginning of the scene"));
-    m_generalList->InsertItem(7, "");
-    m_generalList->InsertItem(8, _("Scene variables"));
-    m_generalList->SetItemFont(8, font);
+    m_generalList->InsertItem(7, _("Allocations during the last image"));
+    m_generalList->InsertItem(8, "");
+    m_generalList->InsertItem(9, _("Scene variables"));
+    m_generalList->SetItemFont(9, font);
     generalBaseItemCount = m_generalList->GetItemCount();
 
     m_objectList->InsertColumn(0, _("Property"));
@@ -161,6 +163,10 @@ void DebuggerGUI::UpdateGUI()
     m_generalList->SetItem(4, 1, ToString(scene.game->GetMainWindowDefaultWidth())+"*"+ToString(scene.game->GetMainWindowDefaultHeight()));
     m_generalList->SetItem(5, 1, ToString(scene.GetInputManager().GetMousePosition().x)+";"+ToString(scene.GetInputManager().GetMousePosition().y));
     m_generalList->SetItem(6, 1, ToString(static_cast<double>(scene.GetTimeFromStart())/1000000.0)+"s");
+    if ( AllocationsTracker::IsEnabled() )
+        m_generalList->SetItem(7, 1, ToString(scene.GetLastFrameAllocations().allocations)+_(" allocations, ")+ToString(scene.GetLastFrameAllocations().bytes)+_(" bytes"));
+    else
+        m_generalList->SetItem(7, 1, _("Not tracked"));
 
     //Suppression des lignes en trop pour les variables
     while(static_cast<unsigned int>(m_generalList->GetItemCount()) > generalBaseItemCount + scene.GetVariables().Count() + scene.game->GetVariables().Count()+2)
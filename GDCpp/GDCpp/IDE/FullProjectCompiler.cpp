@@ -39,6 +39,8 @@
 #include "GDCore/CommonTools.h"
 #include "GDCore/PlatformDefinition/Platform.h"
 #include "GDCore/IDE/ProjectStripper.h"
+#include "GDCore/Serialization/Serializer.h"
+#include "GDCore/Serialization/SerializerElement.h"
 #include "GDCore/IDE/ResourcesMergingHelper.h"
 #include "GDCpp/IDE/ExecutableIconChanger.h"
 #include "GDCpp/IDE/BaseProfiler.h"
@@ -219,12 +221,14 @@ void FullProjectCompiler::LaunchProjectCompilation()
     for (unsigned int j = 0;j<game.GetObjects().size();++j) //Add global objects resources
         game.GetObjects()[j]->ExposeResources(resourcesMergingHelper);
 
-    //Compile all scene events to object files
+    //Compile all scene events to object files: the tasks are all added so that
+    //the code compiler can compile the scenes in parallel.
+    diagnosticManager.OnMessage(gd::ToString(_("Compiling scenes...")));
+    std::vector<std::string> scenesObjectFiles;
     for (unsigned int i = 0;i<game.GetLayoutsCount();++i)
     {
         if ( game.GetLayout(i).GetProfiler() ) game.GetLayout(i).GetProfiler()->profilingActivated = false;
 
-        diagnosticManager.OnMessage(gd::ToString(_("Compiling scene ")+game.GetLayout(i).GetName()+_(".")));
         CodeCompilerTask task;
         task.compilerCall.compilationForRuntime = true;
         task.compilerCall.optimize = optimize;
@@ -235,8 +239,13 @@ void FullProjectCompiler::LaunchProjectCompilation()
         task.preWork = std::shared_ptr<CodeCompilerExtraWork>(new EventsCodeCompilerRuntimePreWork(&game, &game.GetLayout(i), resourcesMergingHelper));
         task.scene = &game.GetLayout(i);
 
+        if ( wxFileExists(task.compilerCall.outputFile) ) //Be sure that an old object file is not taken for the result of the compilation.
+            wxRemoveFile(task.compilerCall.outputFile);
         CodeCompiler::Get()->AddTask(task);
+        scenesObjectFiles.push_back(task.compilerCall.outputFile);
+    }
 
+    {
         wxStopWatch yieldClock;
         while (CodeCompiler::Get()->CompilationInProcess())
         {
@@ -246,8 +255,11 @@ void FullProjectCompiler::LaunchProjectCompilation()
                 yieldClock.Start();
             }
         }
+    }
 
-        if ( !wxFileExists(task.compilerCall.outputFile) )
+    for (unsigned int i = 0;i<game.GetLayoutsCount();++i)
+    {
+        if ( !wxFileExists(scenesObjectFiles[i]) )
         {
             diagnosticManager.AddError(gd::ToString(_("Compilation of scene ")+game.GetLayout(i).GetName()+_(" failed: Please go on our website to report this error, joining this file:\n")
                                                     +CodeCompiler::Get()->GetOutputDirectory()+"LatestCompilationOutput.txt"
@@ -281,31 +293,30 @@ void FullProjectCompiler::LaunchProjectCompilation()
     diagnosticManager.OnMessage(gd::ToString(_( "Copying resources..." )), gd::ToString(_( "Step 1 out of 3" )));
     gd::Project strippedProject = game;
     gd::ProjectStripper::StripProject(strippedProject);
-    strippedProject.SaveToFile(static_cast<string>( tempDir + "/GDProjectSrcFile.gdg" ));
+
+    //Game data is stored as a binary snapshot, read in place by the runtime.
+    std::string projectSnapshot;
+    {
+        gd::SerializerElement rootElement;
+        strippedProject.SerializeTo(rootElement);
+        gd::Serializer::ToBinary(rootElement, projectSnapshot);
+    }
     diagnosticManager.OnPercentUpdate(80);
 
     gd::SafeYield::Do();
     diagnosticManager.OnMessage(gd::ToString(_( "Copying resources..." )), gd::ToString(_( "Step 2 out of 3" )));
 
-    //Encrypt the source file.
+    //Encrypt the game data.
     {
-		std::string ifileName = tempDir.ToStdString() + "/GDProjectSrcFile.gdg";
 		std::string ofileName = tempDir.ToStdString() + "/src";
-
-        ifstream ifile(ifileName.c_str(), ios_base::binary);
         ofstream ofile(ofileName.c_str(), ios_base::binary);
 
-        // get file size
-        ifile.seekg(0,ios_base::end);
-        int size,fsize = ifile.tellg();
-        ifile.seekg(0,ios_base::beg);
+        // round up, the padding being ignored when reading the snapshot
+        int size = (projectSnapshot.size()+15)&(~15);
+        projectSnapshot.resize(size, '\0');
 
-        // round up (ignore pad for here)
-        size = (fsize+15)&(~15);
-
-        char * ibuffer = new char[size];
+        const char * ibuffer = projectSnapshot.data();
         char * obuffer = new char[size];
-        ifile.read(ibuffer,fsize);
 
 
         unsigned char key[] = "-P:j$4t&OHIUVM/Z+u4DeDP.";
@@ -317,11 +328,8 @@ void FullProjectCompiler::LaunchProjectCompilation()
             (uint8_t*)iv, size/AES_BLOCK_SIZE, &keySetting);
 
         ofile.write(obuffer,size);
-
         ofile.close();
-        ifile.close();
 
-        delete [] ibuffer;
         delete [] obuffer;
 	}
     wxRemoveFile( tempDir + "/compil.gdg" );
@@ -11,7 +11,8 @@ InputManager::InputManager(sf::Window * win) :
     mouseWheelDelta(0),
     keyWasPressed(false),
     windowHasFocus(true),
-    disableInputWhenNotFocused(true)
+    disableInputWhenNotFocused(true),
+    inputDisabled(false)
 {
 }
 
@@ -26,7 +27,7 @@ void InputManager::HandleEvent(sf::Event & event)
 {
 	if (event.type == sf::Event::KeyPressed)
 	{
-    	if (!windowHasFocus && disableInputWhenNotFocused)
+    	if (IsInputIgnored())
     		return;
 
         lastPressedKey = event.key.code;
@@ -34,7 +35,7 @@ void InputManager::HandleEvent(sf::Event & event)
 	}
     else if (event.type == sf::Event::TextEntered)
     {
-    	if (!windowHasFocus && disableInputWhenNotFocused)
+    	if (IsInputIgnored())
     		return;
 
     	charactersEntered.push_back(event.text.unicode);
@@ -49,7 +50,7 @@ void InputManager::HandleEvent(sf::Event & event)
 
 bool InputManager::IsKeyPressed(std::string key) const
 {
-    if (!windowHasFocus && disableInputWhenNotFocused)
+    if (IsInputIgnored())
         return false;
 
     const auto & keyMap = GetKeyNameToSfKeyMap();
@@ -73,7 +74,7 @@ std::string InputManager::GetLastPressedKey() const
 
 bool InputManager::AnyKeyIsPressed() const
 {
-    if (!windowHasFocus && disableInputWhenNotFocused)
+    if (IsInputIgnored())
         return false;
 
     return keyWasPressed;
@@ -219,14 +220,14 @@ const std::map<int, std::string> & InputManager::GetSfKeyToKeyNameMap()
 
 sf::Vector2i InputManager::GetMousePosition() const
 {
-	if (!window) return sf::Vector2i(0, 0);
+	if (!window || inputDisabled) return sf::Vector2i(0, 0);
 
 	return sf::Mouse::getPosition(*window);
 }
 
 bool InputManager::IsMouseButtonPressed(const std::string & button) const
 {
-    if (!windowHasFocus && disableInputWhenNotFocused)
+    if (IsInputIgnored())
         return false;
 
     if ( button == "Left" ) { return sf::Mouse::isButtonPressed( sf::Mouse::Left ); }
@@ -240,7 +241,7 @@ bool InputManager::IsMouseButtonPressed(const std::string & button) const
 
 int InputManager::GetMouseWheelDelta() const
 {
-    if (!windowHasFocus && disableInputWhenNotFocused)
+    if (IsInputIgnored())
         return 0;
 
     return mouseWheelDelta;
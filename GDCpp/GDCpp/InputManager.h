@@ -32,7 +32,8 @@ public:
         mouseWheelDelta(0),
         keyWasPressed(false),
         windowHasFocus(true),
-        disableInputWhenNotFocused(true)
+        disableInputWhenNotFocused(true),
+        inputDisabled(false)
     {
     }
 
@@ -54,6 +55,13 @@ public:
      */
     void DisableInputWhenFocusIsLost(bool disable = true) { disableInputWhenNotFocused = disable; }
 
+    /**
+     * \brief Set if the keyboard and the mouse must be ignored, whether the window has the focus or not.
+     *
+     * Used to play a scene without a window, so that the input of the user does not change the game.
+     */
+    void DisableInput(bool disable = true) { inputDisabled = disable; }
+
     /**
      * \brief Handle a SFML event made on the window.
      */
@@ -114,12 +122,18 @@ public:
     ///@}
 
 private:
+    /**
+     * \brief Return true if the keyboard and the mouse must be ignored.
+     */
+    bool IsInputIgnored() const { return inputDisabled || (!windowHasFocus && disableInputWhenNotFocused); }
+
     sf::Window * window;
     int lastPressedKey; ///< SFML key code of the last pressed key.
     int mouseWheelDelta;
     bool keyWasPressed; ///< True if a key was pressed during the last step.
     bool windowHasFocus; ///< True if the render target has the focus.
     bool disableInputWhenNotFocused; ///< True if input should be ignored when focus is lost.
+    bool inputDisabled; ///< True if input should always be ignored.
     std::vector<sf::Uint32> charactersEntered; ///< The characters entered during the last frame.
 };
 
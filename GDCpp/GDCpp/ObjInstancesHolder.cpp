@@ -5,14 +5,35 @@
  */
 #include "GDCpp/ObjInstancesHolder.h"
 #include "GDCpp/RuntimeObject.h"
-#include "GDCpp/profile.h"
+#include <algorithm>
+
+namespace
+{
+    /**
+     * Ensure that \a list can hold \a count more elements. The capacity is at least doubled
+     * when it grows, so that reserving a few elements many times stays linear.
+     */
+    template<class T> void ReserveMore(std::vector<T> & list, std::size_t count)
+    {
+        if ( list.size()+count <= list.capacity() ) return;
+        list.reserve(std::max(list.size()+count, 2*list.capacity()));
+    }
+}
 
 void ObjInstancesHolder::AddObject(const RuntimeObjSPtr & object)
 {
+    ++modificationsCount;
     objectsInstances[object->GetName()].push_back(object);
     objectsRawPointersInstances[object->GetName()].push_back(object.get());
 }
 
+void ObjInstancesHolder::Reserve(const std::string & name, std::size_t count)
+{
+    RuntimeObjList & objects = objectsInstances[name];
+    ReserveMore(objects, count);
+    ReserveMore(objectsRawPointersInstances[name], count);
+}
+
 std::vector<RuntimeObject*> ObjInstancesHolder::GetObjectsRawPointers(const std::string & name)
 {
     return objectsRawPointersInstances[name];
@@ -21,6 +42,7 @@ std::vector<RuntimeObject*> ObjInstancesHolder::GetObjectsRawPointers(const std:
 void ObjInstancesHolder::ObjectNameHasChanged(RuntimeObject * object)
 {
     std::shared_ptr<RuntimeObject> theObject; //We need the object to keep alive.
+    ++modificationsCount;
 
     //Find and erase the object from the object lists.
     for (std::unordered_map<std::string, RuntimeObjList>::iterator it = objectsInstances.begin() ; it != objectsInstances.end(); ++it )
@@ -48,6 +70,7 @@ void ObjInstancesHolder::ObjectNameHasChanged(RuntimeObject * object)
 
 void ObjInstancesHolder::Init(const ObjInstancesHolder & other)
 {
+    ++modificationsCount;
     objectsInstances.clear();
     objectsRawPointersInstances.clear();
     for (std::unordered_map<std::string, RuntimeObjList>::const_iterator it = other.objectsInstances.begin() ;
@@ -58,7 +81,8 @@ void ObjInstancesHolder::Init(const ObjInstancesHolder & other)
     }
 }
 
-ObjInstancesHolder::ObjInstancesHolder(const ObjInstancesHolder & other)
+ObjInstancesHolder::ObjInstancesHolder(const ObjInstancesHolder & other) :
+    modificationsCount(0)
 {
     Init(other);
 }
@@ -24,7 +24,7 @@ public:
     /**
      * \brief Default constructor
      */
-    ObjInstancesHolder() {};
+    ObjInstancesHolder() : modificationsCount(0) {};
 
     /**
      * \brief Copy constructor
@@ -47,6 +47,12 @@ public:
      */
     void AddObject(const RuntimeObjSPtr & object);
 
+    /**
+     * \brief Reserve enough memory in the lists of the objects called \a name
+     * for \a count more objects, before adding a lot of them.
+     */
+    void Reserve(const std::string & name, std::size_t count);
+
     /**
      * \brief Get all objects with the specified name
      */
@@ -84,6 +90,7 @@ public:
      */
     inline void RemoveObject(const RuntimeObjSPtr & object)
     {
+        ++modificationsCount;
         for (std::unordered_map<std::string, RuntimeObjList>::iterator it = objectsInstances.begin() ; it != objectsInstances.end(); ++it )
         {
             RuntimeObjList & associatedList = it->second;
@@ -101,6 +108,7 @@ public:
      */
     inline void RemoveObjects(const std::string & name)
     {
+        ++modificationsCount;
         objectsInstances[name].clear();
         objectsRawPointersInstances[name].clear();
     }
@@ -116,15 +124,24 @@ public:
      */
     inline void Clear()
     {
+        ++modificationsCount;
         objectsInstances.clear();
         objectsRawPointersInstances.clear();
     }
 
+    /**
+     * \brief Return a number changed each time objects are added, removed or renamed.
+     *
+     * Useful to know if something computed from the objects must be computed again.
+     */
+    unsigned int GetModificationsCount() const { return modificationsCount; }
+
 private:
     void Init(const ObjInstancesHolder & other);
 
     std::unordered_map<std::string, RuntimeObjList > objectsInstances; ///< The list of all objects, classified by name
     std::unordered_map<std::string, std::vector<RuntimeObject*> > objectsRawPointersInstances; ///< Clones of the objectsInstances lists, but with raw pointers instead.
+    unsigned int modificationsCount;
 };
 
 #endif // OBJINSTANCESHOLDER_H
@@ -12,6 +12,7 @@
 #include "GDCpp/Scene.h"
 #include "GDCore/Events/EventsCodeGenerationContext.h"
 #include "GDCore/Events/EventsCodeGenerator.h"
+#include "GDCore/Events/EventsCodeOutput.h"
 #include "GDCpp/IDE/BaseProfiler.h"
 #include <iostream>
 
@@ -25,7 +26,7 @@ ProfileEvent::~ProfileEvent()
 {
 }
 
-std::string ProfileEvent::GenerateEventCode(gd::EventsCodeGenerator & codeGenerator, gd::EventsCodeGenerationContext & parentContext)
+void ProfileEvent::GenerateEventCode(gd::EventsCodeGenerator & codeGenerator, gd::EventsCodeGenerationContext & parentContext, gd::EventsCodeOutput & output)
 {
     const gd::Layout & scene = codeGenerator.GetLayout();
     codeGenerator.AddIncludeFile("GDCpp/BuiltinExtensions/ProfileTools.h");
@@ -38,14 +39,10 @@ std::string ProfileEvent::GenerateEventCode(gd::EventsCodeGenerator & codeGenera
         scene.GetProfiler()->profileEventsInformation.push_back(profileLink);
         index = scene.GetProfiler()->profileEventsInformation.size()-1;
     }
-    std::string code;
-
     if ( previousProfileEvent )
-        code += "EndProfileTimer(*runtimeContext->scene, "+ToString(previousProfileEvent->index)+");\n";
-
-    code += "StartProfileTimer(*runtimeContext->scene, "+ToString(index)+");\n";
+        output << "EndProfileTimer(*runtimeContext->scene, "+ToString(previousProfileEvent->index)+");\n";
 
-    return code;
+    output << "StartProfileTimer(*runtimeContext->scene, "+ToString(index)+");\n";
 }
 
 /**
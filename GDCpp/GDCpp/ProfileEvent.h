@@ -9,7 +9,6 @@
 #ifndef PROFILEEVENT_H
 #define PROFILEEVENT_H
 #include "GDCore/Events/Event.h"
-#include "GDCpp/profile.h"
 
 /**
  * \brief Event used internally by GD C++ Platform to profile events.
@@ -27,7 +26,7 @@ public:
     void SetPreviousProfileEvent( std::shared_ptr<ProfileEvent> previousProfileEvent_ ) { previousProfileEvent = previousProfileEvent_; }
 
     virtual bool IsExecutable() const {return true;}
-    virtual std::string GenerateEventCode(gd::EventsCodeGenerator & codeGenerator, gd::EventsCodeGenerationContext & context);
+    virtual void GenerateEventCode(gd::EventsCodeGenerator & codeGenerator, gd::EventsCodeGenerationContext & context, gd::EventsCodeOutput & output);
 
     unsigned int index;
 
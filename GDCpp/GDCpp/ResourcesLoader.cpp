@@ -13,6 +13,7 @@
 #include <utility>
 #include <cstring>
 #include "GDCpp/Music.h"
+#include "GDCpp/FrameProfiler.h"
 #undef LoadImage //Undef a macro from windows.h
 
 using namespace std;
@@ -35,6 +36,7 @@ bool ResourcesLoader::SetResourceFile(const string & filename)
 
 sf::Texture ResourcesLoader::LoadSFMLTexture(const string & filename)
 {
+    GD_PROFILE_SCOPE("Load texture");
     sf::Texture texture;
 
     if (resFile.ContainsFile(filename))
@@ -54,6 +56,7 @@ sf::Texture ResourcesLoader::LoadSFMLTexture(const string & filename)
 
 std::pair<sf::Font *, char *> ResourcesLoader::LoadFont(const string & filename)
 {
+    GD_PROFILE_SCOPE("Load font");
     if (resFile.ContainsFile(filename))
     {
         char* buffer = resFile.GetFile(filename);
@@ -93,6 +96,7 @@ std::pair<sf::Font *, char *> ResourcesLoader::LoadFont(const string & filename)
 
 sf::SoundBuffer ResourcesLoader::LoadSoundBuffer( const string & filename )
 {
+    GD_PROFILE_SCOPE("Load sound");
     sf::SoundBuffer sbuffer;
 
     if (resFile.ContainsFile(filename))
@@ -1,7 +1,6 @@
 #include "RuntimeContext.h"
 #include "GDCpp/RuntimeScene.h"
 #include "GDCpp/RuntimeGame.h"
-#include "GDCpp/profile.h"
 #include <vector>
 
 bool RuntimeContext::TriggerOnce(unsigned int conditionId)
@@ -6,6 +6,7 @@
 #include "RuntimeLayer.h"
 #include "GDCpp/Layer.h"
 #include <SFML/Graphics.hpp>
+#include <cmath>
 
 RuntimeLayer::RuntimeLayer(gd::Layer & layer, const sf::View & defaultView) :
     name(layer.GetName()),
@@ -19,7 +20,9 @@ RuntimeCamera::RuntimeCamera(sf::View & view) :
     originalWidth(view.getSize().x),
     originalHeight(view.getSize().y),
     angle(0),
-    zoomFactor(1)
+    zoomFactor(1),
+    areaUpToDate(false),
+    lastCoordsUpToDate(false)
 {
     sfmlView = view;
 }
@@ -28,7 +31,9 @@ RuntimeCamera::RuntimeCamera(gd::Camera & camera, const sf::View & defaultView)
     originalWidth(defaultView.getSize().x),
     originalHeight(defaultView.getSize().y),
     angle(0),
-    zoomFactor(1)
+    zoomFactor(1),
+    areaUpToDate(false),
+    lastCoordsUpToDate(false)
 {
     sfmlView = defaultView;
     if ( !camera.UseDefaultViewport() ) {
@@ -49,6 +54,7 @@ RuntimeCamera::RuntimeCamera(gd::Camera & camera, const sf::View & defaultView)
 void RuntimeCamera::SetZoom(float newZoom)
 {
     if (newZoom == 0) return;
+    InvalidateCache();
 
     zoomFactor = newZoom;
     sfmlView.setSize(sf::Vector2f(originalWidth/zoomFactor, originalHeight/zoomFactor));
@@ -56,17 +62,20 @@ void RuntimeCamera::SetZoom(float newZoom)
 
 void RuntimeCamera::SetRotation(float newAngle)
 {
+    InvalidateCache();
     angle = newAngle;
     sfmlView.setRotation(angle);
 }
 
 void RuntimeCamera::SetViewCenter(const sf::Vector2f & newCenter)
 {
+    InvalidateCache();
     sfmlView.setCenter(newCenter);
 }
 
 void RuntimeCamera::SetSize(float width_, float height_)
 {
+    InvalidateCache();
     originalWidth = width_;
     originalHeight = height_;
     sfmlView.setSize(originalWidth, originalHeight);
@@ -75,5 +84,36 @@ void RuntimeCamera::SetSize(float width_, float height_)
 
 void RuntimeCamera::SetViewport(float x1, float y1, float x2, float y2)
 {
+    InvalidateCache();
     sfmlView.setViewport(sf::FloatRect(x1, y1, x2-x1,y2-y1));
 }
+
+const sf::FloatRect & RuntimeCamera::GetArea() const
+{
+    if ( !areaUpToDate )
+    {
+        const sf::Vector2f & size = sfmlView.getSize();
+        const sf::Vector2f & center = sfmlView.getCenter();
+        float radians = sfmlView.getRotation()*3.14159265f/180.f;
+        float width = std::abs(size.x*std::cos(radians))+std::abs(size.y*std::sin(radians));
+        float height = std::abs(size.x*std::sin(radians))+std::abs(size.y*std::cos(radians));
+
+        area = sf::FloatRect(center.x-width/2, center.y-height/2, width, height);
+        areaUpToDate = true;
+    }
+
+    return area;
+}
+
+const sf::Vector2f & RuntimeCamera::MapPixelToCoords(const sf::RenderTarget & target, const sf::Vector2i & pixel) const
+{
+    if ( !lastCoordsUpToDate || pixel != lastPixel || target.getSize() != lastTargetSize )
+    {
+        lastCoords = target.mapPixelToCoords(pixel, sfmlView);
+        lastPixel = pixel;
+        lastTargetSize = target.getSize();
+        lastCoordsUpToDate = true;
+    }
+
+    return lastCoords;
+}
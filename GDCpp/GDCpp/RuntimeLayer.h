@@ -23,7 +23,7 @@ public:
      *
      * \warning This constructor should not be used: See the two other alternatives.
      */
-    RuntimeCamera() : originalWidth(0), originalHeight(0),angle(0), zoomFactor(1) {};
+    RuntimeCamera() : originalWidth(0), originalHeight(0),angle(0), zoomFactor(1), areaUpToDate(false), lastCoordsUpToDate(false) {};
 
     /**
      * Construct a runtime camera from a sf::View ( The SFML equivalent of a camera ).
@@ -92,7 +92,23 @@ public:
      */
     void SetViewport(float x1, float y1, float x2, float y2);
 
+    /**
+     * \brief Return the area of the scene displayed by the camera.
+     *
+     * If the camera is rotated, this is the bounding box of the displayed area.
+     * \note The area is only computed again when the camera is changed.
+     */
+    const sf::FloatRect & GetArea() const;
+
+    /**
+     * \brief Convert a position on \a target, in pixels, to a position on the scene as displayed by the camera.
+     *
+     * \note The last conversion is kept: converting the same position again is free until the camera is changed.
+     */
+    const sf::Vector2f & MapPixelToCoords(const sf::RenderTarget & target, const sf::Vector2i & pixel) const;
+
 private:
+    void InvalidateCache() { areaUpToDate = false; lastCoordsUpToDate = false; };
 
     float originalWidth;
     float originalHeight;
@@ -100,6 +116,13 @@ private:
     float zoomFactor; ///< Zoom factor of the camera
 
     sf::View sfmlView; ///< The sf::View which is the SFML equivalent of a camera.
+
+    mutable sf::FloatRect area; ///< The area displayed by the camera, if areaUpToDate is true.
+    mutable bool areaUpToDate;
+    mutable sf::Vector2i lastPixel; ///< The position converted by the last call to MapPixelToCoords.
+    mutable sf::Vector2u lastTargetSize; ///< The size of the target used by the last call to MapPixelToCoords.
+    mutable sf::Vector2f lastCoords; ///< The result of the last call to MapPixelToCoords.
+    mutable bool lastCoordsUpToDate;
 };
 
 /**
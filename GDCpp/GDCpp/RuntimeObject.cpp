@@ -13,6 +13,7 @@
 #include "GDCpp/RuntimeScene.h"
 #include "GDCpp/PolygonCollision.h"
 #include "GDCpp/Polygon2d.h"
+#include "GDCpp/FrameProfiler.h"
 #include "GDCore/CommonTools.h"
 #include <SFML/System.hpp>
 #include <iostream>
@@ -26,6 +27,8 @@ RuntimeObject::RuntimeObject(RuntimeScene & scene, const gd::Object & object) :
     Y(0),
     zOrder(0),
     hidden(false),
+    layerHandle(0),
+    layerHandleResolved(false),
     objectVariables(object.GetVariables())
 {
     ClearForce();
@@ -62,6 +65,8 @@ void RuntimeObject::Init(const RuntimeObject & object)
     zOrder = object.zOrder;
     hidden = object.hidden;
     layer = object.layer;
+    layerHandle = object.layerHandle;
+    layerHandleResolved = object.layerHandleResolved;
     force5 = object.force5;
     forces = object.forces;
 
@@ -118,7 +123,7 @@ bool RuntimeObject::ChangeProperty(unsigned int propertyNb, string newValue)
         else
             SetHidden(false);
     }
-    else if ( propertyNb == 4 ) { layer = newValue; }
+    else if ( propertyNb == 4 ) { SetLayer(newValue); }
     else if ( propertyNb == 5 ) {SetZOrder(ToInt(newValue));}
     else if ( propertyNb == 6 ) {return false;}
     else if ( propertyNb == 7 ) {return false;}
@@ -527,12 +532,14 @@ std::vector<Polygon2d> RuntimeObject::GetHitBoxes() const
 
 bool RuntimeObject::CursorOnObject(RuntimeScene & scene, bool)
 {
-    RuntimeLayer & theLayer = scene.GetRuntimeLayer(layer);
+    if (!scene.renderWindow) return false;
+    RuntimeLayer & theLayer = scene.GetRuntimeLayerFromHandle(GetLayerHandle(scene));
 
     for (unsigned int cameraIndex = 0;cameraIndex < theLayer.GetCameraCount();++cameraIndex)
     {
-        sf::Vector2f mousePos = scene.renderWindow->mapPixelToCoords(
-            scene.GetInputManager().GetMousePosition(), theLayer.GetCamera(cameraIndex).GetSFMLView());
+        //The conversion is cached by the camera, so that it is done once for all the objects.
+        const sf::Vector2f & mousePos = theLayer.GetCamera(cameraIndex).MapPixelToCoords(
+            *scene.renderWindow, scene.GetInputManager().GetMousePosition());
 
         if (GetDrawableX() <= mousePos.x
             && GetDrawableX() + GetWidth()  >= mousePos.x
@@ -546,6 +553,12 @@ bool RuntimeObject::CursorOnObject(RuntimeScene & scene, bool)
     return false;
 }
 
+void RuntimeObject::ResolveLayerHandle(const RuntimeScene & scene) const
+{
+    layerHandle = scene.GetRuntimeLayerHandle(layer);
+    layerHandleResolved = true;
+}
+
 Automatism* RuntimeObject::GetAutomatismRawPointer(const std::string & name)
 {
     return automatisms.find(name)->second;
@@ -625,13 +638,19 @@ float RuntimeObject::TotalForceLength() const
 void RuntimeObject::DoAutomatismsPreEvents(RuntimeScene & scene)
 {
     for (std::map<std::string, Automatism* >::const_iterator it = automatisms.begin() ; it != automatisms.end(); ++it )
+    {
+        GD_PROFILE_SCOPE(it->second->GetTypeName());
         it->second->StepPreEvents(scene);
+    }
 }
 
 void RuntimeObject::DoAutomatismsPostEvents(RuntimeScene & scene)
 {
     for (std::map<std::string, Automatism* >::const_iterator it = automatisms.begin() ; it != automatisms.end(); ++it )
+    {
+        GD_PROFILE_SCOPE(it->second->GetTypeName());
         it->second->StepPostEvents(scene);
+    }
 }
 
 bool RuntimeObject::VariableExists(const std::string & variable)
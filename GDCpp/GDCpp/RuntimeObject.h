@@ -91,6 +91,14 @@ public:
      */
     virtual bool Draw(sf::RenderTarget & renderTarget) {return true;};
 
+    /**
+     * \brief Return true if the object is only drawn using TextRenderer.
+     *
+     * The scene draws the texts pending in the TextRenderer before drawing the objects returning false,
+     * so that the texts of consecutive objects returning true can be drawn with a single draw call.
+     */
+    virtual bool IsDrawnWithTextRenderer() const {return false;};
+
     /** \name Object's variables
      * Members functions providing access to the object's variables.
      */
@@ -177,7 +185,7 @@ public:
     /**
      * \brief Change the layer of the object
      */
-    inline void SetLayer(const std::string & layer_) { layer = layer_;}
+    inline void SetLayer(const std::string & layer_) { layer = layer_; layerHandleResolved = false; }
 
     /**
      * \brief Get the layer of the object
@@ -189,6 +197,17 @@ public:
      */
     inline bool IsOnLayer(const std::string & layer_) const { return layer == layer_; }
 
+    /**
+     * \brief Get the handle of the layer of the object in \a scene ( see RuntimeScene::GetRuntimeLayerHandle ).
+     *
+     * The layer is only searched by its name the first time the handle is needed after the layer was changed.
+     */
+    inline unsigned int GetLayerHandle(const RuntimeScene & scene) const
+    {
+        if ( !layerHandleResolved ) ResolveLayerHandle(scene);
+        return layerHandle;
+    }
+
     /**
      * \brief Get the object hitbox(es)
      * \note Default implementation returns a basic bounding box, according to the object width/height and angle.
@@ -434,6 +453,8 @@ protected:
     int                                                     zOrder; ///<Z order on the scene, to choose if an object is displayed before another object.
     bool                                                    hidden; ///<True to prevent the object from being rendered.
     std::string                                             layer; ///<Name of the layer on which the object is.
+    mutable unsigned int                                    layerHandle; ///< The handle of the layer, if layerHandleResolved is true.
+    mutable bool                                            layerHandleResolved; ///< false if the layer was changed since layerHandle was searched.
     std::map<std::string, gd::Automatism* >                 automatisms; ///<Contains all automatisms of the object. Automatisms are the ownership of the object
     RuntimeVariablesContainer                               objectVariables; ///<List of the variables of the object
     std::vector < Force >                                   forces; ///< Forces applied to the object
@@ -443,6 +464,11 @@ protected:
      * \warning Don't forget to update me if members were changed !
      */
     void Init(const RuntimeObject & object);
+
+    /**
+     * \brief Search the handle of the layer of the object in the scene.
+     */
+    void ResolveLayerHandle(const RuntimeScene & scene) const;
 };
 
 /**
@@ -0,0 +1,136 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2015 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#include "GDCpp/RuntimeObjectsGrid.h"
+#include <cmath>
+
+const double RuntimeObjectsGrid::maxCellsPerObject = 16;
+const double RuntimeObjectsGrid::maxCellsCount = 1 << 20;
+
+namespace
+{
+
+/**
+ * Contrary to sf::FloatRect::intersects, rectangles sharing only an edge and rectangles
+ * with a zero size are considered as intersecting.
+ */
+bool Intersects(const sf::FloatRect & a, const sf::FloatRect & b)
+{
+    return a.left <= b.left+b.width && b.left <= a.left+a.width &&
+           a.top <= b.top+b.height && b.top <= a.top+a.height;
+}
+
+}
+
+RuntimeObjectsGrid::RuntimeObjectsGrid(float cellSize_) :
+    cellSize(cellSize_),
+    queriesCount(0)
+{
+}
+
+void RuntimeObjectsGrid::Clear()
+{
+    //Objects moving around leave a lot of empty cells, which are only destroyed when they are too many.
+    if ( cells.size() > 4*entries.size()+1024 )
+        cells.clear();
+    else
+    {
+        for (std::unordered_map<unsigned long long, std::vector<unsigned int> >::iterator it = cells.begin();it != cells.end();++it)
+            it->second.clear();
+    }
+
+    entries.clear();
+    largeEntries.clear();
+}
+
+double RuntimeObjectsGrid::GetCellsRange(const sf::FloatRect & area, int & x1, int & y1, int & x2, int & y2) const
+{
+    double left = std::floor(area.left/cellSize);
+    double top = std::floor(area.top/cellSize);
+    double right = std::floor((area.left+area.width)/cellSize);
+    double bottom = std::floor((area.top+area.height)/cellSize);
+
+    double cellsCount = (right-left+1)*(bottom-top+1);
+    if ( !(cellsCount <= maxCellsCount) ) return cellsCount; //Also true if the area is not a number.
+
+    x1 = static_cast<int>(left);
+    y1 = static_cast<int>(top);
+    x2 = static_cast<int>(right);
+    y2 = static_cast<int>(bottom);
+    return cellsCount;
+}
+
+void RuntimeObjectsGrid::Insert(RuntimeObject * object, const sf::FloatRect & bounds)
+{
+    unsigned int index = entries.size();
+    entries.push_back(Entry(object, bounds));
+
+    int x1 = 0, y1 = 0, x2 = 0, y2 = 0;
+    if ( !(GetCellsRange(bounds, x1, y1, x2, y2) <= maxCellsPerObject) )
+    {
+        largeEntries.push_back(index);
+        return;
+    }
+
+    for (int x = x1;x<=x2;++x)
+    {
+        for (int y = y1;y<=y2;++y)
+            cells[GetCellKey(x, y)].push_back(index);
+    }
+}
+
+void RuntimeObjectsGrid::Query(const sf::FloatRect & area, std::vector<RuntimeObject*> & result) const
+{
+    ++queriesCount;
+    if ( queriesCount == 0 ) //Reset the marks when the counter wraps around.
+    {
+        for (unsigned int i = 0;i<entries.size();++i) entries[i].lastQuery = 0;
+        queriesCount = 1;
+    }
+
+    //Large objects are marked so that they are not returned again.
+    for (unsigned int i = 0;i<largeEntries.size();++i)
+    {
+        const Entry & entry = entries[largeEntries[i]];
+        entry.lastQuery = queriesCount;
+        if ( Intersects(entry.bounds, area) ) result.push_back(entry.object);
+    }
+
+    //Big areas are checked against all the objects rather than against all their cells.
+    int x1 = 0, y1 = 0, x2 = 0, y2 = 0;
+    double cellsCount = GetCellsRange(area, x1, y1, x2, y2);
+    if ( !(cellsCount <= maxCellsCount && cellsCount <= static_cast<double>(cells.size())) )
+    {
+        for (unsigned int i = 0;i<entries.size();++i)
+        {
+            const Entry & entry = entries[i];
+            if ( entry.lastQuery != queriesCount && Intersects(entry.bounds, area) )
+            {
+                entry.lastQuery = queriesCount;
+                result.push_back(entry.object);
+            }
+        }
+        return;
+    }
+
+    for (int x = x1;x<=x2;++x)
+    {
+        for (int y = y1;y<=y2;++y)
+        {
+            std::unordered_map<unsigned long long, std::vector<unsigned int> >::const_iterator cell = cells.find(GetCellKey(x, y));
+            if ( cell == cells.end() ) continue;
+
+            for (unsigned int i = 0;i<cell->second.size();++i)
+            {
+                const Entry & entry = entries[cell->second[i]];
+                if ( entry.lastQuery != queriesCount && Intersects(entry.bounds, area) )
+                {
+                    entry.lastQuery = queriesCount;
+                    result.push_back(entry.object);
+                }
+            }
+        }
+    }
+}
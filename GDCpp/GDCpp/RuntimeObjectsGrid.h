@@ -0,0 +1,83 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2015 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#ifndef RUNTIMEOBJECTSGRID_H
+#define RUNTIMEOBJECTSGRID_H
+#include <SFML/Graphics/Rect.hpp>
+#include <vector>
+#include <unordered_map>
+class RuntimeObject;
+
+/**
+ * \brief A grid storing the bounding boxes of objects, used to quickly find the objects
+ * intersecting an area.
+ *
+ * Objects are stored in each cell covered by their bounding box. Objects covering too many cells
+ * are stored in a separate list, checked by all the queries.
+ *
+ * \see RuntimeScene::GetObjectsInArea
+ * \ingroup GameEngine
+ */
+class GD_API RuntimeObjectsGrid
+{
+public:
+    RuntimeObjectsGrid(float cellSize = 128);
+    virtual ~RuntimeObjectsGrid() {};
+
+    /**
+     * \brief Remove all the objects from the grid.
+     *
+     * \note The memory used by the cells is kept, so that filling the grid again
+     * with the same objects does not allocate memory.
+     */
+    void Clear();
+
+    /**
+     * \brief Add an object to the grid.
+     * \warning An object must not be added twice.
+     */
+    void Insert(RuntimeObject * object, const sf::FloatRect & bounds);
+
+    /**
+     * \brief Add to \a result the objects having a bounding box intersecting \a area.
+     *
+     * The edges are included so that an area of zero size can be used to find the objects at a position.
+     * The objects are added in no particular order.
+     */
+    void Query(const sf::FloatRect & area, std::vector<RuntimeObject*> & result) const;
+
+    /**
+     * \brief Return the number of objects in the grid.
+     */
+    std::size_t GetObjectsCount() const { return entries.size(); };
+
+private:
+    struct Entry
+    {
+        Entry(RuntimeObject * object_, const sf::FloatRect & bounds_) : object(object_), bounds(bounds_), lastQuery(0) {};
+
+        RuntimeObject * object;
+        sf::FloatRect bounds;
+        mutable unsigned int lastQuery; ///< The last query which found the object, so that it is only returned once.
+    };
+
+    static unsigned long long GetCellKey(int x, int y) { return (static_cast<unsigned long long>(static_cast<unsigned int>(x)) << 32) | static_cast<unsigned int>(y); };
+    /**
+     * \brief Compute the range of the cells covered by \a area and return the number of cells.
+     * The range is not computed if there are more than maxCellsCount cells.
+     */
+    double GetCellsRange(const sf::FloatRect & area, int & x1, int & y1, int & x2, int & y2) const;
+
+    float cellSize;
+    std::vector<Entry> entries;
+    std::unordered_map<unsigned long long, std::vector<unsigned int> > cells; ///< The index in entries of the objects in each cell.
+    std::vector<unsigned int> largeEntries; ///< The index in entries of the objects covering too many cells.
+    mutable unsigned int queriesCount;
+
+    static const double maxCellsPerObject;
+    static const double maxCellsCount;
+};
+
+#endif // RUNTIMEOBJECTSGRID_H
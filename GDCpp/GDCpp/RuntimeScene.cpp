@@ -9,6 +9,9 @@
 #include <sstream>
 #include <fstream>
 #include <iomanip>
+#include <cmath>
+#include <algorithm>
+#include <unordered_map>
 #include <SFML/System.hpp>
 #include <SFML/Graphics.hpp>
 #include <SFML/OpenGL.hpp>
@@ -22,7 +25,7 @@
 #include "GDCpp/ImageManager.h"
 #include "GDCpp/SoundManager.h"
 #include "GDCpp/Layer.h"
-#include "GDCpp/profile.h"
+#include "GDCpp/FrameProfiler.h"
 #include "GDCpp/Position.h"
 #include "GDCpp/FontManager.h"
 #include "GDCpp/AutomatismsSharedData.h"
@@ -30,6 +33,7 @@
 #include "GDCpp/RuntimeContext.h"
 #include "GDCpp/Project.h"
 #include "GDCpp/Text.h"
+#include "GDCpp/TextRenderer.h"
 #include "GDCpp/ManualTimer.h"
 #include "GDCpp/CppPlatform.h"
 #include "GDCore/Tools/Localization.h"
@@ -46,6 +50,7 @@
 #undef GetObject //Disable an annoying macro
 
 RuntimeLayer RuntimeScene::badRuntimeLayer;
+const unsigned int RuntimeScene::badLayerHandle = static_cast<unsigned int>(-1);
 
 RuntimeScene::RuntimeScene(sf::RenderWindow * renderWindow_, RuntimeGame * game_) :
     renderWindow(renderWindow_),
@@ -63,7 +68,10 @@ RuntimeScene::RuntimeScene(sf::RenderWindow * renderWindow_, RuntimeGame * game_
     timeFromStart(0),
     pauseTime(0),
     specialAction(-1),
-    codeExecutionEngine(new CodeExecutionEngine)
+    codeExecutionEngine(new CodeExecutionEngine),
+    objectsGridUpToDate(false),
+    objectsGridModificationsCount(0),
+    objectsGridBuildsCount(0)
 {
     ChangeRenderWindow(renderWindow);
 }
@@ -112,43 +120,60 @@ void RuntimeScene::SetupOpenGLProjection()
     gluPerspective(GetOpenGLFOV(), windowRatio, GetOpenGLZNear(), GetOpenGLZFar());
 }
 
-#ifndef RELEASE
-void DisplayProfile(sf::RenderWindow * renderWindow, CProfileIterator * iter, int x, int & y)
+int RuntimeScene::RenderAndStep()
 {
-    if (!renderWindow) return;
-    FontManager * fontManager = FontManager::Get();
+    GD_PROFILE_SCOPE("Frame");
+    AllocationsCount frameStart = AllocationsTracker::GetCount();
+    ManageRenderTargetEvents();
+    UpdateTime(clock.restart().asMicroseconds()-pauseTime);
+    StepObjectsAndEvents();
+
+    //Rendering
+    Render();
+    legacyTexts.clear();
 
-    y += 15;
-    while ( !iter->Is_Done() )
+    #if defined(GD_IDE_ONLY)
+    if( GetProfiler() && GetProfiler()->profilingActivated )
     {
-        sf::Text text("", *fontManager->GetFont(""));
-        text.setCharacterSize(12);
-        ostringstream texte;
-        if ( CProfileManager::Get_Frame_Count_Since_Reset() != 0 )
-            texte << fixed <<  iter->Get_Current_Name()   << " Calls/Frame:" << iter->Get_Current_Total_Calls()/CProfileManager::Get_Frame_Count_Since_Reset()
-                                                << " Time/Frame:" << iter->Get_Current_Total_Time()/CProfileManager::Get_Frame_Count_Since_Reset()
-                                                << " %Time/Parent " << iter->Get_Current_Total_Time()/iter->Get_Current_Parent_Total_Time()*100.0f;
-        text.setString(texte.str());
-        text.setPosition(x,y);
-        renderWindow->draw(text);
-
-        //Childs
-        CProfileIterator * childIter = CProfileManager::Get_Iterator();
-        *childIter = *iter;
-        childIter->Enter_Child(0);
-        DisplayProfile(renderWindow, childIter, x+15, y);
-        CProfileManager::Release_Iterator(childIter);
-
-        y += 15;
-        iter->Next();
+        GetProfiler()->lastRenderingTime = GetProfiler()->renderingClock.getElapsedTime().asMicroseconds();
+        GetProfiler()->totalSceneTime += GetProfiler()->lastRenderingTime + GetProfiler()->lastEventsTime;
+        GetProfiler()->totalEventsTime += GetProfiler()->lastEventsTime;
+        GetProfiler()->Update();
     }
+    #endif
+
+    lastFrameAllocations = AllocationsTracker::GetCount()-frameStart;
+    firstLoop = false; //The first frame was rendered
+    return specialAction;
 }
-#endif
 
-int RuntimeScene::RenderAndStep()
+int RuntimeScene::Step(signed long long elapsedMicroseconds, sf::RenderTexture * renderTexture)
+{
+    GD_PROFILE_SCOPE("Frame");
+    AllocationsCount frameStart = AllocationsTracker::GetCount();
+
+    //Without a window, the keyboard and the mouse must not be read, so that the steps are deterministic.
+    inputManager.NextFrame();
+    inputManager.DisableInput();
+
+    UpdateTime(elapsedMicroseconds);
+    StepObjectsAndEvents();
+
+    if ( renderTexture )
+    {
+        renderTexture->setActive();
+        Render(*renderTexture);
+        renderTexture->display();
+    }
+    legacyTexts.clear();
+
+    lastFrameAllocations = AllocationsTracker::GetCount()-frameStart;
+    firstLoop = false;
+    return specialAction;
+}
+
+void RuntimeScene::StepObjectsAndEvents()
 {
-    ManageRenderTargetEvents();
-    UpdateTime();
     ManageObjectsBeforeEvents();
     SoundManager::Get()->ManageGarbage();
 
@@ -156,22 +181,21 @@ int RuntimeScene::RenderAndStep()
     if( GetProfiler() )
     {
         if ( firstLoop ) GetProfiler()->Reset();
-        GetProfiler()->eventsClock.reset();
+        GetProfiler()->eventsClock.restart();
     }
     #endif
 
     {
-        #if !defined(RELEASE)
-        BT_PROFILE("Events");
-        #endif
-        GetCodeExecutionEngine()->Execute();
+        GD_PROFILE_SCOPE("Events");
+        InvalidateSpatialIndex(); //Objects were moved by automatisms.
+        if ( GetCodeExecutionEngine()->Ready() ) GetCodeExecutionEngine()->Execute();
     }
 
     #if defined(GD_IDE_ONLY)
     if( GetProfiler() && GetProfiler()->profilingActivated )
     {
-        GetProfiler()->lastEventsTime = GetProfiler()->eventsClock.getTimeMicroseconds();
-        GetProfiler()->renderingClock.reset();
+        GetProfiler()->lastEventsTime = GetProfiler()->eventsClock.getElapsedTime().asMicroseconds();
+        GetProfiler()->renderingClock.restart();
     }
     #endif
 
@@ -180,29 +204,13 @@ int RuntimeScene::RenderAndStep()
     #if defined(GD_IDE_ONLY)
     if( debugger ) debugger->Update();
     #endif
-
-    //Rendering
-    Render();
-    legacyTexts.clear();
-
-    #if defined(GD_IDE_ONLY)
-    if( GetProfiler() && GetProfiler()->profilingActivated )
-    {
-        GetProfiler()->lastRenderingTime = GetProfiler()->renderingClock.getTimeMicroseconds();
-        GetProfiler()->totalSceneTime += GetProfiler()->lastRenderingTime + GetProfiler()->lastEventsTime;
-        GetProfiler()->totalEventsTime += GetProfiler()->lastEventsTime;
-        GetProfiler()->Update();
-    }
-    #endif
-
-    firstLoop = false; //The first frame was rendered
-    return specialAction;
 }
 
 void RuntimeScene::ManageRenderTargetEvents()
 {
     if (!renderWindow) return;
     inputManager.NextFrame();
+    inputManager.DisableInput(false); //The input may have been disabled by Step.
 
     sf::Event event;
     while (renderWindow->pollEvent(event))
@@ -243,80 +251,91 @@ void RuntimeScene::Render()
 {
     if (!renderWindow) return;
 
-    renderWindow->clear( sf::Color( GetBackgroundColorRed(), GetBackgroundColorGreen(), GetBackgroundColorBlue() ) );
+    renderWindow->setActive();
+    Render(*renderWindow);
+
+    // Display window contents on screen
+    GD_PROFILE_SCOPE("Display");
+    renderWindow->display();
+}
+
+void RuntimeScene::Render(sf::RenderTarget & renderTarget)
+{
+    GD_PROFILE_SCOPE("Render");
+
+    renderTarget.clear( sf::Color( GetBackgroundColorRed(), GetBackgroundColorGreen(), GetBackgroundColorBlue() ) );
 
     //Sort object by order to render them
     RuntimeObjList allObjects = objectsInstances.GetAllObjects();
     OrderObjectsByZOrder(allObjects);
 
+    //Put the objects in the list of their layer, so that layers and cameras do not iterate over all objects.
+    objectsByLayer.resize(layers.size());
+    for (unsigned int layerIndex = 0;layerIndex<objectsByLayer.size();++layerIndex)
+        objectsByLayer[layerIndex].clear(); //The memory is kept for the next frames.
+
+    for (unsigned int id = 0;id < allObjects.size();++id)
+    {
+        unsigned int handle = allObjects[id]->GetLayerHandle(*this);
+        if ( handle < objectsByLayer.size() ) objectsByLayer[handle].push_back(allObjects[id].get());
+    }
+
     //To allow using OpenGL to draw:
     glClear(GL_DEPTH_BUFFER_BIT); // Clear the depth buffer
-    renderWindow->pushGLStates();
-    renderWindow->setActive();
+    renderTarget.pushGLStates();
+    TextRenderer * textRenderer = TextRenderer::Get();
 
     //Draw layer by layer
     for (unsigned int layerIndex =0;layerIndex<layers.size();++layerIndex)
     {
         if ( layers[layerIndex].GetVisibility() )
         {
+            GD_PROFILE_SCOPE(layers[layerIndex].GetName()); //The name is only copied when profiling.
             for (unsigned int cameraIndex = 0;cameraIndex < layers[layerIndex].GetCameraCount();++cameraIndex)
             {
                 RuntimeCamera & camera = layers[layerIndex].GetCamera(cameraIndex);
 
                 //Prepare OpenGL rendering
-                renderWindow->popGLStates();
+                renderTarget.popGLStates();
 
                 glMatrixMode(GL_PROJECTION);
                 glLoadIdentity();
                 gluPerspective(GetOpenGLFOV(), camera.GetWidth()/camera.GetHeight(), GetOpenGLZNear(), GetOpenGLZFar());
 
                 const sf::FloatRect & viewport = camera.GetSFMLView().getViewport();
-                glViewport(viewport.left*renderWindow->getSize().x,
-                           renderWindow->getSize().y-(viewport.top+viewport.height)*renderWindow->getSize().y, //Y start from bottom
-                           viewport.width*renderWindow->getSize().x,
-                           viewport.height*renderWindow->getSize().y);
+                glViewport(viewport.left*renderTarget.getSize().x,
+                           renderTarget.getSize().y-(viewport.top+viewport.height)*renderTarget.getSize().y, //Y start from bottom
+                           viewport.width*renderTarget.getSize().x,
+                           viewport.height*renderTarget.getSize().y);
 
-                renderWindow->pushGLStates();
+                renderTarget.pushGLStates();
 
                 //Prepare SFML rendering
-                renderWindow->setView(camera.GetSFMLView());
+                renderTarget.setView(camera.GetSFMLView());
 
-                //Rendering all objects
-                for (unsigned int id = 0;id < allObjects.size();++id)
+                //Rendering all objects of the layer
+                const std::vector<RuntimeObject*> & layerObjects = objectsByLayer[layerIndex];
+                for (unsigned int id = 0;id < layerObjects.size();++id)
                 {
-                    if (allObjects[id]->GetLayer() == layers[layerIndex].GetName())
-                        allObjects[id]->Draw(*renderWindow);
+                    //Texts are drawn by batches, which must be drawn before any other object.
+                    if ( !layerObjects[id]->IsDrawnWithTextRenderer() ) textRenderer->Flush();
+                    layerObjects[id]->Draw(renderTarget);
                 }
 
                 //Texts
-                DisplayLegacyTexts(layers[layerIndex].GetName());
+                DisplayLegacyTexts(renderTarget, layers[layerIndex].GetName());
+                textRenderer->Flush(); //Before the view of the next camera is set.
             }
         }
     }
 
-    //Internal profiler
-    #ifndef RELEASE
-    if ( sf::Keyboard::isKeyPressed(sf::Keyboard::F2))
-        CProfileManager::Reset();
-
-    renderWindow->setView(sf::View(sf::FloatRect(0.0f,0.0f, game->GetMainWindowDefaultWidth(), game->GetMainWindowDefaultHeight())));
-
-    CProfileIterator * iter = CProfileManager::Get_Iterator();
-    int y = 0;
-    DisplayProfile(renderWindow, iter, 0,y);
-    CProfileManager::Increment_Frame_Counter();
-    #endif
-
-    // Display window contents on screen
-    renderWindow->popGLStates();
-    renderWindow->display();
+    renderTarget.popGLStates();
 }
 
-bool RuntimeScene::UpdateTime()
+bool RuntimeScene::UpdateTime(signed long long elapsedMicroseconds)
 {
     //Update time elapsed since last frame
-    realElapsedTime = clock.restart().asMicroseconds();
-    realElapsedTime -= pauseTime;
+    realElapsedTime = elapsedMicroseconds;
 
     //Make sure that the elapsed time is not beyond the limit (slow down the game if necessary)
     if ( game->GetMinimumFPS() != 0 && realElapsedTime > 1000000.0/static_cast<double>(game->GetMinimumFPS()) )
@@ -354,32 +373,157 @@ void RuntimeScene::DisplayText(Text & text)
     legacyTexts.push_back(text);
 }
 
-bool RuntimeScene::DisplayLegacyTexts(string layer)
+bool RuntimeScene::DisplayLegacyTexts(sf::RenderTarget & renderTarget, string layer)
 {
-    if (!renderWindow) return false;
+    //Legacy texts are displayed again at each frame, usually in the same order:
+    //the geometry of each text is kept to be reused by the text displayed at the same position in the next frame.
+    if ( legacyTextsGeometries.size() < legacyTexts.size() ) legacyTextsGeometries.resize(legacyTexts.size());
 
+    TextRenderer * textRenderer = TextRenderer::Get();
+    FontManager * fontManager = FontManager::Get();
     for ( unsigned int i = 0;i < legacyTexts.size();i++ )
     {
         if ( legacyTexts[i].layer == layer )
-            legacyTexts[i].Draw(*renderWindow);
+        {
+            const sf::Text & text = legacyTexts[i].text;
+            legacyTextsGeometries[i].Update(text.getString(), fontManager->GetFont(legacyTexts[i].fontName), text.getCharacterSize(), text.getStyle());
+            textRenderer->Draw(renderTarget, legacyTextsGeometries[i], text.getTransform(), text.getColor());
+        }
     }
 
     return true;
 }
 
-RuntimeLayer & RuntimeScene::GetRuntimeLayer(const std::string & name)
+namespace
+{
+
+/**
+ * \brief Return the bounding box of an object used by the spatial queries.
+ *
+ * Objects are rotated around their center: the square containing the object whatever its angle is used.
+ */
+sf::FloatRect GetObjectBoundingBox(RuntimeObject & object)
+{
+    float width = object.GetWidth();
+    float height = object.GetHeight();
+    float centerX = object.GetDrawableX()+object.GetCenterX();
+    float centerY = object.GetDrawableY()+object.GetCenterY();
+    float halfDiagonal = std::sqrt(width*width+height*height)/2;
+    return sf::FloatRect(centerX-halfDiagonal, centerY-halfDiagonal, halfDiagonal*2, halfDiagonal*2);
+}
+
+}
+
+void RuntimeScene::UpdateSpatialIndex()
 {
-    for (unsigned int i = 0;i<layers.size();++i)
+    if ( objectsGridUpToDate && objectsGridModificationsCount == objectsInstances.GetModificationsCount() )
+        return;
+
+    GD_PROFILE_SCOPE("UpdateSpatialIndex");
+    objectsGrid.Clear();
+    RuntimeObjList allObjects = objectsInstances.GetAllObjects();
+    for (unsigned int i = 0;i<allObjects.size();++i)
     {
-        if ( layers[i].GetName() == name )
-            return layers[i];
+        if ( !allObjects[i]->GetName().empty() ) //Objects deleted during the frame are ignored.
+            objectsGrid.Insert(allObjects[i].get(), GetObjectBoundingBox(*allObjects[i]));
     }
 
-    return badRuntimeLayer;
+    objectsGridUpToDate = true;
+    objectsGridModificationsCount = objectsInstances.GetModificationsCount();
+    ++objectsGridBuildsCount;
+}
+
+const std::vector<RuntimeObject*> & RuntimeScene::GetCachedObjectsInArea(SpatialQueryResult & cache, const sf::FloatRect & area)
+{
+    UpdateSpatialIndex();
+    if ( cache.objectsGridBuild != objectsGridBuildsCount || cache.area != area )
+    {
+        cache.objects.clear();
+        objectsGrid.Query(area, cache.objects);
+        std::sort(cache.objects.begin(), cache.objects.end());
+
+        cache.area = area;
+        cache.objectsGridBuild = objectsGridBuildsCount;
+    }
+
+    return cache.objects;
+}
+
+RuntimeScene::SpatialQueryResult & RuntimeScene::GetCameraVisibleObjects(unsigned int layerHandle, unsigned int camera, float extraBorder)
+{
+    for (std::size_t i = 0;i<camerasVisibleObjects.size();++i)
+    {
+        SpatialQueryResult & cache = camerasVisibleObjects[i];
+        if ( cache.layerHandle == layerHandle && cache.camera == camera && cache.extraBorder == extraBorder )
+            return cache;
+    }
+
+    camerasVisibleObjects.push_back(SpatialQueryResult());
+    camerasVisibleObjects.back().layerHandle = layerHandle;
+    camerasVisibleObjects.back().camera = camera;
+    camerasVisibleObjects.back().extraBorder = extraBorder;
+    return camerasVisibleObjects.back();
+}
+
+void RuntimeScene::GetObjectsInArea(const sf::FloatRect & area, std::vector<RuntimeObject*> & result)
+{
+    UpdateSpatialIndex();
+    objectsGrid.Query(area, result);
+}
+
+void RuntimeScene::GetObjectsAtPosition(float x, float y, std::vector<RuntimeObject*> & result)
+{
+    UpdateSpatialIndex();
+    objectsGrid.Query(sf::FloatRect(x, y, 0, 0), result);
+}
+
+void RuntimeScene::GetObjectsVisibleFromCamera(const std::string & layer, unsigned int camera, std::vector<RuntimeObject*> & result)
+{
+    unsigned int handle = GetRuntimeLayerHandle(layer);
+    const RuntimeLayer & runtimeLayer = GetRuntimeLayerFromHandle(handle);
+    if ( camera >= runtimeLayer.GetCameraCount() ) return;
+
+    const std::vector<RuntimeObject*> & objects = GetCachedObjectsInArea(GetCameraVisibleObjects(handle, camera, 0),
+        runtimeLayer.GetCamera(camera).GetArea());
+
+    //Only keep the objects of the layer.
+    for (std::size_t i = 0;i<objects.size();++i)
+    {
+        if ( objects[i]->GetLayerHandle(*this) == handle ) result.push_back(objects[i]);
+    }
+}
+
+bool RuntimeScene::IsObjectVisibleFromCamera(const RuntimeObject & object, unsigned int camera, float extraBorder)
+{
+    unsigned int handle = object.GetLayerHandle(*this);
+    const RuntimeLayer & runtimeLayer = GetRuntimeLayerFromHandle(handle);
+    if ( camera >= runtimeLayer.GetCameraCount() ) return false;
+
+    const sf::FloatRect & cameraArea = runtimeLayer.GetCamera(camera).GetArea();
+    sf::FloatRect area(cameraArea.left-extraBorder, cameraArea.top-extraBorder,
+        cameraArea.width+2*extraBorder, cameraArea.height+2*extraBorder);
+
+    const std::vector<RuntimeObject*> & objects = GetCachedObjectsInArea(GetCameraVisibleObjects(handle, camera, extraBorder), area);
+    return std::binary_search(objects.begin(), objects.end(), const_cast<RuntimeObject*>(&object));
+}
+
+bool RuntimeScene::IsObjectAtPosition(const RuntimeObject & object, float x, float y)
+{
+    const std::vector<RuntimeObject*> & objects = GetCachedObjectsInArea(objectsAtPosition, sf::FloatRect(x, y, 0, 0));
+    return std::binary_search(objects.begin(), objects.end(), const_cast<RuntimeObject*>(&object));
+}
+
+unsigned int RuntimeScene::GetRuntimeLayerHandle(const std::string & name) const
+{
+    std::unordered_map<std::string, unsigned int>::const_iterator it = layersHandles.find(name);
+    return it != layersHandles.end() ? it->second : badLayerHandle;
 }
 
 void RuntimeScene::ManageObjectsAfterEvents()
 {
+    GD_PROFILE_SCOPE("ManageObjectsAfterEvents");
+    InvalidateSpatialIndex(); //Objects were moved by events.
+
     //Delete objects that were removed.
     RuntimeObjList allObjects = objectsInstances.GetAllObjects();
     for (unsigned int id = 0;id<allObjects.size();++id)
@@ -407,6 +551,9 @@ void RuntimeScene::ManageObjectsAfterEvents()
 
 void RuntimeScene::ManageObjectsBeforeEvents()
 {
+    GD_PROFILE_SCOPE("ManageObjectsBeforeEvents");
+    InvalidateSpatialIndex(); //Objects were moved during the last frame.
+
     RuntimeObjList allObjects = objectsInstances.GetAllObjects();
     for (unsigned int id = 0;id<allObjects.size();++id)
         allObjects[id]->DoAutomatismsPreEvents(*this);
@@ -419,35 +566,73 @@ void RuntimeScene::GotoSceneWhenEventsAreFinished(int scene)
 }
 
 /**
- * \brief Internal Tool class used by RuntimeScene::CreateObjectsFrom
+ * \brief Internal Tool class used by RuntimeScene::CreateObjectsFrom to group the instances by object.
  */
-class ObjectsFromInitialInstanceCreator : public gd::InitialInstanceFunctor
+class InitialInstancesGrouper : public gd::InitialInstanceFunctor
 {
 public:
-    ObjectsFromInitialInstanceCreator(gd::Project & game_, RuntimeScene & scene_, float xOffset_, float yOffset_, std::map<const gd::InitialInstance *, std::shared_ptr<RuntimeObject> > * optionalMap_) :
-        game(game_),
-        scene(scene_),
-        xOffset(xOffset_),
-        yOffset(yOffset_),
-        optionalMap(optionalMap_)
-    {};
-    virtual ~ObjectsFromInitialInstanceCreator() {};
-
-    virtual void operator()(gd::InitialInstance * instancePtr)
+    InitialInstancesGrouper() {};
+    virtual ~InitialInstancesGrouper() {};
+
+    virtual void operator()(gd::InitialInstance * instance)
     {
-        gd::InitialInstance & instance = *instancePtr;
-        std::vector<ObjSPtr>::const_iterator sceneObject = std::find_if(scene.GetObjects().begin(), scene.GetObjects().end(), std::bind2nd(ObjectHasName(), instance.GetObjectName()));
-        std::vector<ObjSPtr>::const_iterator globalObject = std::find_if(game.GetObjects().begin(), game.GetObjects().end(), std::bind2nd(ObjectHasName(), instance.GetObjectName()));
+        //Object names are interned: instances of the same object share the same name string.
+        const std::string * objectName = &instance->GetObjectName();
+        std::unordered_map<const std::string *, unsigned int>::iterator group = groupsIndices.find(objectName);
+        if ( group == groupsIndices.end() )
+        {
+            group = groupsIndices.insert(std::make_pair(objectName, groups.size())).first;
+            groups.push_back(std::vector<const gd::InitialInstance*>());
+        }
 
-        RuntimeObjSPtr newObject = std::shared_ptr<RuntimeObject> ();
+        groups[group->second].push_back(instance);
+    }
 
-        if ( sceneObject != scene.GetObjects().end() ) //We check first scene's objects' list.
-            newObject = CppPlatform::Get().CreateRuntimeObject(scene, **sceneObject);
-        else if ( globalObject != scene.game->GetObjects().end() ) //Then the global object list
-            newObject = CppPlatform::Get().CreateRuntimeObject(scene, **globalObject);
+    std::vector< std::vector<const gd::InitialInstance*> > groups; ///< The instances of each object, in the order of the container.
+
+private:
+    std::unordered_map<const std::string *, unsigned int> groupsIndices;
+};
+
+void RuntimeScene::CreateObjectsFrom(const gd::InitialInstancesContainer & container, float xOffset, float yOffset, std::map<const gd::InitialInstance *, std::shared_ptr<RuntimeObject> > * optionalMap)
+{
+    InitialInstancesGrouper grouper;
+    const_cast<gd::InitialInstancesContainer&>(container).IterateOverInstances(grouper);
 
-        if ( newObject != std::shared_ptr<RuntimeObject> () )
+    //The object and the function creating its runtime objects are searched only once for all the instances of an object.
+    for (unsigned int g = 0;g<grouper.groups.size();++g)
+    {
+        const std::vector<const gd::InitialInstance*> & instances = grouper.groups[g];
+        const std::string & objectName = instances[0]->GetObjectName();
+
+        gd::Object * object = NULL;
+        std::vector<ObjSPtr>::const_iterator sceneObject = std::find_if(GetObjects().begin(), GetObjects().end(), std::bind2nd(ObjectHasName(), objectName));
+        std::vector<ObjSPtr>::const_iterator globalObject = std::find_if(game->GetObjects().begin(), game->GetObjects().end(), std::bind2nd(ObjectHasName(), objectName));
+        if ( sceneObject != GetObjects().end() ) //We check first scene's objects' list.
+            object = sceneObject->get();
+        else if ( globalObject != game->GetObjects().end() ) //Then the global object list
+            object = globalObject->get();
+
+        CreateRuntimeObjectFunPtr createFunction = object ? CppPlatform::Get().GetRuntimeObjectCreationFunction(object->GetType()) : NULL;
+        if ( !createFunction )
         {
+            if ( object ) std::cout << "Tried to create an object with an unknown type: " << object->GetType() << std::endl;
+            std::cout << "Could not find and put object " << objectName << " (" << instances.size() << " instances)" << std::endl;
+
+            if ( optionalMap )
+            {
+                for (unsigned int i = 0;i<instances.size();++i)
+                    (*optionalMap)[instances[i]] = std::shared_ptr<RuntimeObject>();
+            }
+            continue;
+        }
+
+        objectsInstances.Reserve(objectName, instances.size());
+        for (unsigned int i = 0;i<instances.size();++i)
+        {
+            const gd::InitialInstance & instance = *instances[i];
+            std::shared_ptr<RuntimeObject> newObject(createFunction(*this, *object));
+
             newObject->SetX( instance.GetX() + xOffset );
             newObject->SetY( instance.GetY() + yOffset );
             newObject->SetZOrder( instance.GetZOrder() );
@@ -464,26 +649,10 @@ public:
             //Substitute initial variables specific to that object instance.
             newObject->GetVariables().Merge(instance.GetVariables());
 
-            scene.objectsInstances.AddObject(newObject);
+            objectsInstances.AddObject(newObject);
+            if ( optionalMap ) (*optionalMap)[&instance] = newObject;
         }
-        else
-            std::cout << "Could not find and put object " << instance.GetObjectName() << std::endl;
-
-        if ( optionalMap ) (*optionalMap)[&instance] = newObject;
     }
-
-private:
-    gd::Project & game;
-    RuntimeScene & scene;
-    float xOffset;
-    float yOffset;
-    std::map<const gd::InitialInstance *, std::shared_ptr<RuntimeObject> > * optionalMap;
-};
-
-void RuntimeScene::CreateObjectsFrom(const gd::InitialInstancesContainer & container, float xOffset, float yOffset, std::map<const gd::InitialInstance *, std::shared_ptr<RuntimeObject> > * optionalMap)
-{
-    ObjectsFromInitialInstanceCreator func(*game, *this, xOffset, yOffset, optionalMap);
-    const_cast<gd::InitialInstancesContainer&>(container).IterateOverInstances(func);
 }
 
 bool RuntimeScene::LoadFromScene( const gd::Layout & scene )
@@ -493,6 +662,7 @@ bool RuntimeScene::LoadFromScene( const gd::Layout & scene )
 
 bool RuntimeScene::LoadFromSceneAndCustomInstances( const gd::Layout & scene, const gd::InitialInstancesContainer & instances )
 {
+    GD_PROFILE_SCOPE("Load scene");
     std::cout << "Loading RuntimeScene from a scene.";
     if (!game)
     {
@@ -501,7 +671,11 @@ bool RuntimeScene::LoadFromSceneAndCustomInstances( const gd::Layout & scene, co
     }
 
     //Copy inherited scene
-    Scene::operator=(scene);
+    #if defined(GD_IDE_ONLY)
+    Scene::operator=(scene); //The scene can be modified by the editor during the preview.
+    #else
+    InitFromImmutableLayout(scene); //Layouts are not modified by the runtime: share their objects instead of cloning them.
+    #endif
 
     //Clear RuntimeScene datas
     objectsInstances.Clear();
@@ -525,9 +699,11 @@ bool RuntimeScene::LoadFromSceneAndCustomInstances( const gd::Layout & scene, co
     //Initialize layers
     std::cout << ".";
     layers.clear();
+    layersHandles.clear();
     sf::View defaultView( sf::FloatRect( 0.0f, 0.0f, game->GetMainWindowDefaultWidth(), game->GetMainWindowDefaultHeight() ) );
     for (unsigned int i = 0;i<GetLayersCount();++i) {
         layers.push_back(RuntimeLayer(GetLayer(i), defaultView));
+        layersHandles.insert(std::make_pair(layers.back().GetName(), i)); //If two layers have the same name, the first one is used.
     }
 
     //Create object instances which are originally positioned on scene
@@ -546,6 +722,7 @@ bool RuntimeScene::LoadFromSceneAndCustomInstances( const gd::Layout & scene, co
         std::shared_ptr<ExtensionBase> extension = std::dynamic_pointer_cast<ExtensionBase>(gdExtension);
         if ( extension != std::shared_ptr<ExtensionBase>() )
         {
+            GD_PROFILE_SCOPE("SceneLoaded: "+game->GetUsedExtensions()[i]);
             extension->SceneLoaded(*this);
             if ( extension->ToBeNotifiedOnObjectDeletion() ) extensionsToBeNotifiedOnObjectDeletion.push_back(extension.get());
         }
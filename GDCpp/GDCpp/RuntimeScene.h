@@ -11,15 +11,21 @@
 #include <vector>
 #include <string>
 #include <map>
+#include <unordered_map>
 #include <SFML/System.hpp>
 #include <memory>
 #include "GDCpp/ObjInstancesHolder.h"
 #include "GDCpp/RuntimeLayer.h"
+#include "GDCpp/RuntimeObjectsGrid.h"
 #include "GDCpp/Text.h"
+#include "GDCpp/TextRenderer.h"
 #include "GDCpp/InputManager.h"
 #include "GDCpp/ManualTimer.h"
 #include "GDCpp/AutomatismsRuntimeSharedDataHolder.h"
+#include "GDCpp/AllocationsTracker.h"
 namespace sf { class RenderWindow; }
+namespace sf { class RenderTarget; }
+namespace sf { class RenderTexture; }
 namespace sf { class Event; }
 namespace gd { class Project; }
 namespace gd { class Object; }
@@ -91,7 +97,78 @@ public:
     /**
      * Get the layer with specified name.
      */
-    RuntimeLayer & GetRuntimeLayer(const std::string & name);
+    RuntimeLayer & GetRuntimeLayer(const std::string & name) { return GetRuntimeLayerFromHandle(GetRuntimeLayerHandle(name)); };
+
+    /**
+     * \brief Get the handle of the layer with specified name, to get the layer later
+     * without searching it by its name.
+     *
+     * \return The handle of the layer, or RuntimeScene::badLayerHandle if there is no layer with this name.
+     * \note Handles stay valid until the scene is loaded again.
+     * \see RuntimeObject::GetLayerHandle
+     */
+    unsigned int GetRuntimeLayerHandle(const std::string & name) const;
+
+    /**
+     * \brief Get the layer from its handle.
+     * \see RuntimeScene::GetRuntimeLayerHandle
+     */
+    RuntimeLayer & GetRuntimeLayerFromHandle(unsigned int handle) { return handle < layers.size() ? layers[handle] : badRuntimeLayer; };
+
+    static const unsigned int badLayerHandle; ///< The handle returned when a layer does not exist.
+
+    /** \name Spatial queries
+     * Members functions used to find the objects of the scene using their position.
+     *
+     * Objects are found using their bounding box: the square centered on the object center
+     * and containing the object whatever its angle. Callers needing an exact test must check the objects found.
+     *
+     * The queries use an index of the objects which is checked at each query: it is built again if objects
+     * were added, removed or renamed since it was built, or if a new step of the frame started
+     * ( automatisms before events, events, automatisms after events ).
+     * If objects are moved during a step, call InvalidateSpatialIndex before querying them again.
+     */
+    ///@{
+
+    /**
+     * \brief Add to \a result the objects having a bounding box intersecting \a area.
+     */
+    void GetObjectsInArea(const sf::FloatRect & area, std::vector<RuntimeObject*> & result);
+
+    /**
+     * \brief Add to \a result the objects having a bounding box containing the position.
+     */
+    void GetObjectsAtPosition(float x, float y, std::vector<RuntimeObject*> & result);
+
+    /**
+     * \brief Add to \a result the objects of the layer having a bounding box intersecting
+     * the area displayed by a camera of the layer ( see RuntimeCamera::GetArea ).
+     */
+    void GetObjectsVisibleFromCamera(const std::string & layer, unsigned int camera, std::vector<RuntimeObject*> & result);
+
+    /**
+     * \brief Return true if the bounding box of \a object intersects the area displayed by a camera
+     * of the object layer, enlarged by \a extraBorder on each side.
+     *
+     * The objects visible from the camera are searched once and kept until the index or the camera
+     * changes, so that testing all the objects of a layer is fast.
+     */
+    bool IsObjectVisibleFromCamera(const RuntimeObject & object, unsigned int camera, float extraBorder = 0);
+
+    /**
+     * \brief Return true if the bounding box of \a object contains the position.
+     *
+     * The objects at the position are searched once and kept until the index changes or another
+     * position is used, so that testing all the objects at the cursor position is fast.
+     */
+    bool IsObjectAtPosition(const RuntimeObject & object, float x, float y);
+
+    /**
+     * \brief Build again the index used by the spatial queries at the next query.
+     */
+    void InvalidateSpatialIndex() { objectsGridUpToDate = false; };
+
+    ///@}
 
     /**
      * Add a text to be displayed on the scene
@@ -159,6 +236,21 @@ public:
      */
     int RenderAndStep();
 
+    /**
+     * \brief Play the scene one frame, using a fixed elapsed time instead of the clock and without
+     * handling the events of the window.
+     *
+     * This allows to run the game logic deterministically, without a window nor a display
+     * ( for tests, benchmarks or servers ). Create the scene with a NULL render window to use it.
+     * The keyboard and the mouse are not read ( see InputManager::DisableInput ).
+     *
+     * \param elapsedMicroseconds The time elapsed since the last frame, in microseconds ( before applying the time scale ).
+     * \param renderTexture An optional offscreen texture where the scene is rendered. Can be NULL to skip rendering.
+     * \return -1 for doing nothing, -2 to quit the game, another number to change the scene
+     * \see RenderAndStep
+     */
+    int Step(signed long long elapsedMicroseconds, sf::RenderTexture * renderTexture = NULL);
+
     /**
      * Just render a frame.
      */
@@ -189,6 +281,12 @@ public:
      */
     inline bool IsFirstLoop() const { return firstLoop; };
 
+    /**
+     * Return the allocations made during the last frame ( always zero if the allocations are not tracked ).
+     * \see AllocationsTracker
+     */
+    inline const AllocationsCount & GetLastFrameAllocations() const { return lastFrameAllocations; };
+
     /**
      * Notify the scene that something (like a file dialog) stopped scene rendering for a certain amount of time.
      * \param pauseTime_ Pause duration, in microseconds.
@@ -230,6 +328,17 @@ protected:
      */
     void Render();
 
+    /**
+     * \brief Draw the layers of the scene on a render target, without displaying it.
+     */
+    void Render(sf::RenderTarget & renderTarget);
+
+    /**
+     * \brief Update time, launch automatisms and events, and update objects for a frame.
+     * Common to RenderAndStep and Step.
+     */
+    void StepObjectsAndEvents();
+
     /**
      * \brief To be called once during a step, to launch automatisms pre-events steps.
      */
@@ -246,9 +355,44 @@ protected:
      */
     void SetupOpenGLProjection();
 
-    bool UpdateTime();
+    /**
+     * \brief Update the elapsed time and the timers.
+     * \param elapsedMicroseconds The time elapsed since the last frame, before applying the time scale.
+     */
+    bool UpdateTime(signed long long elapsedMicroseconds);
+
+    bool DisplayLegacyTexts(sf::RenderTarget & renderTarget, std::string layer = "");
+
+    /**
+     * \brief The result of a spatial query, kept to answer the same query again.
+     */
+    struct SpatialQueryResult
+    {
+        SpatialQueryResult() : layerHandle(0), camera(0), extraBorder(0), objectsGridBuild(0) {};
+
+        unsigned int layerHandle;
+        unsigned int camera;
+        float extraBorder;
+        sf::FloatRect area; ///< The area searched.
+        unsigned int objectsGridBuild; ///< The value of objectsGridBuildsCount when the objects were searched.
+        std::vector<RuntimeObject*> objects; ///< The objects found, sorted by address.
+    };
 
-    bool DisplayLegacyTexts(std::string layer = "");
+    /**
+     * \brief Build the index used by the spatial queries, if needed.
+     */
+    void UpdateSpatialIndex();
+
+    /**
+     * \brief Return the objects having a bounding box intersecting \a area, using the objects
+     * stored in \a cache if the same area was searched since the index was built.
+     */
+    const std::vector<RuntimeObject*> & GetCachedObjectsInArea(SpatialQueryResult & cache, const sf::FloatRect & area);
+
+    /**
+     * \brief Return the result used to keep the objects visible from a camera.
+     */
+    SpatialQueryResult & GetCameraVisibleObjects(unsigned int layerHandle, unsigned int camera, float extraBorder);
 
     bool                                    firstLoop; ///<true if the scene was just rendered once.
     bool                                    isFullScreen; ///< As sf::RenderWindow can't say if it is fullscreen or not
@@ -258,14 +402,24 @@ protected:
     double                                  timeScale; ///< Time scale
     signed long long                        timeFromStart; ///< Time in microseconds elapsed from start.
     signed long long                        pauseTime; ///< Time to be subtracted to realElapsedTime for the current frame.
+    AllocationsCount                        lastFrameAllocations; ///< The allocations made during the last frame.
     int                                     specialAction; ///< -1 for doing nothing, -2 to quit the game, another number to change the scene
     RuntimeVariablesContainer               variables; ///<List of the scene variables
     std::vector < ExtensionBase * >         extensionsToBeNotifiedOnObjectDeletion; ///< List, built during LoadFromScene, containing a list of extensions which must be notified when an object is deleted.
     sf::Clock                               clock;
     AutomatismsRuntimeSharedDataHolder      automatismsSharedDatas; ///<Contains all automatisms shared datas.
     std::vector < RuntimeLayer >            layers; ///< The layers used at runtime to display the scene.
+    std::unordered_map < std::string, unsigned int > layersHandles; ///< The index in layers of each layer.
+    std::vector < std::vector<RuntimeObject*> > objectsByLayer; ///< Used by Render to store the objects of each layer, sorted by Z order.
     std::shared_ptr<CodeExecutionEngine>    codeExecutionEngine;
     std::vector < Text >                    legacyTexts; ///<Deprecated way of displaying a text
+    std::vector < TextGeometry >            legacyTextsGeometries; ///< The geometries of the legacy texts displayed during the last frame.
+    RuntimeObjectsGrid                      objectsGrid; ///< The index used by the spatial queries.
+    bool                                    objectsGridUpToDate; ///< false if objectsGrid must be built again.
+    unsigned int                            objectsGridModificationsCount; ///< The modifications count of objectsInstances when objectsGrid was built.
+    unsigned int                            objectsGridBuildsCount; ///< Incremented each time objectsGrid is built.
+    std::vector < SpatialQueryResult >      camerasVisibleObjects; ///< The objects visible from the cameras, see IsObjectVisibleFromCamera.
+    SpatialQueryResult                      objectsAtPosition; ///< The objects found by the last IsObjectAtPosition.
 
     static RuntimeLayer badRuntimeLayer; ///< Null object return by GetLayer when no appropriate layer could be found.
 };
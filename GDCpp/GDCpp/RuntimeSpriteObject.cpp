@@ -573,14 +573,18 @@ void RuntimeSpriteObject::FlipY(bool flip)
 
 bool RuntimeSpriteObject::CursorOnObject(RuntimeScene & scene, bool accurate)
 {
-    RuntimeLayer & theLayer = scene.GetRuntimeLayer(layer);
+    if (!scene.renderWindow) return false;
+    RuntimeLayer & theLayer = scene.GetRuntimeLayerFromHandle(GetLayerHandle(scene));
 
     for (unsigned int cameraIndex = 0;cameraIndex < theLayer.GetCameraCount();++cameraIndex)
     {
-        sf::Vector2f mousePos = scene.renderWindow->mapPixelToCoords(
-            scene.GetInputManager().GetMousePosition(), theLayer.GetCamera(cameraIndex).GetSFMLView());
+        //The conversion is cached by the camera, so that it is done once for all the objects.
+        const sf::Vector2f & mousePos = theLayer.GetCamera(cameraIndex).MapPixelToCoords(
+            *scene.renderWindow, scene.GetInputManager().GetMousePosition());
 
-        if (GetDrawableX() <= mousePos.x
+        //The objects under the cursor are searched once for all the objects.
+        if (scene.IsObjectAtPosition(*this, mousePos.x, mousePos.y)
+            && GetDrawableX() <= mousePos.x
             && GetDrawableX() + GetWidth()  >= mousePos.x
             && GetDrawableY() <= mousePos.y
             && GetDrawableY() + GetHeight() >= mousePos.y)
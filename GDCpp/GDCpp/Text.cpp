@@ -22,7 +22,7 @@ Text::~Text()
     //dtor
 }
 
-void Text::Draw(sf::RenderWindow& App)
+void Text::Draw(sf::RenderTarget& App)
 {
     FontManager * fontManager = FontManager::Get();
 
@@ -28,7 +28,7 @@ public:
     string fontName;
     string layer;
 
-    void Draw(sf::RenderWindow& main_window);
+    void Draw(sf::RenderTarget& renderTarget);
 
 protected:
 private:
@@ -0,0 +1,261 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2015 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#include "GDCpp/TextRenderer.h"
+#include <algorithm>
+
+TextRenderer * TextRenderer::_singleton = NULL;
+
+namespace
+{
+
+/**
+ * Numbers displayed by texts ( scores, timers... ) change often and can get longer:
+ * the vertices of texts displaying numbers are allocated for at least this number of characters.
+ */
+const std::size_t minimumNumberLength = 12;
+
+bool IsNumber(const sf::String & string)
+{
+    for (std::size_t i = 0;i<string.getSize();++i)
+    {
+        sf::Uint32 character = string[i];
+        if ( (character < '0' || character > '9') && character != '-' && character != '.' && character != ' ' )
+            return false;
+    }
+
+    return true;
+}
+
+}
+
+GlyphAtlas::GlyphAtlas(const sf::Font & font_, unsigned int characterSize_, bool bold_) :
+    font(font_),
+    characterSize(characterSize_),
+    bold(bold_),
+    lineSpacing(static_cast<float>(font_.getLineSpacing(characterSize_)))
+{
+    for (sf::Uint32 character = firstCachedCharacter;character<=lastCachedCharacter;++character)
+        cachedGlyphs[character-firstCachedCharacter] = font.getGlyph(character, characterSize, bold);
+}
+
+TextGeometry::TextGeometry() :
+    stringHash(Hash(sf::String())),
+    font(NULL),
+    characterSize(0),
+    style(sf::Text::Regular),
+    atlas(NULL),
+    atlasesGeneration(0)
+{
+}
+
+std::size_t TextGeometry::Hash(const sf::String & string)
+{
+    //FNV-1a
+    std::size_t hash = static_cast<std::size_t>(2166136261u);
+    for (std::size_t i = 0;i<string.getSize();++i)
+    {
+        hash ^= static_cast<std::size_t>(string[i]);
+        hash *= static_cast<std::size_t>(16777619u);
+    }
+
+    return hash;
+}
+
+bool TextGeometry::Update(const sf::String & newString, const sf::Font * newFont, unsigned int newCharacterSize, sf::Uint32 newStyle)
+{
+    TextRenderer * renderer = TextRenderer::Get();
+    bool atlasChanged = newFont != font || newCharacterSize != characterSize ||
+        ((newStyle ^ style) & sf::Text::Bold) != 0 || renderer->GetAtlasesGeneration() != atlasesGeneration;
+
+    std::size_t newStringHash = Hash(newString);
+    bool stringChanged = newStringHash != stringHash || newString != string; //Strings are only compared if the hashes are equal.
+
+    if ( !atlasChanged && !stringChanged && newStyle == style )
+        return false;
+
+    if ( stringChanged )
+    {
+        string = newString;
+        stringHash = newStringHash;
+    }
+    style = newStyle;
+    if ( atlasChanged )
+    {
+        font = newFont;
+        characterSize = newCharacterSize;
+        atlas = font ? &renderer->GetAtlas(*font, characterSize, (style & sf::Text::Bold) != 0) : NULL;
+        atlasesGeneration = renderer->GetAtlasesGeneration();
+    }
+
+    Generate();
+    return true;
+}
+
+void TextGeometry::Generate()
+{
+    vertices.clear(); //The memory is kept for the next strings.
+    bounds = sf::FloatRect();
+    if ( !atlas || string.isEmpty() ) return;
+
+    std::size_t expectedCharacters = string.getSize();
+    if ( IsNumber(string) ) expectedCharacters = std::max(expectedCharacters, minimumNumberLength);
+    vertices.reserve((expectedCharacters+1)*4); //One more quad for the underline.
+
+    //Same layout as sf::Text.
+    bool bold = (style & sf::Text::Bold) != 0;
+    bool underlined = (style & sf::Text::Underlined) != 0;
+    float italic = (style & sf::Text::Italic) ? 0.208f : 0.f; //12 degrees
+    float size = static_cast<float>(characterSize);
+    float underlineOffset = size*0.1f;
+    float underlineThickness = size*(bold ? 0.1f : 0.07f);
+
+    float hspace = static_cast<float>(atlas->GetGlyph(L' ').advance);
+    float vspace = atlas->GetLineSpacing();
+    float x = 0.f;
+    float y = size;
+
+    float minX = size;
+    float minY = size;
+    float maxX = 0.f;
+    float maxY = 0.f;
+    sf::Uint32 previousCharacter = 0;
+    for (std::size_t i = 0;i<string.getSize();++i)
+    {
+        sf::Uint32 character = string[i];
+
+        x += atlas->GetKerning(previousCharacter, character);
+        previousCharacter = character;
+
+        if ( underlined && character == L'\n' )
+        {
+            float top = y + underlineOffset;
+            float bottom = top + underlineThickness;
+            vertices.push_back(sf::Vertex(sf::Vector2f(0, top), sf::Color::White, sf::Vector2f(1, 1)));
+            vertices.push_back(sf::Vertex(sf::Vector2f(x, top), sf::Color::White, sf::Vector2f(1, 1)));
+            vertices.push_back(sf::Vertex(sf::Vector2f(x, bottom), sf::Color::White, sf::Vector2f(1, 1)));
+            vertices.push_back(sf::Vertex(sf::Vector2f(0, bottom), sf::Color::White, sf::Vector2f(1, 1)));
+        }
+
+        if ( character == L' ' || character == L'\t' || character == L'\n' || character == L'\v' )
+        {
+            minX = std::min(minX, x);
+            minY = std::min(minY, y);
+
+            if ( character == L' ' ) x += hspace;
+            else if ( character == L'\t' ) x += hspace*4;
+            else if ( character == L'\n' ) { y += vspace; x = 0; }
+            else if ( character == L'\v' ) y += vspace*4;
+
+            maxX = std::max(maxX, x);
+            maxY = std::max(maxY, y);
+            continue;
+        }
+
+        const sf::Glyph & glyph = atlas->GetGlyph(character);
+
+        float left = static_cast<float>(glyph.bounds.left);
+        float top = static_cast<float>(glyph.bounds.top);
+        float right = left + static_cast<float>(glyph.bounds.width);
+        float bottom = top + static_cast<float>(glyph.bounds.height);
+
+        float u1 = static_cast<float>(glyph.textureRect.left);
+        float v1 = static_cast<float>(glyph.textureRect.top);
+        float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width);
+        float v2 = static_cast<float>(glyph.textureRect.top + glyph.textureRect.height);
+
+        vertices.push_back(sf::Vertex(sf::Vector2f(x + left - italic * top, y + top), sf::Color::White, sf::Vector2f(u1, v1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(x + right - italic * top, y + top), sf::Color::White, sf::Vector2f(u2, v1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(x + right - italic * bottom, y + bottom), sf::Color::White, sf::Vector2f(u2, v2)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(x + left - italic * bottom, y + bottom), sf::Color::White, sf::Vector2f(u1, v2)));
+
+        minX = std::min(minX, x + left - italic * bottom);
+        maxX = std::max(maxX, x + right - italic * top);
+        minY = std::min(minY, y + top);
+        maxY = std::max(maxY, y + bottom);
+
+        x += static_cast<float>(glyph.advance);
+    }
+
+    if ( underlined )
+    {
+        float top = y + underlineOffset;
+        float bottom = top + underlineThickness;
+        vertices.push_back(sf::Vertex(sf::Vector2f(0, top), sf::Color::White, sf::Vector2f(1, 1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(x, top), sf::Color::White, sf::Vector2f(1, 1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(x, bottom), sf::Color::White, sf::Vector2f(1, 1)));
+        vertices.push_back(sf::Vertex(sf::Vector2f(0, bottom), sf::Color::White, sf::Vector2f(1, 1)));
+    }
+
+    bounds.left = minX;
+    bounds.top = minY;
+    bounds.width = maxX - minX;
+    bounds.height = maxY - minY;
+}
+
+bool TextRenderer::AtlasKey::operator<(const AtlasKey & other) const
+{
+    if ( font != other.font ) return font < other.font;
+    if ( characterSize != other.characterSize ) return characterSize < other.characterSize;
+    return bold < other.bold;
+}
+
+void TextRenderer::Draw(sf::RenderTarget & target, const TextGeometry & geometry, const sf::Transform & transform, const sf::Color & color)
+{
+    const std::vector<sf::Vertex> & textVertices = geometry.GetVertices();
+    if ( !geometry.GetTexture() || textVertices.empty() ) return;
+
+    if ( !vertices.empty() && (renderTarget != &target || texture != geometry.GetTexture()) )
+        Flush();
+
+    renderTarget = &target;
+    texture = geometry.GetTexture();
+
+    std::size_t start = vertices.size();
+    vertices.resize(start+textVertices.size());
+    for (std::size_t i = 0;i<textVertices.size();++i)
+    {
+        sf::Vertex & vertex = vertices[start+i];
+        vertex.position = transform.transformPoint(textVertices[i].position);
+        vertex.color = color;
+        vertex.texCoords = textVertices[i].texCoords;
+    }
+}
+
+void TextRenderer::Flush()
+{
+    if ( vertices.empty() ) return;
+
+    renderTarget->draw(&vertices[0], vertices.size(), sf::Quads, sf::RenderStates(texture));
+    vertices.clear(); //The memory is kept for the next frames.
+    ++drawCallsCount;
+}
+
+const GlyphAtlas & TextRenderer::GetAtlas(const sf::Font & font, unsigned int characterSize, bool bold)
+{
+    std::unique_ptr<GlyphAtlas> & atlas = atlases[AtlasKey(&font, characterSize, bold)];
+    if ( !atlas ) atlas.reset(new GlyphAtlas(font, characterSize, bold));
+
+    return *atlas;
+}
+
+void TextRenderer::ClearAtlases()
+{
+    //Pending texts would be drawn with the texture of a destroyed font.
+    vertices.clear();
+    texture = NULL;
+
+    atlases.clear();
+    ++atlasesGeneration;
+}
+
+void TextRenderer::DestroySingleton()
+{
+    if ( NULL != _singleton )
+    {
+        delete _singleton;
+        _singleton = NULL;
+    }
+}
@@ -0,0 +1,230 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2015 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+#ifndef TEXTRENDERER_H
+#define TEXTRENDERER_H
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include <map>
+#include <memory>
+#include <cstddef>
+
+/**
+ * \brief The glyphs of a font, for a character size and a style, used to generate the vertices of texts.
+ *
+ * The glyphs of the printable ASCII characters are rendered in the texture of the font when the atlas
+ * is created, so that texts displaying numbers never have to render new glyphs while the game is running.
+ * They are also stored in an array so that they are not searched in the font for each character.
+ *
+ * Atlases are shared by all the texts using the same font, character size and style: get them
+ * using TextRenderer::GetAtlas.
+ *
+ * \see TextRenderer
+ * \ingroup GameEngine
+ */
+class GD_API GlyphAtlas
+{
+public:
+    GlyphAtlas(const sf::Font & font, unsigned int characterSize, bool bold);
+    virtual ~GlyphAtlas() {};
+
+    /**
+     * \brief Return the glyph of a character.
+     */
+    const sf::Glyph & GetGlyph(sf::Uint32 character) const
+    {
+        if ( character >= firstCachedCharacter && character <= lastCachedCharacter )
+            return cachedGlyphs[character-firstCachedCharacter];
+
+        return font.getGlyph(character, characterSize, bold);
+    }
+
+    /**
+     * \brief Return the offset to apply between two characters.
+     */
+    float GetKerning(sf::Uint32 first, sf::Uint32 second) const { return static_cast<float>(font.getKerning(first, second, characterSize)); }
+
+    /**
+     * \brief Return the vertical offset between two lines.
+     */
+    float GetLineSpacing() const { return lineSpacing; }
+
+    /**
+     * \brief Return the texture containing the glyphs.
+     */
+    const sf::Texture & GetTexture() const { return font.getTexture(characterSize); }
+
+    unsigned int GetCharacterSize() const { return characterSize; }
+    bool IsBold() const { return bold; }
+
+private:
+    static const sf::Uint32 firstCachedCharacter = 32;
+    static const sf::Uint32 lastCachedCharacter = 126;
+
+    const sf::Font & font;
+    unsigned int characterSize;
+    bool bold;
+    float lineSpacing;
+    sf::Glyph cachedGlyphs[lastCachedCharacter-firstCachedCharacter+1]; ///< The glyphs of the printable ASCII characters.
+};
+
+/**
+ * \brief The vertices of a text, in the local coordinates of the text.
+ *
+ * The vertices are only generated again when the string ( compared using its hash ), the font, the
+ * character size or the style change: a text can be updated at each frame with the same string for free.
+ * The vertices have no color: the color is applied by the TextRenderer.
+ *
+ * \see TextRenderer
+ * \ingroup GameEngine
+ */
+class GD_API TextGeometry
+{
+public:
+    TextGeometry();
+    virtual ~TextGeometry() {};
+
+    /**
+     * \brief Generate the vertices of the text, unless they were already generated with the same parameters.
+     * \return true if the vertices were generated.
+     */
+    bool Update(const sf::String & string, const sf::Font * font, unsigned int characterSize, sf::Uint32 style);
+
+    /**
+     * \brief Return the vertices ( quads ) of the text.
+     */
+    const std::vector<sf::Vertex> & GetVertices() const { return vertices; }
+
+    /**
+     * \brief Return the bounding rectangle of the text, in local coordinates.
+     */
+    const sf::FloatRect & GetLocalBounds() const { return bounds; }
+
+    /**
+     * \brief Return the texture to be used to draw the vertices, or NULL if the text has no font.
+     */
+    const sf::Texture * GetTexture() const { return atlas ? &atlas->GetTexture() : NULL; }
+
+    /**
+     * \brief Return the hash of a string, used to know if the string of a text has changed.
+     */
+    static std::size_t Hash(const sf::String & string);
+
+private:
+    void Generate();
+
+    sf::String string;
+    std::size_t stringHash;
+    const sf::Font * font;
+    unsigned int characterSize;
+    sf::Uint32 style;
+    const GlyphAtlas * atlas; ///< The atlas used for the vertices, stored in the TextRenderer.
+    unsigned int atlasesGeneration; ///< The generation of the atlases of the TextRenderer when atlas was retrieved.
+    std::vector<sf::Vertex> vertices;
+    sf::FloatRect bounds;
+};
+
+/**
+ * \brief Draw texts by batches: consecutive texts using the same glyph atlas are drawn
+ * with a single draw call.
+ *
+ * Texts are not drawn immediately: Flush must be called before drawing anything else
+ * on the render target, or changing its view. RuntimeScene takes care of this when rendering
+ * objects ( see RuntimeObject::IsDrawnWithTextRenderer ).
+ *
+ * Usage example:
+ * \code
+ * geometry.Update(string, font, characterSize, style); //Only generate the vertices if something changed.
+ * TextRenderer::Get()->Draw(renderTarget, geometry, transform, color);
+ * //...
+ * TextRenderer::Get()->Flush();
+ * \endcode
+ *
+ * \ingroup GameEngine
+ */
+class GD_API TextRenderer
+{
+public:
+    /**
+     * \brief Add a text to the texts to be drawn on \a renderTarget.
+     *
+     * The pending texts are drawn before if they are drawn on another render target or use another atlas.
+     */
+    void Draw(sf::RenderTarget & renderTarget, const TextGeometry & geometry, const sf::Transform & transform, const sf::Color & color);
+
+    /**
+     * \brief Draw the pending texts.
+     */
+    void Flush();
+
+    /**
+     * \brief Return true if some texts are waiting to be drawn.
+     */
+    bool HasPendingTexts() const { return !vertices.empty(); }
+
+    /**
+     * \brief Return the number of draw calls made since the start of the program.
+     */
+    unsigned long long GetDrawCallsCount() const { return drawCallsCount; }
+
+    /**
+     * \brief Return the atlas of a font, for a character size.
+     *
+     * The atlas is created at the first call.
+     */
+    const GlyphAtlas & GetAtlas(const sf::Font & font, unsigned int characterSize, bool bold);
+
+    /**
+     * \brief Destroy all the atlases. Must be called when fonts are destroyed.
+     */
+    void ClearAtlases();
+
+    /**
+     * \brief Return a number changed each time the atlases are cleared.
+     */
+    unsigned int GetAtlasesGeneration() const { return atlasesGeneration; }
+
+    /**
+     * \brief Return a pointer to the global singleton class
+     */
+    static TextRenderer * Get()
+    {
+        if ( NULL == _singleton )
+            _singleton = new TextRenderer;
+
+        return _singleton;
+    }
+
+    /**
+     * \brief Destroy the global singleton class.
+     */
+    static void DestroySingleton();
+
+private:
+    struct AtlasKey
+    {
+        AtlasKey(const sf::Font * font_, unsigned int characterSize_, bool bold_) : font(font_), characterSize(characterSize_), bold(bold_) {};
+        bool operator<(const AtlasKey & other) const;
+
+        const sf::Font * font;
+        unsigned int characterSize;
+        bool bold;
+    };
+
+    TextRenderer() : renderTarget(NULL), texture(NULL), drawCallsCount(0), atlasesGeneration(0) {};
+    virtual ~TextRenderer() {};
+
+    std::vector<sf::Vertex> vertices; ///< The vertices of the pending texts, in the coordinates of the render target.
+    sf::RenderTarget * renderTarget; ///< The render target of the pending texts.
+    const sf::Texture * texture; ///< The texture of the pending texts.
+    unsigned long long drawCallsCount;
+
+    std::map<AtlasKey, std::unique_ptr<GlyphAtlas> > atlases;
+    unsigned int atlasesGeneration;
+
+    static TextRenderer * _singleton;
+};
+
+#endif // TEXTRENDERER_H
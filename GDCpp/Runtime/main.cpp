@@ -7,6 +7,8 @@
 #include <vector>
 #include <string>
 #include <iostream>
+#include <algorithm>
+#include <memory>
 #include <SFML/System.hpp>
 #include <SFML/Graphics.hpp>
 #include <SFML/OpenGL.hpp>
@@ -29,8 +31,8 @@
 #include "GDCpp/Tools/AES.h"
 #include "GDCpp/Serialization/Serializer.h"
 #include "GDCpp/Serialization/SerializerElement.h"
-#include "GDCpp/tinyxml/tinyxml.h"
 #include "GDCpp/RuntimeGame.h"
+#include "GDCpp/FrameProfiler.h"
 #include "CompilationChecker.h"
 
 #include <stdlib.h>
@@ -45,6 +47,29 @@ int main( int argc, char *p_argv[] )
 {
     GDLogBanner();
 
+    //Handle special arguments:
+    //-profile=<file> to profile the game: the trace is written when the game exits.
+    //-headless=<frames> to play the given number of frames without a window, as fast as possible, and print the frames per second.
+    //-offscreen to render the frames in an offscreen texture when playing without a window.
+    std::string profileFile;
+    unsigned int headlessFrames = 0;
+    bool offscreen = false;
+    for (int i = 1;i<argc;++i)
+    {
+        std::string argument = p_argv[i];
+        if ( argument.size() > 9 && argument.substr(0, 9) == "-profile=" )
+            profileFile = argument.substr(9, std::string::npos);
+        else if ( argument.size() > 10 && argument.substr(0, 10) == "-headless=" )
+            headlessFrames = std::max(0, atoi(argument.substr(10, std::string::npos).c_str()));
+        else if ( argument == "-offscreen" )
+            offscreen = true;
+    }
+    if ( !profileFile.empty() )
+    {
+        cout << "Profiling the game, the trace will be written to " << profileFile << endl;
+        FrameProfiler::Enable();
+    }
+
     //Get executable location
     string fullExecutablePath;
     if ( *p_argv[0] != '/' )
@@ -108,19 +133,15 @@ int main( int argc, char *p_argv[] )
         aes_cbc_decrypt(reinterpret_cast<const unsigned char*>(ibuffer), reinterpret_cast<unsigned char*>(obuffer),
             (uint8_t*)iv, size/AES_BLOCK_SIZE, &keySetting);
 
-        string uncryptedSrc = obuffer;
+        cout << "Loading game data..." << endl;
+        gd::SerializerElement rootElement;
+        std::string error;
+        bool parsed = gd::Serializer::FromBinary(rootElement, obuffer, size, &error); //The padding is ignored.
         delete [] obuffer;
 
-        cout << "Loading game data..." << endl;
-        TiXmlDocument doc;
-        if ( !doc.Parse(uncryptedSrc.c_str()) )
-        {
-            return AbortWithMessage("Unable to parse game data. Aborting.");
-        }
+        if ( !parsed )
+            return AbortWithMessage("Unable to parse game data ("+error+"). Aborting.");
 
-        TiXmlHandle hdl(&doc);
-        gd::SerializerElement rootElement;
-        gd::Serializer::FromXML(rootElement, hdl.FirstChildElement().Element());
         game.UnserializeFrom(rootElement);
 	}
 
@@ -153,13 +174,14 @@ int main( int argc, char *p_argv[] )
     //Initialize image manager and load always loaded images
     game.GetImageManager()->LoadPermanentImages();
 
-    //Create main window
+    //Create main window ( not used when playing without a window )
     sf::RenderWindow window;
+    sf::RenderWindow * renderWindow = headlessFrames == 0 ? &window : NULL;
 
     RuntimeGame runtimeGame;
     runtimeGame.LoadFromProject(game);
 
-    RuntimeScene scenePlayed(&window, &runtimeGame);
+    RuntimeScene scenePlayed(renderWindow, &runtimeGame);
     if ( !scenePlayed.LoadFromScene( game.GetLayout(0) ) )
         return AbortWithMessage("Unable to load the first scene \"" + game.GetLayout(0).GetName() + "\". Aborting.");
 
@@ -170,22 +192,44 @@ int main( int argc, char *p_argv[] )
         return AbortWithMessage("Unable to setup execution engine for scene \"" + game.GetLayout(0).GetName() + "\". Aborting.");
     }
 
-    window.create( sf::VideoMode( game.GetMainWindowDefaultWidth(), game.GetMainWindowDefaultHeight(), 32 ), scenePlayed.GetWindowDefaultTitle(), sf::Style::Close );
-    window.setActive(true);
-    window.setFramerateLimit( game.GetMaximumFPS() );
-    window.setVerticalSyncEnabled( game.IsVerticalSynchronizationEnabledByDefault() );
-    scenePlayed.ChangeRenderWindow(&window);
+    std::unique_ptr<sf::RenderTexture> offscreenTexture;
+    if ( renderWindow )
+    {
+        window.create( sf::VideoMode( game.GetMainWindowDefaultWidth(), game.GetMainWindowDefaultHeight(), 32 ), scenePlayed.GetWindowDefaultTitle(), sf::Style::Close );
+        window.setActive(true);
+        window.setFramerateLimit( game.GetMaximumFPS() );
+        window.setVerticalSyncEnabled( game.IsVerticalSynchronizationEnabledByDefault() );
+        scenePlayed.ChangeRenderWindow(&window);
+    }
+    else if ( offscreen )
+    {
+        offscreenTexture.reset(new sf::RenderTexture);
+        if ( !offscreenTexture->create(game.GetMainWindowDefaultWidth(), game.GetMainWindowDefaultHeight(), true) )
+            return AbortWithMessage("Unable to create the offscreen texture. Aborting.");
+    }
+
+    //Frames played without a window use a fixed time step, so that they are reproducible.
+    signed long long headlessTimeStep = 1000000/(game.GetMaximumFPS() > 0 ? game.GetMaximumFPS() : 60);
+    unsigned int headlessFramesPlayed = 0;
+    sf::Clock headlessClock;
 
     //Game main loop
-    while ( scenePlayed.running )
+    while ( scenePlayed.running && (renderWindow || headlessFramesPlayed < headlessFrames) )
     {
-        int returnCode = scenePlayed.RenderAndStep();
+        int returnCode = -1;
+        if ( renderWindow )
+            returnCode = scenePlayed.RenderAndStep();
+        else
+        {
+            returnCode = scenePlayed.Step(headlessTimeStep, offscreenTexture.get());
+            headlessFramesPlayed++;
+        }
 
         if ( returnCode == -2 ) //Quit the game
             scenePlayed.running = false;
         else if ( returnCode != -1 && returnCode < game.GetLayoutsCount()) //Change the scene being played
         {
-            RuntimeScene emptyScene(&window, &runtimeGame);
+            RuntimeScene emptyScene(renderWindow, &runtimeGame);
             scenePlayed = emptyScene; //Clear the scene
 
             if ( !scenePlayed.LoadFromScene( game.GetLayout(returnCode) ) )
@@ -200,11 +244,21 @@ int main( int argc, char *p_argv[] )
         }
     }
 
+    if ( !renderWindow )
+    {
+        double seconds = headlessClock.getElapsedTime().asSeconds();
+        cout << headlessFramesPlayed << " frames played in " << seconds*1000.0 << "ms ("
+            << (seconds > 0 ? headlessFramesPlayed/seconds : 0) << " frames per second)." << endl;
+    }
+
     SoundManager::Get()->DestroySingleton();
     FontManager::Get()->DestroySingleton();
 
     gd::CloseLibrary(codeLibrary);
 
+    if ( !profileFile.empty() && !FrameProfiler::ExportChromeTrace(profileFile) )
+        cout << "Unable to write the profiling trace to " << profileFile << endl;
+
     return EXIT_SUCCESS;
 }
 
@@ -0,0 +1,907 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2015 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+/**
+ * @file Benchmark of the C++ runtime: scenes are played without a window, with a fixed time step,
+ * for a fixed number of frames.
+ *
+ * Synthetic scenes are played ( sprites with forces, collisions, deep events, many variables, platformer crowd
+ * and pathfinding swarm ): they emulate their events by calling, every frame, the same functions as the generated code.
+ *
+ * GDCpp_IDE_benchmarks, the same benchmark built with the IDE version of GDCpp, also plays the benchmark games
+ * of GDJS/tests/games. Their events are compiled by CodeCompiler, as for a preview in the IDE ( the events are
+ * compiled without optimizations ). The events compiler must be installed: the files of the IDE are searched in
+ * the directory given by -ide ( by default, the output directory of the build ).
+ *
+ * Usage: GDCpp_benchmarks [-extensions=<directory>] [-frames=<count>] [-render]
+ *                         [-output=<file>] [-baseline=<file>] [-tolerance=<percent>] [-maxAllocations=<count>]
+ *        GDCpp_IDE_benchmarks [-games=<directory>] [-ide=<directory>] and the same arguments as GDCpp_benchmarks
+ *
+ * The results ( time and allocations per frame, peak memory usage ) are written as JSON to the output file.
+ * When a baseline ( the output of a previous run ) is given, the benchmark fails if a scene is slower or
+ * allocates more than the baseline, beyond the tolerance. With -maxAllocations, the benchmark also fails if a scene
+ * makes, once in a steady state ( the first frames are not measured ), more allocations per frame than the given count.
+ *
+ * \note Textures are created for the sprites: an OpenGL context must be available ( use Xvfb on servers ).
+ * \note The allocations are counted by AllocationsTracker. On Windows, unless GDCpp is built with the CMake option
+ * GDCPP_ALLOCATIONS_TRACKING, the allocations made inside the libraries are not counted.
+ */
+#if defined(GD_IDE_ONLY)
+#include <wx/wx.h> //Must be include first otherwise we get nice errors relative to "cannot convert 'const TCHAR*'..." in wx/msw/winundef.h
+#include <wx/evtloop.h>
+#include <wx/filename.h>
+#include <wx/init.h>
+#endif
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+#include <SFML/Graphics.hpp>
+#if defined(WINDOWS)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+#include "GDCore/BuiltinExtensions/SpriteExtension/SpriteObject.h"
+#include "GDCore/BuiltinExtensions/SpriteExtension/Animation.h"
+#include "GDCore/BuiltinExtensions/SpriteExtension/Direction.h"
+#include "GDCore/BuiltinExtensions/SpriteExtension/Sprite.h"
+#include "GDCpp/Project.h"
+#include "GDCpp/Scene.h"
+#include "GDCpp/ImageManager.h"
+#include "GDCpp/ExtensionsLoader.h"
+#include "GDCpp/Polygon2d.h"
+#include "GDCpp/Serialization/Serializer.h"
+#include "GDCpp/Serialization/SerializerElement.h"
+#include "GDCpp/BuiltinExtensions/ObjectTools.h"
+#include "GDCpp/RuntimeScene.h"
+#include "GDCpp/RuntimeGame.h"
+#include "GDCpp/RuntimeObject.h"
+#include "GDCpp/CppPlatform.h"
+#include "GDCpp/CommonTools.h"
+#include "GDCpp/AllocationsTracker.h"
+#if defined(GD_IDE_ONLY)
+#include "GDCpp/SceneNameMangler.h"
+#include "GDCpp/CodeExecutionEngine.h"
+#include "GDCpp/IDE/CodeCompiler.h"
+#include "GDCpp/Events/CodeCompilationHelpers.h"
+#endif
+#if defined(GD_BENCHMARKS_WITH_EXTENSIONS)
+#include "PlatformAutomatism/PlatformerObjectAutomatism.h"
+#include "PathfindingAutomatism/PathfindingAutomatism.h"
+#endif
+
+#if !defined(GD_BENCHMARKS_EXTENSIONS_DIRECTORY)
+#define GD_BENCHMARKS_EXTENSIONS_DIRECTORY "."
+#endif
+#if !defined(GD_BENCHMARKS_GAMES_DIRECTORY)
+#define GD_BENCHMARKS_GAMES_DIRECTORY "GDJS/tests/games"
+#endif
+#if !defined(GD_BENCHMARKS_IDE_DIRECTORY)
+#define GD_BENCHMARKS_IDE_DIRECTORY "."
+#endif
+
+#if !defined(GD_ALLOCATIONS_TRACKING)
+//GDCpp does not count the allocations: count them in the benchmark ( on Windows, only the allocations
+//made by the benchmark itself are then counted ).
+#include "GDCpp/AllocationsTrackerOperators.h"
+#endif
+
+namespace
+{
+
+/**
+ * A scene to be played by the benchmark.
+ */
+struct Benchmark
+{
+    std::string name;
+    gd::Project * project;
+    gd::Layout * layout;
+    std::function<void(RuntimeScene & scene, unsigned int frame)> events; ///< Called before each frame to emulate the events. Can be empty.
+    bool compiledEvents; ///< true if the events of the layout were compiled and must be executed.
+
+    Benchmark() : project(NULL), layout(NULL), compiledEvents(false) {};
+};
+
+/**
+ * The measures made while playing a scene.
+ */
+struct BenchmarkResult
+{
+    std::string name;
+    double nsPerFrame;
+    double allocationsPerFrame;
+    double bytesPerFrame;
+    long peakRssKB;
+};
+
+/**
+ * Deterministic pseudo-random numbers, so that the synthetic scenes are the same for all runs.
+ */
+class Random
+{
+public:
+    Random(unsigned int seed) : state(seed) {};
+
+    /**
+     * Return a number between 0 and \a max.
+     */
+    float Next(float max)
+    {
+        state = state*1103515245u+12345u;
+        return static_cast<float>((state >> 8) & 0xFFFF)/65535.0f*max;
+    }
+
+private:
+    unsigned int state;
+};
+
+long GetPeakRSS()
+{
+    #if defined(WINDOWS)
+    PROCESS_MEMORY_COUNTERS counters;
+    if ( GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)) )
+        return counters.PeakWorkingSetSize/1024;
+
+    return 0;
+    #else
+    struct rusage usage;
+    if ( getrusage(RUSAGE_SELF, &usage) != 0 ) return 0;
+
+    #if defined(MACOS)
+    return usage.ru_maxrss/1024; //In bytes on Mac OS X.
+    #else
+    return usage.ru_maxrss;
+    #endif
+    #endif
+}
+
+const std::string spriteImageName = "GDCpp_benchmarks sprite";
+
+/**
+ * Make the texture used by the sprites of the synthetic scenes available to the game.
+ */
+void AddSpriteTexture(RuntimeGame & game)
+{
+    std::shared_ptr<SFMLTextureWrapper> texture(new SFMLTextureWrapper);
+    texture->image.create(32, 32, sf::Color::White);
+    texture->texture.loadFromImage(texture->image);
+    game.GetImageManager()->SetSFMLTextureAsPermanentlyLoaded(spriteImageName, texture);
+}
+
+/**
+ * Build the serialized representation of a layout, which is then unserialized, as the
+ * runtime can't create objects, automatisms and instances by itself.
+ */
+class SyntheticLayout
+{
+public:
+    SyntheticLayout() :
+        objects(element.AddChild("objects")),
+        instances(element.AddChild("instances")),
+        automatismsSharedData(element.AddChild("automatismsSharedData"))
+    {
+        element.SetAttribute("oglFOV", 90.0);
+        element.SetAttribute("oglZNear", 1.0);
+        element.SetAttribute("oglZFar", 500.0);
+        element.SetAttribute("standardSortMethod", true);
+
+        gd::SerializerElement & layers = element.AddChild("layers");
+        layers.ConsiderAsArrayOf("layer");
+        gd::SerializerElement & baseLayer = layers.AddChild("layer");
+        baseLayer.SetAttribute("name", "");
+        baseLayer.SetAttribute("visibility", true);
+        gd::SerializerElement & cameras = baseLayer.AddChild("cameras");
+        cameras.ConsiderAsArrayOf("camera");
+        cameras.AddChild("camera");
+
+        element.AddChild("uiSettings");
+        element.AddChild("objectsGroups");
+        element.AddChild("events");
+        element.AddChild("variables");
+        objects.ConsiderAsArrayOf("object");
+        instances.ConsiderAsArrayOf("instance");
+        automatismsSharedData.ConsiderAsArrayOf("automatismSharedData");
+    }
+
+    /**
+     * Add a sprite object. Return the serialized object, to add automatisms to it.
+     */
+    gd::SerializerElement & AddObject(const std::string & name)
+    {
+        gd::SerializerElement & object = objects.AddChild("object");
+        object.SetAttribute("type", "Sprite");
+        object.SetAttribute("name", name);
+        object.AddChild("automatisms").ConsiderAsArrayOf("automatism");
+
+        return object;
+    }
+
+    /**
+     * Add an automatism to an object. Return the serialized automatism, to set its properties.
+     * \note The shared data of the automatism is added to the layout, as done by the IDE.
+     */
+    gd::SerializerElement & AddAutomatism(gd::SerializerElement & object, const std::string & type, const std::string & name)
+    {
+        gd::SerializerElement & sharedData = automatismsSharedData.AddChild("automatismSharedData");
+        sharedData.SetAttribute("type", type);
+        sharedData.SetAttribute("name", name);
+
+        gd::SerializerElement & automatism = object.GetChild("automatisms").AddChild("automatism");
+        automatism.SetAttribute("type", type);
+        automatism.SetAttribute("name", name);
+
+        return automatism;
+    }
+
+    void AddInstance(const std::string & objectName, float x, float y)
+    {
+        gd::SerializerElement & instance = instances.AddChild("instance");
+        instance.SetAttribute("name", objectName);
+        instance.SetAttribute("x", x);
+        instance.SetAttribute("y", y);
+    }
+
+    /**
+     * Create the layout. The sprites all have a 32x32 image and collision mask.
+     */
+    gd::Layout & InsertInto(gd::Project & project, const std::string & name)
+    {
+        gd::Layout & layout = project.InsertNewLayout(name, project.GetLayoutsCount());
+        layout.UnserializeFrom(project, element);
+        layout.SetName(name);
+
+        gd::Sprite sprite;
+        sprite.SetImageName(spriteImageName);
+        Polygon2d mask = Polygon2d::CreateRectangle(32, 32);
+        mask.Move(16, 16);
+        sprite.SetCustomCollisionMask(std::vector<Polygon2d>(1, mask));
+        sprite.SetCollisionMaskAutomatic(false);
+
+        gd::Animation animation;
+        animation.SetDirectionsCount(1);
+        animation.GetDirection(0).AddSprite(sprite);
+
+        for (unsigned int i = 0;i<layout.GetObjectsCount();++i)
+        {
+            gd::SpriteObject * spriteObject = dynamic_cast<gd::SpriteObject*>(&layout.GetObject(i));
+            if ( spriteObject ) spriteObject->AddAnimation(animation);
+        }
+
+        return layout;
+    }
+
+private:
+    gd::SerializerElement element;
+    gd::SerializerElement & objects;
+    gd::SerializerElement & instances;
+    gd::SerializerElement & automatismsSharedData;
+};
+
+/**
+ * Return true if the automatisms are provided by the loaded extensions.
+ */
+bool HasAutomatisms(gd::Project & project, const std::vector<std::string> & types)
+{
+    for (unsigned int i = 0;i<types.size();++i)
+    {
+        std::unique_ptr<gd::Automatism> automatism(project.CreateAutomatism(types[i]));
+        if ( !automatism ) return false;
+    }
+
+    return true;
+}
+
+/**
+ * Many sprites, moved with forces every frame ( like "Forces Benchmark.gdg" ).
+ */
+void AddForcesBenchmark(gd::Project & project, std::vector<Benchmark> & benchmarks)
+{
+    const unsigned int spritesCount = 2000;
+
+    SyntheticLayout synthetic;
+    synthetic.AddObject("Sprite");
+    Random random(1);
+    for (unsigned int i = 0;i<spritesCount;++i)
+        synthetic.AddInstance("Sprite", random.Next(800), random.Next(600));
+
+    Benchmark benchmark;
+    benchmark.name = "Synthetic: "+gd::ToString(spritesCount)+" sprites with forces";
+    benchmark.project = &project;
+    benchmark.layout = &synthetic.InsertInto(project, benchmark.name);
+    benchmark.events = [](RuntimeScene & scene, unsigned int frame) {
+        std::vector<RuntimeObject*> sprites = scene.objectsInstances.GetObjectsRawPointers("Sprite");
+        for (unsigned int i = 0;i<sprites.size();++i)
+        {
+            sprites[i]->AddForceUsingPolarCoordinates((i+frame)%360, 50, 0);
+            sprites[i]->AddForceTowardPosition(400, 300, 20, 0);
+        }
+    };
+
+    benchmarks.push_back(benchmark);
+}
+
+/**
+ * Collisions tests between all the bullets and all the enemies, every frame ( like "Collisions benchmark.gdg" ).
+ */
+void AddCollisionsBenchmark(gd::Project & project, std::vector<Benchmark> & benchmarks)
+{
+    const unsigned int bulletsCount = 200;
+    const unsigned int enemiesCount = 200;
+
+    SyntheticLayout synthetic;
+    synthetic.AddObject("Bullet");
+    synthetic.AddObject("Enemy");
+    Random random(2);
+    for (unsigned int i = 0;i<bulletsCount;++i)
+        synthetic.AddInstance("Bullet", random.Next(800), random.Next(600));
+    for (unsigned int i = 0;i<enemiesCount;++i)
+        synthetic.AddInstance("Enemy", random.Next(800), random.Next(600));
+
+    Benchmark benchmark;
+    benchmark.name = "Synthetic: "+gd::ToString(bulletsCount)+"x"+gd::ToString(enemiesCount)+" collisions";
+    benchmark.project = &project;
+    benchmark.layout = &synthetic.InsertInto(project, benchmark.name);
+    benchmark.events = [](RuntimeScene & scene, unsigned int frame) {
+        std::vector<RuntimeObject*> bullets = scene.objectsInstances.GetObjectsRawPointers("Bullet");
+        for (unsigned int i = 0;i<bullets.size();++i)
+            bullets[i]->AddForce(((i+frame)%3)*50.0f-50.0f, ((i*7+frame)%3)*50.0f-50.0f, 0);
+
+        //Condition "Bullet is in collision with Enemy", then action "Move Bullet".
+        std::vector<RuntimeObject*> enemies = scene.objectsInstances.GetObjectsRawPointers("Enemy");
+        std::map<std::string, std::vector<RuntimeObject*>*> bulletsLists;
+        std::map<std::string, std::vector<RuntimeObject*>*> enemiesLists;
+        bulletsLists["Bullet"] = &bullets;
+        enemiesLists["Enemy"] = &enemies;
+        if ( HitBoxesCollision(bulletsLists, enemiesLists, false) )
+        {
+            for (unsigned int i = 0;i<bullets.size();++i)
+                bullets[i]->SetX(std::fmod(bullets[i]->GetX()+397.0f, 800.0f));
+        }
+    };
+
+    benchmarks.push_back(benchmark);
+}
+
+/**
+ * Evaluate a tree of events, with the same copies of the lists of picked objects as the generated code.
+ */
+void EvaluateEventsTree(std::vector<RuntimeObject*> pickedObjects, unsigned int depth, unsigned int maxDepth)
+{
+    //Condition: compare the variable of the objects.
+    for (unsigned int i = 0;i<pickedObjects.size();)
+    {
+        if ( pickedObjects[i]->GetVariables().Get("Counter").GetValue() >= depth )
+            ++i;
+        else
+        {
+            pickedObjects[i] = pickedObjects.back();
+            pickedObjects.pop_back();
+        }
+    }
+
+    //Action: change the variable of the picked objects.
+    for (unsigned int i = 0;i<pickedObjects.size();++i)
+    {
+        gd::Variable & counter = pickedObjects[i]->GetVariables().Get("Counter");
+        counter.SetValue(std::fmod(counter.GetValue()+1, maxDepth+1));
+    }
+
+    if ( depth >= maxDepth ) return;
+
+    //Sub events.
+    EvaluateEventsTree(pickedObjects, depth+1, maxDepth);
+    EvaluateEventsTree(pickedObjects, depth+1, maxDepth);
+}
+
+/**
+ * A deep tree of events, each event filtering the objects picked by its parent.
+ */
+void AddDeepEventsBenchmark(gd::Project & project, std::vector<Benchmark> & benchmarks)
+{
+    const unsigned int objectsCount = 500;
+    const unsigned int depth = 8;
+
+    SyntheticLayout synthetic;
+    synthetic.AddObject("Object");
+    Random random(3);
+    for (unsigned int i = 0;i<objectsCount;++i)
+        synthetic.AddInstance("Object", random.Next(800), random.Next(600));
+
+    Benchmark benchmark;
+    benchmark.name = "Synthetic: events tree of depth "+gd::ToString(depth);
+    benchmark.project = &project;
+    benchmark.layout = &synthetic.InsertInto(project, benchmark.name);
+    benchmark.events = [depth](RuntimeScene & scene, unsigned int frame) {
+        EvaluateEventsTree(scene.objectsInstances.GetObjectsRawPointers("Object"), 0, depth);
+    };
+
+    benchmarks.push_back(benchmark);
+}
+
+/**
+ * Many scene and objects variables, read and modified every frame ( like "Variable Benchmark.gdg" ).
+ */
+void AddVariablesBenchmark(gd::Project & project, std::vector<Benchmark> & benchmarks)
+{
+    const unsigned int variablesCount = 1000;
+    const unsigned int objectsCount = 200;
+    const unsigned int objectVariablesCount = 10;
+
+    SyntheticLayout synthetic;
+    synthetic.AddObject("Object");
+    for (unsigned int i = 0;i<objectsCount;++i)
+        synthetic.AddInstance("Object", i, 0);
+
+    std::vector<std::string> variablesNames;
+    for (unsigned int i = 0;i<variablesCount;++i)
+        variablesNames.push_back("Variable"+gd::ToString(i));
+
+    std::vector<std::string> objectVariablesNames;
+    for (unsigned int i = 0;i<objectVariablesCount;++i)
+        objectVariablesNames.push_back("ObjectVariable"+gd::ToString(i));
+
+    Benchmark benchmark;
+    benchmark.name = "Synthetic: "+gd::ToString(variablesCount)+" variables";
+    benchmark.project = &project;
+    benchmark.layout = &synthetic.InsertInto(project, benchmark.name);
+    benchmark.events = [variablesNames, objectVariablesNames](RuntimeScene & scene, unsigned int frame) {
+        for (unsigned int i = 0;i<variablesNames.size();++i)
+        {
+            gd::Variable & variable = scene.GetVariables().Get(variablesNames[i]);
+            variable.SetValue(variable.GetValue()+1);
+        }
+
+        gd::Variable & structure = scene.GetVariables().Get("Structure");
+        for (unsigned int i = 0;i<objectVariablesNames.size();++i)
+            structure.GetChild(objectVariablesNames[i]).SetValue(frame);
+
+        scene.GetVariables().Get("Text").SetString("Frame "+gd::ToString(frame));
+
+        std::vector<RuntimeObject*> objects = scene.objectsInstances.GetObjectsRawPointers("Object");
+        for (unsigned int i = 0;i<objects.size();++i)
+        {
+            for (unsigned int j = 0;j<objectVariablesNames.size();++j)
+            {
+                gd::Variable & variable = objects[i]->GetVariables().Get(objectVariablesNames[j]);
+                variable.SetValue(variable.GetValue()+j);
+            }
+        }
+    };
+
+    benchmarks.push_back(benchmark);
+}
+
+/**
+ * Many platformer characters running and jumping on platforms.
+ */
+void AddPlatformerBenchmark(gd::Project & project, std::vector<Benchmark> & benchmarks)
+{
+    #if defined(GD_BENCHMARKS_WITH_EXTENSIONS)
+    const unsigned int charactersCount = 300;
+    const unsigned int platformsCount = 100;
+
+    std::vector<std::string> automatisms;
+    automatisms.push_back("PlatformAutomatism::PlatformerObjectAutomatism");
+    automatisms.push_back("PlatformAutomatism::PlatformAutomatism");
+    if ( !HasAutomatisms(project, automatisms) )
+    {
+        std::cout << "Platform automatism extension not loaded, platformer crowd skipped." << std::endl;
+        return;
+    }
+
+    SyntheticLayout synthetic;
+    gd::SerializerElement & character = synthetic.AddAutomatism(synthetic.AddObject("Character"), automatisms[0], "PlatformerObject");
+    character.SetAttribute("gravity", 1000.0);
+    character.SetAttribute("maxFallingSpeed", 700.0);
+    character.SetAttribute("acceleration", 1500.0);
+    character.SetAttribute("deceleration", 1500.0);
+    character.SetAttribute("maxSpeed", 250.0);
+    character.SetAttribute("jumpSpeed", 600.0);
+    character.SetAttribute("ignoreDefaultControls", true);
+    character.SetAttribute("slopeMaxAngle", 60.0);
+    synthetic.AddAutomatism(synthetic.AddObject("Platform"), automatisms[1], "Platform").SetAttribute("platformType", "NormalPlatform");
+
+    Random random(4);
+    for (unsigned int i = 0;i<platformsCount;++i)
+        synthetic.AddInstance("Platform", (i%25)*32.0f, 100.0f+(i/25)*150.0f);
+    for (unsigned int i = 0;i<charactersCount;++i)
+        synthetic.AddInstance("Character", random.Next(800), random.Next(600)-100.0f);
+
+    Benchmark benchmark;
+    benchmark.name = "Synthetic: "+gd::ToString(charactersCount)+" platformer characters";
+    benchmark.project = &project;
+    benchmark.layout = &synthetic.InsertInto(project, benchmark.name);
+    benchmark.events = [](RuntimeScene & scene, unsigned int frame) {
+        std::vector<RuntimeObject*> characters = scene.objectsInstances.GetObjectsRawPointers("Character");
+        for (unsigned int i = 0;i<characters.size();++i)
+        {
+            PlatformerObjectAutomatism * automatism = static_cast<PlatformerObjectAutomatism*>(characters[i]->GetAutomatismRawPointer("PlatformerObject"));
+            automatism->SimulateControl((i+frame)%120 < 60 ? "Left" : "Right");
+            if ( (i+frame)%90 == 0 ) automatism->SimulateControl("Jump");
+        }
+    };
+
+    benchmarks.push_back(benchmark);
+    #endif
+}
+
+/**
+ * Many objects moving to random destinations, avoiding obstacles.
+ */
+void AddPathfindingBenchmark(gd::Project & project, std::vector<Benchmark> & benchmarks)
+{
+    #if defined(GD_BENCHMARKS_WITH_EXTENSIONS)
+    const unsigned int agentsCount = 100;
+    const unsigned int obstaclesCount = 200;
+
+    std::vector<std::string> automatisms;
+    automatisms.push_back("PathfindingAutomatism::PathfindingAutomatism");
+    automatisms.push_back("PathfindingAutomatism::PathfindingObstacleAutomatism");
+    if ( !HasAutomatisms(project, automatisms) )
+    {
+        std::cout << "Pathfinding automatism extension not loaded, pathfinding swarm skipped." << std::endl;
+        return;
+    }
+
+    SyntheticLayout synthetic;
+    gd::SerializerElement & agent = synthetic.AddAutomatism(synthetic.AddObject("Agent"), automatisms[0], "Pathfinding");
+    agent.SetAttribute("allowDiagonals", true);
+    agent.SetAttribute("acceleration", 400.0);
+    agent.SetAttribute("maxSpeed", 200.0);
+    agent.SetAttribute("angularMaxSpeed", 180.0);
+    agent.SetAttribute("rotateObject", true);
+    agent.SetAttribute("cellWidth", 20);
+    agent.SetAttribute("cellHeight", 20);
+    synthetic.AddAutomatism(synthetic.AddObject("Obstacle"), automatisms[1], "PathfindingObstacle").SetAttribute("impassable", true);
+
+    Random random(5);
+    for (unsigned int i = 0;i<obstaclesCount;++i)
+        synthetic.AddInstance("Obstacle", random.Next(1600), random.Next(1200));
+    for (unsigned int i = 0;i<agentsCount;++i)
+        synthetic.AddInstance("Agent", random.Next(1600), random.Next(1200));
+
+    Benchmark benchmark;
+    benchmark.name = "Synthetic: "+gd::ToString(agentsCount)+" pathfinding agents";
+    benchmark.project = &project;
+    benchmark.layout = &synthetic.InsertInto(project, benchmark.name);
+    benchmark.events = [](RuntimeScene & scene, unsigned int frame) {
+        if ( frame%60 != 0 ) return;
+
+        Random destinations(frame);
+        std::vector<RuntimeObject*> agents = scene.objectsInstances.GetObjectsRawPointers("Agent");
+        for (unsigned int i = 0;i<agents.size();++i)
+        {
+            PathfindingAutomatism * automatism = static_cast<PathfindingAutomatism*>(agents[i]->GetAutomatismRawPointer("Pathfinding"));
+            automatism->MoveTo(scene, destinations.Next(1600), destinations.Next(1200));
+        }
+    };
+
+    benchmarks.push_back(benchmark);
+    #endif
+}
+
+#if defined(GD_IDE_ONLY)
+/**
+ * Load the benchmark games and compile their events with the events compiler of the IDE.
+ * The projects are kept in \a games. The layouts with events that could not be compiled are skipped,
+ * so that empty scenes are not measured.
+ */
+void AddGamesBenchmarks(const std::string & gamesDirectory, std::vector<std::unique_ptr<gd::Project>> & games, std::vector<Benchmark> & benchmarks)
+{
+    std::vector<std::string> gamesFiles;
+    gamesFiles.push_back("Collisions benchmark.gdg");
+    gamesFiles.push_back("Forces Benchmark.gdg");
+    gamesFiles.push_back("Variable Benchmark.gdg");
+    gamesFiles.push_back("PanelSprite test and benchmark.gdg");
+
+    std::vector<Benchmark> gamesBenchmarks;
+    for (unsigned int i = 0;i<gamesFiles.size();++i)
+    {
+        std::unique_ptr<gd::Project> game(new gd::Project);
+        if ( !game->LoadFromFile(gamesDirectory+"/"+gamesFiles[i]) )
+        {
+            std::cout << "Unable to load " << gamesFiles[i] << ", skipped." << std::endl;
+            continue;
+        }
+
+        for (unsigned int j = 0;j<game->GetLayoutsCount();++j)
+        {
+            Benchmark benchmark;
+            benchmark.name = gamesFiles[i].substr(0, gamesFiles[i].length()-4)+": "+game->GetLayout(j).GetName();
+            benchmark.project = game.get();
+            benchmark.layout = &game->GetLayout(j);
+            benchmark.compiledEvents = true;
+            gamesBenchmarks.push_back(benchmark);
+
+            CodeCompilationHelpers::CreateSceneEventsCompilationTask(*game, game->GetLayout(j));
+        }
+
+        games.push_back(std::move(game));
+    }
+
+    //The compiler processes notify their end using wxWidgets events.
+    {
+        wxEventLoop eventLoop;
+        wxEventLoopActivator activateEventLoop(&eventLoop);
+        while ( CodeCompiler::Get()->CompilationInProcess() )
+        {
+            eventLoop.Yield();
+            wxMilliSleep(10);
+        }
+    }
+
+    for (unsigned int i = 0;i<gamesBenchmarks.size();++i)
+    {
+        if ( gamesBenchmarks[i].layout->CompilationNeeded() )
+        {
+            std::cout << "Unable to compile the events of " << gamesBenchmarks[i].name << ", skipped ( see "
+                << CodeCompiler::Get()->GetOutputDirectory() << "LatestCompilationOutput.txt )." << std::endl;
+            continue;
+        }
+
+        benchmarks.push_back(gamesBenchmarks[i]);
+    }
+}
+#endif
+
+/**
+ * Play the scene of the benchmark for \a frames frames, after a few frames to reach a steady state.
+ */
+bool Play(const Benchmark & benchmark, unsigned int frames, sf::RenderTexture * renderTexture, BenchmarkResult & result)
+{
+    const signed long long timeStep = 1000000/60;
+
+    RuntimeGame game;
+    game.LoadFromProject(*benchmark.project);
+    AddSpriteTexture(game);
+
+    RuntimeScene scene(NULL, &game);
+    if ( !scene.LoadFromScene(*benchmark.layout) )
+        return false;
+
+    #if defined(GD_IDE_ONLY)
+    if ( benchmark.compiledEvents && !scene.GetCodeExecutionEngine()->LoadFromDynamicLibrary(benchmark.layout->GetCompiledEventsFile(),
+        "GDSceneEvents"+gd::SceneNameMangler::GetMangledSceneName(benchmark.layout->GetName())) )
+        return false;
+    #endif
+
+    unsigned int frame = 0;
+    for (unsigned int warmupFrames = std::max(frames/10, 1u);frame<warmupFrames;++frame)
+    {
+        if ( benchmark.events ) benchmark.events(scene, frame);
+        scene.Step(timeStep, renderTexture);
+    }
+
+    AllocationsCount allocationsBefore = AllocationsTracker::GetCount();
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for (unsigned int i = 0;i<frames;++i, ++frame)
+    {
+        if ( benchmark.events ) benchmark.events(scene, frame);
+        scene.Step(timeStep, renderTexture);
+    }
+
+    double duration = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()-start).count();
+    result.name = benchmark.name;
+    result.nsPerFrame = duration/frames;
+    AllocationsCount allocated = AllocationsTracker::GetCount()-allocationsBefore;
+    result.allocationsPerFrame = static_cast<double>(allocated.allocations)/frames;
+    result.bytesPerFrame = static_cast<double>(allocated.bytes)/frames;
+    result.peakRssKB = GetPeakRSS();
+
+    return true;
+}
+
+void SerializeResults(const std::vector<BenchmarkResult> & results, unsigned int frames, gd::SerializerElement & element)
+{
+    element.SetAttribute("frames", static_cast<int>(frames));
+    gd::SerializerElement & benchmarksElement = element.AddChild("benchmarks");
+    benchmarksElement.ConsiderAsArrayOf("benchmark");
+    for (unsigned int i = 0;i<results.size();++i)
+    {
+        gd::SerializerElement & benchmarkElement = benchmarksElement.AddChild("benchmark");
+        benchmarkElement.SetAttribute("name", results[i].name);
+        benchmarkElement.SetAttribute("nsPerFrame", results[i].nsPerFrame);
+        benchmarkElement.SetAttribute("allocationsPerFrame", results[i].allocationsPerFrame);
+        benchmarkElement.SetAttribute("bytesPerFrame", results[i].bytesPerFrame);
+        benchmarkElement.SetAttribute("peakRssKB", static_cast<int>(results[i].peakRssKB));
+    }
+}
+
+/**
+ * Compare the results to the baseline.
+ * \return false if a scene is slower or allocates more than the baseline, beyond the tolerance.
+ */
+bool CompareToBaseline(const std::vector<BenchmarkResult> & results, const gd::SerializerElement & baseline, double tolerance)
+{
+    std::map<std::string, const gd::SerializerElement *> baselineBenchmarks;
+    const gd::SerializerElement & benchmarksElement = baseline.GetChild("benchmarks");
+    benchmarksElement.ConsiderAsArrayOf("benchmark");
+    for (unsigned int i = 0;i<benchmarksElement.GetChildrenCount();++i)
+        baselineBenchmarks[benchmarksElement.GetChild(i).GetStringAttribute("name")] = &benchmarksElement.GetChild(i);
+
+    bool success = true;
+    std::cout << "Comparison with the baseline ( tolerance: " << tolerance*100.0 << "% ):" << std::endl;
+    for (unsigned int i = 0;i<results.size();++i)
+    {
+        std::map<std::string, const gd::SerializerElement *>::const_iterator it = baselineBenchmarks.find(results[i].name);
+        if ( it == baselineBenchmarks.end() )
+        {
+            std::cout << "    " << results[i].name << ": not in the baseline." << std::endl;
+            continue;
+        }
+
+        double baselineTime = it->second->GetDoubleAttribute("nsPerFrame");
+        double baselineAllocations = it->second->GetDoubleAttribute("allocationsPerFrame");
+        bool slower = results[i].nsPerFrame > baselineTime*(1.0+tolerance);
+        bool moreAllocations = results[i].allocationsPerFrame > baselineAllocations*(1.0+tolerance)+0.5;
+
+        std::cout << "    " << results[i].name << ": "
+            << std::fixed << std::setprecision(1) << (baselineTime > 0 ? (results[i].nsPerFrame/baselineTime-1.0)*100.0 : 0) << "% time, "
+            << results[i].allocationsPerFrame-baselineAllocations << " allocations/frame"
+            << (slower ? " [SLOWER]" : "") << (moreAllocations ? " [MORE ALLOCATIONS]" : "") << std::endl;
+
+        if ( slower || moreAllocations ) success = false;
+    }
+
+    return success;
+}
+
+}
+
+int main(int argc, char ** argv)
+{
+    #if defined(GD_IDE_ONLY)
+    //The IDE version of GDCpp and its extensions use wxWidgets, including its graphical classes.
+    wxApp::SetInstance(new wxApp);
+    wxInitializer wxInitialization(argc, argv);
+    if ( !wxInitialization.IsOk() )
+    {
+        std::cout << "Unable to initialize wxWidgets." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::string gamesDirectory = GD_BENCHMARKS_GAMES_DIRECTORY;
+    std::string ideDirectory = GD_BENCHMARKS_IDE_DIRECTORY;
+    std::string outputFile = "GDCpp_IDE_benchmarks.json";
+    #else
+    std::string outputFile = "GDCpp_benchmarks.json";
+    #endif
+    std::string extensionsDirectory = GD_BENCHMARKS_EXTENSIONS_DIRECTORY;
+    std::string baselineFile;
+    unsigned int frames = 600;
+    double tolerance = 0.1;
+    double maxAllocations = -1; //No limit.
+    bool render = false;
+    for (int i = 1;i<argc;++i)
+    {
+        std::string argument = argv[i];
+        std::string value = argument.find('=') != std::string::npos ? argument.substr(argument.find('=')+1) : "";
+        if ( argument.find("-extensions=") == 0 ) extensionsDirectory = value;
+        #if defined(GD_IDE_ONLY)
+        else if ( argument.find("-games=") == 0 ) gamesDirectory = value;
+        else if ( argument.find("-ide=") == 0 ) ideDirectory = value;
+        #endif
+        else if ( argument.find("-frames=") == 0 ) frames = std::max(1, atoi(value.c_str()));
+        else if ( argument.find("-output=") == 0 ) outputFile = value;
+        else if ( argument.find("-baseline=") == 0 ) baselineFile = value;
+        else if ( argument.find("-tolerance=") == 0 ) tolerance = atof(value.c_str())/100.0;
+        else if ( argument.find("-maxAllocations=") == 0 ) maxAllocations = atof(value.c_str());
+        else if ( argument == "-render" ) render = true;
+        else
+        {
+            std::cout << "Unknown argument " << argument << "." << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    gd::ExtensionsLoader::LoadAllExtensions(extensionsDirectory, CppPlatform::Get());
+    gd::ExtensionsLoader::ExtensionsLoadingDone(extensionsDirectory);
+
+    std::vector<Benchmark> benchmarks;
+    #if defined(GD_IDE_ONLY)
+    CodeCompiler::Get()->SetBaseDirectory(ideDirectory);
+    std::vector<std::unique_ptr<gd::Project>> games;
+    AddGamesBenchmarks(gamesDirectory, games, benchmarks);
+    #endif
+
+    gd::Project synthetic;
+    AddForcesBenchmark(synthetic, benchmarks);
+    AddCollisionsBenchmark(synthetic, benchmarks);
+    AddDeepEventsBenchmark(synthetic, benchmarks);
+    AddVariablesBenchmark(synthetic, benchmarks);
+    AddPlatformerBenchmark(synthetic, benchmarks);
+    AddPathfindingBenchmark(synthetic, benchmarks);
+
+    std::unique_ptr<sf::RenderTexture> renderTexture;
+    if ( render )
+    {
+        renderTexture.reset(new sf::RenderTexture);
+        if ( !renderTexture->create(800, 600, true) )
+        {
+            std::cout << "Unable to create the texture to render the scenes." << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::vector<BenchmarkResult> results;
+    for (unsigned int i = 0;i<benchmarks.size();++i)
+    {
+        #if defined(GD_IDE_ONLY)
+        //As for a preview, the resources of the games are found relative to the directory of the game.
+        wxString workingDirectory = wxGetCwd();
+        if ( benchmarks[i].compiledEvents )
+            wxSetWorkingDirectory(wxFileName::FileName(benchmarks[i].project->GetProjectFile()).GetPath());
+        #endif
+
+        BenchmarkResult result;
+        bool played = Play(benchmarks[i], frames, renderTexture.get(), result);
+
+        #if defined(GD_IDE_ONLY)
+        wxSetWorkingDirectory(workingDirectory);
+        #endif
+        if ( !played )
+        {
+            std::cout << "Unable to load " << benchmarks[i].name << ", skipped." << std::endl;
+            continue;
+        }
+
+        results.push_back(result);
+    }
+
+    std::cout << std::endl << "Scenes played for " << frames << " frames" << (render ? ", rendered offscreen" : "") << ":" << std::endl;
+    for (unsigned int i = 0;i<results.size();++i)
+    {
+        std::cout << "    " << std::setw(50) << std::left << results[i].name << std::right
+            << std::setw(12) << std::fixed << std::setprecision(0) << results[i].nsPerFrame << " ns/frame, "
+            << std::setw(9) << std::setprecision(1) << results[i].allocationsPerFrame << " allocations/frame, "
+            << std::setw(8) << results[i].peakRssKB << " KB peak RSS" << std::endl;
+    }
+
+    gd::SerializerElement resultsElement;
+    SerializeResults(results, frames, resultsElement);
+    if ( !gd::Serializer::ToJSONFile(resultsElement, outputFile, true) )
+        std::cout << "Unable to write the results to " << outputFile << "." << std::endl;
+
+    bool success = true;
+    if ( !baselineFile.empty() )
+    {
+        gd::SerializerElement baseline;
+        std::string error;
+        if ( !gd::Serializer::FromJSONFile(baseline, baselineFile, &error) )
+        {
+            std::cout << "Unable to read the baseline " << baselineFile << " (" << error << ")." << std::endl;
+            return EXIT_FAILURE;
+        }
+
+        success = CompareToBaseline(results, baseline, tolerance);
+    }
+
+    if ( maxAllocations >= 0 )
+    {
+        for (unsigned int i = 0;i<results.size();++i)
+        {
+            if ( results[i].allocationsPerFrame > maxAllocations )
+            {
+                std::cout << results[i].name << " makes " << results[i].allocationsPerFrame << " allocations per frame ( maximum: " << maxAllocations << " )." << std::endl;
+                success = false;
+            }
+        }
+    }
+
+    CppPlatform::DestroySingleton();
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,48 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2015 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the allocations tracking of GDevelop C++ Platform.
+ */
+#include "catch.hpp"
+#include "GDCpp/AllocationsTracker.h"
+#include "GDCpp/FrameProfiler.h"
+#include <string>
+#include <vector>
+
+TEST_CASE( "AllocationsTracker", "[common]" ) {
+	SECTION("Allocations count") {
+		AllocationsCount start = AllocationsTracker::GetCount();
+		std::vector<char> * buffer = new std::vector<char>(1000, 'a');
+		AllocationsCount allocated = AllocationsTracker::GetCount()-start;
+		REQUIRE( buffer->size() == 1000 );
+		delete buffer;
+
+		if ( AllocationsTracker::IsEnabled() )
+		{
+			REQUIRE( allocated.allocations == 2 );
+			REQUIRE( allocated.bytes == sizeof(std::vector<char>)+1000 );
+		}
+		else
+			REQUIRE( allocated.allocations == 0 );
+	}
+	SECTION("Allocations of the profiler scopes") {
+		FrameProfiler::Clear();
+		FrameProfiler::Enable();
+		{
+			GD_PROFILE_SCOPE("Allocating");
+			std::vector<char> * buffer = new std::vector<char>(1000, 'a');
+			delete buffer;
+		}
+		FrameProfiler::Enable(false);
+
+		std::string trace;
+		FrameProfiler::WriteChromeTrace(trace);
+		if ( AllocationsTracker::IsEnabled() )
+			REQUIRE( trace.find("\"args\":{\"allocations\":2,") != std::string::npos );
+		else
+			REQUIRE( trace.find("\"args\"") == std::string::npos );
+	}
+}
@@ -10,7 +10,10 @@
 #include "GDCore/CommonTools.h"
 #include "GDCore/PlatformDefinition/ClassWithObjects.h"
 #include "GDCore/PlatformDefinition/Layout.h"
+#include "GDCore/PlatformDefinition/Object.h"
 #include "GDCpp/RuntimeScene.h"
+#include "GDCpp/RuntimeObject.h"
+#include "GDCpp/RuntimeLayer.h"
 #include "GDCpp/RuntimeGame.h"
 
 TEST_CASE( "RuntimeScene", "[common]" ) {
@@ -41,6 +44,41 @@ TEST_CASE( "RuntimeScene", "[common]" ) {
         REQUIRE(scene.GetVariables().Get("MaVar").GetString() == "Hello");
         REQUIRE(scene.GetVariables().Get("MaVar2").GetValue() == 42);
 	}
+	SECTION("Headless steps") {
+		gd::Layout layout;
+		RuntimeGame game;
+		RuntimeScene scene(NULL, &game);
+		scene.LoadFromScene(layout);
+
+		REQUIRE( scene.Step(16000) == -1 );
+		REQUIRE( scene.GetElapsedTime() == 16000 );
+		REQUIRE( scene.IsFirstLoop() == false );
+
+		scene.SetTimeScale(2);
+		scene.Step(16000);
+		REQUIRE( scene.GetElapsedTime() == 32000 );
+		REQUIRE( scene.GetTimeFromStart() == 48000 );
+	}
+	SECTION("Layers handles") {
+		gd::Layout layout;
+		layout.InsertNewLayer("Foreground", 1);
+		RuntimeGame game;
+		RuntimeScene scene(NULL, &game);
+		scene.LoadFromScene(layout);
+
+		unsigned int handle = scene.GetRuntimeLayerHandle("Foreground");
+		REQUIRE( handle != RuntimeScene::badLayerHandle );
+		REQUIRE( &scene.GetRuntimeLayerFromHandle(handle) == &scene.GetRuntimeLayer("Foreground") );
+		REQUIRE( scene.GetRuntimeLayerFromHandle(handle).GetName() == "Foreground" );
+		REQUIRE( scene.GetRuntimeLayerHandle("Unknown layer") == RuntimeScene::badLayerHandle );
+		REQUIRE( &scene.GetRuntimeLayerFromHandle(RuntimeScene::badLayerHandle) == &scene.GetRuntimeLayer("Unknown layer") );
+
+		gd::Object obj("1");
+		RuntimeObject object(scene, obj);
+		REQUIRE( object.GetLayerHandle(scene) == scene.GetRuntimeLayerHandle("") );
+		object.SetLayer("Foreground");
+		REQUIRE( object.GetLayerHandle(scene) == handle );
+	}
 }
 
 TEST_CASE( "gd::Project", "[common]" ) {
@@ -0,0 +1,75 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2015 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the frame profiler of GDevelop C++ Platform.
+ */
+#include "catch.hpp"
+#include "GDCpp/FrameProfiler.h"
+#include <string>
+
+namespace
+{
+
+unsigned int CountOccurrences(const std::string & str, const std::string & pattern)
+{
+    unsigned int count = 0;
+    for (size_t pos = str.find(pattern);pos != std::string::npos;pos = str.find(pattern, pos+1))
+        count++;
+
+    return count;
+}
+
+}
+
+TEST_CASE( "FrameProfiler", "[common]" ) {
+	SECTION("Disabled profiler") {
+		FrameProfiler::Enable(false);
+		FrameProfiler::Clear();
+		unsigned int namesEvaluated = 0;
+		{
+			GD_PROFILE_SCOPE("Not recorded");
+			GD_PROFILE_SCOPE([&]() { namesEvaluated++; return std::string("Not evaluated"); }());
+		}
+
+		std::string trace;
+		FrameProfiler::WriteChromeTrace(trace);
+		REQUIRE( CountOccurrences(trace, "Not recorded") == 0 );
+		REQUIRE( namesEvaluated == 0 );
+	}
+	SECTION("Nested scopes") {
+		FrameProfiler::Clear();
+		FrameProfiler::Enable();
+		{
+			GD_PROFILE_SCOPE("Frame");
+			{
+				GD_PROFILE_SCOPE(std::string("Events"));
+			}
+		}
+		FrameProfiler::Enable(false);
+
+		std::string trace;
+		FrameProfiler::WriteChromeTrace(trace);
+		REQUIRE( CountOccurrences(trace, "\"ph\":\"X\"") == 2 );
+		REQUIRE( CountOccurrences(trace, "\"name\":\"Frame\"") == 1 );
+		REQUIRE( CountOccurrences(trace, "\"name\":\"Events\"") == 1 );
+		REQUIRE( trace.find("\"name\":\"Events\"") < trace.find("\"name\":\"Frame\"") ); //Scopes are written when they end.
+	}
+	SECTION("Ring buffer") {
+		FrameProfiler::SetBufferCapacity(3);
+		FrameProfiler::Enable();
+		for (unsigned int i = 0;i<10;++i)
+		{
+			GD_PROFILE_SCOPE("Scope");
+		}
+		FrameProfiler::Enable(false);
+
+		std::string trace;
+		FrameProfiler::WriteChromeTrace(trace);
+		REQUIRE( CountOccurrences(trace, "\"name\":\"Scope\"") == 3 );
+
+		FrameProfiler::SetBufferCapacity(65536);
+	}
+}
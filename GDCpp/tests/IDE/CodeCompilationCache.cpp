@@ -0,0 +1,109 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2015 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+/**
+ * @file Tests for the compilation cache of events code.
+ */
+#include "../catch.hpp"
+#include "GDCore/PlatformDefinition/Project.h"
+#include "GDCore/PlatformDefinition/Layout.h"
+#include "GDCore/Events/Builtin/StandardEvent.h"
+#include "GDCore/Events/Builtin/GroupEvent.h"
+#include "GDCore/Events/Instruction.h"
+#include "GDCpp/Events/EventsCodeGenerator.h"
+#include "GDCpp/IDE/CodeCompilationCache.h"
+#include "GDCpp/IDE/CodeCompiler.h"
+#include "GDCpp/CppPlatform.h"
+#include <wx/filefn.h>
+#include <wx/filename.h>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+/**
+ * Create a project with a scene using Trigger once conditions, in the main events and in a group of events.
+ */
+std::unique_ptr<gd::Project> CreateProject()
+{
+	std::unique_ptr<gd::Project> project(new gd::Project);
+	project->AddPlatform(CppPlatform::Get());
+	project->SetProjectFile("/tmp/Project.gdg");
+	gd::Layout & layout = project->InsertNewLayout("Scene", 0);
+
+	gd::StandardEvent event;
+	event.GetConditions().push_back(gd::Instruction("BuiltinCommonInstructions::Once"));
+	layout.GetEvents().InsertEvent(event);
+
+	gd::GroupEvent group;
+	group.SetName("Group");
+	group.GetSubEvents().InsertEvent(event);
+	layout.GetEvents().InsertEvent(group);
+
+	return project;
+}
+
+/**
+ * Generate the events of the scene of a project, as done by the IDE before compiling them.
+ */
+std::string GenerateSceneCode(gd::Project & project, std::vector<EventsCodeUnit> & units)
+{
+	gd::Layout & layout = project.GetLayout(0);
+	gd::EventsList eventsCopy = layout.GetEvents();
+	std::string header;
+	return EventsCodeGenerator::GenerateSceneEventsSplitCode(project, layout, eventsCopy, "GDScene_EventsHeader.h", header, units);
+}
+
+std::string WriteFile(const std::string & filename, const std::string & content)
+{
+	std::string path = wxFileName::GetTempDir().ToStdString()+"/"+filename;
+	std::ofstream file(path.c_str(), std::ios::out | std::ios::binary);
+	file << content;
+	return path;
+}
+
+}
+
+TEST_CASE( "CodeCompilationCache", "[common]" ) {
+	SECTION("Keys of the code generated for the same events") {
+		CodeCompilationCache cache;
+		cache.SetDirectory(wxFileName::GetTempDir().ToStdString()+"/GDCompilationCacheTests");
+
+		//Two IDE sessions: the scenes are at different addresses and the generated files have different names.
+		std::unique_ptr<gd::Project> firstSession = CreateProject();
+		std::unique_ptr<gd::Project> secondSession = CreateProject();
+
+		std::vector<EventsCodeUnit> firstUnits, secondUnits;
+		std::string firstCode = GenerateSceneCode(*firstSession, firstUnits);
+		std::string secondCode = GenerateSceneCode(*secondSession, secondUnits);
+		REQUIRE( firstCode == secondCode );
+		REQUIRE( firstUnits.size() == 1 );
+		REQUIRE( secondUnits.size() == 1 );
+		REQUIRE( firstUnits[0].code == secondUnits[0].code );
+
+		CodeCompilerCall firstCall;
+		firstCall.eventsGeneratedCode = true;
+		firstCall.inputFile = WriteFile("GD0x1234EventsSource.cpp", firstCode);
+		firstCall.outputFile = "GD0x1234ObjectFile.o";
+		CodeCompilerCall secondCall = firstCall;
+		secondCall.inputFile = WriteFile("GD0x5678EventsSource.cpp", secondCode);
+		secondCall.outputFile = "GD0x5678ObjectFile.o";
+
+		std::string key = cache.ComputeKey(firstCall);
+		REQUIRE( key.empty() == false );
+		REQUIRE( cache.ComputeKey(secondCall) == key );
+
+		//Another code has another key.
+		secondCall.inputFile = WriteFile("GD0x5678EventsSource.cpp", secondCode+"\n//Modified");
+		REQUIRE( cache.ComputeKey(secondCall) != key );
+
+		wxRemoveFile(firstCall.inputFile);
+		wxRemoveFile(secondCall.inputFile);
+		cache.Clear();
+	}
+}
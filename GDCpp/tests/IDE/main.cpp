@@ -0,0 +1,12 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2015 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+/**
+ * @file Main file for the tests of the IDE features of GDevelop C++ Platform
+ *
+ * Please write any new test in a separate file.
+ */
+#define CATCH_CONFIG_MAIN
+#include "../catch.hpp"
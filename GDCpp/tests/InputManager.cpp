@@ -40,4 +40,23 @@ TEST_CASE( "InputManager", "[game-engine]" ) {
 		m.HandleEvent(keyEvent);
 		REQUIRE(m.AnyKeyIsPressed() == false);
 	}
+	SECTION("Disabled input") {
+		InputManager m;
+		m.DisableInputWhenFocusIsLost(false);
+
+		sf::Event keyEvent;
+		keyEvent.type = sf::Event::KeyPressed;
+		keyEvent.key = {sf::Keyboard::A, false, false, false, false};
+
+		//The input is ignored whatever the focus option...
+		m.DisableInput();
+		m.HandleEvent(keyEvent);
+		REQUIRE(m.AnyKeyIsPressed() == false);
+		REQUIRE(m.IsKeyPressed("a") == false);
+
+		//...which is not changed.
+		m.DisableInput(false);
+		m.HandleEvent(keyEvent);
+		REQUIRE(m.AnyKeyIsPressed() == true);
+	}
 }
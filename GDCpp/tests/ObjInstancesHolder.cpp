@@ -62,4 +62,36 @@ TEST_CASE( "ObjInstancesHolder", "[common]" ) {
 		REQUIRE(container.GetObjects("2").size() == 3);
 		REQUIRE(container.GetObjectsRawPointers("2").size() == 3);
 	}
+	SECTION("Reserving memory") {
+		gd::Object obj1("1");
+
+		RuntimeGame game;
+		RuntimeScene scene(NULL, &game);
+
+		ObjInstancesHolder container;
+		container.AddObject(std::shared_ptr<RuntimeObject>(new RuntimeObject(scene, obj1)));
+		container.Reserve("1", 10);
+		REQUIRE(container.GetObjects("1").size() == 1);
+		REQUIRE(container.GetObjects("1").capacity() >= 11);
+
+		//Reserving memory does not change the objects.
+		RuntimeObject * first = container.GetObjects("1")[0].get();
+		for (unsigned int i = 0;i<10;++i)
+			container.AddObject(std::shared_ptr<RuntimeObject>(new RuntimeObject(scene, obj1)));
+		REQUIRE(container.GetObjects("1").size() == 11);
+		REQUIRE(container.GetObjects("1")[0].get() == first);
+		REQUIRE(container.GetObjectsRawPointers("1").size() == 11);
+		REQUIRE(container.GetObjectsRawPointers("1")[0] == first);
+
+		//Reserving a few objects many times does not reallocate the list each time.
+		std::size_t reallocations = 0;
+		for (unsigned int i = 0;i<100;++i)
+		{
+			std::size_t capacity = container.GetObjects("1").capacity();
+			container.Reserve("1", 1);
+			container.AddObject(std::shared_ptr<RuntimeObject>(new RuntimeObject(scene, obj1)));
+			if ( container.GetObjects("1").capacity() != capacity ) reallocations++;
+		}
+		REQUIRE(reallocations < 10);
+	}
 }
@@ -0,0 +1,27 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2015 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the cameras of the runtime layers.
+ */
+#include "catch.hpp"
+#include "GDCpp/RuntimeLayer.h"
+
+TEST_CASE( "RuntimeCamera", "[common]" ) {
+	SECTION("Camera area") {
+		sf::View view(sf::FloatRect(0, 0, 800, 600));
+		RuntimeCamera camera(view);
+		REQUIRE(camera.GetArea().left == 0);
+		REQUIRE(camera.GetArea().width == 800);
+
+		camera.SetViewCenter(sf::Vector2f(1000, 1000));
+		REQUIRE(camera.GetArea().left == 600);
+		REQUIRE(camera.GetArea().top == 700);
+
+		camera.SetRotation(90);
+		REQUIRE(camera.GetArea().width == Approx(600));
+		REQUIRE(camera.GetArea().height == Approx(800));
+	}
+}
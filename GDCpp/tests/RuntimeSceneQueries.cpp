@@ -0,0 +1,126 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2015 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the spatial queries of RuntimeScene.
+ */
+#include "catch.hpp"
+#include "GDCore/PlatformDefinition/Layout.h"
+#include "GDCore/PlatformDefinition/Object.h"
+#include "GDCpp/RuntimeObject.h"
+#include "GDCpp/RuntimeScene.h"
+#include "GDCpp/RuntimeLayer.h"
+#include "GDCpp/RuntimeGame.h"
+#include <algorithm>
+
+TEST_CASE( "RuntimeScene spatial queries", "[common]" ) {
+	SECTION("Objects at a position and in an area") {
+		gd::Object obj1("1");
+
+		RuntimeGame game;
+		RuntimeScene scene(NULL, &game);
+
+		std::shared_ptr<RuntimeObject> objA(new RuntimeObject(scene, obj1));
+		std::shared_ptr<RuntimeObject> objB(new RuntimeObject(scene, obj1));
+		objA->SetX(10); objA->SetY(10);
+		objB->SetX(500); objB->SetY(-300);
+		scene.objectsInstances.AddObject(objA);
+		scene.objectsInstances.AddObject(objB);
+
+		std::vector<RuntimeObject*> result;
+		scene.GetObjectsAtPosition(10, 10, result);
+		REQUIRE(result.size() == 1);
+		REQUIRE(result[0] == objA.get());
+
+		result.clear();
+		scene.GetObjectsInArea(sf::FloatRect(0, -1000, 1000, 2000), result);
+		REQUIRE(result.size() == 2);
+
+		//Moved objects are found after the index is invalidated.
+		objA->SetX(2000);
+		scene.InvalidateSpatialIndex();
+		result.clear();
+		scene.GetObjectsAtPosition(10, 10, result);
+		REQUIRE(result.empty());
+
+		//Added and deleted objects are taken into account.
+		std::shared_ptr<RuntimeObject> objC(new RuntimeObject(scene, obj1));
+		objC->SetX(10); objC->SetY(10);
+		scene.objectsInstances.AddObject(objC);
+		result.clear();
+		scene.GetObjectsAtPosition(10, 10, result);
+		REQUIRE(result.size() == 1);
+		REQUIRE(result[0] == objC.get());
+
+		objC->DeleteFromScene(scene);
+		result.clear();
+		scene.GetObjectsAtPosition(10, 10, result);
+		REQUIRE(result.empty());
+	}
+	SECTION("Objects visible from a camera") {
+		gd::Layout layout;
+		layout.InsertNewLayer("Foreground", 1);
+		gd::Object obj1("1");
+
+		RuntimeGame game;
+		RuntimeScene scene(NULL, &game);
+		scene.LoadFromScene(layout);
+		RuntimeCamera & camera = scene.GetRuntimeLayer("").GetCamera(0);
+		camera.SetSize(800, 600);
+		camera.SetViewCenter(sf::Vector2f(400, 300));
+
+		std::shared_ptr<RuntimeObject> objA(new RuntimeObject(scene, obj1));
+		std::shared_ptr<RuntimeObject> objB(new RuntimeObject(scene, obj1));
+		std::shared_ptr<RuntimeObject> objC(new RuntimeObject(scene, obj1));
+		objA->SetX(100); objA->SetY(100);
+		objB->SetX(900); objB->SetY(100);
+		objC->SetX(100); objC->SetY(100);
+		objC->SetLayer("Foreground");
+		scene.objectsInstances.AddObject(objA);
+		scene.objectsInstances.AddObject(objB);
+		scene.objectsInstances.AddObject(objC);
+
+		std::vector<RuntimeObject*> result;
+		scene.GetObjectsVisibleFromCamera("", 0, result);
+		REQUIRE(result.size() == 1);
+		REQUIRE(result[0] == objA.get());
+
+		REQUIRE(scene.IsObjectVisibleFromCamera(*objA, 0) == true);
+		REQUIRE(scene.IsObjectVisibleFromCamera(*objB, 0) == false);
+		REQUIRE(scene.IsObjectVisibleFromCamera(*objB, 0, 150) == true);
+		REQUIRE(scene.IsObjectVisibleFromCamera(*objA, 1) == false);
+
+		//Moving the camera changes the objects visible from it.
+		camera.SetViewCenter(sf::Vector2f(1200, 300));
+		REQUIRE(scene.IsObjectVisibleFromCamera(*objA, 0) == false);
+		REQUIRE(scene.IsObjectVisibleFromCamera(*objB, 0) == true);
+
+		//Objects moved are found after a new step of the frame.
+		objA->SetX(1000);
+		scene.InvalidateSpatialIndex();
+		REQUIRE(scene.IsObjectVisibleFromCamera(*objA, 0) == true);
+	}
+	SECTION("Objects at a position tested one by one") {
+		gd::Object obj1("1");
+
+		RuntimeGame game;
+		RuntimeScene scene(NULL, &game);
+
+		std::shared_ptr<RuntimeObject> objA(new RuntimeObject(scene, obj1));
+		std::shared_ptr<RuntimeObject> objB(new RuntimeObject(scene, obj1));
+		objA->SetX(10); objA->SetY(10);
+		objB->SetX(500); objB->SetY(-300);
+		scene.objectsInstances.AddObject(objA);
+		scene.objectsInstances.AddObject(objB);
+
+		REQUIRE(scene.IsObjectAtPosition(*objA, 10, 10) == true);
+		REQUIRE(scene.IsObjectAtPosition(*objB, 10, 10) == false);
+		REQUIRE(scene.IsObjectAtPosition(*objB, 500, -300) == true);
+		REQUIRE(scene.IsObjectAtPosition(*objA, 500, -300) == false);
+
+		objB->DeleteFromScene(scene);
+		REQUIRE(scene.IsObjectAtPosition(*objB, 500, -300) == false);
+	}
+}
@@ -0,0 +1,49 @@
+/*
+ * GDevelop C++ Platform
+ * Copyright 2008-2015 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+/**
+ * @file Tests covering the text renderer of GDevelop C++ Platform.
+ */
+#include "catch.hpp"
+#include "GDCpp/TextRenderer.h"
+#include "GDCpp/FontManager.h"
+
+TEST_CASE( "TextRenderer", "[common]" ) {
+	const sf::Font * font = FontManager::Get()->GetFont("");
+
+	SECTION("Geometry is only generated when needed") {
+		TextGeometry geometry;
+		REQUIRE( geometry.Update("Score: 10", font, 20, sf::Text::Regular) == true );
+		REQUIRE( geometry.GetVertices().size() == 8*4 ); //The space has no quad.
+		REQUIRE( geometry.GetLocalBounds().width > 0 );
+
+		REQUIRE( geometry.Update("Score: 10", font, 20, sf::Text::Regular) == false );
+		REQUIRE( geometry.Update("Score: 11", font, 20, sf::Text::Regular) == true );
+		REQUIRE( geometry.Update("Score: 11", font, 21, sf::Text::Regular) == true );
+		REQUIRE( geometry.Update("Score: 11", font, 21, sf::Text::Underlined) == true );
+		REQUIRE( geometry.GetVertices().size() == 9*4 );
+		REQUIRE( geometry.Update("Score: 11", font, 21, sf::Text::Underlined) == false );
+	}
+	SECTION("Numbers can grow without reallocating the vertices") {
+		TextGeometry geometry;
+		geometry.Update("1", font, 20, sf::Text::Regular);
+		const sf::Vertex * vertices = &geometry.GetVertices()[0];
+
+		geometry.Update("1000000", font, 20, sf::Text::Regular);
+		REQUIRE( geometry.GetVertices().size() == 7*4 );
+		REQUIRE( &geometry.GetVertices()[0] == vertices );
+	}
+	SECTION("Atlases are shared") {
+		TextRenderer * renderer = TextRenderer::Get();
+		REQUIRE( &renderer->GetAtlas(*font, 20, false) == &renderer->GetAtlas(*font, 20, false) );
+		REQUIRE( &renderer->GetAtlas(*font, 20, false) != &renderer->GetAtlas(*font, 20, true) );
+		REQUIRE( &renderer->GetAtlas(*font, 20, false).GetTexture() == &font->getTexture(20) );
+
+		TextGeometry geometry;
+		geometry.Update("1", font, 20, sf::Text::Regular);
+		renderer->ClearAtlases();
+		REQUIRE( geometry.Update("1", font, 20, sf::Text::Regular) == true );
+	}
+}
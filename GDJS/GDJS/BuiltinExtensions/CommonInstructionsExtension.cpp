@@ -60,27 +60,24 @@ CommonInstructionsExtension::CommonInstructionsExtension()
     {
         class CodeGen : public gd::EventMetadata::CodeGenerator
         {
-            virtual std::string Generate(gd::BaseEvent & event_, gd::EventsCodeGenerator & codeGenerator, gd::EventsCodeGenerationContext & context)
+            virtual void Generate(gd::BaseEvent & event_, gd::EventsCodeGenerator & codeGenerator, gd::EventsCodeGenerationContext & context, gd::EventsCodeOutput & output)
             {
-                std::string outputCode;
                 gd::StandardEvent & event = dynamic_cast<gd::StandardEvent&>(event_);
 
-                outputCode += codeGenerator.GenerateConditionsListCode(event.GetConditions(), context);
+                output << codeGenerator.GenerateConditionsListCode(event.GetConditions(), context);
 
                 std::string ifPredicat = event.GetConditions().empty() ? "" : codeGenerator.GenerateBooleanFullName("condition"+gd::ToString(event.GetConditions().size()-1)+"IsTrue", context)+".val";
 
-                if ( !ifPredicat.empty() ) outputCode += "if (" +ifPredicat+ ") {\n";
-                outputCode += codeGenerator.GenerateActionsListCode(event.GetActions(), context);
+                if ( !ifPredicat.empty() ) output << "if (" +ifPredicat+ ") {\n";
+                output << codeGenerator.GenerateActionsListCode(event.GetActions(), context);
                 if ( event.HasSubEvents() ) //Sub events
                 {
-                    outputCode += "\n{ //Subevents\n";
-                    outputCode += codeGenerator.GenerateEventsListCode(event.GetSubEvents(), context);
-                    outputCode += "} //End of subevents\n";
+                    output << "\n{ //Subevents\n";
+                    codeGenerator.GenerateEventsListCode(event.GetSubEvents(), context, output);
+                    output << "} //End of subevents\n";
                 }
 
-                if ( !ifPredicat.empty() ) outputCode += "}\n";
-
-                return outputCode;
+                if ( !ifPredicat.empty() ) output << "}\n";
             }
         };
         gd::EventMetadata::CodeGenerator * codeGen = new CodeGen;
@@ -284,7 +281,7 @@ CommonInstructionsExtension::CommonInstructionsExtension()
     {
         class CodeGen : public gd::EventMetadata::CodeGenerator
         {
-            virtual std::string Generate(gd::BaseEvent & event_, gd::EventsCodeGenerator & codeGenerator, gd::EventsCodeGenerationContext & parentContext)
+            virtual void Generate(gd::BaseEvent & event_, gd::EventsCodeGenerator & codeGenerator, gd::EventsCodeGenerationContext & parentContext, gd::EventsCodeOutput & output)
             {
                 std::string outputCode;
                 gd::WhileEvent & event = dynamic_cast<gd::WhileEvent&>(event_);
@@ -318,14 +315,13 @@ CommonInstructionsExtension::CommonInstructionsExtension()
                 outputCode += "if (" +ifPredicat+ ") {\n";
                 outputCode += actionsCode;
                 outputCode += "\n{ //Subevents: \n";
-                outputCode += codeGenerator.GenerateEventsListCode(event.GetSubEvents(), context);
-                outputCode += "} //Subevents end.\n";
-                outputCode += "}\n";
-                outputCode += "} else "+whileBoolean+" = true; \n";
+                output << outputCode;
+                codeGenerator.GenerateEventsListCode(event.GetSubEvents(), context, output);
+                output << "} //Subevents end.\n";
+                output << "}\n";
+                output << "} else "+whileBoolean+" = true; \n";
 
-                outputCode += "} while ( !"+whileBoolean+" );\n";
-
-                return outputCode;
+                output << "} while ( !"+whileBoolean+" );\n";
             }
         };
         gd::EventMetadata::CodeGenerator * codeGen = new CodeGen;
@@ -336,9 +332,8 @@ CommonInstructionsExtension::CommonInstructionsExtension()
     {
         class CodeGen : public gd::EventMetadata::CodeGenerator
         {
-            virtual std::string Generate(gd::BaseEvent & event_, gd::EventsCodeGenerator & codeGenerator, gd::EventsCodeGenerationContext & parentContext)
+            virtual void Generate(gd::BaseEvent & event_, gd::EventsCodeGenerator & codeGenerator, gd::EventsCodeGenerationContext & parentContext, gd::EventsCodeOutput & output)
             {
-                std::string outputCode;
                 gd::RepeatEvent & event = dynamic_cast<gd::RepeatEvent&>(event_);
 
                 const gd::Layout & scene = codeGenerator.GetLayout();
@@ -362,35 +357,30 @@ CommonInstructionsExtension::CommonInstructionsExtension()
                 if ( !event.GetConditions().empty() )
                     ifPredicat = codeGenerator.GenerateBooleanFullName("condition"+ToString(event.GetConditions().size()-1)+"IsTrue", context)+".val";
 
-                //Prepare object declaration and sub events
-                std::string subevents = codeGenerator.GenerateEventsListCode(event.GetSubEvents(), context);
-                std::string objectDeclaration = codeGenerator.GenerateObjectsDeclarationCode(context)+"\n";
-
-                //Write final code
+                //Write final code ( object declaration is known only when sub events are generated )
                 std::string repeatCountVar = "gdjs."+gd::SceneNameMangler::GetMangledSceneName(codeGenerator.GetLayout().GetName())
                     +"Code.repeatCount"+gd::ToString(context.GetContextDepth());
                 codeGenerator.AddGlobalDeclaration(repeatCountVar+" = 0;\n");
                 std::string repeatIndexVar = "gdjs."+gd::SceneNameMangler::GetMangledSceneName(codeGenerator.GetLayout().GetName())
                     +"Code.repeatIndex"+gd::ToString(context.GetContextDepth());
                 codeGenerator.AddGlobalDeclaration(repeatIndexVar+" = 0;\n");
-                outputCode += repeatCountVar+" = "+repeatCountCode+";\n";
-                outputCode += "for("+repeatIndexVar+" = 0;"+repeatIndexVar+" < "+repeatCountVar+";++"+repeatIndexVar+") {\n";
-                outputCode += objectDeclaration;
-                outputCode += conditionsCode;
-                outputCode += "if (" +ifPredicat+ ")\n";
-                outputCode += "{\n";
-                outputCode += actionsCode;
+                output << repeatCountVar+" = "+repeatCountCode+";\n";
+                output << "for("+repeatIndexVar+" = 0;"+repeatIndexVar+" < "+repeatCountVar+";++"+repeatIndexVar+") {\n";
+                std::size_t objectDeclaration = output.AddPlaceholder();
+                output << conditionsCode;
+                output << "if (" +ifPredicat+ ")\n";
+                output << "{\n";
+                output << actionsCode;
                 if ( event.HasSubEvents() )
                 {
-                    outputCode += "\n{ //Subevents: \n";
-                    outputCode += subevents;
-                    outputCode += "} //Subevents end.\n";
+                    output << "\n{ //Subevents: \n";
+                    codeGenerator.GenerateEventsListCode(event.GetSubEvents(), context, output);
+                    output << "} //Subevents end.\n";
                 }
-                outputCode += "}\n";
+                output << "}\n";
 
-                outputCode += "}\n";
-
-                return outputCode;
+                output << "}\n";
+                output.FillPlaceholder(objectDeclaration, codeGenerator.GenerateObjectsDeclarationCode(context)+"\n");
             }
         };
         gd::EventMetadata::CodeGenerator * codeGen = new CodeGen;
@@ -401,7 +391,7 @@ CommonInstructionsExtension::CommonInstructionsExtension()
     {
         class CodeGen : public gd::EventMetadata::CodeGenerator
         {
-            virtual std::string Generate(gd::BaseEvent & event_, gd::EventsCodeGenerator & codeGenerator, gd::EventsCodeGenerationContext & parentContext)
+            virtual void Generate(gd::BaseEvent & event_, gd::EventsCodeGenerator & codeGenerator, gd::EventsCodeGenerationContext & parentContext, gd::EventsCodeOutput & output)
             {
                 std::string outputCode;
                 gd::ForEachEvent & event = dynamic_cast<gd::ForEachEvent&>(event_);
@@ -431,7 +421,7 @@ CommonInstructionsExtension::CommonInstructionsExtension()
                         ++i;
                 }
 
-                if ( realObjects.empty() ) return "";
+                if ( realObjects.empty() ) return;
 
                 for (unsigned int i = 0;i<realObjects.size();++i)
                     parentContext.ObjectsListNeeded(realObjects[i]);
@@ -450,11 +440,6 @@ CommonInstructionsExtension::CommonInstructionsExtension()
                 if ( !event.GetConditions().empty() )
                     ifPredicat = codeGenerator.GenerateBooleanFullName("condition"+ToString(event.GetConditions().size()-1)+"IsTrue", context)+".val";
 
-                //Prepare object declaration and sub events
-                std::string subevents = codeGenerator.GenerateEventsListCode(event.GetSubEvents(), context);
-
-                std::string objectDeclaration = codeGenerator.GenerateObjectsDeclarationCode(context)+"\n";
-
                 std::string forEachTotalCountVar = "gdjs."+gd::SceneNameMangler::GetMangledSceneName(codeGenerator.GetLayout().GetName())
                     +"Code.forEachTotalCount"+gd::ToString(context.GetContextDepth());
                 codeGenerator.AddGlobalDeclaration(forEachTotalCountVar+" = 0;\n");
@@ -490,7 +475,9 @@ CommonInstructionsExtension::CommonInstructionsExtension()
                 else
                     outputCode += "for("+forEachIndexVar+" = 0;"+forEachIndexVar+" < "+forEachTotalCountVar+";++"+forEachIndexVar+") {\n";
 
-                outputCode += objectDeclaration;
+                output << outputCode;
+                outputCode.clear();
+                std::size_t objectDeclaration = output.AddPlaceholder(); //Known only when sub events are generated.
 
                 //Clear all concerned objects lists and keep only one object
                 if ( realObjects.size() == 1 )
@@ -530,17 +517,17 @@ CommonInstructionsExtension::CommonInstructionsExtension()
                 outputCode += conditionsCode;
                 outputCode += "if (" +ifPredicat+ ") {\n";
                 outputCode += actionsCode;
+                output << outputCode;
                 if ( event.HasSubEvents() )
                 {
-                    outputCode += "\n{ //Subevents: \n";
-                    outputCode += subevents;
-                    outputCode += "} //Subevents end.\n";
+                    output << "\n{ //Subevents: \n";
+                    codeGenerator.GenerateEventsListCode(event.GetSubEvents(), context, output);
+                    output << "} //Subevents end.\n";
                 }
-                outputCode += "}\n";
+                output << "}\n";
 
-                outputCode += "}\n"; //End of for loop
-
-                return outputCode;
+                output << "}\n"; //End of for loop
+                output.FillPlaceholder(objectDeclaration, codeGenerator.GenerateObjectsDeclarationCode(context)+"\n");
             }
         };
         gd::EventMetadata::CodeGenerator * codeGen = new CodeGen;
@@ -551,9 +538,9 @@ CommonInstructionsExtension::CommonInstructionsExtension()
     {
         class CodeGen : public gd::EventMetadata::CodeGenerator
         {
-            virtual std::string Generate(gd::BaseEvent & event, gd::EventsCodeGenerator & codeGenerator, gd::EventsCodeGenerationContext & context)
+            virtual void Generate(gd::BaseEvent & event, gd::EventsCodeGenerator & codeGenerator, gd::EventsCodeGenerationContext & context, gd::EventsCodeOutput & output)
             {
-                return codeGenerator.GenerateEventsListCode(event.GetSubEvents(), context);
+                codeGenerator.GenerateEventsListCode(event.GetSubEvents(), context, output);
             }
         };
         gd::EventMetadata::CodeGenerator * codeGen = new CodeGen;
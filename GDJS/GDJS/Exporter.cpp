@@ -126,8 +126,10 @@ std::string Exporter::ExportToJSON(gd::AbstractFileSystem & fs, const gd::Projec
     gd::SerializerElement rootElement;
     project.SerializeTo(rootElement);
 
-    std::string output = gd::Serializer::ToJSON(rootElement);
-    if (!wrapIntoVariable.empty()) output = wrapIntoVariable + " = " + output + ";";
+    std::string output;
+    if (!wrapIntoVariable.empty()) output = wrapIntoVariable + " = ";
+    gd::Serializer::ToJSON(rootElement, output, prettyPrinting);
+    if (!wrapIntoVariable.empty()) output += ";";
 
     if (!fs.WriteToFile(filename, output))
         return "Unable to write "+filename;
@@ -0,0 +1,148 @@
+/*
+ * GDevelop JS Platform
+ * Copyright 2008-2015 Florian Rival (Florian.Rival@gmail.com). All rights reserved.
+ * This project is released under the MIT License.
+ */
+/**
+ * @file Benchmark of the events code generation of the C++ and JS platforms,
+ * on the games of GDJS/tests/games.
+ *
+ * Usage: GDJS_benchmarks [games directory] [iterations] [events copies]
+ * The events of each scene can be copied multiple times to simulate bigger projects.
+ */
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <algorithm>
+#include <string>
+#include <set>
+#include <memory>
+#include <SFML/System/Clock.hpp>
+#include <wx/dir.h>
+#include <wx/arrstr.h>
+#include "GDCore/PlatformDefinition/Project.h"
+#include "GDCore/PlatformDefinition/Layout.h"
+#include "GDCore/Events/EventsList.h"
+#include "GDCore/Events/Event.h"
+#include "GDCore/IDE/PlatformManager.h"
+#include "GDCore/CommonTools.h"
+#include "GDCpp/CppPlatform.h"
+#include "GDCpp/Events/EventsCodeGenerator.h"
+#include "GDJS/JsPlatform.h"
+#include "GDJS/EventsCodeGenerator.h"
+
+namespace
+{
+
+/**
+ * The platforms are singletons: they must not be destroyed by the platform manager.
+ */
+struct NoDelete
+{
+    void operator()(gd::Platform *) const {};
+};
+
+unsigned int CountEvents(const gd::EventsList & events)
+{
+    unsigned int count = events.size();
+    for (unsigned int i = 0;i<events.size();++i)
+    {
+        if ( events[i].CanHaveSubEvents() )
+            count += CountEvents(events[i].GetSubEvents());
+    }
+
+    return count;
+}
+
+/**
+ * Return a copy of the events of the layout, copied \a copies times.
+ */
+gd::EventsList GetEventsCopy(const gd::Layout & layout, unsigned int copies)
+{
+    gd::EventsList events;
+    for (unsigned int i = 0;i<copies;++i)
+        events.InsertEvents(layout.GetEvents(), 0, layout.GetEvents().size());
+
+    return events;
+}
+
+/**
+ * Generate the code of all the layouts of the project \a iterations times with the generator
+ * of the platform, and print the average time taken.
+ */
+void BenchmarkGeneration(gd::Project & project, const std::string & platformName, unsigned int iterations, unsigned int copies)
+{
+    unsigned int eventsCount = 0;
+    size_t codeSize = 0;
+    sf::Int64 totalTime = 0;
+
+    for (unsigned int i = 0;i<project.GetLayoutsCount();++i)
+    {
+        gd::Layout & layout = project.GetLayout(i);
+        for (unsigned int iteration = 0;iteration<iterations;++iteration)
+        {
+            //The preprocessing modifies the events: generate the code from a copy.
+            gd::EventsList events = GetEventsCopy(layout, copies);
+            if ( iteration == 0 ) eventsCount += CountEvents(events);
+
+            sf::Clock clock;
+            std::string code;
+            if ( platformName == "C++" )
+                code = ::EventsCodeGenerator::GenerateSceneEventsCompleteCode(project, layout, events, false);
+            else
+            {
+                std::set<std::string> includeFiles;
+                code = gdjs::EventsCodeGenerator::GenerateSceneEventsCompleteCode(project, layout, events, includeFiles, false);
+            }
+            totalTime += clock.getElapsedTime().asMicroseconds();
+
+            if ( iteration == 0 ) codeSize += code.size();
+        }
+    }
+
+    std::cout << "    " << std::setw(4) << platformName
+        << ": " << std::setw(6) << eventsCount << " events, "
+        << std::setw(9) << codeSize << " characters, "
+        << std::setw(10) << std::fixed << std::setprecision(3) << static_cast<double>(totalTime)/1000.0/iterations << "ms" << std::endl;
+}
+
+}
+
+int main(int argc, char ** argv)
+{
+    std::string gamesDirectory = argc > 1 ? argv[1] : "GDJS/tests/games";
+    unsigned int iterations = argc > 2 ? std::max(1, atoi(argv[2])) : 10;
+    unsigned int copies = argc > 3 ? std::max(1, atoi(argv[3])) : 1;
+
+    gd::PlatformManager::Get()->AddPlatform(std::shared_ptr<gd::Platform>(&CppPlatform::Get(), NoDelete()));
+    gd::PlatformManager::Get()->AddPlatform(std::shared_ptr<gd::Platform>(&gdjs::JsPlatform::Get(), NoDelete()));
+
+    wxArrayString games;
+    wxDir::GetAllFiles(gamesDirectory, &games, "*.gdg", wxDIR_FILES);
+    games.Sort();
+    if ( games.empty() )
+    {
+        std::cout << "No games found in " << gamesDirectory << "." << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    std::cout << "Events code generation, average of " << iterations << " iterations"
+        << ( copies > 1 ? ", events copied "+gd::ToString(copies)+" times" : "" ) << ":" << std::endl;
+    for (unsigned int i = 0;i<games.size();++i)
+    {
+        gd::Project project;
+        if ( !project.LoadFromFile(gd::ToString(games[i])) )
+        {
+            std::cout << "Unable to load " << games[i] << ", skipped." << std::endl;
+            continue;
+        }
+
+        std::cout << gd::ToString(games[i]) << ":" << std::endl;
+        BenchmarkGeneration(project, "C++", iterations, copies);
+        BenchmarkGeneration(project, "JS", iterations, copies);
+    }
+
+    CppPlatform::DestroySingleton();
+    gdjs::JsPlatform::DestroySingleton();
+    return EXIT_SUCCESS;
+}
@@ -910,10 +910,10 @@ changesNeedRestart(false)
     }
 
     int eventsCompilerMaxThread = 0;
-    if ( pConfig->Read("/CodeCompiler/MaxThread", &eventsCompilerMaxThread, 1) )
-    {
+    if ( pConfig->Read("/CodeCompiler/MaxThread", &eventsCompilerMaxThread) && eventsCompilerMaxThread > 0 )
         codeCompilerThreadEdit->SetValue(eventsCompilerMaxThread);
-    }
+    else
+        codeCompilerThreadEdit->SetValue(CodeCompiler::Get()->GetMaxProcessesCount());
 
     wxString javaDir;
     if ( pConfig->Read("/Paths/Java", &javaDir) )